@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <pthread.h>
+#include "securec.h"
+#include "archive_macros.h"
+#include "archive_crc32.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define ARCHIVE_CRC32_PCLMUL
+#elif defined(__aarch64__) && defined(__GNUC__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#define ARCHIVE_CRC32_ARMV8
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#endif
+
+// reflected polynomial of the zip/gzip crc
+#define CRC32_POLY 0xedb88320U
+#define CRC32_TABLE_NUM 8
+#define CRC32_TABLE_SIZE 256
+#define CRC32_BYTE_MASK 0xffU
+#define CRC32_BYTE_BITS 8
+#define CRC32_X2N_NUM 32
+#define CRC32_PCLMUL_MIN_LEN 64
+#define CRC32_PCLMUL_CHUNK_MASK 15
+
+typedef uint32_t (*Crc32Func)(uint32_t crc, const uint8_t *buf, size_t len);
+
+static uint32_t g_crc32Table[CRC32_TABLE_NUM][CRC32_TABLE_SIZE];
+// x^(2^n) modulo the polynomial, used to shift a crc over a run of zero bytes
+static uint32_t g_crc32X2nTable[CRC32_X2N_NUM];
+static Crc32Func g_crc32Func = NULL;
+static pthread_once_t g_crc32Once = PTHREAD_ONCE_INIT;
+
+static inline uint32_t Crc32Byte(uint32_t crc, uint8_t value)
+{
+    return g_crc32Table[0][(crc ^ value) & CRC32_BYTE_MASK] ^ (crc >> CRC32_BYTE_BITS);
+}
+
+// Portable slicing-by-8, eight table lookups per 8 input bytes
+static uint32_t Crc32Slice8(uint32_t crc, const uint8_t *buf, size_t len)
+{
+    crc = ~crc;
+    while (len > 0 && ((uintptr_t)buf & 7) != 0) {
+        crc = Crc32Byte(crc, *buf++);
+        len--;
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (len >= 8) {
+        uint32_t lo;
+        uint32_t hi;
+        (void)memcpy_s(&lo, sizeof(lo), buf, sizeof(lo));
+        (void)memcpy_s(&hi, sizeof(hi), buf + sizeof(lo), sizeof(hi));
+        lo ^= crc;
+        crc = g_crc32Table[7][lo & 0xff] ^ g_crc32Table[6][(lo >> 8) & 0xff] ^
+            g_crc32Table[5][(lo >> 16) & 0xff] ^ g_crc32Table[4][lo >> 24] ^
+            g_crc32Table[3][hi & 0xff] ^ g_crc32Table[2][(hi >> 8) & 0xff] ^
+            g_crc32Table[1][(hi >> 16) & 0xff] ^ g_crc32Table[0][hi >> 24];
+        buf += 8;
+        len -= 8;
+    }
+#endif
+    while (len > 0) {
+        crc = Crc32Byte(crc, *buf++);
+        len--;
+    }
+    return ~crc;
+}
+
+#ifdef ARCHIVE_CRC32_PCLMUL
+// Folds 64 bytes per round with carry-less multiplies and Barrett-reduces the result, len is a multiple of 16
+// and at least 64. The crc is taken and returned inverted. Constants are those of "Fast CRC Computation for
+// Generic Polynomials Using PCLMULQDQ Instruction" for the bit-reflected zip polynomial.
+__attribute__((target("sse4.1,pclmul"))) static uint32_t Crc32PclmulFold(const uint8_t *buf, size_t len,
+    uint32_t crc)
+{
+    static const uint64_t k1k2[] __attribute__((aligned(16))) = { 0x0154442bd4, 0x01c6e41596 };
+    static const uint64_t k3k4[] __attribute__((aligned(16))) = { 0x01751997d0, 0x00ccaa009e };
+    static const uint64_t k5k0[] __attribute__((aligned(16))) = { 0x0163cd6124, 0x0000000000 };
+    static const uint64_t poly[] __attribute__((aligned(16))) = { 0x01db710641, 0x01f7011641 };
+
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+    __m128i x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+    __m128i x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+    __m128i x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    __m128i x0 = _mm_load_si128((const __m128i *)k1k2);
+    buf += CRC32_PCLMUL_MIN_LEN;
+    len -= CRC32_PCLMUL_MIN_LEN;
+
+    while (len >= CRC32_PCLMUL_MIN_LEN) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(buf + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(buf + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(buf + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(buf + 0x30)));
+        buf += CRC32_PCLMUL_MIN_LEN;
+        len -= CRC32_PCLMUL_MIN_LEN;
+    }
+
+    // fold the four lanes into one
+    x0 = _mm_load_si128((const __m128i *)k3k4);
+    __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x4), x5);
+
+    while (len >= 16) {
+        x2 = _mm_loadu_si128((const __m128i *)buf);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x2), x5);
+        buf += 16;
+        len -= 16;
+    }
+
+    // 128 to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = _mm_loadl_epi64((const __m128i *)k5k0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x00), x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128((const __m128i *)poly);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+static uint32_t Crc32Pclmul(uint32_t crc, const uint8_t *buf, size_t len)
+{
+    if (len >= CRC32_PCLMUL_MIN_LEN) {
+        size_t chunk = len & ~(size_t)CRC32_PCLMUL_CHUNK_MASK;
+        crc = ~Crc32PclmulFold(buf, chunk, ~crc);
+        buf += chunk;
+        len -= chunk;
+    }
+    return len > 0 ? Crc32Slice8(crc, buf, len) : crc;
+}
+#endif
+
+#ifdef ARCHIVE_CRC32_ARMV8
+#ifdef __clang__
+#define CRC32_ARMV8_TARGET "crc"
+#else
+#define CRC32_ARMV8_TARGET "+crc"
+#endif
+// ARMv8 CRC32 instructions, one per 8 input bytes
+__attribute__((target(CRC32_ARMV8_TARGET))) static uint32_t Crc32Armv8(uint32_t crc, const uint8_t *buf,
+    size_t len)
+{
+    crc = ~crc;
+    while (len > 0 && ((uintptr_t)buf & 7) != 0) {
+        crc = __crc32b(crc, *buf++);
+        len--;
+    }
+    while (len >= 8) {
+        uint64_t value;
+        (void)memcpy_s(&value, sizeof(value), buf, sizeof(value));
+        crc = __crc32d(crc, value);
+        buf += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        crc = __crc32b(crc, *buf++);
+        len--;
+    }
+    return ~crc;
+}
+#endif
+
+static uint32_t Crc32MultModP(uint32_t a, uint32_t b)
+{
+    uint32_t m = 1U << 31;
+    uint32_t p = 0;
+    while (m != 0) {
+        if ((a & m) != 0) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) != 0 ? (b >> 1) ^ CRC32_POLY : b >> 1;
+    }
+    return p;
+}
+
+static void Crc32Init(void)
+{
+    for (uint32_t n = 0; n < CRC32_TABLE_SIZE; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < CRC32_BYTE_BITS; k++) {
+            c = (c & 1) != 0 ? CRC32_POLY ^ (c >> 1) : c >> 1;
+        }
+        g_crc32Table[0][n] = c;
+    }
+    for (uint32_t n = 0; n < CRC32_TABLE_SIZE; n++) {
+        uint32_t c = g_crc32Table[0][n];
+        for (int k = 1; k < CRC32_TABLE_NUM; k++) {
+            c = g_crc32Table[0][c & CRC32_BYTE_MASK] ^ (c >> CRC32_BYTE_BITS);
+            g_crc32Table[k][n] = c;
+        }
+    }
+    // x^1 in the reflected representation
+    uint32_t p = 1U << 30;
+    g_crc32X2nTable[0] = p;
+    for (int n = 1; n < CRC32_X2N_NUM; n++) {
+        p = Crc32MultModP(p, p);
+        g_crc32X2nTable[n] = p;
+    }
+
+    g_crc32Func = Crc32Slice8;
+#if defined(ARCHIVE_CRC32_PCLMUL)
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+        g_crc32Func = Crc32Pclmul;
+    }
+#elif defined(ARCHIVE_CRC32_ARMV8)
+    if ((getauxval(AT_HWCAP) & HWCAP_CRC32) != 0) {
+        g_crc32Func = Crc32Armv8;
+    }
+#endif
+}
+
+ARCHIVE_IMPL uint32_t ArchiveCrc32(uint32_t crc, const uint8_t *buf, size_t len)
+{
+    if (buf == NULL || len == 0) {
+        return crc;
+    }
+    (void)pthread_once(&g_crc32Once, Crc32Init);
+    return g_crc32Func(crc, buf, len);
+}
+
+ARCHIVE_IMPL uint32_t ArchiveCrc32Combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+    (void)pthread_once(&g_crc32Once, Crc32Init);
+    // multiply crc1 by x^(8 * len2), walking the bits of the length over the x^(2^n) table
+    uint32_t p = 1U << 31;
+    uint32_t k = 3;
+    while (len2 != 0) {
+        if ((len2 & 1) != 0) {
+            p = Crc32MultModP(g_crc32X2nTable[k & (CRC32_X2N_NUM - 1)], p);
+        }
+        len2 >>= 1;
+        k++;
+    }
+    return Crc32MultModP(p, crc1) ^ crc2;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ARCHIVE_CRC32_H
+#define ARCHIVE_CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Same result as zlib crc32(), the kernel is picked once at runtime from the cpu features
+uint32_t ArchiveCrc32(uint32_t crc, const uint8_t *buf, size_t len);
+
+// CRC of A followed by B from crc1 of A, crc2 of B and the length of B, so chunks can be checksummed apart
+uint32_t ArchiveCrc32Combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
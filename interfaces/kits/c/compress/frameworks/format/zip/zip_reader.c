@@ -16,6 +16,7 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <string.h>
 #include <utime.h>
@@ -32,6 +33,7 @@
 #include "compress/stream_deflate.h"
 #include "raw/stream_raw.h"
 #include "zlib.h"
+#include "checksum/archive_crc32.h"
 #include "zip_handler_common.h"
 #include "securec.h"
 #include "errorcode.h"
@@ -39,6 +41,10 @@
 
 #define EXTRACT_ENTRY_CONTINUE (0)
 #define EXTRACT_ENTRY_BREAK (-1)
+#define ZIP_EXTRACT_INDEX_INIT_CAPACITY (64)
+#define ZIP_CATALOG_MIN_BUCKET_NUM (16)
+#define ZIP_CATALOG_HASH_OFFSET (14695981039346656037ULL) // FNV-1a 64 bit
+#define ZIP_CATALOG_HASH_PRIME (1099511628211ULL)
 
 struct ZipReaderEntryInfo {
     uint64_t uncompressedSize;
@@ -57,7 +63,6 @@ struct ZipReaderEntryInfo {
     time_t modifiedTime;
 
     bool useUnicodePath;
-    char entryName[ZIP_FILE_NAME_LEN_MAX + 1];
 };
 
 struct ZipReaderExtractContext {
@@ -68,6 +73,7 @@ struct ZipReaderExtractContext {
     struct ReadCentralDirHeader centralDirHeader;
     struct LocalFileHeader localFileHeader;
     struct ZipReaderEntryInfo entryInfo;
+    char entryName[ZIP_FILE_NAME_LEN_MAX + 1];
     struct StrongEncryptionHeader strongEncryptHeader;
     // progress of decompress each entry
     uint64_t progressPrevious;
@@ -81,6 +87,27 @@ struct ReadResource {
     char buffer[ZIP_BUF_INTERNAL];
 };
 
+// A file or symlink entry resolved from the central directory, ready to be extracted by any worker
+struct ZipReaderIndexEntry {
+    struct ReadCentralDirHeader centralDirHeader;
+    struct ZipReaderEntryInfo entryInfo;
+    char *outPath;
+};
+
+// An entry of the random access catalog, kept in central directory order
+struct ZipReaderCatalogEntry {
+    struct ReadCentralDirHeader centralDirHeader;
+    struct ZipReaderEntryInfo entryInfo;
+    char *name;
+    bool isDirectory;
+};
+
+struct ZipReaderExtractWorker {
+    pthread_t thread;
+    struct ZipReaderExtractContext context;
+    struct ReadResource resource;
+};
+
 struct ZipReader {
     struct EndOfCentralDir endOfCentralDir;
     struct EndOfCentralDir64 endOfCentralDir64;
@@ -97,11 +124,40 @@ struct ZipReader {
     int8_t isZip64;
     uint64_t totalNumberOfEntries;
 
+    char archivePath[PATH_MAX + 1];
+    // backend of every file stream the reader creates
+    uint32_t fileIoMode;
+    uint32_t fileIoBufferSize;
+
+    // extract index shared by the workers, entries are claimed through nextIndexEntry
+    struct ZipReaderIndexEntry *indexEntries;
+    size_t indexEntryCount;
+    size_t indexEntryCapacity;
+    size_t extractThreadNum;
+    _Atomic size_t nextIndexEntry;
+    _Atomic int extractResult;
+    // auto rename and file creation take turns in index order, so duplicated names resolve as a serial extraction
+    pthread_mutex_t pathLock;
+    pthread_cond_t pathCond;
+    size_t nextPathEntry;
+
+    // random access catalog, built from the central directory on first use
+    struct ZipReaderCatalogEntry *catalogEntries;
+    size_t catalogEntryCount;
+    size_t catalogEntryCapacity;
+    // open addressing name table holding entry index + 1, 0 marks a free bucket
+    size_t *catalogBuckets;
+    size_t catalogBucketNum;
+    bool catalogBuilt;
+    // catalog extraction drives context and resource too, so ExtractAllFiles takes it as well
+    pthread_mutex_t catalogLock;
+
     // progress
     OH_Archive_ProgressHandlerWithData progressHandlerWithData;
     void *progressHandlerData;
     uint64_t progressTotal;
     _Atomic uint64_t progressUpdated;
+    pthread_mutex_t progressLock;
 };
 
 /* 删除当前正在解压Item发生异常生成的文件*/
@@ -200,11 +256,35 @@ LOCAL struct ZipReader *ZipReaderCreate(void)
     }
 
     reader->context.reader = reader;
+    pthread_mutex_init(&reader->pathLock, NULL);
+    pthread_cond_init(&reader->pathCond, NULL);
+    pthread_mutex_init(&reader->progressLock, NULL);
+    pthread_mutex_init(&reader->catalogLock, NULL);
     return reader;
 }
 
+LOCAL void ZipReaderFreeCatalog(struct ZipReader *reader)
+{
+    for (size_t i = 0; i < reader->catalogEntryCount; i++) {
+        free(reader->catalogEntries[i].name);
+    }
+    free(reader->catalogEntries);
+    free(reader->catalogBuckets);
+    reader->catalogEntries = NULL;
+    reader->catalogEntryCount = 0;
+    reader->catalogEntryCapacity = 0;
+    reader->catalogBuckets = NULL;
+    reader->catalogBucketNum = 0;
+    reader->catalogBuilt = false;
+}
+
 LOCAL void ZipReaderDestroy(struct ZipReader **reader)
 {
+    ZipReaderFreeCatalog(*reader);
+    pthread_mutex_destroy(&(*reader)->catalogLock);
+    pthread_mutex_destroy(&(*reader)->pathLock);
+    pthread_cond_destroy(&(*reader)->pathCond);
+    pthread_mutex_destroy(&(*reader)->progressLock);
     free(*reader);
     *reader = NULL;
 }
@@ -270,7 +350,7 @@ LOCAL int ZipReaderProcessExtraField(struct ZipReader *reader, void *extraField,
                 ret = ZipReadUnicodePathExtraField(extraField,
                     cur,
                     dataSize,
-                    (unsigned char *)&reader->context.entryInfo.entryName,
+                    (unsigned char *)&reader->context.entryName,
                     GETV(reader->context.centralDirHeader.fileNameLength));
                 if (ret == ARCHIVE_OK) {
                     reader->context.entryInfo.useUnicodePath = true;
@@ -313,19 +393,19 @@ LOCAL int ZipReaderProcessCentralDirHeader(struct ZipReader *reader, uint64_t of
 
 LOCAL int ZipReaderConvertFileNameEncoding(struct ZipReader *reader, uint16_t fileNameLen)
 {
-    if (IsUTF8Str(reader->context.entryInfo.entryName)) {
+    if (IsUTF8Str(reader->context.entryName)) {
         return ARCHIVE_OK;
     }
     uint16_t utf8NameSize = fileNameLen * 4 + 1; // 假设每个字符最多转换为4个字节，+1为结束符
     utf8NameSize = utf8NameSize > ZIP_FILE_NAME_LEN_MAX ? ZIP_FILE_NAME_LEN_MAX : utf8NameSize;
-    char *utf8Name = ConvertStrGBKToUTF8((const char *)(reader->context.entryInfo.entryName));
+    char *utf8Name = ConvertStrGBKToUTF8((const char *)(reader->context.entryName));
     if (utf8Name) {
-        int ret = strncpy_s(reader->context.entryInfo.entryName,  utf8NameSize, utf8Name, strlen(utf8Name));
+        int ret = strncpy_s(reader->context.entryName,  utf8NameSize, utf8Name, strlen(utf8Name));
         free(utf8Name);
         if (ret != EOK) {
             return ARCHIVE_INTERNAL_ERROR;
         }
-        reader->context.entryInfo.entryName[utf8NameSize] = '\0';
+        reader->context.entryName[utf8NameSize] = '\0';
     }
 
     return ARCHIVE_OK;
@@ -338,11 +418,11 @@ LOCAL void ZipReaderConvertPathSlash(struct ZipReader *reader)
         hostOS != ZIP_HOST_OS_VFAT) {
             return;
     }
-    if (strchr(reader->context.entryInfo.entryName, '\\') != NULL) {
-        size_t len = strlen(reader->context.entryInfo.entryName);
+    if (strchr(reader->context.entryName, '\\') != NULL) {
+        size_t len = strlen(reader->context.entryName);
         for (size_t i = 0; i < len; i++) {
-            if (reader->context.entryInfo.entryName[i] == '\\') {
-                reader->context.entryInfo.entryName[i] = '/';
+            if (reader->context.entryName[i] == '\\') {
+                reader->context.entryName[i] = '/';
             }
         }
     }
@@ -359,11 +439,11 @@ LOCAL int ZipReaderGoToCentralDirHeader(struct ZipReader *reader, uint64_t offse
     uint16_t fileNameLen = GETV(reader->context.centralDirHeader.fileNameLength) < ZIP_FILE_NAME_LEN_MAX
                                 ? GETV(reader->context.centralDirHeader.fileNameLength)
                                 : ZIP_FILE_NAME_LEN_MAX;
-    size_t read = StreamRead(reader->resource.baseStream, reader->context.entryInfo.entryName, fileNameLen);
+    size_t read = StreamRead(reader->resource.baseStream, reader->context.entryName, fileNameLen);
     if (read != fileNameLen) {
         return ARCHIVE_READ_ERROR;
     }
-    reader->context.entryInfo.entryName[fileNameLen] = '\0';
+    reader->context.entryName[fileNameLen] = '\0';
     void *extraField = malloc(GETV(reader->context.centralDirHeader.extraFieldLength));
     if (extraField == NULL) {
         return ARCHIVE_MEM_ERROR;
@@ -464,8 +544,14 @@ LOCAL int ZipReaderOpenFile(HmArchiveReadInfo *archive, const char *infile)
         return ARCHIVE_MEM_ERROR;
     }
     archive->fmtInfo = reader;
+    if (strncpy_s(reader->archivePath, sizeof(reader->archivePath), infile, strlen(infile)) != EOK) {
+        ZipReaderDestroy(&reader);
+        return ARCHIVE_NAME_TOO_LONG_ERROR;
+    }
 
-    struct Stream *stream = FileStreamCreate(infile);
+    reader->fileIoMode = archive->fileIoMode;
+    reader->fileIoBufferSize = archive->fileIoBufferSize;
+    struct Stream *stream = FileStreamCreateWithIo(infile, reader->fileIoMode, reader->fileIoBufferSize);
     if (stream == NULL) {
         ZipReaderDestroy(&reader);
         return ARCHIVE_INTERNAL_ERROR;
@@ -512,7 +598,7 @@ LOCAL int64_t ZipReaderReadData(struct ZipReaderExtractContext *context, struct
     }
 
     // Update crc according to the data read
-    context->entryInfo.entryCrc = crc32(context->entryInfo.entryCrc, buf, read);
+    context->entryInfo.entryCrc = ArchiveCrc32(context->entryInfo.entryCrc, buf, read);
 
     return read;
 }
@@ -578,8 +664,8 @@ LOCAL bool ZipReaderEntryIsSymlink(struct ReadCentralDirHeader *centralDirHeader
 
 LOCAL bool ZipReaderEntryIsDirectory(struct ZipReaderExtractContext *context)
 {
-    size_t filenameLen = strlen(context->entryInfo.entryName);
-    char *filename = context->entryInfo.entryName;
+    size_t filenameLen = strlen(context->entryName);
+    char *filename = context->entryName;
     if (filename != NULL && filenameLen > 0 && filename[filenameLen - 1] == '/') {
         return true;
     }
@@ -650,8 +736,13 @@ LOCAL int ZipReaderInitStream(struct ZipReaderExtractContext *context, struct Re
     StreamSetBase(resource->compressStream, resource->baseStream);
     ret = StreamOpen(resource->compressStream, ARCHIVE_OPEN_MODE_READ);
     RETURN_IF_FAIL(ret);
-    if (!ZipReaderEntryIsSymlink(&context->centralDirHeader)) {
-        resource->extractStream = FileStreamCreate(outPath);
+    // without an output path the caller consumes the data itself
+    if (outPath != NULL && !ZipReaderEntryIsSymlink(&context->centralDirHeader)) {
+        struct ZipReader *reader = context->reader;
+        resource->extractStream = FileStreamCreateWithIo(outPath, reader->fileIoMode, reader->fileIoBufferSize);
+        if (resource->extractStream == NULL) {
+            return ARCHIVE_MEM_ERROR;
+        }
         ret = StreamOpen(resource->extractStream, ARCHIVE_OPEN_MODE_CREATE);
     }
     return ret;
@@ -708,8 +799,8 @@ LOCAL int ZipReaderVerifyEntryCrc(struct ZipReaderExtractContext *context, struc
     return ARCHIVE_OK;
 }
 
-LOCAL int ZipReaderAutoRenamePath(struct ZipReader *reader, const char *entryName,
-    const char *outPath, char *newFilePath, size_t newFilePathSize)
+LOCAL int ZipReaderAutoRenamePath(struct ZipReader *reader, const char *outPath, char *newFilePath,
+    size_t newFilePathSize)
 {
     int ret;
     ret = strncpy_s(newFilePath, newFilePathSize, outPath, newFilePathSize);
@@ -725,6 +816,27 @@ LOCAL int ZipReaderAutoRenamePath(struct ZipReader *reader, const char *entryNam
     return ARCHIVE_OK;
 }
 
+// Adds the bytes a worker has processed since its last report and notifies the handler, one caller at a time
+LOCAL int ZipReaderReportProgress(struct ZipReader *reader, uint64_t processed)
+{
+    int ret = OH_ARCHIVE_PROGRESS_CONTINUE;
+    pthread_mutex_lock(&reader->progressLock);
+    uint64_t updated = atomic_fetch_add(&reader->progressUpdated, processed) + processed;
+    if (atomic_load(&reader->extractResult) == ARCHIVE_CANCEL_ERROR) {
+        ret = OH_ARCHIVE_PROGRESS_CANCEL;
+    } else {
+        int progress = updated * PROGRESS_PERCENT / reader->progressTotal;
+        // progress must be less than or equal to 100%
+        ret = reader->progressHandlerWithData(progress <= 100 ? progress : 100, reader->progressHandlerData);
+        int expected = ARCHIVE_OK;
+        if (ret == OH_ARCHIVE_PROGRESS_CANCEL) {
+            atomic_compare_exchange_strong(&reader->extractResult, &expected, ARCHIVE_CANCEL_ERROR);
+        }
+    }
+    pthread_mutex_unlock(&reader->progressLock);
+    return ret;
+}
+
 LOCAL int ZipReaderUpdateProgress(struct ZipReaderExtractContext *context, struct ReadResource *resource, bool force)
 {
     struct ZipReader *reader = context->reader;
@@ -733,6 +845,10 @@ LOCAL int ZipReaderUpdateProgress(struct ZipReaderExtractContext *context, struc
     }
 
     if (reader->progressHandlerWithData) {
+        // another worker's handler call has already cancelled the extraction
+        if (atomic_load(&reader->extractResult) == ARCHIVE_CANCEL_ERROR) {
+            return OH_ARCHIVE_PROGRESS_CANCEL;
+        }
         size_t totalIn = StreamGetTotalIn(resource->compressStream);
         if (totalIn >  context->entryInfo.compressedSize) {
             totalIn = context->entryInfo.compressedSize;
@@ -742,9 +858,7 @@ LOCAL int ZipReaderUpdateProgress(struct ZipReaderExtractContext *context, struc
         size_t currentUpdate = (context->progressPrevious + totalIn) - context->progressUpdated;
         if ((currentUpdate > PROGRESS_UPDATE_INTERVAL) || force) {
             context->progressUpdated = context->progressPrevious + totalIn;
-            int progress = context->progressUpdated * PROGRESS_PERCENT / reader->progressTotal;
-            // progress must be less than or equal to 100%
-            return reader->progressHandlerWithData(progress <= 100 ? progress : 100, reader->progressHandlerData);
+            return ZipReaderReportProgress(reader, currentUpdate);
         }
     }
 
@@ -840,67 +954,230 @@ LOCAL int ZipReaderSetFileAttribs(struct ZipReaderExtractContext *context, const
     return ARCHIVE_OK;
 }
 
-LOCAL int ZipReaderExtractEntry(struct ZipReader *reader, char *outPath)
+// Writes the opened entry to path and restores its time and attributes
+LOCAL int ZipReaderWriteEntryFile(struct ZipReaderExtractContext *context, struct ReadResource *resource,
+    const char *path)
 {
     int ret;
-    if (ZipReaderEntryIsDirectory(&reader->context) && !ZipReaderEntryIsSymlink(&reader->context.centralDirHeader)) {
-        return CreateDirectory(outPath, NULL);
-    }
-    char newFilePath[ZIP_FILE_NAME_LEN_MAX];
-    ret = ZipReaderAutoRenamePath(
-        reader, reader->context.entryInfo.entryName, outPath, newFilePath, ZIP_FILE_NAME_LEN_MAX);
-    RETURN_IF_FAIL(ret);
-    ret = CreateParentDirectory(newFilePath, NULL);
-    RETURN_IF_FAIL(ret);
-    ret = ZipReaderOpenEntry(&reader->context, &reader->resource, newFilePath);
-    RETURN_IF_FAIL(ret);
-    if (ZipReaderEntryIsSymlink(&reader->context.centralDirHeader)) {
-        return ZipReaderCreateSymlink(&reader->context, &reader->resource, newFilePath);
+    if (ZipReaderEntryIsSymlink(&context->centralDirHeader)) {
+        return ZipReaderCreateSymlink(context, resource, path);
     } else {
-        ret = ZipReaderSaveFile(&reader->context, &reader->resource, newFilePath);
+        ret = ZipReaderSaveFile(context, resource, path);
     }
     RETURN_IF_FAIL(ret);
 
     // Set the time of the file
-    ZipReaderSetFileTime(&reader->context, newFilePath);
+    ZipReaderSetFileTime(context, path);
     // Set the attributes of the file
-    ZipReaderSetFileAttribs(&reader->context, newFilePath);
+    ZipReaderSetFileAttribs(context, path);
+    return ret;
+}
+
+// Picks the path of the entry at index and creates it once every earlier entry has created its own
+LOCAL int ZipReaderExtractEntry(struct ZipReaderExtractContext *context, struct ReadResource *resource,
+    size_t index, const char *outPath)
+{
+    struct ZipReader *reader = context->reader;
+    char newFilePath[ZIP_FILE_NAME_LEN_MAX];
+    pthread_mutex_lock(&reader->pathLock);
+    while (reader->nextPathEntry != index) {
+        pthread_cond_wait(&reader->pathCond, &reader->pathLock);
+    }
+    int ret = ZipReaderAutoRenamePath(reader, outPath, newFilePath, ZIP_FILE_NAME_LEN_MAX);
+    if (ret == ARCHIVE_OK) {
+        ret = ZipReaderOpenEntry(context, resource, newFilePath);
+    }
+    // a symlink only appears on disk once written, its data is small enough to do so within the turn
+    bool written = ret == ARCHIVE_OK && ZipReaderEntryIsSymlink(&context->centralDirHeader);
+    if (written) {
+        ret = ZipReaderWriteEntryFile(context, resource, newFilePath);
+    }
+    reader->nextPathEntry++;
+    pthread_cond_broadcast(&reader->pathCond);
+    pthread_mutex_unlock(&reader->pathLock);
+    if (ret != ARCHIVE_OK || written) {
+        return ret;
+    }
+    return ZipReaderWriteEntryFile(context, resource, newFilePath);
+}
+
+LOCAL void ZipReaderFreeExtractIndex(struct ZipReader *reader)
+{
+    for (size_t i = 0; i < reader->indexEntryCount; i++) {
+        free(reader->indexEntries[i].outPath);
+    }
+    free(reader->indexEntries);
+    reader->indexEntries = NULL;
+    reader->indexEntryCount = 0;
+    reader->indexEntryCapacity = 0;
+}
+
+LOCAL int ZipReaderAddIndexEntry(struct ZipReader *reader, const char *outPath)
+{
+    int ret = CreateParentDirectory(outPath, NULL);
+    RETURN_IF_FAIL(ret);
+    if (reader->indexEntryCount == reader->indexEntryCapacity) {
+        size_t capacity = reader->indexEntryCapacity == 0 ? ZIP_EXTRACT_INDEX_INIT_CAPACITY :
+            reader->indexEntryCapacity << 1;
+        struct ZipReaderIndexEntry *entries =
+            (struct ZipReaderIndexEntry *)realloc(reader->indexEntries, capacity * sizeof(struct ZipReaderIndexEntry));
+        if (entries == NULL) {
+            return ARCHIVE_MEM_ERROR;
+        }
+        reader->indexEntries = entries;
+        reader->indexEntryCapacity = capacity;
+    }
+    struct ZipReaderIndexEntry *entry = &reader->indexEntries[reader->indexEntryCount];
+    entry->outPath = strdup(outPath);
+    if (entry->outPath == NULL) {
+        return ARCHIVE_MEM_ERROR;
+    }
+    entry->centralDirHeader = reader->context.centralDirHeader;
+    entry->entryInfo = reader->context.entryInfo;
+    reader->indexEntryCount++;
+    return ARCHIVE_OK;
+}
+
+// Reads the central directory once: directories are created here, files and symlinks are indexed for the workers
+LOCAL int ZipReaderBuildExtractIndex(struct ZipReader *reader, const char *outDir)
+{
+    char outPath[ZIP_FILE_NAME_LEN_MAX];
+    int ret = ZipReaderGotoFirstCentralDirHeader(reader);
+    while (ret == ARCHIVE_OK) {
+        ret = GetOutputFilePath(reader->context.entryName, outDir, outPath, ZIP_FILE_NAME_LEN_MAX);
+        RETURN_IF_FAIL(ret);
+        if (ZipReaderEntryIsDirectory(&reader->context) &&
+            !ZipReaderEntryIsSymlink(&reader->context.centralDirHeader)) {
+            ret = CreateDirectory(outPath, NULL);
+            atomic_fetch_add(&reader->progressUpdated, reader->context.entryInfo.compressedSize +
+                sizeof(struct LocalFileHeader) + GETV(reader->context.centralDirHeader.fileNameLength));
+        } else {
+            ret = ZipReaderAddIndexEntry(reader, outPath);
+        }
+        RETURN_IF_FAIL(ret);
+        ret = ZipReaderGotoNextCentralDirHeader(reader);
+    }
+    return ret == ARCHIVE_END_OF_LIST ? ARCHIVE_OK : ret;
+}
+
+// Claims index entries until the index is drained or any worker fails or cancels
+LOCAL int ZipReaderRunExtractWorker(struct ZipReaderExtractContext *context, struct ReadResource *resource)
+{
+    struct ZipReader *reader = context->reader;
+    while (atomic_load(&reader->extractResult) == ARCHIVE_OK) {
+        size_t index = atomic_fetch_add(&reader->nextIndexEntry, 1);
+        if (index >= reader->indexEntryCount) {
+            break;
+        }
+        struct ZipReaderIndexEntry *entry = &reader->indexEntries[index];
+        context->centralDirHeader = entry->centralDirHeader;
+        context->entryInfo = entry->entryInfo;
+        int ret = ZipReaderExtractEntry(context, resource, index, entry->outPath);
+        if (ret != ARCHIVE_OK) {
+            int expected = ARCHIVE_OK;
+            atomic_compare_exchange_strong(&reader->extractResult, &expected, ret);
+            break;
+        }
+        context->progressPrevious += context->entryInfo.compressedSize + sizeof(struct LocalFileHeader) +
+            context->localFileHeader.fileNameLength + context->localFileHeader.extraFieldLength;
+    }
+    return atomic_load(&reader->extractResult);
+}
+
+LOCAL void *ZipReaderExtractWorkerRoutine(void *arg)
+{
+    struct ZipReaderExtractWorker *worker = (struct ZipReaderExtractWorker *)arg;
+    (void)ZipReaderRunExtractWorker(&worker->context, &worker->resource);
+    return NULL;
+}
+
+LOCAL size_t ZipReaderGetExtractWorkerNum(struct ZipReader *reader)
+{
+    long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t workerNum = reader->extractThreadNum > 1 ? reader->extractThreadNum : 1;
+    if (cpuNum > 0 && workerNum > (size_t)cpuNum) {
+        workerNum = (size_t)cpuNum;
+    }
+    if (workerNum > reader->indexEntryCount) {
+        workerNum = reader->indexEntryCount;
+    }
+    return workerNum;
+}
+
+// Each extra worker reopens the archive so that no stream position is shared between threads
+LOCAL int ZipReaderStartExtractWorker(struct ZipReader *reader, struct ZipReaderExtractWorker *worker,
+    const char *outDir)
+{
+    worker->context.reader = reader;
+    worker->context.outDir = outDir;
+    worker->resource.baseStream = FileStreamCreateWithIo(reader->archivePath, reader->fileIoMode,
+        reader->fileIoBufferSize);
+    if (worker->resource.baseStream == NULL) {
+        return ARCHIVE_MEM_ERROR;
+    }
+    int ret = StreamOpen(worker->resource.baseStream, ARCHIVE_OPEN_MODE_READ);
+    if (ret == ARCHIVE_OK && pthread_create(&worker->thread, NULL, ZipReaderExtractWorkerRoutine, worker) != 0) {
+        ret = ARCHIVE_INTERNAL_ERROR;
+    }
+    if (ret != ARCHIVE_OK) {
+        StreamClose(worker->resource.baseStream);
+        StreamDestroy(&worker->resource.baseStream);
+    }
     return ret;
 }
 
+LOCAL int ZipReaderExtractIndexEntries(struct ZipReader *reader, const char *outDir)
+{
+    size_t workerNum = ZipReaderGetExtractWorkerNum(reader);
+    struct ZipReaderExtractWorker *workers = NULL;
+    size_t started = 0;
+    if (workerNum > 1) {
+        workers = (struct ZipReaderExtractWorker *)calloc(workerNum - 1, sizeof(struct ZipReaderExtractWorker));
+    }
+    // fewer workers than planned only slows the extraction down
+    while (workers != NULL && started < workerNum - 1 &&
+        ZipReaderStartExtractWorker(reader, &workers[started], outDir) == ARCHIVE_OK) {
+        started++;
+    }
+    (void)ZipReaderRunExtractWorker(&reader->context, &reader->resource);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        StreamClose(workers[i].resource.baseStream);
+        StreamDestroy(&workers[i].resource.baseStream);
+    }
+    free(workers);
+    return atomic_load(&reader->extractResult);
+}
+
 LOCAL int ZipReaderExtractAllFiles(HmArchiveReadInfo *archive, const char *outDir)
 {
     if (archive == NULL || outDir == NULL) {
         return ARCHIVE_PARAM_ERROR;
     }
-    int ret;
-    char outPath[ZIP_FILE_NAME_LEN_MAX];
     struct ZipReader *reader = (struct ZipReader *)archive->fmtInfo;
     if (reader == NULL) {
         return ARCHIVE_INTERNAL_ERROR;
     }
 
+    pthread_mutex_lock(&reader->catalogLock);
     reader->progressHandlerWithData = archive->progressHandlerWithData;
     reader->progressHandlerData = archive->progressHandlerData;
+    reader->extractThreadNum = archive->extractThreadNum;
 
     reader->progressTotal = reader->offsetOfCentralDir;
     reader->context.progressPrevious = 0;
     reader->context.progressUpdated = 0;
-    ret = ZipReaderGotoFirstCentralDirHeader(reader);
-    RETURN_IF_FAIL(ret);
-    do {
-        reader->context.outDir = outDir;
-        ret = GetOutputFilePath(reader->context.entryInfo.entryName, outDir, outPath, ZIP_FILE_NAME_LEN_MAX);
-        RETURN_IF_FAIL(ret);
-        ret = ZipReaderExtractEntry(reader, outPath);
-        RETURN_IF_FAIL(ret);
-        reader->context.progressPrevious += reader->context.entryInfo.compressedSize + sizeof(struct LocalFileHeader) +
-            reader->context.localFileHeader.fileNameLength + reader->context.localFileHeader.extraFieldLength;
-        ret = ZipReaderGotoNextCentralDirHeader(reader);
-    } while (ret == ARCHIVE_OK);
-    if (ret == ARCHIVE_END_OF_LIST) {
-        return ARCHIVE_OK;
-    }
+    reader->context.outDir = outDir;
+    reader->nextPathEntry = 0;
+    atomic_store(&reader->progressUpdated, 0);
+    atomic_store(&reader->extractResult, ARCHIVE_OK);
+    atomic_store(&reader->nextIndexEntry, 0);
+    int ret = ZipReaderBuildExtractIndex(reader, outDir);
+    if (ret == ARCHIVE_OK) {
+        ret = ZipReaderExtractIndexEntries(reader, outDir);
+    }
+    ZipReaderFreeExtractIndex(reader);
+    pthread_mutex_unlock(&reader->catalogLock);
     return ret;
 }
 
@@ -924,8 +1201,270 @@ LOCAL int ZipReaderClose(HmArchiveReadInfo *archive)
     return ARCHIVE_OK;
 }
 
+LOCAL uint64_t ZipReaderHashName(const char *name)
+{
+    uint64_t hash = ZIP_CATALOG_HASH_OFFSET;
+    for (const unsigned char *p = (const unsigned char *)name; *p != '\0'; p++) {
+        hash = (hash ^ *p) * ZIP_CATALOG_HASH_PRIME;
+    }
+    return hash;
+}
+
+// Returns the bucket holding name, or the free bucket it would be inserted into
+LOCAL size_t ZipReaderFindCatalogBucket(struct ZipReader *reader, const char *name)
+{
+    size_t mask = reader->catalogBucketNum - 1;
+    size_t bucket = (size_t)ZipReaderHashName(name) & mask;
+    while (reader->catalogBuckets[bucket] != 0 &&
+        strcmp(reader->catalogEntries[reader->catalogBuckets[bucket] - 1].name, name) != 0) {
+        bucket = (bucket + 1) & mask;
+    }
+    return bucket;
+}
+
+LOCAL int ZipReaderHashCatalog(struct ZipReader *reader)
+{
+    // keep the load factor at most 1/2 so that probing stays short
+    size_t bucketNum = ZIP_CATALOG_MIN_BUCKET_NUM;
+    while (bucketNum < reader->catalogEntryCount * 2) {
+        bucketNum <<= 1;
+    }
+    reader->catalogBuckets = (size_t *)calloc(bucketNum, sizeof(size_t));
+    if (reader->catalogBuckets == NULL) {
+        return ARCHIVE_MEM_ERROR;
+    }
+    reader->catalogBucketNum = bucketNum;
+    for (size_t i = 0; i < reader->catalogEntryCount; i++) {
+        size_t bucket = ZipReaderFindCatalogBucket(reader, reader->catalogEntries[i].name);
+        // a repeated name keeps resolving to its first entry
+        if (reader->catalogBuckets[bucket] == 0) {
+            reader->catalogBuckets[bucket] = i + 1;
+        }
+    }
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipReaderAddCatalogEntry(struct ZipReader *reader)
+{
+    if (reader->catalogEntryCount == reader->catalogEntryCapacity) {
+        size_t capacity = reader->catalogEntryCapacity == 0 ? ZIP_EXTRACT_INDEX_INIT_CAPACITY :
+            reader->catalogEntryCapacity << 1;
+        struct ZipReaderCatalogEntry *entries = (struct ZipReaderCatalogEntry *)realloc(reader->catalogEntries,
+            capacity * sizeof(struct ZipReaderCatalogEntry));
+        if (entries == NULL) {
+            return ARCHIVE_MEM_ERROR;
+        }
+        reader->catalogEntries = entries;
+        reader->catalogEntryCapacity = capacity;
+    }
+    struct ZipReaderCatalogEntry *entry = &reader->catalogEntries[reader->catalogEntryCount];
+    entry->name = strdup(reader->context.entryName);
+    if (entry->name == NULL) {
+        return ARCHIVE_MEM_ERROR;
+    }
+    entry->centralDirHeader = reader->context.centralDirHeader;
+    entry->entryInfo = reader->context.entryInfo;
+    entry->isDirectory = ZipReaderEntryIsDirectory(&reader->context) &&
+        !ZipReaderEntryIsSymlink(&reader->context.centralDirHeader);
+    reader->catalogEntryCount++;
+    return ARCHIVE_OK;
+}
+
+// Reads the central directory once, later lookups never touch it again
+LOCAL int ZipReaderBuildCatalog(struct ZipReader *reader)
+{
+    if (reader->catalogBuilt) {
+        return ARCHIVE_OK;
+    }
+    int ret = ZipReaderGotoFirstCentralDirHeader(reader);
+    while (ret == ARCHIVE_OK) {
+        ret = ZipReaderAddCatalogEntry(reader);
+        if (ret == ARCHIVE_OK) {
+            ret = ZipReaderGotoNextCentralDirHeader(reader);
+        }
+    }
+    if (ret == ARCHIVE_END_OF_LIST) {
+        ret = ZipReaderHashCatalog(reader);
+    }
+    if (ret != ARCHIVE_OK) {
+        ZipReaderFreeCatalog(reader);
+        return ret;
+    }
+    reader->catalogBuilt = true;
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipReaderStreamEntry(struct ZipReaderExtractContext *context, struct ReadResource *resource,
+    const FmtReaderEntrySink *sink)
+{
+    int ret = ARCHIVE_OK;
+    int64_t read;
+    do {
+        read = ZipReaderReadData(context, resource, resource->buffer, sizeof(resource->buffer));
+        if (read < 0) {
+            ret = ARCHIVE_READ_ERROR;
+            break;
+        }
+        if (read > 0 && sink->handler(resource->buffer, (uint64_t)read, sink->userData) != (uint64_t)read) {
+            ret = ARCHIVE_WRITE_ERROR;
+            break;
+        }
+    } while (read > 0);
+    if (ret == ARCHIVE_OK) {
+        ret = ZipReaderVerifyEntryCrc(context, resource);
+    }
+    ZipReaderCloseEntry(context, resource);
+    return ret;
+}
+
+// Seeks straight to the local header of entry, no other entry is read
+LOCAL int ZipReaderExtractCatalogEntry(struct ZipReader *reader, const struct ZipReaderCatalogEntry *entry,
+    const FmtReaderEntrySink *sink)
+{
+    struct ZipReaderExtractContext *context = &reader->context;
+    struct ReadResource *resource = &reader->resource;
+    // progress is only reported for ExtractAllFiles
+    reader->progressTotal = 0;
+    context->centralDirHeader = entry->centralDirHeader;
+    context->entryInfo = entry->entryInfo;
+    int ret = ZipReaderOpenEntry(context, resource, sink->outPath);
+    RETURN_IF_FAIL(ret);
+    if (sink->outPath != NULL) {
+        return ZipReaderWriteEntryFile(context, resource, sink->outPath);
+    }
+    return ZipReaderStreamEntry(context, resource, sink);
+}
+
 const FmtReaderOps g_ZipReaderFmtOps = {
     .open = ZipReaderOpenFile,
     .extract = ZipReaderExtractAllFiles,
     .close = ZipReaderClose,
-};
\ No newline at end of file
+};
+
+// The built-in reader indexes the archive it already holds open, a plugin reader gets a private one
+LOCAL int ZipReaderOpenIndex(HmArchiveReadInfo *archive, const char *infile)
+{
+    if (archive == NULL || infile == NULL) {
+        return ARCHIVE_PARAM_ERROR;
+    }
+    if (archive->fmtOps == &g_ZipReaderFmtOps) {
+        archive->indexInfo = archive->fmtInfo;
+        return ARCHIVE_OK;
+    }
+
+    HmArchiveReadInfo indexArchive = {0};
+    indexArchive.fileIoMode = archive->fileIoMode;
+    indexArchive.fileIoBufferSize = archive->fileIoBufferSize;
+    int ret = ZipReaderOpenFile(&indexArchive, infile);
+    RETURN_IF_FAIL(ret);
+    archive->indexInfo = indexArchive.fmtInfo;
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipReaderGetEntryCount(HmArchiveReadInfo *archive, uint64_t *count)
+{
+    struct ZipReader *reader = (struct ZipReader *)archive->indexInfo;
+    if (reader == NULL) {
+        return ARCHIVE_INTERNAL_ERROR;
+    }
+
+    pthread_mutex_lock(&reader->catalogLock);
+    int ret = ZipReaderBuildCatalog(reader);
+    if (ret == ARCHIVE_OK) {
+        *count = reader->catalogEntryCount;
+    }
+    pthread_mutex_unlock(&reader->catalogLock);
+    return ret;
+}
+
+LOCAL int ZipReaderGetEntryInfo(HmArchiveReadInfo *archive, uint64_t index, OH_Archive_EntryInfo *info)
+{
+    struct ZipReader *reader = (struct ZipReader *)archive->indexInfo;
+    if (reader == NULL) {
+        return ARCHIVE_INTERNAL_ERROR;
+    }
+
+    pthread_mutex_lock(&reader->catalogLock);
+    int ret = ZipReaderBuildCatalog(reader);
+    if (ret == ARCHIVE_OK && index >= reader->catalogEntryCount) {
+        ret = ARCHIVE_PARAM_ERROR;
+    }
+    if (ret == ARCHIVE_OK) {
+        const struct ZipReaderCatalogEntry *entry = &reader->catalogEntries[index];
+        info->name = entry->name;
+        info->uncompressedSize = entry->entryInfo.uncompressedSize;
+        info->compressedSize = entry->entryInfo.compressedSize;
+        info->offset = entry->entryInfo.relativeOffsetOfLocalHeader;
+        info->crc32 = GETV(entry->centralDirHeader.crc32);
+        info->method = entry->entryInfo.compressionMethod;
+        info->isDirectory = entry->isDirectory ? 1 : 0;
+    }
+    pthread_mutex_unlock(&reader->catalogLock);
+    return ret;
+}
+
+LOCAL int ZipReaderFindEntry(HmArchiveReadInfo *archive, const char *name, uint64_t *index)
+{
+    struct ZipReader *reader = (struct ZipReader *)archive->indexInfo;
+    if (reader == NULL) {
+        return ARCHIVE_INTERNAL_ERROR;
+    }
+
+    pthread_mutex_lock(&reader->catalogLock);
+    int ret = ZipReaderBuildCatalog(reader);
+    if (ret == ARCHIVE_OK) {
+        size_t bucket = ZipReaderFindCatalogBucket(reader, name);
+        if (reader->catalogBuckets[bucket] == 0) {
+            ret = ARCHIVE_EXIST_ERROR;
+        } else {
+            *index = reader->catalogBuckets[bucket] - 1;
+        }
+    }
+    pthread_mutex_unlock(&reader->catalogLock);
+    return ret;
+}
+
+LOCAL int ZipReaderExtractOneEntry(HmArchiveReadInfo *archive, uint64_t index, const FmtReaderEntrySink *sink)
+{
+    struct ZipReader *reader = (struct ZipReader *)archive->indexInfo;
+    if (reader == NULL) {
+        return ARCHIVE_INTERNAL_ERROR;
+    }
+
+    pthread_mutex_lock(&reader->catalogLock);
+    int ret = ZipReaderBuildCatalog(reader);
+    if (ret == ARCHIVE_OK && (index >= reader->catalogEntryCount || reader->catalogEntries[index].isDirectory)) {
+        ret = ARCHIVE_PARAM_ERROR;
+    }
+    if (ret == ARCHIVE_OK) {
+        ret = ZipReaderExtractCatalogEntry(reader, &reader->catalogEntries[index], sink);
+    }
+    pthread_mutex_unlock(&reader->catalogLock);
+    return ret;
+}
+
+LOCAL int ZipReaderCloseIndex(HmArchiveReadInfo *archive)
+{
+    if (archive == NULL) {
+        return ARCHIVE_PARAM_ERROR;
+    }
+    void *indexInfo = archive->indexInfo;
+    archive->indexInfo = NULL;
+    // a shared reader and its catalog are released by ZipReaderClose of the archive itself
+    if (indexInfo == NULL || indexInfo == archive->fmtInfo) {
+        return ARCHIVE_OK;
+    }
+
+    HmArchiveReadInfo indexArchive = {0};
+    indexArchive.fmtInfo = indexInfo;
+    return ZipReaderClose(&indexArchive);
+}
+
+const FmtReaderIndexOps g_ZipReaderIndexOps = {
+    .open = ZipReaderOpenIndex,
+    .getEntryCount = ZipReaderGetEntryCount,
+    .getEntryInfo = ZipReaderGetEntryInfo,
+    .findEntry = ZipReaderFindEntry,
+    .extractEntry = ZipReaderExtractOneEntry,
+    .close = ZipReaderCloseIndex,
+};
@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+
+#include "zip_stream_reader.h"
+#include "zip_read_format.h"
+#include "zip_reader_impl.h"
+#include "zip_handler_common.h"
+#include "archive_macros.h"
+#include "archive_inner.h"
+#include "checksum/archive_crc32.h"
+#include "zlib.h"
+#include "securec.h"
+#include "errorcode.h"
+
+#define ZIP_STREAM_OUT_BLOCK_SIZE (64 * 1024)
+#define ZIP_STREAM_DESCRIPTOR_SIZE (12)
+#define ZIP_STREAM_DESCRIPTOR64_SIZE (20)
+#define ZIP_STREAM_HOLD_SIZE (32)
+#define ZIP_STREAM_EXTRA_HEADER_SIZE (4)
+
+enum ZipStreamState {
+    ZIP_STREAM_STATE_HEADER = 0,
+    ZIP_STREAM_STATE_NAME_EXTRA,
+    ZIP_STREAM_STATE_DATA,
+    ZIP_STREAM_STATE_DESCRIPTOR,
+    ZIP_STREAM_STATE_END,
+};
+
+struct ZipStreamReader {
+    ZipStreamReaderSink sink;
+    enum ZipStreamState state;
+    // first failure, every later update returns it
+    int result;
+    // local header or data descriptor bytes gathered across updates
+    uint8_t hold[ZIP_STREAM_HOLD_SIZE];
+    size_t holdSize;
+    // file name and extra field of the current local header
+    uint8_t *fields;
+    size_t fieldsSize;
+    size_t fieldsCapacity;
+    uint8_t *outBuf;
+    z_stream zlibStream;
+    bool inflateInited;
+    struct LocalFileHeader localHeader;
+    char entryName[ZIP_FILE_NAME_LEN_MAX + 1];
+    ZipStreamEntry entry;
+    bool entryStarted;
+    bool hasDescriptor;
+    bool isZip64;
+    uint64_t entryIn;
+    uint64_t entryOut;
+    uint32_t entryCrc;
+    uint64_t entryCount;
+    uint64_t totalIn;
+};
+
+// Copies input into dst until it holds need bytes, returns whether it does
+LOCAL bool ZipStreamGather(uint8_t *dst, size_t *have, size_t need, const uint8_t **data, size_t *size)
+{
+    if (*have >= need) {
+        return true;
+    }
+    size_t copy = need - *have;
+    if (copy > *size) {
+        copy = *size;
+    }
+    if (copy > 0 && memcpy_s(dst + *have, need - *have, *data, copy) != EOK) {
+        return false;
+    }
+    *have += copy;
+    *data += copy;
+    *size -= copy;
+    return *have == need;
+}
+
+LOCAL void ZipStreamEndEntry(struct ZipStreamReader *reader, int result)
+{
+    if (!reader->entryStarted) {
+        return;
+    }
+    reader->entryStarted = false;
+    if (reader->sink.entryEnd != NULL) {
+        reader->sink.entryEnd(&reader->entry, result, reader->sink.userData);
+    }
+}
+
+LOCAL int ZipStreamEmit(struct ZipStreamReader *reader, const uint8_t *data, size_t size)
+{
+    if (size == 0) {
+        return ARCHIVE_OK;
+    }
+    reader->entryCrc = ArchiveCrc32(reader->entryCrc, data, size);
+    reader->entryOut += size;
+    if (reader->sink.entryData == NULL) {
+        return ARCHIVE_OK;
+    }
+    return reader->sink.entryData(data, size, reader->sink.userData);
+}
+
+LOCAL int ZipStreamCompleteEntry(struct ZipStreamReader *reader)
+{
+    OH_Archive_EntryInfo *info = &reader->entry.info;
+    if (reader->entryIn != info->compressedSize || reader->entryOut != info->uncompressedSize) {
+        return ARCHIVE_DATA_ERROR;
+    }
+    if (reader->entryCrc != info->crc32) {
+        return ARCHIVE_CRC_ERROR;
+    }
+    ZipStreamEndEntry(reader, ARCHIVE_OK);
+    reader->entryCount++;
+    reader->state = ZIP_STREAM_STATE_HEADER;
+    reader->holdSize = 0;
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipStreamFinishData(struct ZipStreamReader *reader)
+{
+    if (reader->hasDescriptor) {
+        reader->state = ZIP_STREAM_STATE_DESCRIPTOR;
+        reader->holdSize = 0;
+        return ARCHIVE_OK;
+    }
+    return ZipStreamCompleteEntry(reader);
+}
+
+// Anything after the last entry (central directory, end of central directory) ends the stream
+LOCAL int ZipStreamCheckSignature(struct ZipStreamReader *reader, uint32_t signature)
+{
+    switch (signature) {
+        case ZIP_MAGIC_LOCALHEADER:
+            return ARCHIVE_OK;
+        case ZIP_MAGIC_CENTRALHEADER:
+        case ZIP_MAGIC_ENDHEADER:
+        case ZIP_MAGIC_ENDHEADER64:
+            reader->state = ZIP_STREAM_STATE_END;
+            return ARCHIVE_OK;
+        default:
+            return ARCHIVE_DATA_ERROR;
+    }
+}
+
+LOCAL int ZipStreamProcessHeader(struct ZipStreamReader *reader, const uint8_t **data, size_t *size)
+{
+    if (reader->holdSize < ZIP_SIZE_SIGNATURE) {
+        if (!ZipStreamGather(reader->hold, &reader->holdSize, ZIP_SIZE_SIGNATURE, data, size)) {
+            return ARCHIVE_OK;
+        }
+        int ret = ZipStreamCheckSignature(reader, (uint32_t)GetLittleEndianValue(reader->hold, ZIP_SIZE_SIGNATURE));
+        if (ret != ARCHIVE_OK || reader->state == ZIP_STREAM_STATE_END) {
+            return ret;
+        }
+    }
+    if (!ZipStreamGather(reader->hold, &reader->holdSize, sizeof(struct LocalFileHeader), data, size)) {
+        return ARCHIVE_OK;
+    }
+
+    if (memcpy_s(&reader->localHeader, sizeof(reader->localHeader), reader->hold,
+        sizeof(struct LocalFileHeader)) != EOK) {
+        return ARCHIVE_INTERNAL_ERROR;
+    }
+    uint16_t flag = GETV(reader->localHeader.flag);
+    if ((flag & (ZIP_FLAG_ENCRYPTED | ZIP_FLAG_STRONG_ENCRYPTED)) != 0) {
+        return ARCHIVE_SUPPORT_ERROR;
+    }
+    uint16_t method = GETV(reader->localHeader.compressionMethod);
+    if (method != OH_ARCHIVE_NO_COMPRESSION && method != OH_ARCHIVE_COMPRESS_DEFLATE) {
+        return ARCHIVE_SUPPORT_ERROR;
+    }
+    uint16_t fileNameLength = GETV(reader->localHeader.fileNameLength);
+    if (fileNameLength == 0) {
+        return ARCHIVE_DATA_ERROR;
+    }
+    if (fileNameLength > ZIP_FILE_NAME_LEN_MAX) {
+        return ARCHIVE_NAME_TOO_LONG_ERROR;
+    }
+
+    size_t fieldsSize = (size_t)fileNameLength + GETV(reader->localHeader.extraFieldLength);
+    if (fieldsSize > reader->fieldsCapacity) {
+        free(reader->fields);
+        reader->fields = (uint8_t *)malloc(fieldsSize);
+        if (reader->fields == NULL) {
+            reader->fieldsCapacity = 0;
+            return ARCHIVE_MEM_ERROR;
+        }
+        reader->fieldsCapacity = fieldsSize;
+    }
+    reader->fieldsSize = 0;
+    reader->entry.info.offset = reader->totalIn - *size - sizeof(struct LocalFileHeader);
+    reader->state = ZIP_STREAM_STATE_NAME_EXTRA;
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipStreamReadExtraField(struct ZipStreamReader *reader, uint8_t *extraField, uint16_t extraFieldLength)
+{
+    uint16_t cur = 0;
+    while (cur + ZIP_STREAM_EXTRA_HEADER_SIZE <= extraFieldLength) {
+        uint16_t headerId = (uint16_t)GetLittleEndianValue(extraField + cur, sizeof(uint16_t));
+        uint16_t dataSize = (uint16_t)GetLittleEndianValue(extraField + cur + sizeof(uint16_t), sizeof(uint16_t));
+        cur += ZIP_STREAM_EXTRA_HEADER_SIZE;
+        if (dataSize > extraFieldLength - cur) {
+            return ARCHIVE_DATA_ERROR;
+        }
+        if (headerId == ZIP_EXTRAFIELD_ZIP64_HEADER) {
+            struct ReadZip64ExtraField field = {
+                .uncompressedSize = reader->entry.info.uncompressedSize,
+                .compressedSize = reader->entry.info.compressedSize,
+            };
+            int ret = ZipReadZip64ExtraField(extraField, cur, dataSize, &field);
+            RETURN_IF_FAIL(ret);
+            reader->entry.info.uncompressedSize = field.uncompressedSize;
+            reader->entry.info.compressedSize = field.compressedSize;
+            // the data descriptor of an entry with a zip64 extra field carries 8 byte sizes
+            reader->isZip64 = true;
+        }
+        cur += dataSize;
+    }
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipStreamReadEntryName(struct ZipStreamReader *reader, uint16_t fileNameLength)
+{
+    if (memcpy_s(reader->entryName, sizeof(reader->entryName), reader->fields, fileNameLength) != EOK) {
+        return ARCHIVE_INTERNAL_ERROR;
+    }
+    reader->entryName[fileNameLength] = '\0';
+    if ((GETV(reader->localHeader.flag) & ZIP_FLAG_UTF8) != 0 || IsUTF8Str(reader->entryName)) {
+        return ARCHIVE_OK;
+    }
+    char *utf8Name = ConvertStrGBKToUTF8((const char *)reader->entryName);
+    if (utf8Name != NULL) {
+        int ret = strcpy_s(reader->entryName, sizeof(reader->entryName), utf8Name);
+        free(utf8Name);
+        if (ret != EOK) {
+            return ARCHIVE_NAME_TOO_LONG_ERROR;
+        }
+    }
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipStreamPrepareData(struct ZipStreamReader *reader)
+{
+    OH_Archive_EntryInfo *info = &reader->entry.info;
+    reader->entryIn = 0;
+    reader->entryOut = 0;
+    reader->entryCrc = 0;
+    if (info->method == OH_ARCHIVE_COMPRESS_DEFLATE) {
+        int ret = reader->inflateInited ? inflateReset2(&reader->zlibStream, -MAX_WBITS) :
+            inflateInit2(&reader->zlibStream, -MAX_WBITS);
+        if (ret != Z_OK) {
+            return ARCHIVE_MEM_ERROR;
+        }
+        reader->inflateInited = true;
+        reader->state = ZIP_STREAM_STATE_DATA;
+        return ARCHIVE_OK;
+    }
+    // stored data has no end marker, its size is only known up front
+    if (reader->hasDescriptor && info->compressedSize == 0 && !info->isDirectory) {
+        return ARCHIVE_SUPPORT_ERROR;
+    }
+    if (info->compressedSize == 0) {
+        return ZipStreamFinishData(reader);
+    }
+    reader->state = ZIP_STREAM_STATE_DATA;
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipStreamProcessNameExtra(struct ZipStreamReader *reader, const uint8_t **data, size_t *size)
+{
+    uint16_t fileNameLength = GETV(reader->localHeader.fileNameLength);
+    uint16_t extraFieldLength = GETV(reader->localHeader.extraFieldLength);
+    if (!ZipStreamGather(reader->fields, &reader->fieldsSize, (size_t)fileNameLength + extraFieldLength, data, size)) {
+        return ARCHIVE_OK;
+    }
+
+    int ret = ZipStreamReadEntryName(reader, fileNameLength);
+    RETURN_IF_FAIL(ret);
+    OH_Archive_EntryInfo *info = &reader->entry.info;
+    size_t nameLen = strlen(reader->entryName);
+    info->name = reader->entryName;
+    info->uncompressedSize = GETV(reader->localHeader.uncompressedSize);
+    info->compressedSize = GETV(reader->localHeader.compressedSize);
+    info->crc32 = GETV(reader->localHeader.crc32);
+    info->method = GETV(reader->localHeader.compressionMethod);
+    info->isDirectory = (nameLen > 0 && reader->entryName[nameLen - 1] == '/') ? 1 : 0;
+    reader->entry.modifiedTime = ZipConvertDosDateToTime(GETV(reader->localHeader.dosModDateTime));
+    reader->hasDescriptor = (GETV(reader->localHeader.flag) & ZIP_FLAG_DATA_DESCRIPTOR) != 0;
+    reader->isZip64 = false;
+    ret = ZipStreamReadExtraField(reader, reader->fields + fileNameLength, extraFieldLength);
+    RETURN_IF_FAIL(ret);
+
+    if (reader->sink.entryStart != NULL) {
+        ret = reader->sink.entryStart(&reader->entry, reader->sink.userData);
+        RETURN_IF_FAIL(ret);
+    }
+    reader->entryStarted = true;
+    return ZipStreamPrepareData(reader);
+}
+
+LOCAL int ZipStreamProcessStored(struct ZipStreamReader *reader, const uint8_t **data, size_t *size)
+{
+    uint64_t left = reader->entry.info.compressedSize - reader->entryIn;
+    size_t copy = *size < left ? *size : (size_t)left;
+    int ret = ZipStreamEmit(reader, *data, copy);
+    RETURN_IF_FAIL(ret);
+    reader->entryIn += copy;
+    *data += copy;
+    *size -= copy;
+    if (reader->entryIn == reader->entry.info.compressedSize) {
+        return ZipStreamFinishData(reader);
+    }
+    return ARCHIVE_OK;
+}
+
+LOCAL int ZipStreamProcessDeflate(struct ZipStreamReader *reader, const uint8_t **data, size_t *size)
+{
+    z_stream *strm = &reader->zlibStream;
+    uInt availIn = *size > UINT_MAX ? UINT_MAX : (uInt)*size;
+    strm->next_in = (z_const Bytef *)*data;
+    strm->avail_in = availIn;
+    int ret;
+    do {
+        strm->next_out = (Bytef *)reader->outBuf;
+        strm->avail_out = ZIP_STREAM_OUT_BLOCK_SIZE;
+        ret = inflate(strm, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            return ARCHIVE_DATA_ERROR;
+        }
+        int emitRet = ZipStreamEmit(reader, reader->outBuf, ZIP_STREAM_OUT_BLOCK_SIZE - strm->avail_out);
+        RETURN_IF_FAIL(emitRet);
+    } while (ret == Z_OK && (strm->avail_in > 0 || strm->avail_out == 0));
+
+    size_t consumed = availIn - strm->avail_in;
+    reader->entryIn += consumed;
+    *data += consumed;
+    *size -= consumed;
+    if (ret == Z_STREAM_END) {
+        return ZipStreamFinishData(reader);
+    }
+    return ARCHIVE_OK;
+}
+
+LOCAL bool ZipStreamIsSignature(uint32_t signature)
+{
+    return signature == ZIP_MAGIC_LOCALHEADER || signature == ZIP_MAGIC_CENTRALHEADER ||
+        signature == ZIP_MAGIC_ENDHEADER || signature == ZIP_MAGIC_ENDHEADER64;
+}
+
+// Without a zip64 extra field a writer may still have used 8 byte sizes, as the central directory would say. The
+// 4 byte form is taken when its sizes match the data just read and a header signature follows it, the 8 byte form
+// can never pass both checks, so that signature is handed on to the next header. Returns false until enough input
+// has arrived to tell.
+LOCAL bool ZipStreamSelectDescriptorForm(struct ZipStreamReader *reader, size_t pos, const uint8_t **data,
+    size_t *size, bool *isZip64)
+{
+    size_t sizesEnd = pos + ZIP_STREAM_DESCRIPTOR_SIZE;
+    uint32_t compressedSize = (uint32_t)GetLittleEndianValue(reader->hold + pos + sizeof(uint32_t), sizeof(uint32_t));
+    uint32_t uncompressedSize = (uint32_t)GetLittleEndianValue(reader->hold + sizesEnd - sizeof(uint32_t),
+        sizeof(uint32_t));
+    if (compressedSize != (uint32_t)reader->entryIn || uncompressedSize != (uint32_t)reader->entryOut) {
+        *isZip64 = true;
+        return true;
+    }
+    if (!ZipStreamGather(reader->hold, &reader->holdSize, sizesEnd + ZIP_SIZE_SIGNATURE, data, size)) {
+        return false;
+    }
+    *isZip64 = !ZipStreamIsSignature((uint32_t)GetLittleEndianValue(reader->hold + sizesEnd, ZIP_SIZE_SIGNATURE));
+    return true;
+}
+
+LOCAL int ZipStreamProcessDescriptor(struct ZipStreamReader *reader, const uint8_t **data, size_t *size)
+{
+    if (reader->holdSize < ZIP_SIZE_SIGNATURE &&
+        !ZipStreamGather(reader->hold, &reader->holdSize, ZIP_SIZE_SIGNATURE, data, size)) {
+        return ARCHIVE_OK;
+    }
+    // the data descriptor signature is optional
+    size_t pos = GetLittleEndianValue(reader->hold, ZIP_SIZE_SIGNATURE) == ZIP_MAGIC_DATADESCRIPTOR ?
+        ZIP_SIZE_SIGNATURE : 0;
+    if (!ZipStreamGather(reader->hold, &reader->holdSize, pos + ZIP_STREAM_DESCRIPTOR_SIZE, data, size)) {
+        return ARCHIVE_OK;
+    }
+    // the CRC leads both forms, a mismatch needs no more input
+    if ((uint32_t)GetLittleEndianValue(reader->hold + pos, sizeof(uint32_t)) != reader->entryCrc) {
+        return ARCHIVE_CRC_ERROR;
+    }
+    bool isZip64 = reader->isZip64;
+    if (!isZip64 && !ZipStreamSelectDescriptorForm(reader, pos, data, size, &isZip64)) {
+        return ARCHIVE_OK;
+    }
+    if (isZip64 && !ZipStreamGather(reader->hold, &reader->holdSize, pos + ZIP_STREAM_DESCRIPTOR64_SIZE, data, size)) {
+        return ARCHIVE_OK;
+    }
+
+    size_t sizeBytes = isZip64 ? sizeof(uint64_t) : sizeof(uint32_t);
+    OH_Archive_EntryInfo *info = &reader->entry.info;
+    size_t cur = pos;
+    info->crc32 = (uint32_t)GetLittleEndianValue(reader->hold + cur, sizeof(uint32_t));
+    cur += sizeof(uint32_t);
+    info->compressedSize = GetLittleEndianValue(reader->hold + cur, sizeBytes);
+    cur += sizeBytes;
+    info->uncompressedSize = GetLittleEndianValue(reader->hold + cur, sizeBytes);
+    cur += sizeBytes;
+    size_t holdSize = reader->holdSize;
+    int ret = ZipStreamCompleteEntry(reader);
+    if (ret != ARCHIVE_OK || holdSize == cur) {
+        return ret;
+    }
+    // the signature read past a 4 byte descriptor starts the next header
+    if (memcpy_s(reader->hold, sizeof(reader->hold), reader->hold + cur, ZIP_SIZE_SIGNATURE) != EOK) {
+        return ARCHIVE_INTERNAL_ERROR;
+    }
+    reader->holdSize = ZIP_SIZE_SIGNATURE;
+    return ZipStreamCheckSignature(reader, (uint32_t)GetLittleEndianValue(reader->hold, ZIP_SIZE_SIGNATURE));
+}
+
+LOCAL int ZipStreamProcess(struct ZipStreamReader *reader, const uint8_t **data, size_t *size)
+{
+    switch (reader->state) {
+        case ZIP_STREAM_STATE_HEADER:
+            return ZipStreamProcessHeader(reader, data, size);
+        case ZIP_STREAM_STATE_NAME_EXTRA:
+            return ZipStreamProcessNameExtra(reader, data, size);
+        case ZIP_STREAM_STATE_DATA:
+            if (reader->entry.info.method == OH_ARCHIVE_COMPRESS_DEFLATE) {
+                return ZipStreamProcessDeflate(reader, data, size);
+            }
+            return ZipStreamProcessStored(reader, data, size);
+        case ZIP_STREAM_STATE_DESCRIPTOR:
+            return ZipStreamProcessDescriptor(reader, data, size);
+        default:
+            // the central directory is not needed, whatever follows it is skipped
+            *data += *size;
+            *size = 0;
+            return ARCHIVE_OK;
+    }
+}
+
+struct ZipStreamReader *ZipStreamReaderCreate(void)
+{
+    struct ZipStreamReader *reader = (struct ZipStreamReader *)calloc(1, sizeof(struct ZipStreamReader));
+    if (reader == NULL) {
+        return NULL;
+    }
+    reader->outBuf = (uint8_t *)malloc(ZIP_STREAM_OUT_BLOCK_SIZE);
+    if (reader->outBuf == NULL) {
+        free(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+int ZipStreamReaderStart(struct ZipStreamReader *reader, const ZipStreamReaderSink *sink)
+{
+    if (reader == NULL || sink == NULL) {
+        return ARCHIVE_PARAM_ERROR;
+    }
+    ZipStreamEndEntry(reader, ARCHIVE_CANCEL_ERROR);
+    reader->sink = *sink;
+    reader->state = ZIP_STREAM_STATE_HEADER;
+    reader->result = ARCHIVE_OK;
+    reader->holdSize = 0;
+    reader->entryCount = 0;
+    reader->totalIn = 0;
+    return ARCHIVE_OK;
+}
+
+int ZipStreamReaderUpdate(struct ZipStreamReader *reader, const uint8_t *data, size_t size)
+{
+    if (reader == NULL || data == NULL) {
+        return ARCHIVE_PARAM_ERROR;
+    }
+    RETURN_IF_FAIL(reader->result);
+    reader->totalIn += size;
+    int ret = ARCHIVE_OK;
+    while (size > 0 && ret == ARCHIVE_OK) {
+        ret = ZipStreamProcess(reader, &data, &size);
+    }
+    if (ret != ARCHIVE_OK) {
+        reader->result = ret;
+        ZipStreamEndEntry(reader, ret);
+    }
+    return ret;
+}
+
+int ZipStreamReaderFinish(struct ZipStreamReader *reader, uint64_t *entryCount)
+{
+    if (reader == NULL) {
+        return ARCHIVE_PARAM_ERROR;
+    }
+    RETURN_IF_FAIL(reader->result);
+    // a stream cut before the central directory is truncated
+    if (reader->state != ZIP_STREAM_STATE_END) {
+        reader->result = ARCHIVE_DATA_ERROR;
+        ZipStreamEndEntry(reader, ARCHIVE_DATA_ERROR);
+        return ARCHIVE_DATA_ERROR;
+    }
+    if (entryCount != NULL) {
+        *entryCount = reader->entryCount;
+    }
+    return ARCHIVE_OK;
+}
+
+void ZipStreamReaderDestroy(struct ZipStreamReader *reader)
+{
+    if (reader == NULL) {
+        return;
+    }
+    ZipStreamEndEntry(reader, ARCHIVE_CANCEL_ERROR);
+    if (reader->inflateInited) {
+        (void)inflateEnd(&reader->zlibStream);
+    }
+    free(reader->fields);
+    free(reader->outBuf);
+    free(reader);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ZIP_STREAM_READER_H
+#define ZIP_STREAM_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "oh_archive.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ZipStreamReader;
+
+// An entry as described by its local header, sizes and crc32 are completed from the data descriptor at its end
+typedef struct {
+    OH_Archive_EntryInfo info;
+    time_t modifiedTime;
+} ZipStreamEntry;
+
+// Receives the entries in archive order, entryEnd follows every entryStart with the result of the entry
+typedef struct {
+    int (*entryStart)(const ZipStreamEntry *entry, void *userData);
+    int (*entryData)(const uint8_t *data, size_t size, void *userData);
+    void (*entryEnd)(const ZipStreamEntry *entry, int result, void *userData);
+    void *userData;
+} ZipStreamReaderSink;
+
+struct ZipStreamReader *ZipStreamReaderCreate(void);
+int ZipStreamReaderStart(struct ZipStreamReader *reader, const ZipStreamReaderSink *sink);
+int ZipStreamReaderUpdate(struct ZipStreamReader *reader, const uint8_t *data, size_t size);
+int ZipStreamReaderFinish(struct ZipStreamReader *reader, uint64_t *entryCount);
+void ZipStreamReaderDestroy(struct ZipStreamReader *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZIP_STREAM_READER_H
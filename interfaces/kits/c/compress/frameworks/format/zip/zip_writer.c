@@ -13,14 +13,17 @@
  * limitations under the License.
  */
 #include <stdlib.h>
+#include <pthread.h>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <errno.h>
+#include <strings.h>
 #include "errorcode.h"
 #include <stdatomic.h>
 #include <unistd.h>
 #include "zip_util.h"
 #include "zip_writer_impl.h"
+#include "zip_reader_impl.h"
 #include "zip_handler_common.h"
 #include "zip_format.h"
 #include "archive_macros.h"
@@ -31,11 +34,13 @@
 #include "memory/stream_mem.h"
 #include "file/stream_file.h"
 #include "zlib.h"
+#include "checksum/archive_crc32.h"
 #include "securec.h"
 #include "oh_archive_writer.h"
 #include "resource/container/dir_item_queue.h"
 
 #define ARCHIVE_APPEND_STATUS_CREATE (0)
+#define ARCHIVE_APPEND_STATUS_APPEND (1)
 #define ZIP_VERSION_20 (20)
 #define ZIP_VERSION_45 (45)
 
@@ -52,6 +57,15 @@
 #define IS_SYMLINK (1)
 #define NOT_SYMLINK (0)
 #define COMPRESS_OVER_PROCESS (100)
+#define ZIP_SAMPLE_COMPRESS_LEVEL (1)
+#define ZIP_SAMPLE_PERCENT (100)
+#define ZIP_WRITER_MAX_WORKER_NUM (4)
+// jobs in flight per worker, bounds the memory held by finished entries waiting for their turn
+#define ZIP_WRITER_JOBS_PER_WORKER (2)
+// files up to this size are deflated by the workers into memory, larger ones by the adding thread in place
+#define ZIP_WRITER_MAX_JOB_FILE_SIZE (4 * 1024 * 1024)
+// chunk used to copy the central directory of an archive opened for append
+#define ZIP_WRITER_CD_COPY_SIZE (64 * 1024)
 
 struct ZipWriterEntryInfo {
     uint16_t versionMadeBy;
@@ -71,6 +85,15 @@ struct ZipWriterEntryInfo {
     uint64_t zip64extraInLocalHeaderPos;
 };
 
+// Trial deflate of the first block of each file when auto store is enabled
+struct ZipWriterSampler {
+    z_stream stream;
+    bool inited;
+    uint8_t buffer[ZIP_BUF_INTERNAL];
+};
+
+struct ZipWriterPool;
+
 struct ZipWriter {
     struct Stream *baseStream;
     struct Stream *cdMemStream;
@@ -92,7 +115,15 @@ struct ZipWriter {
     uint64_t totalNumberOfEntries;
     int mode;
     int isOpened;
+    // entries of an existing archive are kept, it is never removed on failure
+    bool isAppending;
     char outfile[ZIP_FILE_NAME_LEN_MAX + 1];
+
+    pthread_mutex_t progressLock;
+    // trial deflate for auto store, used by the adding thread, each worker has its own
+    struct ZipWriterSampler sampler;
+    // set while Add runs with workers
+    struct ZipWriterPool *pool;
 };
 
 typedef enum {
@@ -117,10 +148,60 @@ struct ZipWriterTaskParam {
     FileType fileType;
     uint8_t buffer[ZIP_BUF_INTERNAL];
     FilePathNode *fileNode;
+    // where the compressed data goes, the archive itself or the memory of a job
+    struct Stream *outStream;
+    struct ZipWriterSampler *sampler;
+};
+
+typedef enum {
+    ZIP_WRITER_JOB_FREE,
+    ZIP_WRITER_JOB_PENDING,
+    ZIP_WRITER_JOB_RUNNING,
+    ZIP_WRITER_JOB_DONE
+} ZipWriterJobState;
+
+// An entry in submission order, compressed by a worker unless it is written in place
+struct ZipWriterJob {
+    ZipWriterJobState state;
+    FileType fileType;
+    bool inPlace;
+    bool skipped;
+    int result;
+    FilePathNode fileNode;
+    struct ZipWriterEntryInfo entryInfo;
+    struct Stream *dataStream;
+};
+
+struct ZipWriterWorker {
+    pthread_t thread;
+    struct ZipWriterPool *pool;
+    struct ZipWriterSampler sampler;
+};
+
+// Jobs live in a ring indexed by sequence, the adding thread appends them to the archive in that order
+struct ZipWriterPool {
+    HmArchiveWriteInfo *archive;
+    struct ZipWriter *writer;
+    struct ZipWriterWorker *workers;
+    size_t workerNum;
+    struct ZipWriterJob *jobs;
+    size_t jobNum;
+    uint64_t nextSeq;
+    uint64_t claimSeq;
+    uint64_t emitSeq;
+    int result;
+    bool stop;
+    pthread_mutex_t lock;
+    pthread_cond_t workCond;
+    pthread_cond_t doneCond;
 };
 
-static uint32_t ZipConvertAppendToStreamMode(void)
+static uint32_t ZipConvertAppendToStreamMode(HmArchiveWriteInfo *archive, struct ZipWriter *writer)
 {
+    // appending to a missing archive creates it
+    if (archive->append == ARCHIVE_APPEND_STATUS_APPEND && access(writer->outfile, F_OK) == 0) {
+        return OPEN_MODE_READ_WRITE | OPEN_MODE_APPEND;
+    }
     return OPEN_MODE_WRITE | OPEN_MODE_CREATE;
 }
 
@@ -131,6 +212,7 @@ static struct ZipWriter *ZipWriterCreate(void)
         writer->baseStream = NULL;
         writer->cdMemStream = NULL;
         writer->globalComment = NULL;
+        pthread_mutex_init(&writer->progressLock, NULL);
     }
     return writer;
 }
@@ -169,6 +251,99 @@ static int ZipWriterOpenFileOpenStream(struct ZipWriter *writer, int mode)
     return ret;
 }
 
+static int ZipWriterCopyCD(struct ZipWriter *writer, uint64_t offsetOfCentralDir, uint64_t sizeOfCentralDir)
+{
+    int ret = StreamSeek(writer->baseStream, (int64_t)offsetOfCentralDir, ARCHIVE_SEEK_SET);
+    RETURN_IF_FAIL(ret);
+    uint8_t *buffer = (uint8_t *)malloc(ZIP_WRITER_CD_COPY_SIZE);
+    if (buffer == NULL) {
+        return ARCHIVE_MEM_ERROR;
+    }
+    while (sizeOfCentralDir > 0) {
+        int64_t len = sizeOfCentralDir > ZIP_WRITER_CD_COPY_SIZE ? ZIP_WRITER_CD_COPY_SIZE : (int64_t)sizeOfCentralDir;
+        int64_t readRet = StreamRead(writer->baseStream, buffer, len);
+        if (readRet != len) {
+            ret = readRet < 0 ? (int)readRet : ARCHIVE_FORMAT_ERROR;
+            break;
+        }
+        int64_t writeRet = StreamWrite(writer->cdMemStream, buffer, len);
+        if (writeRet != len) {
+            ret = writeRet < 0 ? (int)writeRet : ARCHIVE_WRITE_ERROR;
+            break;
+        }
+        sizeOfCentralDir -= (uint64_t)len;
+    }
+    free(buffer);
+    return ret;
+}
+
+static int ZipWriterLoadComment(struct ZipWriter *writer, uint64_t offsetOfEOCD, uint16_t commentLength)
+{
+    if (commentLength == 0) {
+        return ARCHIVE_OK;
+    }
+    int ret = StreamSeek(writer->baseStream, (int64_t)(offsetOfEOCD + ZIP_SIZE_EOCD_FIXED), ARCHIVE_SEEK_SET);
+    RETURN_IF_FAIL(ret);
+    writer->globalComment = (char *)malloc(commentLength);
+    if (writer->globalComment == NULL) {
+        return ARCHIVE_MEM_ERROR;
+    }
+    // a truncated comment is dropped rather than failing the append
+    int64_t readRet = StreamRead(writer->baseStream, writer->globalComment, commentLength);
+    if (readRet != (int64_t)commentLength) {
+        free(writer->globalComment);
+        writer->globalComment = NULL;
+        return readRet < 0 ? (int)readRet : ARCHIVE_OK;
+    }
+    writer->globalCommentLength = commentLength;
+    return ARCHIVE_OK;
+}
+
+// New entries are written over the central directory of the existing archive, which is kept in memory and
+// saved again on close together with the new entries
+static int ZipWriterLoadCD(struct ZipWriter *writer)
+{
+    struct Stream *baseStream = writer->baseStream;
+    writer->isAppending = true;
+    int ret = StreamSeek(baseStream, 0, ARCHIVE_SEEK_END);
+    RETURN_IF_FAIL(ret);
+    if (StreamTell(baseStream) == 0) {
+        return ARCHIVE_OK;
+    }
+
+    struct EndOfCentralDir eocd = {0};
+    struct EndOfCentralDir64 eocd64 = {0};
+    uint64_t offsetOfEOCD = 0;
+    uint64_t offsetOfEOCD64 = 0;
+    int8_t isZip64 = 0;
+    ret = ZipSearchEOCD(baseStream, &eocd, &offsetOfEOCD, &eocd64, &offsetOfEOCD64, &isZip64);
+    RETURN_IF_FAIL(ret);
+    // 0xFFFF entries without a zip64 locator is a plain archive that happens to hold that many
+    if (isZip64 && GETV(eocd64.signature) != ZIP_MAGIC_ENDHEADER64) {
+        isZip64 = 0;
+    }
+    uint64_t offsetOfCentralDir = isZip64 ? GETV(eocd64.offsetOfCentralDir) : GETV(eocd.offsetOfCentralDir);
+    uint64_t sizeOfCentralDir = isZip64 ? GETV(eocd64.sizeOfCentralDir) : GETV(eocd.sizeOfCentralDir);
+    uint64_t totalNumberOfEntries = isZip64 ? GETV(eocd64.totalNumberOfEntries) : GETV(eocd.totalNumberOfEntries);
+    int64_t offsetCorrection = 0;
+    ret = ZipCheckAndCorrectCentralDirOffset(baseStream, isZip64 ? offsetOfEOCD64 : offsetOfEOCD, (uint8_t)isZip64,
+        &offsetOfCentralDir, &sizeOfCentralDir, &offsetCorrection);
+    RETURN_IF_FAIL(ret);
+    // the central directory is copied as it is, data in front of the archive would leave its offsets wrong
+    if (offsetCorrection != 0) {
+        return ARCHIVE_FORMAT_ERROR;
+    }
+
+    ret = ZipWriterCopyCD(writer, offsetOfCentralDir, sizeOfCentralDir);
+    RETURN_IF_FAIL(ret);
+    ret = ZipWriterLoadComment(writer, offsetOfEOCD, GETV(eocd.commentLength));
+    RETURN_IF_FAIL(ret);
+    writer->totalNumberOfEntries = totalNumberOfEntries;
+    // keep the zip64 records, the rewritten tail is then never shorter than the old one
+    writer->isZip64 = isZip64;
+    return StreamSeek(baseStream, (int64_t)offsetOfCentralDir, ARCHIVE_SEEK_SET);
+}
+
 static int ZipWriterOpenOutputFile(HmArchiveWriteInfo *archive)
 {
     if (archive == NULL) {
@@ -176,17 +351,21 @@ static int ZipWriterOpenOutputFile(HmArchiveWriteInfo *archive)
     }
     struct ZipWriter *writer = (struct ZipWriter *)archive->fmtInfo;
     int ret = ARCHIVE_OK;
-    uint32_t mode = ZipConvertAppendToStreamMode();
+    uint32_t mode = ZipConvertAppendToStreamMode(archive, writer);
     ret = ZipWriterOpenFileOpenStream(writer, (int)mode);
+    if (ret == ARCHIVE_OK && (mode & OPEN_MODE_APPEND)) {
+        ret = ZipWriterLoadCD(writer);
+    }
     if (ret != ARCHIVE_OK) {
         ZipWriterOpenFail(writer);
     }
     return ret;
 }
 
-static int ZipWriterOpenFileCreateWriteStream(struct ZipWriter *writer, const char *outfile)
+static int ZipWriterOpenFileCreateWriteStream(HmArchiveWriteInfo *archive, struct ZipWriter *writer,
+                                              const char *outfile)
 {
-    struct Stream *stream = FileStreamCreate(outfile);
+    struct Stream *stream = FileStreamCreateWithIo(outfile, archive->fileIoMode, archive->fileIoBufferSize);
     if (stream == NULL) {
         return ARCHIVE_MEM_ERROR;
     }
@@ -211,21 +390,18 @@ static int ZipWriterOpenFile(HmArchiveWriteInfo *archive, const char *outfile)
     }
     archive->fmtInfo = writer;
 
-    ret = ZipWriterOpenFileCreateWriteStream(writer, outfile);
+    ret = ZipWriterOpenFileCreateWriteStream(archive, writer, outfile);
     if (ret != ARCHIVE_OK) {
         ZipWriterOpenFail(writer);
+        pthread_mutex_destroy(&writer->progressLock);
         free(archive->fmtInfo);
         archive->fmtInfo = NULL;
     }
     return ret;
 }
 
-static int ZipWriterUpdateProgress(struct ZipWriter *writer, size_t len, bool isCompressOver)
+static int ZipWriterUpdateProgressLocked(struct ZipWriter *writer, size_t len, bool isCompressOver)
 {
-    if (writer->progressHandler == NULL) {
-        return OH_ARCHIVE_PROGRESS_CONTINUE;
-    }
-
     if (writer->progressTotal == 0 || isCompressOver) {
         int ratio = 0;
         if (isCompressOver) {
@@ -240,6 +416,19 @@ static int ZipWriterUpdateProgress(struct ZipWriter *writer, size_t len, bool is
     return writer->progressHandler(ratio, writer->progressHandlerUserData);
 }
 
+// Workers report too, the handler is called by one thread at a time
+static int ZipWriterUpdateProgress(struct ZipWriter *writer, size_t len, bool isCompressOver)
+{
+    if (writer->progressHandler == NULL) {
+        return OH_ARCHIVE_PROGRESS_CONTINUE;
+    }
+
+    pthread_mutex_lock(&writer->progressLock);
+    int ret = ZipWriterUpdateProgressLocked(writer, len, isCompressOver);
+    pthread_mutex_unlock(&writer->progressLock);
+    return ret;
+}
+
 static int ZipWriterOpenInitCompressStream(struct ZipWriterTaskParam *writerTask)
 {
     switch (writerTask->entryInfo->compressionMethod) {
@@ -258,7 +447,7 @@ static int ZipWriterOpenInitCompressStream(struct ZipWriterTaskParam *writerTask
     if (writerTask->compressStream == NULL) {
         return ARCHIVE_MEM_ERROR;
     }
-    StreamSetBase(writerTask->compressStream, writerTask->writer->baseStream);
+    StreamSetBase(writerTask->compressStream, writerTask->outStream);
     return StreamOpen(writerTask->compressStream, ARCHIVE_OPEN_MODE_WRITE);
 }
 
@@ -268,7 +457,8 @@ static int ZipWriterOpenInitExtractStream(struct ZipWriterTaskParam *writerTask)
         writerTask->extractStream = NULL;
         return ARCHIVE_OK;
     } else {
-        writerTask->extractStream = FileStreamCreate(writerTask->fileNode->filePath);
+        writerTask->extractStream = FileStreamCreateWithIo(writerTask->fileNode->filePath,
+            writerTask->archive->fileIoMode, writerTask->archive->fileIoBufferSize);
         if (writerTask->extractStream == NULL) {
             return ARCHIVE_MEM_ERROR;
         }
@@ -588,7 +778,7 @@ static int ZipWriterAddData(struct ZipWriterTaskParam *writerTask)
             return writerRet < 0 ? writerRet : ARCHIVE_WRITE_ERROR;
         }
         if (len > 0) {
-            writerTask->entryInfo->crc = crc32(writerTask->entryInfo->crc, (const uint8_t *)linkName, len);
+            writerTask->entryInfo->crc = ArchiveCrc32(writerTask->entryInfo->crc, (const uint8_t *)linkName, len);
         }
         return ARCHIVE_OK;
     }
@@ -600,7 +790,7 @@ static int ZipWriterAddData(struct ZipWriterTaskParam *writerTask)
         }
         /* code */
         if (writeRet > 0) {
-            writerTask->entryInfo->crc = crc32(writerTask->entryInfo->crc, writerTask->buffer, writeRet);
+            writerTask->entryInfo->crc = ArchiveCrc32(writerTask->entryInfo->crc, writerTask->buffer, writeRet);
             int ret = ZipWriterUpdateProgress(writerTask->writer, writeRet, 0);
             if (ret == OH_ARCHIVE_PROGRESS_CANCEL) {
                 return ARCHIVE_CANCEL_ERROR;
@@ -681,7 +871,7 @@ static void ZipWriterOpenInitEntryInfo(struct ZipWriterTaskParam *writerTask)
     entryInfo->dosModDateTime = GetFileModfiyTime(writerTask->fileNode->filePath);
     entryInfo->internalFa = 0;
     entryInfo->externalFa = GetFileExternalAttributes(writerTask->fileNode->filePath);
-    entryInfo->localHeaderOffset = (uint64_t)StreamTell(writerTask->writer->baseStream);
+    entryInfo->localHeaderOffset = 0;
     entryInfo->filename = writerTask->fileNode->saveName;
     entryInfo->filenameSize = entryInfo->filename == NULL ? 0 : (uint16_t)strlen(entryInfo->filename);
     entryInfo->compressedSize = 0;
@@ -699,12 +889,89 @@ static void ZipWriterOpenInitEntryInfo(struct ZipWriterTaskParam *writerTask)
     }
 }
 
-static int ZipWriterEntryOpen(struct ZipWriterTaskParam *writerTask)
+static bool ZipWriterIsStoreExtension(HmArchiveWriteInfo *archive, const char *path)
 {
-    writerTask->entryInfo = (struct ZipWriterEntryInfo *)calloc(1, sizeof(struct ZipWriterEntryInfo));
-    if (writerTask->entryInfo == NULL) {
-        return ARCHIVE_MEM_ERROR;
+    const char *dot = strrchr(path, '.');
+    const char *slash = strrchr(path, '/');
+    if (dot == NULL || (slash != NULL && dot < slash)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < archive->storeExtensionNum; i++) {
+        if (strcasecmp(dot + 1, archive->storeExtensions[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Deflates the first block at the fastest level, the output buffer is no larger than the input on purpose
+static int ZipWriterSampleSaving(struct ZipWriterTaskParam *writerTask, uint32_t *savingPercent)
+{
+    struct ZipWriterSampler *sampler = writerTask->sampler;
+    int64_t readRet = StreamRead(writerTask->extractStream, writerTask->buffer, sizeof(writerTask->buffer));
+    if (readRet < 0) {
+        return (int)readRet;
+    }
+    *savingPercent = ZIP_SAMPLE_PERCENT;
+    if (readRet > 0) {
+        if (!sampler->inited) {
+            if (deflateInit2(&sampler->stream, ZIP_SAMPLE_COMPRESS_LEVEL, Z_DEFLATED, -MAX_WBITS,
+                ZLIB_DEFLATE_DEF_MEM_LEVEL, ZLIB_DEFLATE_STRATEGY) != Z_OK) {
+                return ARCHIVE_MEM_ERROR;
+            }
+            sampler->inited = true;
+        } else if (deflateReset(&sampler->stream) != Z_OK) {
+            return ARCHIVE_INTERNAL_ERROR;
+        }
+        sampler->stream.next_in = writerTask->buffer;
+        sampler->stream.avail_in = (uInt)readRet;
+        sampler->stream.next_out = sampler->buffer;
+        sampler->stream.avail_out = (uInt)readRet;
+        // the block did not fit in its own size, so it does not shrink at all
+        if (deflate(&sampler->stream, Z_FINISH) != Z_STREAM_END) {
+            *savingPercent = 0;
+        } else {
+            *savingPercent = (uint32_t)((readRet - sampler->stream.total_out) * ZIP_SAMPLE_PERCENT / readRet);
+        }
+    }
+    return StreamSeek(writerTask->extractStream, 0, ARCHIVE_SEEK_SET);
+}
+
+// Stores files that match the extension list or barely shrink in the trial deflate
+static int ZipWriterChooseMethod(struct ZipWriterTaskParam *writerTask)
+{
+    HmArchiveWriteInfo *archive = writerTask->archive;
+    struct ZipWriterEntryInfo *entryInfo = writerTask->entryInfo;
+    if (entryInfo->compressionMethod != OH_ARCHIVE_COMPRESS_DEFLATE || writerTask->fileType != FILE_TYPE_FILE ||
+        IsSymlink(writerTask->fileNode->filePath) == IS_SYMLINK) {
+        return ARCHIVE_OK;
+    }
+
+    bool store = ZipWriterIsStoreExtension(archive, writerTask->fileNode->filePath);
+    if (!store && archive->minSavingPercent > 0) {
+        uint32_t savingPercent = 0;
+        int ret = ZipWriterSampleSaving(writerTask, &savingPercent);
+        RETURN_IF_FAIL(ret);
+        store = savingPercent < archive->minSavingPercent;
+    }
+    if (store) {
+        entryInfo->compressionMethod = OH_ARCHIVE_NO_COMPRESSION;
+        entryInfo->flag &= (uint16_t)~ZIP_FLAG_DEFLATE_SUPER_FAST;
+    }
+    return ARCHIVE_OK;
+}
+
+static void ZipWriterEndSampler(struct ZipWriterSampler *sampler)
+{
+    if (sampler->inited) {
+        (void)deflateEnd(&sampler->stream);
+        sampler->inited = false;
     }
+}
+
+// Fills the entry info and opens the input, nothing is written to the archive yet
+static int ZipWriterEntryPrepare(struct ZipWriterTaskParam *writerTask)
+{
     if ((writerTask->archive->method != OH_ARCHIVE_NO_COMPRESSION) &&
         (writerTask->archive->method != OH_ARCHIVE_COMPRESS_DEFLATE)) {
         return ARCHIVE_PARAM_ERROR;
@@ -721,6 +988,22 @@ static int ZipWriterEntryOpen(struct ZipWriterTaskParam *writerTask)
         return ret;
     }
 
+    return ZipWriterChooseMethod(writerTask);
+}
+
+static int ZipWriterEntryOpen(struct ZipWriterTaskParam *writerTask)
+{
+    writerTask->entryInfo = (struct ZipWriterEntryInfo *)calloc(1, sizeof(struct ZipWriterEntryInfo));
+    if (writerTask->entryInfo == NULL) {
+        return ARCHIVE_MEM_ERROR;
+    }
+
+    int ret = ZipWriterEntryPrepare(writerTask);
+    if (ret != ARCHIVE_OK) {
+        return ret;
+    }
+
+    writerTask->entryInfo->localHeaderOffset = (uint64_t)StreamTell(writerTask->writer->baseStream);
     ret = ZipEntryWriteLocalHeader(writerTask->writer->baseStream, writerTask->entryInfo);
     if (ret != ARCHIVE_OK) {
         return ret;
@@ -815,6 +1098,8 @@ static int32_t ZipWriterAddOneFile(HmArchiveWriteInfo *archive, struct ZipWriter
     param.writer = writer;
     param.fileType = FILE_TYPE_FILE;
     param.fileNode = nodePtr;
+    param.outStream = writer->baseStream;
+    param.sampler = &writer->sampler;
 
     int ret = ZipWriterEntryOpen(&param);
     if (ret == ARCHIVE_OK) {
@@ -958,6 +1243,295 @@ static int GetSaveName(char *filePath, const char *inputDir, const char **saveNa
     return ARCHIVE_OK;
 }
 
+static int ZipWriterWriteEmptyDir(HmArchiveWriteInfo *archive, struct ZipWriter *writer, FilePathNodePtr nodePtr)
+{
+    struct ZipWriterTaskParam param;
+    memset_s(&param, sizeof(param), 0, sizeof(param));
+    param.archive = archive;
+    param.writer = writer;
+    param.fileType = FILE_TYPE_EMPTY_DIR;
+    param.fileNode = nodePtr;
+    param.outStream = writer->baseStream;
+    param.sampler = &writer->sampler;
+    int ret = ZipWriterEntryOpen(&param);
+    if (ret == ARCHIVE_OK) {
+        ret = ZipWriterCloseStream(&param, 0);
+    }
+    ZipWriterDeleteStream(&param);
+    if (ZipWriterUpdateProgress(writer, 0, 0) == OH_ARCHIVE_PROGRESS_CANCEL) {
+        return ARCHIVE_CANCEL_ERROR;
+    }
+    return ret;
+}
+
+static void ZipWriterFreeJob(struct ZipWriterJob *job)
+{
+    free(job->fileNode.filePath);
+    free(job->fileNode.saveName);
+    job->fileNode.filePath = NULL;
+    job->fileNode.saveName = NULL;
+    if (job->dataStream != NULL) {
+        StreamClose(job->dataStream);
+        StreamDestroy(&job->dataStream);
+    }
+}
+
+// Deflates one file into the memory of its job, the same steps as ZipWriterAddOneFile minus the archive writes
+static int ZipWriterCompressJob(struct ZipWriterWorker *worker, struct ZipWriterJob *job)
+{
+    job->dataStream = MemStreamCreate();
+    if (job->dataStream == NULL) {
+        return ARCHIVE_MEM_ERROR;
+    }
+    int ret = StreamOpen(job->dataStream, ARCHIVE_OPEN_MODE_WRITE);
+    RETURN_IF_FAIL(ret);
+
+    struct ZipWriterTaskParam param;
+    memset_s(&param, sizeof(param), 0, sizeof(param));
+    param.archive = worker->pool->archive;
+    param.writer = worker->pool->writer;
+    param.fileType = FILE_TYPE_FILE;
+    param.fileNode = &job->fileNode;
+    param.entryInfo = &job->entryInfo;
+    param.outStream = job->dataStream;
+    param.sampler = &worker->sampler;
+
+    ret = ZipWriterEntryPrepare(&param);
+    if (ret == ARCHIVE_OK) {
+        ret = ZipWriterOpenInitCompressStream(&param);
+    }
+    if (ret == ARCHIVE_OK) {
+        ret = ZipWriterAddData(&param);
+    } else if (ret == ARCHIVE_OPEN_ERROR && access(job->fileNode.filePath, F_OK) != 0) {
+        job->skipped = true;
+        ret = ARCHIVE_OK;
+    }
+    if (ret == ARCHIVE_OK && !job->skipped) {
+        ret = StreamClose(param.compressStream);
+        if (ret == ARCHIVE_OK) {
+            UpdateCompressedSize(&param);
+        }
+        StreamDestroy(&param.compressStream);
+    }
+    // the entry info belongs to the job
+    param.entryInfo = NULL;
+    ZipWriterDeleteStream(&param);
+    return ret;
+}
+
+static void *ZipWriterWorkerRoutine(void *arg)
+{
+    struct ZipWriterWorker *worker = (struct ZipWriterWorker *)arg;
+    struct ZipWriterPool *pool = worker->pool;
+    pthread_mutex_lock(&pool->lock);
+    while (true) {
+        while (!pool->stop && pool->claimSeq == pool->nextSeq) {
+            pthread_cond_wait(&pool->workCond, &pool->lock);
+        }
+        if (pool->stop) {
+            break;
+        }
+        struct ZipWriterJob *job = &pool->jobs[pool->claimSeq % pool->jobNum];
+        pool->claimSeq++;
+        if (job->state != ZIP_WRITER_JOB_PENDING) {
+            continue;
+        }
+        // once something failed the remaining jobs are only marked done so the adding thread can free them
+        int ret = pool->result;
+        if (ret == ARCHIVE_OK) {
+            job->state = ZIP_WRITER_JOB_RUNNING;
+            pthread_mutex_unlock(&pool->lock);
+            ret = ZipWriterCompressJob(worker, job);
+            pthread_mutex_lock(&pool->lock);
+            if (ret != ARCHIVE_OK && pool->result == ARCHIVE_OK) {
+                pool->result = ret;
+            }
+        }
+        job->result = ret;
+        job->state = ZIP_WRITER_JOB_DONE;
+        pthread_cond_broadcast(&pool->doneCond);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    ZipWriterEndSampler(&worker->sampler);
+    return NULL;
+}
+
+static int ZipWriterWriteJobEntry(struct ZipWriter *writer, struct ZipWriterJob *job)
+{
+    job->entryInfo.localHeaderOffset = (uint64_t)StreamTell(writer->baseStream);
+    int ret = ZipEntryWriteLocalHeader(writer->baseStream, &job->entryInfo);
+    RETURN_IF_FAIL(ret);
+    ret = ZipWriteMemStream(writer->baseStream, job->dataStream);
+    RETURN_IF_FAIL(ret);
+    ret = ZipEntryWriteCdHeader(writer->cdMemStream, &job->entryInfo);
+    RETURN_IF_FAIL(ret);
+    writer->totalNumberOfEntries += 1;
+    return ARCHIVE_OK;
+}
+
+static int ZipWriterEmitJob(struct ZipWriterPool *pool, struct ZipWriterJob *job)
+{
+    if (job->result != ARCHIVE_OK || job->skipped) {
+        return job->result;
+    }
+    if (job->fileType == FILE_TYPE_EMPTY_DIR) {
+        return ZipWriterWriteEmptyDir(pool->archive, pool->writer, &job->fileNode);
+    }
+    if (job->inPlace) {
+        return ZipWriterAddOneFile(pool->archive, pool->writer, &job->fileNode);
+    }
+    return ZipWriterWriteJobEntry(pool->writer, job);
+}
+
+// Appends finished jobs to the archive in submission order until endSeq
+static int ZipWriterEmitJobs(struct ZipWriterPool *pool, uint64_t endSeq)
+{
+    int ret = ARCHIVE_OK;
+    while (ret == ARCHIVE_OK && pool->emitSeq < endSeq) {
+        struct ZipWriterJob *job = &pool->jobs[pool->emitSeq % pool->jobNum];
+        pthread_mutex_lock(&pool->lock);
+        while (job->state != ZIP_WRITER_JOB_DONE) {
+            pthread_cond_wait(&pool->doneCond, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+        ret = ZipWriterEmitJob(pool, job);
+        ZipWriterFreeJob(job);
+        pthread_mutex_lock(&pool->lock);
+        job->state = ZIP_WRITER_JOB_FREE;
+        if (ret != ARCHIVE_OK && pool->result == ARCHIVE_OK) {
+            pool->result = ret;
+        }
+        pthread_mutex_unlock(&pool->lock);
+        pool->emitSeq++;
+    }
+    return ret;
+}
+
+static int ZipWriterSubmitJob(struct ZipWriterPool *pool, FilePathNodePtr nodePtr, FileType fileType)
+{
+    // backpressure, a full ring waits for its oldest job to be written
+    if (pool->nextSeq - pool->emitSeq == pool->jobNum) {
+        int ret = ZipWriterEmitJobs(pool, pool->emitSeq + 1);
+        RETURN_IF_FAIL(ret);
+    }
+    struct ZipWriterJob newJob = {0};
+    newJob.fileNode.filePath = strdup(nodePtr->filePath);
+    newJob.fileNode.saveName = strdup(nodePtr->saveName);
+    if (newJob.fileNode.filePath == NULL || newJob.fileNode.saveName == NULL) {
+        ZipWriterFreeJob(&newJob);
+        return ARCHIVE_MEM_ERROR;
+    }
+    newJob.fileType = fileType;
+    newJob.result = ARCHIVE_OK;
+    bool pending = fileType == FILE_TYPE_FILE && GetFileSize(nodePtr->filePath) <= ZIP_WRITER_MAX_JOB_FILE_SIZE;
+    newJob.inPlace = fileType == FILE_TYPE_FILE && !pending;
+    newJob.state = pending ? ZIP_WRITER_JOB_PENDING : ZIP_WRITER_JOB_DONE;
+
+    // a worker still behind on claims may read the slot's previous job, so it is only refilled under the lock
+    pthread_mutex_lock(&pool->lock);
+    pool->jobs[pool->nextSeq % pool->jobNum] = newJob;
+    pool->nextSeq++;
+    pthread_cond_signal(&pool->workCond);
+    pthread_mutex_unlock(&pool->lock);
+    return ARCHIVE_OK;
+}
+
+static size_t ZipWriterGetWorkerNum(void)
+{
+    long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t workerNum = cpuNum > 1 ? (size_t)cpuNum : 1;
+    if (workerNum > ZIP_WRITER_MAX_WORKER_NUM) {
+        workerNum = ZIP_WRITER_MAX_WORKER_NUM;
+    }
+    return workerNum;
+}
+
+static void ZipWriterDestroyPool(struct ZipWriterPool *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->workCond);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->workerNum; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pthread_cond_destroy(&pool->doneCond);
+    pthread_cond_destroy(&pool->workCond);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool->jobs);
+    free(pool);
+}
+
+// Single core devices keep the serial path, so does any failure to set the pool up
+static void ZipWriterStartPool(HmArchiveWriteInfo *archive, struct ZipWriter *writer)
+{
+    size_t workerNum = ZipWriterGetWorkerNum();
+    if (workerNum <= 1) {
+        return;
+    }
+    struct ZipWriterPool *pool = (struct ZipWriterPool *)calloc(1, sizeof(struct ZipWriterPool));
+    if (pool == NULL) {
+        return;
+    }
+    pool->archive = archive;
+    pool->writer = writer;
+    pool->jobNum = workerNum * ZIP_WRITER_JOBS_PER_WORKER;
+    pool->jobs = (struct ZipWriterJob *)calloc(pool->jobNum, sizeof(struct ZipWriterJob));
+    pool->workers = (struct ZipWriterWorker *)calloc(workerNum, sizeof(struct ZipWriterWorker));
+    if (pool->jobs == NULL || pool->workers == NULL) {
+        free(pool->jobs);
+        free(pool->workers);
+        free(pool);
+        return;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->workCond, NULL);
+    pthread_cond_init(&pool->doneCond, NULL);
+    for (size_t i = 0; i < workerNum; i++) {
+        pool->workers[i].pool = pool;
+        if (pthread_create(&pool->workers[i].thread, NULL, ZipWriterWorkerRoutine, &pool->workers[i]) != 0) {
+            break;
+        }
+        pool->workerNum++;
+    }
+    if (pool->workerNum == 0) {
+        ZipWriterDestroyPool(pool);
+        return;
+    }
+    writer->pool = pool;
+}
+
+// Writes the jobs still in flight, or on failure waits for them and drops them, then stops the workers
+static int ZipWriterFinishPool(struct ZipWriter *writer, int ret)
+{
+    struct ZipWriterPool *pool = writer->pool;
+    if (pool == NULL) {
+        return ret;
+    }
+    if (ret == ARCHIVE_OK) {
+        ret = ZipWriterEmitJobs(pool, pool->nextSeq);
+    }
+    if (ret != ARCHIVE_OK) {
+        pthread_mutex_lock(&pool->lock);
+        if (pool->result == ARCHIVE_OK) {
+            pool->result = ret;
+        }
+        for (; pool->emitSeq < pool->nextSeq; pool->emitSeq++) {
+            struct ZipWriterJob *job = &pool->jobs[pool->emitSeq % pool->jobNum];
+            while (job->state != ZIP_WRITER_JOB_DONE) {
+                pthread_cond_wait(&pool->doneCond, &pool->lock);
+            }
+            ZipWriterFreeJob(job);
+            job->state = ZIP_WRITER_JOB_FREE;
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    writer->pool = NULL;
+    ZipWriterDestroyPool(pool);
+    return ret;
+}
+
 int32_t ZipWriterAddEmptyDir(HmArchiveWriteInfo *archive, struct ZipWriter *writer, const char *inputDir, char *path)
 {
     FilePathNode pathNode;
@@ -975,21 +1549,10 @@ int32_t ZipWriterAddEmptyDir(HmArchiveWriteInfo *archive, struct ZipWriter *writ
     if (ret != ARCHIVE_OK) {
         return ret;
     }
-    struct ZipWriterTaskParam param;
-    memset_s(&param, sizeof(param), 0, sizeof(param));
-    param.archive = archive;
-    param.writer = writer;
-    param.fileType = FILE_TYPE_EMPTY_DIR;
-    param.fileNode = &pathNode;
-    ret = ZipWriterEntryOpen(&param);
-    if (ret == ARCHIVE_OK) {
-        ret = ZipWriterCloseStream(&param, 0);
+    if (writer->pool != NULL) {
+        return ZipWriterSubmitJob(writer->pool, &pathNode, FILE_TYPE_EMPTY_DIR);
     }
-    ZipWriterDeleteStream(&param);
-    if (ZipWriterUpdateProgress(writer, 0, 0) == OH_ARCHIVE_PROGRESS_CANCEL) {
-        return ARCHIVE_CANCEL_ERROR;
-    }
-    return ret;
+    return ZipWriterWriteEmptyDir(archive, writer, &pathNode);
 }
 
 static int ZipWriterAddOnePath(HmArchiveWriteInfo *archive, struct ZipWriter *writer, const char *infile,
@@ -1013,7 +1576,8 @@ static int ZipWriterAddOnePath(HmArchiveWriteInfo *archive, struct ZipWriter *wr
             pathNode.filePath = path;
             ret = GetSaveName(path, inputDir, (const char **)&pathNode.saveName);
             if (ret == ARCHIVE_OK) {
-                ret = ZipWriterAddOneFile(archive, writer, &pathNode);
+                ret = writer->pool != NULL ? ZipWriterSubmitJob(writer->pool, &pathNode, FILE_TYPE_FILE) :
+                    ZipWriterAddOneFile(archive, writer, &pathNode);
             }
         }
         free(path);
@@ -1039,7 +1603,7 @@ static int32_t ZipWriterAddFiles(HmArchiveWriteInfo *archive, struct ZipWriter *
 
 static void ZipWriterDeleteFiles(HmArchiveWriteInfo *archive, struct ZipWriter *writer, int ret)
 {
-    if (ret != ARCHIVE_OK && archive->append == ARCHIVE_APPEND_STATUS_CREATE) {
+    if (ret != ARCHIVE_OK && !writer->isAppending) {
         if (writer->baseStream != NULL) {
             StreamClose(writer->baseStream);
             StreamDestroy(&writer->baseStream);
@@ -1087,7 +1651,9 @@ static int ZipWriterAddFunc(HmArchiveWriteInfo *archive, const char **infile, ui
 
     ret = InitWriterProgress(archive, writer, infile, fileNum);
     if (ret == ARCHIVE_OK) {
+        ZipWriterStartPool(archive, writer);
         ret = ZipWriterAddFiles(archive, writer, infile, fileNum);
+        ret = ZipWriterFinishPool(writer, ret);
     }
     if (ret == ARCHIVE_OK) {
         ret = ZipWriterUpdateProgress(writer, 0, 1);
@@ -1153,6 +1719,12 @@ static int ZipWriteEndOfCD(struct ZipWriter *writer, struct Stream *stream)
     if (writeRet != sizeof(struct EndOfCentralDir)) {
         return writeRet < 0 ? writeRet : ARCHIVE_WRITE_ERROR;
     }
+    if (writer->globalCommentLength > 0) {
+        writeRet = StreamWrite(stream, writer->globalComment, writer->globalCommentLength);
+        if (writeRet != (int64_t)writer->globalCommentLength) {
+            return writeRet < 0 ? writeRet : ARCHIVE_WRITE_ERROR;
+        }
+    }
     return ARCHIVE_OK;
 }
 
@@ -1170,7 +1742,7 @@ static int ZipWriterSaveCD(struct ZipWriter *writer)
     writer->numberOfDiskWithCD = 0;
     writer->sizeOfCentralDir = (uint64_t)StreamTell(baseStream) - writer->offsetOfCentralDir;
     if (writer->sizeOfCentralDir > UINT32_MAX || writer->offsetOfCentralDir > UINT32_MAX ||
-        writer->totalNumberOfEntries > UINT16_MAX) {
+        writer->totalNumberOfEntries > UINT16_MAX || writer->isZip64) {
         writer->offsetOfEOCD = (uint64_t)StreamTell(baseStream);
         ret = ZipWriterZip64EndOfCD(writer, baseStream);
         RETURN_IF_FAIL(ret);
@@ -1210,6 +1782,8 @@ static int ZipWriterClose(HmArchiveWriteInfo *archive)
         free(writer->globalComment);
         writer->globalComment = NULL;
     }
+    ZipWriterEndSampler(&writer->sampler);
+    pthread_mutex_destroy(&writer->progressLock);
     free(archive->fmtInfo);
     archive->fmtInfo = NULL;
     return ret;
@@ -16,6 +16,7 @@
 #ifndef STREAM_FILE_H
 #define STREAM_FILE_H
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #ifdef __cplusplus
@@ -27,7 +28,14 @@ extern "C" {
 #define OPEN_MODE_APPEND        (0x04)
 #define OPEN_MODE_CREATE        (0x08)
 #define OPEN_MODE_EXISTING      (0x10)
+#define FILE_STREAM_IO_STDIO    (0)
+#define FILE_STREAM_IO_MAPPED   (1)
+#define FILE_STREAM_DEFAULT_BUFFER_SIZE (1024 * 1024)
+#define FILE_STREAM_MAX_BUFFER_SIZE     (64 * 1024 * 1024)
 struct Stream *FileStreamCreate(const char *path);
+struct Stream *MappedFileStreamCreate(const char *path, uint32_t bufferSize);
+struct Stream *FileStreamCreateWithIo(const char *path, uint32_t ioMode, uint32_t bufferSize);
+int32_t ConvertWriteErrno(int errnoNum, int defaultErrNum);
 struct Stream *FileHandleStreamCreate(FILE *handle);
 int FileStreamSetPath(struct Stream *stream, const char *path);
 const char *FindLastSeparator(const char *filePath);
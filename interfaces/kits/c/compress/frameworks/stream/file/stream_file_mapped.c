@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <securec.h>
+#include "stream.h"
+#include "stream_file.h"
+#include "archive_macros.h"
+#include "errorcode.h"
+#define STREAM_MAGIC_MAPPED_FILE 0x4B7FA4A0
+#define MAPPED_FILE_ALIGNMENT (4096)
+
+// Reads come from a read only mapping of the whole file, or from pread into an aligned window when mapping fails or
+// the file is found shrunk under the mapping. Writes are coalesced in the same buffer and flushed with pwrite, so
+// seeks never flush anything by themselves. The buffer is only allocated once a read or write goes through it.
+typedef struct {
+    struct Stream stream;
+    char path[PATH_MAX + 1];
+    int fd;
+    uint32_t mode;
+    uint8_t *map;
+    uint64_t fileSize;
+    uint64_t pos;
+    uint8_t *buffer;
+    uint32_t bufferSize;
+    uint64_t bufferStart;
+    uint32_t bufferLen;
+    bool bufferDirty;
+} MappedFileStream;
+
+static inline bool MappedFileIsReadOnly(const MappedFileStream *file)
+{
+    return (file->mode & OPEN_MODE_READ_WRITE) == OPEN_MODE_READ;
+}
+
+static int MappedFileOpenFd(MappedFileStream *file)
+{
+    char resolvedPath[PATH_MAX + 1];
+    if (MappedFileIsReadOnly(file) || (file->mode & OPEN_MODE_APPEND)) {
+        if (realpath(file->path, resolvedPath) == NULL) {
+            return ConvertWriteErrno(errno, ARCHIVE_OPEN_ERROR);
+        }
+        file->fd = open(resolvedPath, MappedFileIsReadOnly(file) ? (O_RDONLY | O_CLOEXEC) : (O_RDWR | O_CLOEXEC));
+    } else {
+        char parentPath[ZIP_FILE_NAME_LEN_MAX];
+        char fullPath[ZIP_FILE_NAME_LEN_MAX];
+        if (GetParentDirectory(file->path, parentPath, ZIP_FILE_NAME_LEN_MAX) != ARCHIVE_OK) {
+            return ARCHIVE_OPEN_ERROR;
+        }
+        if (realpath(parentPath, resolvedPath) == NULL) {
+            return ConvertWriteErrno(errno, ARCHIVE_OPEN_ERROR);
+        }
+        const char *lastSeparator = FindLastSeparator(file->path);
+        const char *fileName = lastSeparator == NULL ? file->path : lastSeparator + 1;
+        if (snprintf_s(fullPath, ZIP_FILE_NAME_LEN_MAX, ZIP_FILE_NAME_LEN_MAX - 1,
+                       "%s/%s", resolvedPath, fileName) < 0) {
+            return ARCHIVE_OPEN_ERROR;
+        }
+        if (access(fullPath, F_OK) != -1) {
+            remove(fullPath);
+        }
+        file->fd = open(fullPath, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    }
+    if (file->fd < 0) {
+        return ConvertWriteErrno(errno, ARCHIVE_OPEN_ERROR);
+    }
+    return ARCHIVE_OK;
+}
+
+LOCAL int MappedFileStreamOpen(struct Stream *stream, int mode)
+{
+    RETURN_IF_MAGIC_ERR(stream, STREAM_MAGIC_MAPPED_FILE);
+    MappedFileStream *file = (MappedFileStream *)(void *)stream;
+    file->mode = (uint32_t)mode;
+    if (!MappedFileIsReadOnly(file) && !(file->mode & (OPEN_MODE_APPEND | OPEN_MODE_CREATE))) {
+        return ARCHIVE_OPEN_ERROR;
+    }
+    int ret = MappedFileOpenFd(file);
+    RETURN_IF_FAIL(ret);
+
+    struct stat statBuf;
+    if (fstat(file->fd, &statBuf) != 0) {
+        ret = ConvertWriteErrno(errno, ARCHIVE_OPEN_ERROR);
+        close(file->fd);
+        file->fd = -1;
+        return ret;
+    }
+    file->fileSize = (uint64_t)statBuf.st_size;
+    file->pos = 0;
+    file->bufferStart = 0;
+    file->bufferLen = 0;
+    file->bufferDirty = false;
+    if (MappedFileIsReadOnly(file) && file->fileSize > 0 && file->fileSize <= SIZE_MAX) {
+        void *map = mmap(NULL, (size_t)file->fileSize, PROT_READ, MAP_PRIVATE, file->fd, 0);
+        if (map != MAP_FAILED) {
+            file->map = (uint8_t *)map;
+            (void)madvise(map, (size_t)file->fileSize, MADV_SEQUENTIAL);
+            return ARCHIVE_OK;
+        }
+    }
+    if (MappedFileIsReadOnly(file)) {
+        (void)posix_fadvise(file->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+    return ARCHIVE_OK;
+}
+
+static int MappedFileAllocBuffer(MappedFileStream *file)
+{
+    if (file->buffer != NULL) {
+        return ARCHIVE_OK;
+    }
+    if (MappedFileIsReadOnly(file)) {
+        // a small file never needs a window larger than itself
+        uint64_t fileBufferSize = (file->fileSize / MAPPED_FILE_ALIGNMENT + 1) * MAPPED_FILE_ALIGNMENT;
+        if (fileBufferSize < file->bufferSize) {
+            file->bufferSize = (uint32_t)fileBufferSize;
+        }
+    }
+    if (posix_memalign((void **)&file->buffer, MAPPED_FILE_ALIGNMENT, file->bufferSize) != 0) {
+        file->buffer = NULL;
+        return ARCHIVE_MEM_ERROR;
+    }
+    return ARCHIVE_OK;
+}
+
+// The size is taken when the file is mapped and only checked again by a read reaching the mapped end, a file found
+// shrunk is read with pread from then on. Checking on every read would cost a syscall each time and still leave the
+// window between the check and the copy, so a file truncated while open can raise SIGBUS as any mapping does
+static void MappedFileCheckMapSize(MappedFileStream *file)
+{
+    struct stat statBuf;
+    if (fstat(file->fd, &statBuf) != 0) {
+        // the size can not be trusted any more, pread reports a short file as the end of data instead
+        statBuf.st_size = (off_t)file->fileSize;
+    } else if ((uint64_t)statBuf.st_size >= file->fileSize) {
+        return;
+    }
+    munmap(file->map, (size_t)file->fileSize);
+    file->map = NULL;
+    file->fileSize = (uint64_t)statBuf.st_size;
+}
+
+static int64_t MappedFilePread(MappedFileStream *file, uint8_t *buf, uint64_t len, uint64_t offset)
+{
+    uint64_t done = 0;
+    while (done < len) {
+        ssize_t readSize = pread(file->fd, buf + done, (size_t)(len - done), (off_t)(offset + done));
+        if (readSize < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return ConvertWriteErrno(errno, ARCHIVE_READ_ERROR);
+        }
+        if (readSize == 0) {
+            break;
+        }
+        done += (uint64_t)readSize;
+    }
+    return (int64_t)done;
+}
+
+static int MappedFilePwrite(MappedFileStream *file, const uint8_t *buf, uint64_t len, uint64_t offset)
+{
+    uint64_t done = 0;
+    while (done < len) {
+        ssize_t writeSize = pwrite(file->fd, buf + done, (size_t)(len - done), (off_t)(offset + done));
+        if (writeSize < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return ConvertWriteErrno(errno, ARCHIVE_WRITE_ERROR);
+        }
+        done += (uint64_t)writeSize;
+    }
+    return ARCHIVE_OK;
+}
+
+static int MappedFileFlush(MappedFileStream *file)
+{
+    if (!file->bufferDirty || file->bufferLen == 0) {
+        file->bufferDirty = false;
+        file->bufferLen = 0;
+        return ARCHIVE_OK;
+    }
+    int ret = MappedFilePwrite(file, file->buffer, file->bufferLen, file->bufferStart);
+    file->bufferDirty = false;
+    file->bufferLen = 0;
+    return ret;
+}
+
+// Serves reads through the aligned window, requests larger than the window bypass it
+static int64_t MappedFileReadBuffered(MappedFileStream *file, uint8_t *buf, uint64_t len)
+{
+    uint64_t done = 0;
+    while (done < len && file->pos < file->fileSize) {
+        if (file->pos >= file->bufferStart && file->pos < file->bufferStart + file->bufferLen) {
+            uint64_t avail = file->bufferStart + file->bufferLen - file->pos;
+            uint64_t copySize = avail < len - done ? avail : len - done;
+            if (memcpy_s(buf + done, len - done, file->buffer + (file->pos - file->bufferStart), copySize) != EOK) {
+                return ARCHIVE_INTERNAL_ERROR;
+            }
+            done += copySize;
+            file->pos += copySize;
+            continue;
+        }
+        if (len - done >= file->bufferSize) {
+            int64_t readSize = MappedFilePread(file, buf + done, len - done, file->pos);
+            if (readSize < 0) {
+                return readSize;
+            }
+            done += (uint64_t)readSize;
+            file->pos += (uint64_t)readSize;
+            break;
+        }
+        int ret = MappedFileAllocBuffer(file);
+        RETURN_IF_FAIL(ret);
+        file->bufferStart = file->pos - file->pos % MAPPED_FILE_ALIGNMENT;
+        file->bufferLen = 0;
+        int64_t readSize = MappedFilePread(file, file->buffer, file->bufferSize, file->bufferStart);
+        if (readSize < 0) {
+            return readSize;
+        }
+        file->bufferLen = (uint32_t)readSize;
+        if (file->bufferStart + file->bufferLen <= file->pos) {
+            break;
+        }
+    }
+    return (int64_t)done;
+}
+
+LOCAL int64_t MappedFileStreamRead(struct Stream *stream, void *buf, int64_t len)
+{
+    ASSERT_IF_MAGIC_ERR(stream, STREAM_MAGIC_MAPPED_FILE);
+    MappedFileStream *file = (MappedFileStream *)(void *)stream;
+    ASSERT(file->fd >= 0);
+    if (len <= 0) {
+        return 0;
+    }
+    if (file->map != NULL && (file->pos >= file->fileSize || (uint64_t)len >= file->fileSize - file->pos)) {
+        MappedFileCheckMapSize(file);
+    }
+    if (file->map != NULL) {
+        if (file->pos >= file->fileSize) {
+            return 0;
+        }
+        uint64_t avail = file->fileSize - file->pos;
+        uint64_t copySize = avail < (uint64_t)len ? avail : (uint64_t)len;
+        if (memcpy_s(buf, (size_t)len, file->map + file->pos, (size_t)copySize) != EOK) {
+            return ARCHIVE_READ_ERROR;
+        }
+        file->pos += copySize;
+        return (int64_t)copySize;
+    }
+    if (MappedFileIsReadOnly(file)) {
+        return MappedFileReadBuffered(file, (uint8_t *)buf, (uint64_t)len);
+    }
+    // the buffer holds pending writes, they must reach the file before it is read back
+    int ret = MappedFileFlush(file);
+    RETURN_IF_FAIL(ret);
+    int64_t readSize = MappedFilePread(file, (uint8_t *)buf, (uint64_t)len, file->pos);
+    if (readSize > 0) {
+        file->pos += (uint64_t)readSize;
+    }
+    return readSize;
+}
+
+LOCAL int64_t MappedFileStreamWrite(struct Stream *stream, const void *buf, int64_t len)
+{
+    ASSERT_IF_MAGIC_ERR(stream, STREAM_MAGIC_MAPPED_FILE);
+    MappedFileStream *file = (MappedFileStream *)(void *)stream;
+    ASSERT(file->fd >= 0);
+    if (MappedFileIsReadOnly(file)) {
+        return ARCHIVE_WRITE_ERROR;
+    }
+    if (len <= 0) {
+        return 0;
+    }
+    int ret = ARCHIVE_OK;
+    if (file->bufferLen != 0 && file->pos != file->bufferStart + file->bufferLen) {
+        ret = MappedFileFlush(file);
+        RETURN_IF_FAIL(ret);
+    }
+    const uint8_t *data = (const uint8_t *)buf;
+    uint64_t done = 0;
+    while (done < (uint64_t)len) {
+        uint64_t remain = (uint64_t)len - done;
+        if (file->bufferLen == 0 && remain >= file->bufferSize) {
+            ret = MappedFilePwrite(file, data + done, remain, file->pos);
+            RETURN_IF_FAIL(ret);
+            done += remain;
+            file->pos += remain;
+            break;
+        }
+        ret = MappedFileAllocBuffer(file);
+        RETURN_IF_FAIL(ret);
+        if (file->bufferLen == 0) {
+            file->bufferStart = file->pos;
+        }
+        uint64_t space = file->bufferSize - file->bufferLen;
+        uint64_t copySize = space < remain ? space : remain;
+        if (memcpy_s(file->buffer + file->bufferLen, space, data + done, (size_t)copySize) != EOK) {
+            return ARCHIVE_INTERNAL_ERROR;
+        }
+        file->bufferLen += (uint32_t)copySize;
+        file->bufferDirty = true;
+        done += copySize;
+        file->pos += copySize;
+        if (file->bufferLen == file->bufferSize) {
+            ret = MappedFileFlush(file);
+            RETURN_IF_FAIL(ret);
+        }
+    }
+    if (file->pos > file->fileSize) {
+        file->fileSize = file->pos;
+    }
+    return len;
+}
+
+LOCAL int MappedFileStreamSeek(struct Stream *stream, int64_t offset, int origin)
+{
+    RETURN_IF_MAGIC_ERR(stream, STREAM_MAGIC_MAPPED_FILE);
+    MappedFileStream *file = (MappedFileStream *)(void *)stream;
+    ASSERT(file->fd >= 0);
+    int64_t base;
+    switch (origin) {
+        case SEEK_SET:
+            base = 0;
+            break;
+        case SEEK_CUR:
+            base = (int64_t)file->pos;
+            break;
+        case SEEK_END:
+            base = (int64_t)file->fileSize;
+            break;
+        default:
+            return ARCHIVE_SEEK_ERROR;
+    }
+    if ((offset < 0 && base + offset < 0) || (offset > 0 && base > INT64_MAX - offset)) {
+        return ARCHIVE_SEEK_ERROR;
+    }
+    file->pos = (uint64_t)(base + offset);
+    return ARCHIVE_OK;
+}
+
+LOCAL int64_t MappedFileStreamTell(struct Stream *stream)
+{
+    ASSERT_IF_MAGIC_ERR(stream, STREAM_MAGIC_MAPPED_FILE);
+    MappedFileStream *file = (MappedFileStream *)(void *)stream;
+    ASSERT(file->fd >= 0);
+    return (int64_t)file->pos;
+}
+
+LOCAL int MappedFileStreamClose(struct Stream *stream)
+{
+    RETURN_IF_MAGIC_ERR(stream, STREAM_MAGIC_MAPPED_FILE);
+    MappedFileStream *file = (MappedFileStream *)(void *)stream;
+    int ret = ARCHIVE_OK;
+    if (file->buffer != NULL) {
+        ret = MappedFileFlush(file);
+        free(file->buffer);
+        file->buffer = NULL;
+    }
+    if (file->map != NULL) {
+        munmap(file->map, (size_t)file->fileSize);
+        file->map = NULL;
+    }
+    if (file->fd >= 0) {
+        close(file->fd);
+        file->fd = -1;
+    }
+    return ret;
+}
+
+LOCAL const StreamOps g_MappedFileStreamOps = {
+    .open = MappedFileStreamOpen,
+    .read = MappedFileStreamRead,
+    .write = MappedFileStreamWrite,
+    .seek = MappedFileStreamSeek,
+    .tell = MappedFileStreamTell,
+    .close = MappedFileStreamClose,
+};
+
+ARCHIVE_IMPL struct Stream *MappedFileStreamCreate(const char *path, uint32_t bufferSize)
+{
+    if (path == NULL) {
+        return NULL;
+    }
+    MappedFileStream *file = calloc(1, sizeof(MappedFileStream));
+    if (file == NULL) {
+        ARCHIVE_ERR("MappedFileStreamCreate fail!\n");
+        return NULL;
+    }
+
+    SET_OBJ_MAGIC(&file->stream, STREAM_MAGIC_MAPPED_FILE);
+    if (strncpy_s(file->path, PATH_MAX, path, strlen(path)) != EOK) {
+        ARCHIVE_ERR("MappedFileStream copy path fail!\n");
+        free(file);
+        return NULL;
+    }
+    if (bufferSize == 0) {
+        bufferSize = FILE_STREAM_DEFAULT_BUFFER_SIZE;
+    }
+    // whole pages, so the read window and every flush stay aligned
+    bufferSize = (bufferSize + MAPPED_FILE_ALIGNMENT - 1) / MAPPED_FILE_ALIGNMENT * MAPPED_FILE_ALIGNMENT;
+    file->stream.ops = g_MappedFileStreamOps;
+    file->fd = -1;
+    file->bufferSize = bufferSize;
+    return (struct Stream *)file;
+}
+
+ARCHIVE_IMPL struct Stream *FileStreamCreateWithIo(const char *path, uint32_t ioMode, uint32_t bufferSize)
+{
+    if (ioMode == FILE_STREAM_IO_MAPPED) {
+        return MappedFileStreamCreate(path, bufferSize);
+    }
+    return FileStreamCreate(path);
+}
@@ -39,7 +39,7 @@ ARCHIVE_IMPL const char *FindLastSeparator(const char *filePath)
     return lastSeparator;
 }
 
-static int32_t ConvertWriteErrno(int errnoNum, int defaultErrNum)
+ARCHIVE_IMPL int32_t ConvertWriteErrno(int errnoNum, int defaultErrNum)
 {
     switch (errnoNum) {
         case ENOSPC:
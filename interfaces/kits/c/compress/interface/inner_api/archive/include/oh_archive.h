@@ -59,6 +59,16 @@ typedef struct ArchiveStreamWriteCtx *OH_Archive_StreamWrite_Ctx;
  * @since 26.0.0
  */
 typedef struct ArchiveStreamReadCtx *OH_Archive_StreamRead_Ctx;
+/**
+ * @brief Archive codec context structure, reusable compression state for many small buffers.
+ * @since 26.0.0
+ */
+typedef struct ArchiveCodecCtx *OH_Archive_Codec_Ctx;
+/**
+ * @brief Archive zipStreamRead context structure, forward-only extraction of a ZIP archive delivered in chunks.
+ * @since 26.0.0
+ */
+typedef struct ArchiveZipStreamReadCtx *OH_Archive_ZipStreamRead_Ctx;
 
 /**
  * @brief Archive format enumeration.
@@ -98,7 +108,13 @@ typedef enum {
      * @brief Create mode.
      * @since 26.0.0
      */
-    OH_ARCHIVE_OPEN_MODE_CREATE = 0
+    OH_ARCHIVE_OPEN_MODE_CREATE = 0,
+    /**
+     * @brief Append mode, new entries are added after the entries of an existing archive and only its central
+     * directory is rewritten. A missing archive is created.
+     * @since 26.0.0
+     */
+    OH_ARCHIVE_OPEN_MODE_APPEND = 1
 } OH_Archive_OpenMode;
 
 /**
@@ -169,7 +185,8 @@ typedef struct {
      */
     uint32_t blockSize;
     /**
-     * @brief Number of threads
+     * @brief Number of threads. Values greater than 1 compress blockSize blocks in parallel,
+     * buffering up to twice that many blocks.
      * @since 26.0.0
      */
     int32_t threadNum;
@@ -185,6 +202,116 @@ typedef struct {
     OH_Archive_CompressMethod method;
 } OH_Archive_Stream_Config;
 
+/**
+ * @brief Archive entry information structure.
+ * @since 26.0.0
+ */
+typedef struct {
+    /**
+     * @brief Entry name, valid until the archive reader context is closed.
+     * @since 26.0.0
+     */
+    const char *name;
+    /**
+     * @brief Size of the entry data before compression.
+     * @since 26.0.0
+     */
+    uint64_t uncompressedSize;
+    /**
+     * @brief Size of the entry data stored in the archive.
+     * @since 26.0.0
+     */
+    uint64_t compressedSize;
+    /**
+     * @brief Offset of the entry's local header in the archive.
+     * @since 26.0.0
+     */
+    uint64_t offset;
+    /**
+     * @brief CRC32 of the uncompressed entry data.
+     * @since 26.0.0
+     */
+    uint32_t crc32;
+    /**
+     * @brief Compression method as stored in the archive, see {@link OH_Archive_CompressMethod}.
+     * @since 26.0.0
+     */
+    uint16_t method;
+    /**
+     * @brief Whether the entry is a directory, 1 for a directory and 0 otherwise.
+     * @since 26.0.0
+     */
+    uint8_t isDirectory;
+} OH_Archive_EntryInfo;
+
+/**
+ * @brief File I/O mode of the archive file and of the files read or written by a reader or writer.
+ * @since 26.0.0
+ */
+typedef enum {
+    /**
+     * @brief Buffered stdio file access.
+     * @since 26.0.0
+     */
+    OH_ARCHIVE_FILE_IO_DEFAULT = 0,
+    /**
+     * @brief Reads from a memory mapping, falling back to pread with an aligned buffer, and coalesced pwrite writes.
+     * @since 26.0.0
+     */
+    OH_ARCHIVE_FILE_IO_MAPPED = 1
+} OH_Archive_FileIoMode;
+
+/**
+ * @brief File I/O options given when a reader or writer context is created.
+ * @since 26.0.0
+ */
+typedef struct {
+    /**
+     * @brief File I/O mode, see {@link OH_Archive_FileIoMode}.
+     * @since 26.0.0
+     */
+    OH_Archive_FileIoMode ioMode;
+    /**
+     * @brief Read and write buffer size in bytes for {@link OH_ARCHIVE_FILE_IO_MAPPED}, rounded up to whole pages.
+     *        0 selects the default of 1 MiB, the maximum is 64 MiB. A file read through its memory mapping never
+     *        allocates it, and a file read with pread gets no more than its own size.
+     * @since 26.0.0
+     */
+    uint32_t bufferSize;
+} OH_Archive_FileIoOptions;
+
+/**
+ * @brief One buffer of a codec batch.
+ * @since 26.0.0
+ */
+typedef struct {
+    /**
+     * @brief Source data.
+     * @since 26.0.0
+     */
+    const uint8_t *srcBuffer;
+    /**
+     * @brief Size of the source data.
+     * @since 26.0.0
+     */
+    uint64_t srcSize;
+    /**
+     * @brief Destination buffer.
+     * @since 26.0.0
+     */
+    uint8_t *dstBuffer;
+    /**
+     * @brief Destination buffer size on input, size of the produced data on output.
+     * @since 26.0.0
+     */
+    uint64_t dstSize;
+    /**
+     * @brief Result of this buffer, set by the batch call.
+     * @since 26.0.0
+     */
+    OH_Archive_ErrCode result;
+} OH_Archive_Codec_Buffer;
+
 /**
  * @brief Defines a function pointer type OH_Archive_ProgressHandlerWithData for
  * specifying the progress display handler.
@@ -207,6 +334,17 @@ typedef OH_Archive_ProgressType (*OH_Archive_ProgressHandlerWithData)(int32_t pr
  */
 typedef uint64_t (*OH_Archive_Stream_OutputHandler)(const void* data, uint64_t size, void* userData);
 
+/**
+ * @brief Function pointer type called by the streaming ZIP reader when the local header of an entry has arrived.
+ * @param info Entry information from the local header, valid during the callback only. crc32, compressedSize and
+ *     uncompressedSize are 0 when the entry keeps them in a data descriptor after its data.
+ * @param userData User-defined context that will be passed back in the callback.
+ * @return {@link OH_ARCHIVE_PROGRESS_CONTINUE} to receive the entry data, {@link OH_ARCHIVE_PROGRESS_CANCEL} to stop.
+ * @since 26.0.0
+ */
+typedef OH_Archive_ProgressType (*OH_Archive_ZipStream_EntryHandler)(const OH_Archive_EntryInfo *info,
+    void *userData);
+
 /**
  * @brief Opens an archive file for reading.
  * @note The returned context must be freed by calling OH_Archive_Reader_Close() to release allocated resources.
@@ -217,8 +355,24 @@ typedef uint64_t (*OH_Archive_Stream_OutputHandler)(const void* data, uint64_t s
  */
 OH_Archive_Reader_Ctx OH_Archive_Reader_OpenFile(const char *infile);
 
+/**
+ * @brief Opens an archive file for reading with the given file I/O options.
+ * @note The returned context must be freed by calling OH_Archive_Reader_Close() to release allocated resources.
+ * @note With {@link OH_ARCHIVE_FILE_IO_MAPPED} the built-in ZIP reader is used even where a faster reader plugin is
+ *     available, since the plugin does its own file I/O.
+ * @param infile Path to the source archive file.
+ * @param options File I/O options, NULL behaves as OH_Archive_Reader_OpenFile().
+ * @return Returns a handle to the archive reader context, or NULL if the operation fails or the options are invalid.
+ * @since 26.0.0
+ * @release archive/OH_Archive_Reader_Close {return}
+ */
+OH_Archive_Reader_Ctx OH_Archive_Reader_OpenFileWithOptions(const char *infile,
+                                                            const OH_Archive_FileIoOptions *options);
+
 /**
  * @brief Sets the progress callback function with user data for the archive reader.
+ * @note With an extract thread number greater than 1 the handler is called from the extract threads, one call at a
+ *     time, so it must not rely on running on the thread that called OH_Archive_Reader_ExtractAllFile().
  * @param arc Handle to the archive reader context.
  * @param progressHandler The callback function to handle progress updates.
  * @param userData User data, passed when calling the callback.
@@ -230,6 +384,20 @@ OH_Archive_Reader_Ctx OH_Archive_Reader_OpenFile(const char *infile);
 OH_Archive_ErrCode OH_Archive_Reader_SetProgressHandlerWithData(OH_Archive_Reader_Ctx arc,
                                                                 OH_Archive_ProgressHandlerWithData progressHandler,
                                                                 void *userData);
+/**
+ * @brief Sets the number of threads OH_Archive_Reader_ExtractAllFile() extracts files with.
+ * @note Entries whose names resolve to the same path are renamed in archive order whatever the thread number.
+ * @param arc Handle to the archive reader context.
+ * @param threadNum Number of threads, 0 or 1 extracts on the calling thread, which is the default, at most 16.
+ *     Each extra thread opens the archive file again, fewer threads are used when it fails or the CPUs are fewer.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_OK} - Execution successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters.
+ *         {@link OH_ARCHIVE_UNSUPPORTED_ERROR} - The archive is read by a plugin that extracts on its own threads.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Reader_SetExtractThreadNum(OH_Archive_Reader_Ctx arc, uint32_t threadNum);
+
 /**
  * @brief Extract all files from the archive.
  * @param arc Handle to the archive reader context.
@@ -239,6 +407,101 @@ OH_Archive_ErrCode OH_Archive_Reader_SetProgressHandlerWithData(OH_Archive_Reade
  */
 OH_Archive_ErrCode OH_Archive_Reader_ExtractAllFile(OH_Archive_Reader_Ctx arc, const char *outDir);
 
+/**
+ * @brief Gets the number of entries in the archive.
+ * @note The central directory is indexed on the first entry query, later queries and lookups take O(1).
+ * @param arc Handle to the archive reader context.
+ * @param count Returns the number of entries, directories included.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_OK} - Execution successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters.
+ *         {@link OH_ARCHIVE_UNSUPPORTED_ERROR} - The archive can not be indexed.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Reader_GetEntryCount(OH_Archive_Reader_Ctx arc, uint64_t *count);
+
+/**
+ * @brief Gets the information of an entry in the archive.
+ * @param arc Handle to the archive reader context.
+ * @param index Entry index, between 0 and the entry count, in central directory order.
+ * @param info Returns the entry information.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_OK} - Execution successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters or index out of range.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Reader_GetEntryInfo(OH_Archive_Reader_Ctx arc, uint64_t index,
+                                                  OH_Archive_EntryInfo *info);
+
+/**
+ * @brief Finds an entry by name.
+ * @param arc Handle to the archive reader context.
+ * @param name Entry name, for example "dir/file.txt". When names repeat, the first entry is returned.
+ * @param index Returns the entry index.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_OK} - Execution successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters.
+ *         {@link OH_ARCHIVE_PATH_NOT_EXIST_ERROR} - No entry has that name.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Reader_FindEntry(OH_Archive_Reader_Ctx arc, const char *name, uint64_t *index);
+
+/**
+ * @brief Extracts a single file or symlink entry to the given path, replacing an existing file.
+ * @param arc Handle to the archive reader context.
+ * @param index Entry index.
+ * @param outPath Output file path, its parent directory must exist.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters or the entry is a directory.
+ *         {@link OH_ARCHIVE_CRC_ERROR} - The extracted data does not match the entry CRC32.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Reader_ExtractEntryToFile(OH_Archive_Reader_Ctx arc, uint64_t index,
+                                                        const char *outPath);
+
+/**
+ * @brief Extracts the data of a single entry to an opened file descriptor, starting at its current offset.
+ * @param arc Handle to the archive reader context.
+ * @param index Entry index.
+ * @param fd Writable file descriptor, it is not closed.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters or the entry is a directory.
+ *         {@link OH_ARCHIVE_WRITE_ERROR} - Failed to write to fd.
+ *         {@link OH_ARCHIVE_NO_SPACE_ERROR} - No space left on the device.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Reader_ExtractEntryToFd(OH_Archive_Reader_Ctx arc, uint64_t index, int fd);
+
+/**
+ * @brief Extracts the data of a single entry to a caller buffer.
+ * @param arc Handle to the archive reader context.
+ * @param index Entry index.
+ * @param buffer Destination buffer.
+ * @param size Input the buffer size, returns the number of bytes extracted. When the buffer is too small,
+ *     returns the uncompressed size of the entry.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters or the entry is a directory.
+ *         {@link OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR} - The buffer is too small.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Reader_ExtractEntryToBuffer(OH_Archive_Reader_Ctx arc, uint64_t index,
+                                                          uint8_t *buffer, uint64_t *size);
+
+/**
+ * @brief Extracts the data of a single entry and passes it to the output handler chunk by chunk.
+ * @param arc Handle to the archive reader context.
+ * @param index Entry index.
+ * @param outputHandler Callback receiving the extracted data, it must return the size it was passed.
+ * @param userData User data, passed when calling the callback.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters or the entry is a directory.
+ *         {@link OH_ARCHIVE_STREAM_OUTPUT_ERROR} - The output handler did not consume the data.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Reader_ExtractEntryToStream(OH_Archive_Reader_Ctx arc, uint64_t index,
+                                                          OH_Archive_Stream_OutputHandler outputHandler,
+                                                          void *userData);
+
 /**
  * @brief Closes an opened archive file and releases associated resources.
  * @param arc Handle to the archive reader context.
@@ -261,6 +524,24 @@ OH_Archive_Writer_Ctx OH_Archive_Writer_OpenFile(const char *outfile,
                                                  OH_Archive_OpenMode openMode,
                                                  OH_Archive_Format fmt);
 
+/**
+ * @brief Creates and opens an archive file with the given file I/O options.
+ * @note The returned context must be freed by calling OH_Archive_Writer_Close() to release allocated resources.
+ * @note With {@link OH_ARCHIVE_FILE_IO_MAPPED} the built-in ZIP writer is used even where a faster writer plugin is
+ *     available, since the plugin does its own file I/O.
+ * @param outfile Path to the destination archive file.
+ * @param openMode Append mode.
+ * @param fmt Archive format.
+ * @param options File I/O options, NULL behaves as OH_Archive_Writer_OpenFile().
+ * @return Returns a handle to the archive writer context, or NULL if the operation fails or the options are invalid.
+ * @since 26.0.0
+ * @release archive/OH_Archive_Writer_Close {return}
+ */
+OH_Archive_Writer_Ctx OH_Archive_Writer_OpenFileWithOptions(const char *outfile,
+                                                            OH_Archive_OpenMode openMode,
+                                                            OH_Archive_Format fmt,
+                                                            const OH_Archive_FileIoOptions *options);
+
 /**
  * @brief Set the compression method for the archive file
  * @param arc Handle to the archive writer context.
@@ -278,6 +559,8 @@ OH_Archive_ErrCode OH_Archive_Writer_SetCompressMethod(OH_Archive_Writer_Ctx arc
 
 /**
  * @brief Set the compression progress function for the archive file.
+ * @note On a device with several CPUs files are compressed on worker threads, so the handler may be called from
+ *     those threads, one call at a time, rather than from the thread that called OH_Archive_Writer_Add().
  * @param arc Handle to the archive writer context.
  * @param progressHandler The callback function to handle progress updates.
  * @param userData User data, passed when calling the callback.
@@ -290,6 +573,25 @@ OH_Archive_ErrCode OH_Archive_Writer_SetProgressHandlerWithData(OH_Archive_Write
                                                                 OH_Archive_ProgressHandlerWithData progressHandler,
                                                                 void *userData);
 
+/**
+ * @brief Sets which entries the archive writer stores without compression when the method is
+ * OH_ARCHIVE_COMPRESS_DEFLATE, so already compressed content such as images and videos is not deflated again.
+ * @param arc Handle to the archive writer context.
+ * @param minSavingPercent Minimum percentage a trial deflate of the first block of a file must save for the file
+ *     to be deflated, between 0 and 100. 0 disables the trial.
+ * @param storeExtensions File name extensions always stored, case-insensitive and without the dot, for example "jpg".
+ *     Can be NULL when extensionNum is 0.
+ * @param extensionNum Number of extensions.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_OK} - Execution successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters.
+ *         {@link OH_ARCHIVE_MEM_ERROR} - Failed to allocate memory.
+ *         {@link OH_ARCHIVE_UNSUPPORTED_ERROR} - The archive is written by a plugin that does not support auto store.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Writer_SetAutoStore(OH_Archive_Writer_Ctx arc, uint32_t minSavingPercent,
+                                                  const char **storeExtensions, uint32_t extensionNum);
+
 /**
  * @brief Adds a list of files to the archive.
  * @param arc Handle to the archive writer context.
@@ -351,6 +653,106 @@ OH_Archive_ErrCode OH_Archive_BufferRead(uint8_t *dstBuffer, uint64_t *dstSize,
                                          const uint8_t *srcBuffer, uint64_t srcSize,
                                          OH_Archive_CompressMethod method);
 
+/**
+ * @brief Creates a codec context that keeps its compression state between calls.
+ * @note Every buffer is compressed independently, in the same format as OH_Archive_BufferWrite(), so the output of
+ *     OH_Archive_Codec_Compress() can be read by OH_Archive_BufferRead() unless a dictionary is set. The compression
+ *     state is allocated on first use and only reset afterwards. A context must not be used by several threads at
+ *     the same time.
+ * @param method Compression method type, only OH_ARCHIVE_COMPRESS_DEFLATE is supported.
+ * @param compressLevel Compression level. The value -1 indicates the default compression level, 0 to 9 otherwise.
+ * @return Returns a handle to the codec context, or NULL if the parameters are invalid or the operation fails.
+ * @since 26.0.0
+ * @release archive/OH_Archive_Codec_Destroy {return}
+ */
+OH_Archive_Codec_Ctx OH_Archive_Codec_Create(OH_Archive_CompressMethod method, int32_t compressLevel);
+
+/**
+ * @brief Sets a preset dictionary used for every following compression and decompression.
+ * @note Small records that share content compress better against a dictionary. The same dictionary must be set on
+ *     the context that decompresses the data.
+ * @param ctx Codec context.
+ * @param dict Dictionary data, copied into the context. NULL with dictSize 0 removes the dictionary.
+ * @param dictSize Dictionary size, at most 32 KiB are used, the tail of a longer dictionary.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters.
+ *         {@link OH_ARCHIVE_MEM_ERROR} - Out of memory.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Codec_SetDictionary(OH_Archive_Codec_Ctx ctx, const uint8_t *dict, uint32_t dictSize);
+
+/**
+ * @brief Compresses one buffer with the codec context.
+ * @param ctx Codec context.
+ * @param dstBuffer Destination buffer, see OH_Archive_BufferWriteCompressBound() for its size.
+ * @param dstSize Destination buffer size on input, compressed size on output.
+ * @param srcBuffer Source data.
+ * @param srcSize Size of the source data.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters.
+ *         {@link OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR} - The destination buffer is too small.
+ *         {@link OH_ARCHIVE_MEM_ERROR} - Out of memory.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Codec_Compress(OH_Archive_Codec_Ctx ctx, uint8_t *dstBuffer, uint64_t *dstSize,
+                                             const uint8_t *srcBuffer, uint64_t srcSize);
+
+/**
+ * @brief Decompresses one buffer with the codec context.
+ * @param ctx Codec context.
+ * @param dstBuffer Destination buffer.
+ * @param dstSize Destination buffer size on input, decompressed size on output.
+ * @param srcBuffer Compressed data.
+ * @param srcSize Size of the compressed data.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ *         {@link OH_ARCHIVE_PARAM_ERROR} - Invalid input parameters.
+ *         {@link OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR} - The destination buffer is too small.
+ *         {@link OH_ARCHIVE_DEFLATE_ERROR} - The data is corrupted or needs another dictionary.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Codec_Decompress(OH_Archive_Codec_Ctx ctx, uint8_t *dstBuffer, uint64_t *dstSize,
+                                               const uint8_t *srcBuffer, uint64_t srcSize);
+
+/**
+ * @brief Compresses an array of buffers in one call.
+ * @param ctx Codec context.
+ * @param buffers Buffers to compress, the dstSize and result of each one are updated.
+ * @param count Number of buffers.
+ * @param threadNum Number of threads to spread the buffers over, 0 or 1 runs on the calling thread, at most 16.
+ * @return Returns OH_ARCHIVE_OK when every buffer succeeded, otherwise the result of the first failed buffer.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Codec_CompressBatch(OH_Archive_Codec_Ctx ctx, OH_Archive_Codec_Buffer *buffers,
+                                                  uint64_t count, uint32_t threadNum);
+
+/**
+ * @brief Decompresses an array of buffers in one call.
+ * @param ctx Codec context.
+ * @param buffers Buffers to decompress, the dstSize and result of each one are updated.
+ * @param count Number of buffers.
+ * @param threadNum Number of threads to spread the buffers over, 0 or 1 runs on the calling thread, at most 16.
+ * @return Returns OH_ARCHIVE_OK when every buffer succeeded, otherwise the result of the first failed buffer.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Codec_DecompressBatch(OH_Archive_Codec_Ctx ctx, OH_Archive_Codec_Buffer *buffers,
+                                                    uint64_t count, uint32_t threadNum);
+
+/**
+ * @brief Resets the codec context to its created state and removes its dictionary.
+ * @note The allocated compression state is kept for reuse.
+ * @param ctx Codec context.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_Codec_Reset(OH_Archive_Codec_Ctx ctx);
+
+/**
+ * @brief Destroys a codec context.
+ * @param ctx Codec context.
+ * @since 26.0.0
+ */
+void OH_Archive_Codec_Destroy(OH_Archive_Codec_Ctx ctx);
+
 /**
  * @brief Creates a compression instance.
  * @param config Compression configuration.
@@ -472,6 +874,69 @@ OH_Archive_ErrCode OH_Archive_StreamRead_End(OH_Archive_StreamRead_Ctx ctx, OH_A
  */
 void OH_Archive_StreamRead_Destroy(OH_Archive_StreamRead_Ctx ctx);
 
+/**
+ * @brief Creates a streaming ZIP reader. Unlike OH_Archive_Reader_OpenFile() it needs no seekable file: the archive
+ *     is fed in order with OH_Archive_ZipStreamRead_Update() and every entry is extracted as soon as it arrives.
+ * @return Returns a pointer to the streaming ZIP reader context, or NULL if creation fails.
+ * @since 26.0.0
+ * @release archive/OH_Archive_ZipStreamRead_Destroy {return}
+ */
+OH_Archive_ZipStreamRead_Ctx OH_Archive_ZipStreamRead_Create(void);
+
+/**
+ * @brief Starts reading an archive whose entries are extracted below a directory.
+ * @param ctx Streaming ZIP reader context.
+ * @param outDir Output directory, it must exist. An entry is renamed if a file of that name already exists.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_ZipStreamRead_StartToDir(OH_Archive_ZipStreamRead_Ctx ctx, const char *outDir);
+
+/**
+ * @brief Starts reading an archive whose entries are passed to callbacks. The data of an entry is passed to
+ *     outputHandler after entryHandler is called for it and before entryHandler is called for the next entry.
+ * @param ctx Streaming ZIP reader context.
+ * @param entryHandler Called for every entry before its data, may be NULL.
+ * @param outputHandler Receives the decompressed data of the entries.
+ * @param userData User-defined context that will be passed back in the callbacks. The userData is owned by
+ *     the caller and must remain valid until OH_Archive_ZipStreamRead_End is complete.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_ZipStreamRead_Start(OH_Archive_ZipStreamRead_Ctx ctx,
+                                                  OH_Archive_ZipStream_EntryHandler entryHandler,
+                                                  OH_Archive_Stream_OutputHandler outputHandler, void *userData);
+
+/**
+ * @brief Submits the next chunk of the archive. Entries without compression must record their size in the local
+ *     header, encrypted entries are not supported. The CRC32 of an entry is checked when its data is complete.
+ * @param ctx Streaming ZIP reader context.
+ * @param data Next bytes of the archive.
+ * @param size Size of the data.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if successful. After a failure every later call returns
+ *     the same error.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_ZipStreamRead_Update(OH_Archive_ZipStreamRead_Ctx ctx, const uint8_t *data,
+                                                   uint64_t size);
+
+/**
+ * @brief Ends reading the archive.
+ * @param ctx Streaming ZIP reader context.
+ * @param entryCount Number of entries extracted, may be NULL.
+ * @return Returns the error code. Returns OH_ARCHIVE_OK if the central directory has been reached, otherwise
+ *     the archive is truncated and OH_ARCHIVE_DATA_ERROR is returned.
+ * @since 26.0.0
+ */
+OH_Archive_ErrCode OH_Archive_ZipStreamRead_End(OH_Archive_ZipStreamRead_Ctx ctx, uint64_t *entryCount);
+
+/**
+ * @brief Destroys the streaming ZIP reader. A file partially extracted to a directory is removed.
+ * @param ctx Streaming ZIP reader context to be destroyed.
+ * @since 26.0.0
+ */
+void OH_Archive_ZipStreamRead_Destroy(OH_Archive_ZipStreamRead_Ctx ctx);
+
 #ifdef __cplusplus
 }
 #endif /* End of #ifdef __cplusplus */
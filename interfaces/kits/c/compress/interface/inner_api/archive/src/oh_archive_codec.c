@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <pthread.h>
+#include <securec.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "archive_macros.h"
+#include "oh_archive.h"
+#include "zlib.h"
+
+#define CODEC_DEFAULT_MEM_LEVEL (8)
+#define CODEC_MIN_LEVEL (-1)
+#define CODEC_MAX_LEVEL (9)
+#define CODEC_MAX_DICT_SIZE (32 * 1024)
+#define CODEC_MAX_THREAD_NUM (16)
+
+/* zlib state of one thread, created on first use and only reset afterwards */
+typedef struct {
+    z_stream deflateStream;
+    z_stream inflateStream;
+    bool deflateInited;
+    bool inflateInited;
+} CodecState;
+
+struct ArchiveCodecCtx {
+    int level;
+    uint8_t *dict;
+    uint32_t dictSize;
+    /* states[0] serves the calling thread, the others the batch workers */
+    CodecState states[CODEC_MAX_THREAD_NUM];
+};
+
+typedef struct {
+    OH_Archive_Codec_Ctx ctx;
+    OH_Archive_Codec_Buffer *buffers;
+    uint64_t count;
+    bool compress;
+    _Atomic uint64_t nextIndex;
+} CodecBatch;
+
+typedef struct {
+    CodecBatch *batch;
+    CodecState *state;
+} CodecWorker;
+
+static void CodecNext(z_stream *stream, uint64_t *dstLeft, uint64_t *srcLeft)
+{
+    const uInt max = (uInt)-1;
+    if (stream->avail_out == 0) {
+        stream->avail_out = *dstLeft > (uint64_t)max ? max : (uInt)*dstLeft;
+        *dstLeft -= stream->avail_out;
+    }
+    if (stream->avail_in == 0) {
+        stream->avail_in = *srcLeft > (uint64_t)max ? max : (uInt)*srcLeft;
+        *srcLeft -= stream->avail_in;
+    }
+}
+
+static OH_Archive_ErrCode CodecPrepareDeflate(OH_Archive_Codec_Ctx ctx, CodecState *state)
+{
+    int err;
+    if (!state->deflateInited) {
+        err = deflateInit2(&state->deflateStream, ctx->level, Z_DEFLATED, -MAX_WBITS, CODEC_DEFAULT_MEM_LEVEL,
+            Z_DEFAULT_STRATEGY);
+        if (err != Z_OK) {
+            return err == Z_MEM_ERROR ? OH_ARCHIVE_MEM_ERROR : OH_ARCHIVE_PARAM_ERROR;
+        }
+        state->deflateInited = true;
+    } else if (deflateReset(&state->deflateStream) != Z_OK) {
+        return OH_ARCHIVE_DEFLATE_ERROR;
+    }
+    if (ctx->dict != NULL && deflateSetDictionary(&state->deflateStream, ctx->dict, ctx->dictSize) != Z_OK) {
+        return OH_ARCHIVE_DEFLATE_ERROR;
+    }
+    return OH_ARCHIVE_OK;
+}
+
+static OH_Archive_ErrCode CodecPrepareInflate(OH_Archive_Codec_Ctx ctx, CodecState *state)
+{
+    if (!state->inflateInited) {
+        int err = inflateInit2(&state->inflateStream, -MAX_WBITS);
+        if (err != Z_OK) {
+            return err == Z_MEM_ERROR ? OH_ARCHIVE_MEM_ERROR : OH_ARCHIVE_DEFLATE_ERROR;
+        }
+        state->inflateInited = true;
+    } else if (inflateReset(&state->inflateStream) != Z_OK) {
+        return OH_ARCHIVE_DEFLATE_ERROR;
+    }
+    /* a raw stream takes its dictionary up front */
+    if (ctx->dict != NULL && inflateSetDictionary(&state->inflateStream, ctx->dict, ctx->dictSize) != Z_OK) {
+        return OH_ARCHIVE_DEFLATE_ERROR;
+    }
+    return OH_ARCHIVE_OK;
+}
+
+static OH_Archive_ErrCode CodecCompressOne(OH_Archive_Codec_Ctx ctx, CodecState *state, uint8_t *dst,
+    uint64_t *dstSize, const uint8_t *src, uint64_t srcSize)
+{
+    uint64_t dstLeft = *dstSize;
+    *dstSize = 0;
+    OH_Archive_ErrCode ret = CodecPrepareDeflate(ctx, state);
+    if (ret != OH_ARCHIVE_OK) {
+        return ret;
+    }
+
+    z_stream *stream = &state->deflateStream;
+    stream->next_out = dst;
+    stream->next_in = (z_const Bytef *)src;
+    stream->avail_out = 0;
+    stream->avail_in = 0;
+    uint64_t produced = 0;
+    int err;
+    do {
+        CodecNext(stream, &dstLeft, &srcSize);
+        uInt availOutBefore = stream->avail_out;
+        err = deflate(stream, srcSize != 0 ? Z_NO_FLUSH : Z_FINISH);
+        produced += (uint64_t)(availOutBefore - stream->avail_out);
+    } while (err == Z_OK);
+
+    *dstSize = produced;
+    if (err == Z_STREAM_END) {
+        return OH_ARCHIVE_OK;
+    }
+    return err == Z_BUF_ERROR ? OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR : OH_ARCHIVE_DEFLATE_ERROR;
+}
+
+/* Same rules as OH_Archive_BufferRead: the input may end without a final block once it is all consumed */
+static OH_Archive_ErrCode CodecDecompressOne(OH_Archive_Codec_Ctx ctx, CodecState *state, uint8_t *dst,
+    uint64_t *dstSize, const uint8_t *src, uint64_t srcSize)
+{
+    uint64_t dstLeft = *dstSize;
+    *dstSize = 0;
+    OH_Archive_ErrCode ret = CodecPrepareInflate(ctx, state);
+    if (ret != OH_ARCHIVE_OK) {
+        return ret;
+    }
+
+    z_stream *stream = &state->inflateStream;
+    stream->next_out = dst;
+    stream->next_in = (z_const Bytef *)src;
+    stream->avail_out = 0;
+    stream->avail_in = 0;
+    uint64_t produced = 0;
+    int err;
+    do {
+        CodecNext(stream, &dstLeft, &srcSize);
+        uInt availOutBefore = stream->avail_out;
+        err = inflate(stream, Z_NO_FLUSH);
+        produced += (uint64_t)(availOutBefore - stream->avail_out);
+    } while (err == Z_OK);
+
+    *dstSize = produced;
+    if (err == Z_STREAM_END) {
+        return OH_ARCHIVE_OK;
+    }
+    if (err != Z_BUF_ERROR) {
+        return OH_ARCHIVE_DEFLATE_ERROR;
+    }
+    if (stream->avail_out == 0 && dstLeft == 0) {
+        return OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR;
+    }
+    return (stream->avail_in == 0 && srcSize == 0) ? OH_ARCHIVE_OK : OH_ARCHIVE_DEFLATE_ERROR;
+}
+
+static OH_Archive_ErrCode CodecRunOne(OH_Archive_Codec_Ctx ctx, CodecState *state, bool compress,
+    OH_Archive_Codec_Buffer *buffer)
+{
+    if (buffer->srcBuffer == NULL || buffer->dstBuffer == NULL || buffer->srcSize == 0) {
+        buffer->dstSize = 0;
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+    if (compress) {
+        return CodecCompressOne(ctx, state, buffer->dstBuffer, &buffer->dstSize, buffer->srcBuffer, buffer->srcSize);
+    }
+    return CodecDecompressOne(ctx, state, buffer->dstBuffer, &buffer->dstSize, buffer->srcBuffer, buffer->srcSize);
+}
+
+static void CodecRunBatch(CodecBatch *batch, CodecState *state)
+{
+    while (true) {
+        uint64_t index = atomic_fetch_add(&batch->nextIndex, 1);
+        if (index >= batch->count) {
+            break;
+        }
+        OH_Archive_Codec_Buffer *buffer = &batch->buffers[index];
+        buffer->result = CodecRunOne(batch->ctx, state, batch->compress, buffer);
+    }
+}
+
+static void *CodecWorkerRoutine(void *arg)
+{
+    CodecWorker *worker = (CodecWorker *)arg;
+    CodecRunBatch(worker->batch, worker->state);
+    return NULL;
+}
+
+static OH_Archive_ErrCode CodecBatchProcess(OH_Archive_Codec_Ctx ctx, OH_Archive_Codec_Buffer *buffers,
+    uint64_t count, uint32_t threadNum, bool compress)
+{
+    if (ctx == NULL || buffers == NULL || count == 0 || threadNum > CODEC_MAX_THREAD_NUM) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+    CodecBatch batch = {.ctx = ctx, .buffers = buffers, .count = count, .compress = compress};
+    atomic_init(&batch.nextIndex, 0);
+    uint64_t workerNum = threadNum > 1 ? threadNum - 1 : 0;
+    if (workerNum > count - 1) {
+        workerNum = count - 1;
+    }
+
+    pthread_t threads[CODEC_MAX_THREAD_NUM];
+    CodecWorker workers[CODEC_MAX_THREAD_NUM];
+    uint64_t started = 0;
+    for (; started < workerNum; started++) {
+        workers[started].batch = &batch;
+        workers[started].state = &ctx->states[started + 1];
+        if (pthread_create(&threads[started], NULL, CodecWorkerRoutine, &workers[started]) != 0) {
+            break;
+        }
+    }
+    /* the calling thread takes its share, and everything when no worker could start */
+    CodecRunBatch(&batch, &ctx->states[0]);
+    for (uint64_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        if (buffers[i].result != OH_ARCHIVE_OK) {
+            return buffers[i].result;
+        }
+    }
+    return OH_ARCHIVE_OK;
+}
+
+ARCHIVE_API OH_Archive_Codec_Ctx OH_Archive_Codec_Create(OH_Archive_CompressMethod method, int32_t compressLevel)
+{
+    if (method != OH_ARCHIVE_COMPRESS_DEFLATE || compressLevel < CODEC_MIN_LEVEL || compressLevel > CODEC_MAX_LEVEL) {
+        return NULL;
+    }
+    OH_Archive_Codec_Ctx ctx = calloc(1, sizeof(struct ArchiveCodecCtx));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    ctx->level = compressLevel;
+    return ctx;
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Codec_SetDictionary(OH_Archive_Codec_Ctx ctx, const uint8_t *dict,
+    uint32_t dictSize)
+{
+    if (ctx == NULL || (dict == NULL && dictSize != 0) || (dict != NULL && dictSize == 0)) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+    uint8_t *copy = NULL;
+    if (dict != NULL) {
+        /* deflate only looks back 32K, so only the tail of a longer dictionary matters */
+        if (dictSize > CODEC_MAX_DICT_SIZE) {
+            dict += dictSize - CODEC_MAX_DICT_SIZE;
+            dictSize = CODEC_MAX_DICT_SIZE;
+        }
+        copy = malloc(dictSize);
+        if (copy == NULL) {
+            return OH_ARCHIVE_MEM_ERROR;
+        }
+        if (memcpy_s(copy, dictSize, dict, dictSize) != EOK) {
+            free(copy);
+            return OH_ARCHIVE_MEM_ERROR;
+        }
+    }
+    free(ctx->dict);
+    ctx->dict = copy;
+    ctx->dictSize = dictSize;
+    return OH_ARCHIVE_OK;
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Codec_Compress(OH_Archive_Codec_Ctx ctx, uint8_t *dstBuffer,
+    uint64_t *dstSize, const uint8_t *srcBuffer, uint64_t srcSize)
+{
+    if (ctx == NULL || dstBuffer == NULL || dstSize == NULL || srcBuffer == NULL || srcSize == 0) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+    return CodecCompressOne(ctx, &ctx->states[0], dstBuffer, dstSize, srcBuffer, srcSize);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Codec_Decompress(OH_Archive_Codec_Ctx ctx, uint8_t *dstBuffer,
+    uint64_t *dstSize, const uint8_t *srcBuffer, uint64_t srcSize)
+{
+    if (ctx == NULL || dstBuffer == NULL || dstSize == NULL || srcBuffer == NULL || srcSize == 0) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+    return CodecDecompressOne(ctx, &ctx->states[0], dstBuffer, dstSize, srcBuffer, srcSize);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Codec_CompressBatch(OH_Archive_Codec_Ctx ctx,
+    OH_Archive_Codec_Buffer *buffers, uint64_t count, uint32_t threadNum)
+{
+    return CodecBatchProcess(ctx, buffers, count, threadNum, true);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Codec_DecompressBatch(OH_Archive_Codec_Ctx ctx,
+    OH_Archive_Codec_Buffer *buffers, uint64_t count, uint32_t threadNum)
+{
+    return CodecBatchProcess(ctx, buffers, count, threadNum, false);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Codec_Reset(OH_Archive_Codec_Ctx ctx)
+{
+    if (ctx == NULL) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+    for (int i = 0; i < CODEC_MAX_THREAD_NUM; i++) {
+        CodecState *state = &ctx->states[i];
+        if (state->deflateInited) {
+            (void)deflateReset(&state->deflateStream);
+        }
+        if (state->inflateInited) {
+            (void)inflateReset(&state->inflateStream);
+        }
+    }
+    free(ctx->dict);
+    ctx->dict = NULL;
+    ctx->dictSize = 0;
+    return OH_ARCHIVE_OK;
+}
+
+ARCHIVE_API void OH_Archive_Codec_Destroy(OH_Archive_Codec_Ctx ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+    for (int i = 0; i < CODEC_MAX_THREAD_NUM; i++) {
+        CodecState *state = &ctx->states[i];
+        if (state->deflateInited) {
+            (void)deflateEnd(&state->deflateStream);
+        }
+        if (state->inflateInited) {
+            (void)inflateEnd(&state->inflateStream);
+        }
+    }
+    free(ctx->dict);
+    free(ctx);
+}
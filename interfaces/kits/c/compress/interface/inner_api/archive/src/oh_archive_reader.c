@@ -22,8 +22,17 @@
 #include <ctype.h>
 #include <stdatomic.h>
 #include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <utime.h>
+#include <sys/stat.h>
 #include "oh_archive_plugin.h"
 #include "errorcode.h"
+#include "file/stream_file.h"
+#include "checksum/archive_crc32.h"
+#include "zip_stream_reader.h"
+#include "securec.h"
 
 extern const FmtReaderOps g_ZipReaderFmtOps;
 const FmtReaderOps *g_AllFmtReaderOps[] = {
@@ -32,6 +41,26 @@ const FmtReaderOps *g_AllFmtReaderOps[] = {
     NULL
 };
 
+extern const FmtReaderIndexOps g_ZipReaderIndexOps;
+const FmtReaderIndexOps *g_AllFmtReaderIndexOps[] = {
+    &g_ZipReaderIndexOps,
+    NULL,
+    NULL
+};
+
+#define READER_EXTRACT_MAX_THREAD_NUM (16)
+
+typedef struct {
+    int fd;
+    int error;
+} FdOutputData;
+
+typedef struct {
+    uint8_t *buffer;
+    uint64_t capacity;
+    uint64_t size;
+} BufferOutputData;
+
 static uint8_t CheckSuffix(const char *a, const char *b)
 {
     while (1) {
@@ -111,11 +140,15 @@ static OH_Archive_ErrCode ConvertErrCode(int ret)
     return OH_ARCHIVE_UNKNOWN_ERROR;
 }
 
-ARCHIVE_API OH_Archive_Reader_Ctx OH_Archive_Reader_OpenFile(const char *inFile)
+static OH_Archive_Reader_Ctx ReaderOpenFile(const char *inFile, const OH_Archive_FileIoOptions *options)
 {
     if (inFile == NULL) {
         return NULL;
     }
+    if (options != NULL && ((options->ioMode != OH_ARCHIVE_FILE_IO_DEFAULT &&
+        options->ioMode != OH_ARCHIVE_FILE_IO_MAPPED) || options->bufferSize > FILE_STREAM_MAX_BUFFER_SIZE)) {
+        return NULL;
+    }
 
     ArchiveFormat fmt = GetFileArchiveFormat(inFile);
     if (fmt != ARCHIVE_FMT_ZIP) {
@@ -127,11 +160,15 @@ ARCHIVE_API OH_Archive_Reader_Ctx OH_Archive_Reader_OpenFile(const char *inFile)
         return NULL;
     }
     archive->fmtOps = g_AllFmtReaderOps[fmt];
+    if (options != NULL) {
+        archive->fileIoMode = (uint32_t)options->ioMode;
+        archive->fileIoBufferSize = options->bufferSize;
+    }
 
-    // dlopen hispeed
+    // dlopen hispeed, which does its own file I/O, so mapped I/O stays with the built-in reader
 #if defined(__aarch64__) || defined(_M_ARM64)
     const HispeedArchivePlugin* plugin = GetHispeedArchivePluginHandle();
-    if (plugin != NULL) {
+    if (plugin != NULL && archive->fileIoMode == OH_ARCHIVE_FILE_IO_DEFAULT) {
         archive->fmtOps = plugin->HSDZipReaderFmtOps;
     }
 #endif
@@ -145,10 +182,31 @@ ARCHIVE_API OH_Archive_Reader_Ctx OH_Archive_Reader_OpenFile(const char *inFile)
         free(archive);
         return NULL;
     }
-    
+
+    // a plugin reader would parse the archive a second time for the index, so that waits for the entry APIs
+    archive->indexOps = g_AllFmtReaderIndexOps[fmt];
+    if (archive->indexOps != NULL) {
+        archive->indexPath = strdup(inFile);
+        if (archive->indexPath == NULL) {
+            archive->indexOps = NULL;
+        }
+    }
+    pthread_mutex_init(&archive->indexLock, NULL);
+
     return (OH_Archive_Reader_Ctx)&archive->archive;
 }
 
+ARCHIVE_API OH_Archive_Reader_Ctx OH_Archive_Reader_OpenFile(const char *inFile)
+{
+    return ReaderOpenFile(inFile, NULL);
+}
+
+ARCHIVE_API OH_Archive_Reader_Ctx OH_Archive_Reader_OpenFileWithOptions(const char *inFile,
+    const OH_Archive_FileIoOptions *options)
+{
+    return ReaderOpenFile(inFile, options);
+}
+
 ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_SetProgressHandlerWithData(OH_Archive_Reader_Ctx arc,
     OH_Archive_ProgressHandlerWithData progressHandler, void *userData)
 {
@@ -162,6 +220,31 @@ ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_SetProgressHandlerWithData(OH_A
     return OH_ARCHIVE_OK;
 }
 
+// Whether the archive is served by a built-in format reader rather than the hispeed plugin
+static bool ReaderIsBuiltIn(const HmArchiveReadInfo *archive)
+{
+    for (size_t i = 0; i < sizeof(g_AllFmtReaderOps) / sizeof(g_AllFmtReaderOps[0]); i++) {
+        if (g_AllFmtReaderOps[i] != NULL && archive->fmtOps == g_AllFmtReaderOps[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_SetExtractThreadNum(OH_Archive_Reader_Ctx arc, uint32_t threadNum)
+{
+    if (arc == NULL || threadNum > READER_EXTRACT_MAX_THREAD_NUM) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    HmArchiveReadInfo *archive = (HmArchiveReadInfo *)arc;
+    if (!ReaderIsBuiltIn(archive)) {
+        return OH_ARCHIVE_UNSUPPORTED_ERROR;
+    }
+    archive->extractThreadNum = threadNum;
+    return OH_ARCHIVE_OK;
+}
+
 ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_ExtractAllFile(OH_Archive_Reader_Ctx arc, const char *outDir)
 {
     if (arc == NULL || outDir == NULL) {
@@ -191,6 +274,178 @@ ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_ExtractAllFile(OH_Archive_Reade
     return ConvertErrCode(archive->fmtOps->extract(archive, resolvedPath));
 }
 
+// Opens the entry index on first use, without an index only the entry APIs are unavailable
+static int ReaderOpenIndex(HmArchiveReadInfo *archive)
+{
+    pthread_mutex_lock(&archive->indexLock);
+    if (!archive->indexOpened) {
+        if (archive->indexOps != NULL && archive->indexOps->open(archive, archive->indexPath) != ARCHIVE_OK) {
+            archive->indexOps = NULL;
+        }
+        free(archive->indexPath);
+        archive->indexPath = NULL;
+        archive->indexOpened = true;
+    }
+    pthread_mutex_unlock(&archive->indexLock);
+    return archive->indexOps == NULL ? ARCHIVE_SUPPORT_ERROR : ARCHIVE_OK;
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_GetEntryCount(OH_Archive_Reader_Ctx arc, uint64_t *count)
+{
+    if (arc == NULL || count == NULL) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    HmArchiveReadInfo *archive = (HmArchiveReadInfo *)arc;
+    if (ReaderOpenIndex(archive) != ARCHIVE_OK) {
+        return OH_ARCHIVE_UNSUPPORTED_ERROR;
+    }
+    return ConvertErrCode(archive->indexOps->getEntryCount(archive, count));
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_GetEntryInfo(OH_Archive_Reader_Ctx arc, uint64_t index,
+    OH_Archive_EntryInfo *info)
+{
+    if (arc == NULL || info == NULL) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    HmArchiveReadInfo *archive = (HmArchiveReadInfo *)arc;
+    if (ReaderOpenIndex(archive) != ARCHIVE_OK) {
+        return OH_ARCHIVE_UNSUPPORTED_ERROR;
+    }
+    return ConvertErrCode(archive->indexOps->getEntryInfo(archive, index, info));
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_FindEntry(OH_Archive_Reader_Ctx arc, const char *name,
+    uint64_t *index)
+{
+    if (arc == NULL || name == NULL || index == NULL) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    HmArchiveReadInfo *archive = (HmArchiveReadInfo *)arc;
+    if (ReaderOpenIndex(archive) != ARCHIVE_OK) {
+        return OH_ARCHIVE_UNSUPPORTED_ERROR;
+    }
+    return ConvertErrCode(archive->indexOps->findEntry(archive, name, index));
+}
+
+static int ExtractEntry(OH_Archive_Reader_Ctx arc, uint64_t index, const FmtReaderEntrySink *sink)
+{
+    HmArchiveReadInfo *archive = (HmArchiveReadInfo *)arc;
+    if (ReaderOpenIndex(archive) != ARCHIVE_OK) {
+        return ARCHIVE_SUPPORT_ERROR;
+    }
+    return archive->indexOps->extractEntry(archive, index, sink);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_ExtractEntryToFile(OH_Archive_Reader_Ctx arc, uint64_t index,
+    const char *outPath)
+{
+    if (arc == NULL || outPath == NULL) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    if (strlen(outPath) >= PATH_MAX) {
+        return OH_ARCHIVE_FULL_PATH_TOO_LONG_ERROR;
+    }
+
+    FmtReaderEntrySink sink = {.outPath = outPath};
+    return ConvertErrCode(ExtractEntry(arc, index, &sink));
+}
+
+static uint64_t FdOutputHandler(const void *data, uint64_t size, void *userData)
+{
+    FdOutputData *output = (FdOutputData *)userData;
+    uint64_t written = 0;
+    while (written < size) {
+        ssize_t ret = write(output->fd, (const uint8_t *)data + written, size - written);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            output->error = errno;
+            break;
+        }
+        written += (uint64_t)ret;
+    }
+    return written;
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_ExtractEntryToFd(OH_Archive_Reader_Ctx arc, uint64_t index, int fd)
+{
+    if (arc == NULL || fd < 0) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    FdOutputData output = {.fd = fd, .error = 0};
+    FmtReaderEntrySink sink = {.handler = FdOutputHandler, .userData = &output};
+    int ret = ExtractEntry(arc, index, &sink);
+    if (ret == ARCHIVE_WRITE_ERROR && output.error == ENOSPC) {
+        return OH_ARCHIVE_NO_SPACE_ERROR;
+    }
+    return ConvertErrCode(ret);
+}
+
+static uint64_t BufferOutputHandler(const void *data, uint64_t size, void *userData)
+{
+    BufferOutputData *output = (BufferOutputData *)userData;
+    if (size > output->capacity - output->size) {
+        return 0;
+    }
+    if (memcpy_s(output->buffer + output->size, size, data, size) != EOK) {
+        return 0;
+    }
+    output->size += size;
+    return size;
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_ExtractEntryToBuffer(OH_Archive_Reader_Ctx arc, uint64_t index,
+    uint8_t *buffer, uint64_t *size)
+{
+    if (arc == NULL || buffer == NULL || size == NULL) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    OH_Archive_EntryInfo info;
+    OH_Archive_ErrCode errCode = OH_Archive_Reader_GetEntryInfo(arc, index, &info);
+    if (errCode != OH_ARCHIVE_OK) {
+        return errCode;
+    }
+    if (info.uncompressedSize > *size) {
+        *size = info.uncompressedSize;
+        return OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR;
+    }
+
+    BufferOutputData output = {.buffer = buffer, .capacity = *size, .size = 0};
+    FmtReaderEntrySink sink = {.handler = BufferOutputHandler, .userData = &output};
+    int ret = ExtractEntry(arc, index, &sink);
+    // the central directory understated the entry size
+    if (ret == ARCHIVE_WRITE_ERROR) {
+        return OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR;
+    }
+    if (ret == ARCHIVE_OK) {
+        *size = output.size;
+    }
+    return ConvertErrCode(ret);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_ExtractEntryToStream(OH_Archive_Reader_Ctx arc, uint64_t index,
+    OH_Archive_Stream_OutputHandler outputHandler, void *userData)
+{
+    if (arc == NULL || outputHandler == NULL) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    FmtReaderEntrySink sink = {.handler = outputHandler, .userData = userData};
+    int ret = ExtractEntry(arc, index, &sink);
+    if (ret == ARCHIVE_WRITE_ERROR) {
+        return OH_ARCHIVE_STREAM_OUTPUT_ERROR;
+    }
+    return ConvertErrCode(ret);
+}
+
 ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_Close(OH_Archive_Reader_Ctx arc)
 {
     if (arc == NULL) {
@@ -199,9 +454,14 @@ ARCHIVE_API OH_Archive_ErrCode OH_Archive_Reader_Close(OH_Archive_Reader_Ctx arc
 
     OH_Archive_ErrCode ret = OH_ARCHIVE_OK;
     HmArchiveReadInfo *archive = (HmArchiveReadInfo *)arc;
+    if (archive->indexOpened && archive->indexOps != NULL) {
+        (void)archive->indexOps->close(archive);
+    }
     if (archive->fmtOps != NULL && archive->fmtOps->close != NULL) {
         ret = ConvertErrCode(archive->fmtOps->close(archive));
     }
+    free(archive->indexPath);
+    pthread_mutex_destroy(&archive->indexLock);
 
     if (archive != NULL) {
         free(arc);
@@ -349,7 +609,7 @@ static OH_Archive_ErrCode StreamReadHandle(OH_Archive_StreamRead_Ctx ctx)
     }
 
     if (ctx->checksum == OH_ARCHIVE_CRC32) {
-        ctx->crc = crc32(ctx->crc, ctx->outBuf, outBufLen);
+        ctx->crc = ArchiveCrc32(ctx->crc, ctx->outBuf, outBufLen);
     }
     ctx->totalOutSize += outBufLen;
     return OH_ARCHIVE_OK;
@@ -428,3 +688,190 @@ ARCHIVE_API void OH_Archive_StreamRead_Destroy(OH_Archive_StreamRead_Ctx ctx)
     return;
 }
 
+ARCHIVE_API OH_Archive_ZipStreamRead_Ctx OH_Archive_ZipStreamRead_Create(void)
+{
+    OH_Archive_ZipStreamRead_Ctx ctx = calloc(1, sizeof(struct ArchiveZipStreamReadCtx));
+    if (ctx == NULL) {
+        return NULL;
+    }
+
+    ctx->reader = ZipStreamReaderCreate();
+    if (ctx->reader == NULL) {
+        free(ctx);
+        return NULL;
+    }
+    ctx->outFd = -1;
+    return ctx;
+}
+
+static int ZipStreamDirOpenFile(OH_Archive_ZipStreamRead_Ctx ctx, const char *path)
+{
+    int ret = CreateParentDirectory(path, NULL);
+    RETURN_IF_FAIL(ret);
+    if (IsFileExists(path) == ARCHIVE_OK) {
+        ret = GenerateNewFilename(path, ctx->outPath, sizeof(ctx->outPath));
+    } else {
+        ret = strcpy_s(ctx->outPath, sizeof(ctx->outPath), path) == EOK ? ARCHIVE_OK : ARCHIVE_FULL_PATH_TOO_LONG;
+    }
+    RETURN_IF_FAIL(ret);
+
+    ctx->outFd = open(ctx->outPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (ctx->outFd < 0) {
+        return errno == EACCES ? ARCHIVE_EACCES_ERROR : ARCHIVE_OPEN_ERROR;
+    }
+    return ARCHIVE_OK;
+}
+
+static int ZipStreamDirEntryStart(const ZipStreamEntry *entry, void *userData)
+{
+    OH_Archive_ZipStreamRead_Ctx ctx = (OH_Archive_ZipStreamRead_Ctx)userData;
+    char path[ZIP_FILE_NAME_LEN_MAX];
+    int ret = GetOutputFilePath(entry->info.name, ctx->outDir, path, sizeof(path));
+    RETURN_IF_FAIL(ret);
+    if (entry->info.isDirectory) {
+        return CreateDirectory(path, NULL);
+    }
+    return ZipStreamDirOpenFile(ctx, path);
+}
+
+static int ZipStreamDirEntryData(const uint8_t *data, size_t size, void *userData)
+{
+    OH_Archive_ZipStreamRead_Ctx ctx = (OH_Archive_ZipStreamRead_Ctx)userData;
+    if (ctx->outFd < 0) {
+        return ARCHIVE_OK;
+    }
+    FdOutputData output = {.fd = ctx->outFd, .error = 0};
+    if (FdOutputHandler(data, size, &output) != size) {
+        ctx->writeError = output.error;
+        return ARCHIVE_WRITE_ERROR;
+    }
+    return ARCHIVE_OK;
+}
+
+static void ZipStreamDirEntryEnd(const ZipStreamEntry *entry, int result, void *userData)
+{
+    OH_Archive_ZipStreamRead_Ctx ctx = (OH_Archive_ZipStreamRead_Ctx)userData;
+    if (ctx->outFd < 0) {
+        return;
+    }
+    (void)close(ctx->outFd);
+    ctx->outFd = -1;
+    if (result != ARCHIVE_OK) {
+        // 解压失败时删除当前未解压完的文件
+        (void)unlink(ctx->outPath);
+        return;
+    }
+    struct utimbuf ut = {.actime = time(NULL), .modtime = entry->modifiedTime};
+    (void)utime(ctx->outPath, &ut);
+}
+
+static int ZipStreamHandlerEntryStart(const ZipStreamEntry *entry, void *userData)
+{
+    OH_Archive_ZipStreamRead_Ctx ctx = (OH_Archive_ZipStreamRead_Ctx)userData;
+    if (ctx->entryHandler != NULL &&
+        ctx->entryHandler(&entry->info, ctx->userData) == OH_ARCHIVE_PROGRESS_CANCEL) {
+        return ARCHIVE_CANCEL_ERROR;
+    }
+    return ARCHIVE_OK;
+}
+
+static int ZipStreamHandlerEntryData(const uint8_t *data, size_t size, void *userData)
+{
+    OH_Archive_ZipStreamRead_Ctx ctx = (OH_Archive_ZipStreamRead_Ctx)userData;
+    if (ctx->outputHandler(data, size, ctx->userData) != size) {
+        ctx->outputFailed = true;
+        return ARCHIVE_WRITE_ERROR;
+    }
+    return ARCHIVE_OK;
+}
+
+static OH_Archive_ErrCode ZipStreamReadStart(OH_Archive_ZipStreamRead_Ctx ctx, const ZipStreamReaderSink *sink)
+{
+    ctx->writeError = 0;
+    ctx->outputFailed = false;
+    int ret = ZipStreamReaderStart(ctx->reader, sink);
+    ctx->started = ret == ARCHIVE_OK;
+    return ConvertErrCode(ret);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_ZipStreamRead_StartToDir(OH_Archive_ZipStreamRead_Ctx ctx,
+    const char *outDir)
+{
+    if (ctx == NULL || outDir == NULL || outDir[0] == '\0') {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    char *dir = strdup(outDir);
+    if (dir == NULL) {
+        return OH_ARCHIVE_MEM_ERROR;
+    }
+    free(ctx->outDir);
+    ctx->outDir = dir;
+    ZipStreamReaderSink sink = {
+        .entryStart = ZipStreamDirEntryStart,
+        .entryData = ZipStreamDirEntryData,
+        .entryEnd = ZipStreamDirEntryEnd,
+        .userData = ctx,
+    };
+    return ZipStreamReadStart(ctx, &sink);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_ZipStreamRead_Start(OH_Archive_ZipStreamRead_Ctx ctx,
+    OH_Archive_ZipStream_EntryHandler entryHandler, OH_Archive_Stream_OutputHandler outputHandler, void *userData)
+{
+    if (ctx == NULL || outputHandler == NULL) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    ctx->entryHandler = entryHandler;
+    ctx->outputHandler = outputHandler;
+    ctx->userData = userData;
+    ZipStreamReaderSink sink = {
+        .entryStart = ZipStreamHandlerEntryStart,
+        .entryData = ZipStreamHandlerEntryData,
+        .entryEnd = NULL,
+        .userData = ctx,
+    };
+    return ZipStreamReadStart(ctx, &sink);
+}
+
+static OH_Archive_ErrCode ZipStreamReadConvertErrCode(OH_Archive_ZipStreamRead_Ctx ctx, int ret)
+{
+    if (ret == ARCHIVE_WRITE_ERROR && ctx->outputFailed) {
+        return OH_ARCHIVE_STREAM_OUTPUT_ERROR;
+    }
+    if (ret == ARCHIVE_WRITE_ERROR && ctx->writeError == ENOSPC) {
+        return OH_ARCHIVE_NO_SPACE_ERROR;
+    }
+    return ConvertErrCode(ret);
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_ZipStreamRead_Update(OH_Archive_ZipStreamRead_Ctx ctx,
+    const uint8_t *data, uint64_t size)
+{
+    if (ctx == NULL || data == NULL || size == 0 || !ctx->started) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    return ZipStreamReadConvertErrCode(ctx, ZipStreamReaderUpdate(ctx->reader, data, (size_t)size));
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_ZipStreamRead_End(OH_Archive_ZipStreamRead_Ctx ctx, uint64_t *entryCount)
+{
+    if (ctx == NULL || !ctx->started) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+
+    return ZipStreamReadConvertErrCode(ctx, ZipStreamReaderFinish(ctx->reader, entryCount));
+}
+
+ARCHIVE_API void OH_Archive_ZipStreamRead_Destroy(OH_Archive_ZipStreamRead_Ctx ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+
+    ZipStreamReaderDestroy(ctx->reader);
+    free(ctx->outDir);
+    free(ctx);
+}
@@ -16,6 +16,7 @@
 #ifndef OH_ARCHIVE_READER_H
 #define OH_ARCHIVE_READER_H
 
+#include <pthread.h>
 #include "archive_inner.h"
 #include "oh_archive.h"
 #include "zlib.h"
@@ -37,12 +38,46 @@ typedef struct {
     FmtReaderCloseFunc close;
 } FmtReaderOps;
 
+// Where a single entry is extracted to: a file when outPath is set, otherwise each decoded chunk goes to handler
+typedef struct {
+    const char *outPath;
+    OH_Archive_Stream_OutputHandler handler;
+    void *userData;
+} FmtReaderEntrySink;
+
+typedef int (*FmtReaderIndexOpenFunc)(HmArchiveReadInfo *archive, const char *inFile);
+typedef int (*FmtReaderGetEntryCountFunc)(HmArchiveReadInfo *archive, uint64_t *count);
+typedef int (*FmtReaderGetEntryInfoFunc)(HmArchiveReadInfo *archive, uint64_t index, OH_Archive_EntryInfo *info);
+typedef int (*FmtReaderFindEntryFunc)(HmArchiveReadInfo *archive, const char *name, uint64_t *index);
+typedef int (*FmtReaderExtractEntryFunc)(HmArchiveReadInfo *archive, uint64_t index, const FmtReaderEntrySink *sink);
+
+// Random access over the entries of an archive, always served by the built-in format reader
+typedef struct {
+    FmtReaderIndexOpenFunc open;
+    FmtReaderGetEntryCountFunc getEntryCount;
+    FmtReaderGetEntryInfoFunc getEntryInfo;
+    FmtReaderFindEntryFunc findEntry;
+    FmtReaderExtractEntryFunc extractEntry;
+    FmtReaderCloseFunc close;
+} FmtReaderIndexOps;
+
 struct HmArchiveReadInfoS {
     struct HmArchiveS archive;
     OH_Archive_ProgressHandlerWithData progressHandlerWithData;
     void *progressHandlerData;
     const FmtReaderOps *fmtOps;
     void *fmtInfo;
+    const FmtReaderIndexOps *indexOps;
+    void *indexInfo;
+    // the index is opened on the first entry API call, indexPath is kept until then
+    char *indexPath;
+    bool indexOpened;
+    pthread_mutex_t indexLock;
+    // file stream backend and its buffer size, see OH_Archive_FileIoOptions
+    uint32_t fileIoMode;
+    uint32_t fileIoBufferSize;
+    // threads of OH_Archive_Reader_ExtractAllFile, 0 and 1 extract on the calling thread
+    uint32_t extractThreadNum;
 };
 
 struct ArchiveStreamReadCtx {
@@ -58,6 +93,23 @@ struct ArchiveStreamReadCtx {
     uint64_t totalOutSize;
 };
 
+struct ZipStreamReader;
+
+struct ArchiveZipStreamReadCtx {
+    struct ZipStreamReader *reader;
+    bool started;
+    // directory mode: outDir is set and the current file entry is written to outFd
+    char *outDir;
+    char outPath[ZIP_FILE_NAME_LEN_MAX];
+    int outFd;
+    int writeError;
+    // callback mode
+    OH_Archive_ZipStream_EntryHandler entryHandler;
+    OH_Archive_Stream_OutputHandler outputHandler;
+    void *userData;
+    bool outputFailed;
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,7 @@
  */
 
 #include <errno.h>
+#include <pthread.h>
 #include <securec.h>
 #include <stdatomic.h>
 #include <stddef.h>
@@ -23,6 +24,7 @@
 #include "oh_archive.h"
 #include "oh_archive_plugin.h"
 #include "zlib.h"
+#include "checksum/archive_crc32.h"
 
 #define DEFLATE_DEFAULT_MEM_LEVEL (8)
 #define DEFLATE_DEFAULT_LEVEL (6)
@@ -36,6 +38,8 @@
 
 #define DEFLATE_BLOCK_SIZE_THRESHOLD (32 * 1024)
 #define DEFLATE_BUFFER_BLOCK_SIZE (64 * 1024)
+#define DEFLATE_DICT_SIZE (32 * 1024)
+#define DEFLATE_MAX_WORKER_NUM (16)
 
 #if defined(__aarch64__) || defined(_M_ARM64)
 #ifndef LOAD_ARCHIVE_PLUGIN
@@ -45,6 +49,51 @@
 
 typedef OH_Archive_ErrCode (*PushDataRoutine)(OH_Archive_StreamWrite_Ctx ctx, const uint8_t *data, uint64_t size);
 
+typedef enum {
+    DEFLATE_BLOCK_FREE = 0,
+    DEFLATE_BLOCK_QUEUED,
+    DEFLATE_BLOCK_DONE,
+} DeflateBlockState;
+
+/* One blockSize slice of the input, compressed independently and written out in sequence order. */
+typedef struct DeflateBlock {
+    DeflateBlockState state;
+    int last;
+    int level;
+    OH_Archive_ErrCode result;
+    uint8_t *in;
+    uint64_t inLen;
+    uint8_t *dict;
+    uint64_t dictLen;
+    uint8_t *out;
+    uint64_t outSize;
+    uint64_t outLen;
+    uint32_t crc32;
+    struct DeflateBlock *next;
+} DeflateBlock;
+
+/*
+ * Block pool shared by the caller and the deflate workers. Block seq lives in slot seq % blockNum, so a slot is
+ * reused only after its previous block has been written out. Each block is primed with the last 32K of the
+ * preceding block as dictionary and ends on a sync flush, so the concatenated output is a single raw deflate stream.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t workCond;
+    pthread_cond_t doneCond;
+    pthread_t *workers;
+    int workerNum;
+    int exiting;
+    DeflateBlock *blocks;
+    uint32_t blockNum;
+    DeflateBlock *queueHead;
+    DeflateBlock *queueTail;
+    DeflateBlock *filling;
+    uint64_t nextSeq;
+    uint64_t emitSeq;
+    uint32_t busyNum;
+} ParallelDeflate;
+
 typedef enum {
     W_STREAM_CREATED = 0,
     W_STREAM_STARTED,
@@ -63,6 +112,7 @@ struct ArchiveStreamWriteCtx {
     uint32_t crc32;
 
     PushDataRoutine pushDataRoutine;
+    ParallelDeflate *parallel;
 
     z_stream zstream;
     _Atomic WriteStreamState state;
@@ -121,12 +171,318 @@ static OH_Archive_ErrCode PushDataSequential(OH_Archive_StreamWrite_Ctx ctx, con
     strm->avail_in = size;
     ctx->totalIn += size;
     if (ctx->config.checksum == OH_ARCHIVE_CRC32) {
-        ctx->crc32 = crc32(ctx->crc32, data, size);
+        ctx->crc32 = ArchiveCrc32(ctx->crc32, data, size);
     }
 
     return FlushInternalData(ctx, Z_NO_FLUSH);
 }
 
+static OH_Archive_ErrCode DeflateBlockData(z_stream *strm, int *strmLevel, DeflateBlock *block, int checksum)
+{
+    if (deflateReset(strm) != Z_OK) {
+        return OH_ARCHIVE_DEFLATE_ERROR;
+    }
+    if (*strmLevel != block->level) {
+        if (deflateParams(strm, block->level, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return OH_ARCHIVE_DEFLATE_ERROR;
+        }
+        *strmLevel = block->level;
+    }
+    if (block->dictLen > 0 && deflateSetDictionary(strm, block->dict, block->dictLen) != Z_OK) {
+        return OH_ARCHIVE_DEFLATE_ERROR;
+    }
+    strm->next_in = block->in;
+    strm->avail_in = block->inLen;
+    strm->next_out = block->out;
+    strm->avail_out = block->outSize;
+    int ret = deflate(strm, block->last ? Z_FINISH : Z_SYNC_FLUSH);
+    if (block->last ? (ret != Z_STREAM_END) : (ret != Z_OK || strm->avail_in != 0 || strm->avail_out == 0)) {
+        ARCHIVE_ERR("deflate block failed, ret is %d\n", ret);
+        return OH_ARCHIVE_DEFLATE_ERROR;
+    }
+    block->outLen = block->outSize - strm->avail_out;
+    if (checksum == OH_ARCHIVE_CRC32) {
+        block->crc32 = ArchiveCrc32(0, block->in, block->inLen);
+    }
+    return OH_ARCHIVE_OK;
+}
+
+static void *ParallelDeflateWorker(void *arg)
+{
+    OH_Archive_StreamWrite_Ctx ctx = (OH_Archive_StreamWrite_Ctx)arg;
+    ParallelDeflate *pd = ctx->parallel;
+    z_stream strm;
+    memset_s(&strm, sizeof(z_stream), 0, sizeof(z_stream));
+    int strmLevel = DEFLATE_DEFAULT_LEVEL;
+    int strmReady = deflateInit2(&strm, strmLevel, Z_DEFLATED, -MAX_WBITS, DEFLATE_DEFAULT_MEM_LEVEL,
+                                 Z_DEFAULT_STRATEGY) == Z_OK;
+
+    pthread_mutex_lock(&pd->lock);
+    while (!pd->exiting) {
+        DeflateBlock *block = pd->queueHead;
+        if (block == NULL) {
+            pthread_cond_wait(&pd->workCond, &pd->lock);
+            continue;
+        }
+        pd->queueHead = block->next;
+        if (pd->queueHead == NULL) {
+            pd->queueTail = NULL;
+        }
+        pthread_mutex_unlock(&pd->lock);
+
+        if (atomic_load(&ctx->result) != OH_ARCHIVE_OK) {
+            block->result = ctx->result;
+        } else if (!strmReady) {
+            block->result = OH_ARCHIVE_MEM_ERROR;
+        } else {
+            block->result = DeflateBlockData(&strm, &strmLevel, block, ctx->config.checksum);
+        }
+
+        pthread_mutex_lock(&pd->lock);
+        block->state = DEFLATE_BLOCK_DONE;
+        pd->busyNum--;
+        pthread_cond_broadcast(&pd->doneCond);
+    }
+    pthread_mutex_unlock(&pd->lock);
+    if (strmReady) {
+        (void)deflateEnd(&strm);
+    }
+    return NULL;
+}
+
+static OH_Archive_ErrCode WriteDeflateBlock(OH_Archive_StreamWrite_Ctx ctx, DeflateBlock *block)
+{
+    if (block->result != OH_ARCHIVE_OK) {
+        return block->result;
+    }
+    if (block->outLen > 0) {
+        uint64_t len = ctx->writeCallback(block->out, block->outLen, ctx->userData);
+        if (len != block->outLen) {
+            return OH_ARCHIVE_STREAM_OUTPUT_ERROR;
+        }
+        ctx->totalOut += block->outLen;
+    }
+    if (ctx->config.checksum == OH_ARCHIVE_CRC32) {
+        ctx->crc32 = ArchiveCrc32Combine(ctx->crc32, block->crc32, block->inLen);
+    }
+    return OH_ARCHIVE_OK;
+}
+
+/* Writes out finished blocks in order, waiting for unfinished ones until every block before waitSeq is written. */
+static OH_Archive_ErrCode DrainDeflateBlocks(OH_Archive_StreamWrite_Ctx ctx, uint64_t waitSeq)
+{
+    ParallelDeflate *pd = ctx->parallel;
+    while (pd->emitSeq < pd->nextSeq) {
+        DeflateBlock *block = &pd->blocks[pd->emitSeq % pd->blockNum];
+        pthread_mutex_lock(&pd->lock);
+        while (block->state != DEFLATE_BLOCK_DONE && pd->emitSeq < waitSeq &&
+               atomic_load(&ctx->result) == OH_ARCHIVE_OK) {
+            pthread_cond_wait(&pd->doneCond, &pd->lock);
+        }
+        int done = block->state == DEFLATE_BLOCK_DONE;
+        pthread_mutex_unlock(&pd->lock);
+        if (atomic_load(&ctx->result) != OH_ARCHIVE_OK) {
+            return ctx->result;
+        }
+        if (!done) {
+            break;
+        }
+        OH_Archive_ErrCode ret = WriteDeflateBlock(ctx, block);
+        if (ret != OH_ARCHIVE_OK) {
+            atomic_store(&ctx->result, ret);
+            return ret;
+        }
+        block->state = DEFLATE_BLOCK_FREE;
+        pd->emitSeq++;
+    }
+    return OH_ARCHIVE_OK;
+}
+
+static OH_Archive_ErrCode AcquireFillingBlock(OH_Archive_StreamWrite_Ctx ctx, DeflateBlock **filling)
+{
+    ParallelDeflate *pd = ctx->parallel;
+    if (pd->filling == NULL) {
+        if (pd->nextSeq - pd->emitSeq >= pd->blockNum) {
+            OH_Archive_ErrCode ret = DrainDeflateBlocks(ctx, pd->nextSeq - pd->blockNum + 1);
+            if (ret != OH_ARCHIVE_OK) {
+                return ret;
+            }
+        }
+        DeflateBlock *block = &pd->blocks[pd->nextSeq % pd->blockNum];
+        block->inLen = 0;
+        block->dictLen = 0;
+        block->outLen = 0;
+        block->crc32 = 0;
+        block->result = OH_ARCHIVE_OK;
+        if (pd->nextSeq > 0) {
+            const DeflateBlock *prev = &pd->blocks[(pd->nextSeq - 1) % pd->blockNum];
+            block->dictLen = prev->inLen < DEFLATE_DICT_SIZE ? prev->inLen : DEFLATE_DICT_SIZE;
+            (void)memcpy_s(block->dict, DEFLATE_DICT_SIZE, prev->in + prev->inLen - block->dictLen, block->dictLen);
+        }
+        pd->filling = block;
+    }
+    *filling = pd->filling;
+    return OH_ARCHIVE_OK;
+}
+
+static void SubmitDeflateBlock(OH_Archive_StreamWrite_Ctx ctx, DeflateBlock *block, int last)
+{
+    ParallelDeflate *pd = ctx->parallel;
+    block->last = last;
+    block->level = ctx->level;
+    block->next = NULL;
+    pthread_mutex_lock(&pd->lock);
+    block->state = DEFLATE_BLOCK_QUEUED;
+    if (pd->queueTail != NULL) {
+        pd->queueTail->next = block;
+    } else {
+        pd->queueHead = block;
+    }
+    pd->queueTail = block;
+    pd->busyNum++;
+    pthread_cond_signal(&pd->workCond);
+    pthread_mutex_unlock(&pd->lock);
+    pd->filling = NULL;
+    pd->nextSeq++;
+}
+
+static OH_Archive_ErrCode PushDataParallel(OH_Archive_StreamWrite_Ctx ctx, const uint8_t *data, uint64_t size)
+{
+    ctx->totalIn += size;
+    while (size > 0) {
+        DeflateBlock *block = NULL;
+        OH_Archive_ErrCode ret = AcquireFillingBlock(ctx, &block);
+        if (ret != OH_ARCHIVE_OK) {
+            return ret;
+        }
+        uint64_t copyLen = ctx->config.blockSize - block->inLen;
+        copyLen = copyLen < size ? copyLen : size;
+        (void)memcpy_s(block->in + block->inLen, ctx->config.blockSize - block->inLen, data, copyLen);
+        block->inLen += copyLen;
+        data += copyLen;
+        size -= copyLen;
+        if (block->inLen == ctx->config.blockSize) {
+            SubmitDeflateBlock(ctx, block, 0);
+        }
+    }
+    return DrainDeflateBlocks(ctx, 0);
+}
+
+static OH_Archive_ErrCode FinishParallelDeflate(OH_Archive_StreamWrite_Ctx ctx)
+{
+    if (atomic_load(&ctx->result) != OH_ARCHIVE_OK) {
+        return ctx->result;
+    }
+    DeflateBlock *block = NULL;
+    OH_Archive_ErrCode ret = AcquireFillingBlock(ctx, &block);
+    if (ret != OH_ARCHIVE_OK) {
+        return ret;
+    }
+    SubmitDeflateBlock(ctx, block, 1);
+    return DrainDeflateBlocks(ctx, ctx->parallel->nextSeq);
+}
+
+/* Waits for in-flight blocks, e.g. left over by a cancel, and rewinds the pool for a new stream. */
+static void ResetParallelDeflate(ParallelDeflate *pd)
+{
+    pthread_mutex_lock(&pd->lock);
+    while (pd->busyNum > 0) {
+        pthread_cond_wait(&pd->doneCond, &pd->lock);
+    }
+    for (uint32_t i = 0; i < pd->blockNum; i++) {
+        pd->blocks[i].state = DEFLATE_BLOCK_FREE;
+    }
+    pd->queueHead = NULL;
+    pd->queueTail = NULL;
+    pthread_mutex_unlock(&pd->lock);
+    pd->filling = NULL;
+    pd->nextSeq = 0;
+    pd->emitSeq = 0;
+}
+
+static void WakeParallelDeflate(ParallelDeflate *pd)
+{
+    pthread_mutex_lock(&pd->lock);
+    pthread_cond_broadcast(&pd->doneCond);
+    pthread_mutex_unlock(&pd->lock);
+}
+
+static void DestroyParallelDeflate(ParallelDeflate *pd)
+{
+    if (pd == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&pd->lock);
+    pd->exiting = 1;
+    pthread_cond_broadcast(&pd->workCond);
+    pthread_mutex_unlock(&pd->lock);
+    for (int i = 0; i < pd->workerNum; i++) {
+        pthread_join(pd->workers[i], NULL);
+    }
+    if (pd->blocks != NULL) {
+        for (uint32_t i = 0; i < pd->blockNum; i++) {
+            free(pd->blocks[i].in);
+            free(pd->blocks[i].dict);
+            free(pd->blocks[i].out);
+        }
+    }
+    pthread_cond_destroy(&pd->doneCond);
+    pthread_cond_destroy(&pd->workCond);
+    pthread_mutex_destroy(&pd->lock);
+    free(pd->blocks);
+    free(pd->workers);
+    free(pd);
+}
+
+static int AllocDeflateBlocks(ParallelDeflate *pd, uint32_t blockSize)
+{
+    pd->blocks = (DeflateBlock *)calloc(pd->blockNum, sizeof(DeflateBlock));
+    if (pd->blocks == NULL) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < pd->blockNum; i++) {
+        DeflateBlock *block = &pd->blocks[i];
+        block->outSize = OUT_BUF_SIZE((uint64_t)blockSize);
+        block->in = (uint8_t *)malloc(blockSize);
+        block->dict = (uint8_t *)malloc(DEFLATE_DICT_SIZE);
+        block->out = (uint8_t *)malloc(block->outSize);
+        if (block->in == NULL || block->dict == NULL || block->out == NULL) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Starts threadNum deflate workers; any failure leaves the ctx on the sequential path. */
+static void CreateParallelDeflate(OH_Archive_StreamWrite_Ctx ctx)
+{
+    int workerNum = ctx->config.threadNum < DEFLATE_MAX_WORKER_NUM ? ctx->config.threadNum : DEFLATE_MAX_WORKER_NUM;
+    ParallelDeflate *pd = (ParallelDeflate *)calloc(1, sizeof(ParallelDeflate));
+    if (pd == NULL) {
+        return;
+    }
+    pthread_mutex_init(&pd->lock, NULL);
+    pthread_cond_init(&pd->workCond, NULL);
+    pthread_cond_init(&pd->doneCond, NULL);
+    pd->blockNum = MEM_BLOCK_NUM(workerNum);
+    pd->workers = (pthread_t *)calloc(workerNum, sizeof(pthread_t));
+    if (pd->workers == NULL || AllocDeflateBlocks(pd, ctx->config.blockSize) != 0) {
+        ARCHIVE_ERR("parallel deflate pool create failed\n");
+        DestroyParallelDeflate(pd);
+        return;
+    }
+    ctx->parallel = pd;
+    for (; pd->workerNum < workerNum; pd->workerNum++) {
+        if (pthread_create(&pd->workers[pd->workerNum], NULL, ParallelDeflateWorker, ctx) != 0) {
+            ARCHIVE_ERR("parallel deflate worker create failed\n");
+            ctx->parallel = NULL;
+            DestroyParallelDeflate(pd);
+            return;
+        }
+    }
+    ctx->pushDataRoutine = PushDataParallel;
+}
+
 static void InitStreamWriteCtx(OH_Archive_StreamWrite_Ctx ctx, OH_Archive_Stream_Config *config)
 {
     ctx->result = OH_ARCHIVE_OK;
@@ -134,6 +490,10 @@ static void InitStreamWriteCtx(OH_Archive_StreamWrite_Ctx ctx, OH_Archive_Stream
     ctx->state = W_STREAM_CREATED;
     ctx->bufSize = config->blockSize;
     ctx->pushDataRoutine = PushDataSequential;
+    ctx->parallel = NULL;
+    if (config->threadNum > 1) {
+        CreateParallelDeflate(ctx);
+    }
 }
 
 EXPORT_API OH_Archive_StreamWrite_Ctx OH_Archive_StreamWrite_Create(OH_Archive_Stream_Config config)
@@ -198,7 +558,6 @@ EXPORT_API OH_Archive_ErrCode OH_Archive_StreamWrite_SetCompressLevel(OH_Archive
         return OH_ARCHIVE_PARAM_ERROR;
     }
     ctx->level = compressLevel;
-    ctx->pushDataRoutine = PushDataSequential;
 
     return OH_ARCHIVE_OK;
 }
@@ -218,6 +577,9 @@ EXPORT_API OH_Archive_ErrCode OH_Archive_StreamWrite_Cancel(OH_Archive_StreamWri
 
     atomic_store(&ctx->result, OH_ARCHIVE_CANCEL_ERROR);
     deflateReset(&ctx->zstream);
+    if (ctx->parallel != NULL) {
+        WakeParallelDeflate(ctx->parallel);
+    }
     atomic_store(&ctx->state, W_STREAM_CANCELED);
     return OH_ARCHIVE_OK;
 }
@@ -240,6 +602,9 @@ EXPORT_API OH_Archive_ErrCode OH_Archive_StreamWrite_Start(OH_Archive_StreamWrit
     if (deflateReset(&ctx->zstream) != Z_OK) {
         return OH_ARCHIVE_DEFLATE_ERROR;
     }
+    if (ctx->parallel != NULL) {
+        ResetParallelDeflate(ctx->parallel);
+    }
     ctx->zstream.next_out = ctx->buf;
     ctx->zstream.avail_out = ctx->bufSize;
 
@@ -286,16 +651,24 @@ EXPORT_API OH_Archive_ErrCode OH_Archive_StreamWrite_End(OH_Archive_StreamWrite_
     if (ctx->state != W_STREAM_STARTED && ctx->state != W_STREAM_CANCELED) {
         return OH_ARCHIVE_PARAM_ERROR;
     }
-    int result = FlushInternalData(ctx, Z_FINISH);
-    if (result != OH_ARCHIVE_OK) {
-        return result;
-    }
-    uint64_t remainedSize = ctx->bufSize - ctx->zstream.avail_out;
-    uint64_t len = ctx->writeCallback(ctx->buf, remainedSize, ctx->userData);
-    if (len != remainedSize) {
-        return OH_ARCHIVE_STREAM_OUTPUT_ERROR;
+    int result = OH_ARCHIVE_OK;
+    if (ctx->parallel != NULL) {
+        result = FinishParallelDeflate(ctx);
+        if (result != OH_ARCHIVE_OK) {
+            return result;
+        }
+    } else {
+        result = FlushInternalData(ctx, Z_FINISH);
+        if (result != OH_ARCHIVE_OK) {
+            return result;
+        }
+        uint64_t remainedSize = ctx->bufSize - ctx->zstream.avail_out;
+        uint64_t len = ctx->writeCallback(ctx->buf, remainedSize, ctx->userData);
+        if (len != remainedSize) {
+            return OH_ARCHIVE_STREAM_OUTPUT_ERROR;
+        }
+        ctx->totalOut += remainedSize;
     }
-    ctx->totalOut += remainedSize;
 
     if (compressInfo != NULL) {
         compressInfo->totalInSize = ctx->totalIn;
@@ -316,6 +689,8 @@ EXPORT_API void OH_Archive_StreamWrite_Destroy(OH_Archive_StreamWrite_Ctx ctx)
     if (ctx == NULL) {
         return;
     }
+    DestroyParallelDeflate(ctx->parallel);
+    ctx->parallel = NULL;
     free(ctx->buf);
     ctx->buf = NULL;
     deflateEnd(&ctx->zstream);
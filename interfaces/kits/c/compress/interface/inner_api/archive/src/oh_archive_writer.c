@@ -18,6 +18,7 @@
 #include "archive_macros.h"
 #include "archive_inner.h"
 #include "zip_util.h"
+#include "file/stream_file.h"
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -25,6 +26,7 @@
 #include <ctype.h>
 #define ARCHIVE_DEFAULT_COMPRESS_LEVEL (6)
 #define ARCHIVE_MAX_COMPRESS_LEVEL (9)
+#define ARCHIVE_MAX_SAVING_PERCENT (100)
 const FmtWriterOps *g_AllFmtWriterOps[] = {
     &g_ZipWriterFmtOps,
     NULL,
@@ -78,14 +80,17 @@ static void LoadArchiveWriterFunc(OH_Archive_Writer_Ctx ctx)
     ctx->fmtOps = zipWriterOps;
 }
 
-ARCHIVE_API OH_Archive_Writer_Ctx OH_Archive_Writer_OpenFile(const char *outfile,
-                                                             OH_Archive_OpenMode openMode,
-                                                             OH_Archive_Format fmt)
+static OH_Archive_Writer_Ctx WriterOpenFile(const char *outfile, OH_Archive_OpenMode openMode,
+                                            OH_Archive_Format fmt, const OH_Archive_FileIoOptions *options)
 {
     if (outfile == NULL) {
         return NULL;
     }
-    if (openMode != OH_ARCHIVE_OPEN_MODE_CREATE) {
+    if (options != NULL && ((options->ioMode != OH_ARCHIVE_FILE_IO_DEFAULT &&
+        options->ioMode != OH_ARCHIVE_FILE_IO_MAPPED) || options->bufferSize > FILE_STREAM_MAX_BUFFER_SIZE)) {
+        return NULL;
+    }
+    if (openMode != OH_ARCHIVE_OPEN_MODE_CREATE && openMode != OH_ARCHIVE_OPEN_MODE_APPEND) {
         return NULL;
     }
     
@@ -98,7 +103,15 @@ ARCHIVE_API OH_Archive_Writer_Ctx OH_Archive_Writer_OpenFile(const char *outfile
         return NULL;
     }
     archive->append = openMode;
-    LoadArchiveWriterFunc(archive);
+    if (options != NULL) {
+        archive->fileIoMode = (uint32_t)options->ioMode;
+        archive->fileIoBufferSize = options->bufferSize;
+    }
+    // append rewrites an existing archive in place, only the built-in writer is known to preserve it, and the
+    // plugin does its own file I/O, so mapped I/O stays with the built-in writer too
+    if (openMode == OH_ARCHIVE_OPEN_MODE_CREATE && archive->fileIoMode == OH_ARCHIVE_FILE_IO_DEFAULT) {
+        LoadArchiveWriterFunc(archive);
+    }
     if (archive->fmtOps == NULL) {
         const FmtWriterOps *writerOps = g_AllFmtWriterOps[fmt];
         if (writerOps == NULL) {
@@ -124,6 +137,21 @@ ARCHIVE_API OH_Archive_Writer_Ctx OH_Archive_Writer_OpenFile(const char *outfile
     return archive;
 }
 
+ARCHIVE_API OH_Archive_Writer_Ctx OH_Archive_Writer_OpenFile(const char *outfile,
+                                                             OH_Archive_OpenMode openMode,
+                                                             OH_Archive_Format fmt)
+{
+    return WriterOpenFile(outfile, openMode, fmt, NULL);
+}
+
+ARCHIVE_API OH_Archive_Writer_Ctx OH_Archive_Writer_OpenFileWithOptions(const char *outfile,
+                                                                        OH_Archive_OpenMode openMode,
+                                                                        OH_Archive_Format fmt,
+                                                                        const OH_Archive_FileIoOptions *options)
+{
+    return WriterOpenFile(outfile, openMode, fmt, options);
+}
+
 ARCHIVE_API OH_Archive_ErrCode OH_Archive_Writer_SetCompressMethod(OH_Archive_Writer_Ctx arc,
                                                                    OH_Archive_CompressMethod method,
                                                                    int32_t compressLevel)
@@ -158,6 +186,63 @@ OH_Archive_ErrCode OH_Archive_Writer_SetProgressHandlerWithData(OH_Archive_Write
     return OH_ARCHIVE_OK;
 }
 
+// Whether the archive is written by a built-in format writer rather than the hispeed plugin
+static bool WriterIsBuiltIn(OH_Archive_Writer_Ctx arc)
+{
+    for (size_t i = 0; i < sizeof(g_AllFmtWriterOps) / sizeof(g_AllFmtWriterOps[0]); i++) {
+        if (g_AllFmtWriterOps[i] != NULL && arc->fmtOps == g_AllFmtWriterOps[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void FreeStoreExtensions(OH_Archive_Writer_Ctx arc)
+{
+    for (uint32_t i = 0; i < arc->storeExtensionNum; i++) {
+        free(arc->storeExtensions[i]);
+    }
+    free(arc->storeExtensions);
+    arc->storeExtensions = NULL;
+    arc->storeExtensionNum = 0;
+}
+
+ARCHIVE_API OH_Archive_ErrCode OH_Archive_Writer_SetAutoStore(OH_Archive_Writer_Ctx arc, uint32_t minSavingPercent,
+                                                              const char **storeExtensions, uint32_t extensionNum)
+{
+    if (arc == NULL || minSavingPercent > ARCHIVE_MAX_SAVING_PERCENT || (extensionNum > 0 && storeExtensions == NULL)) {
+        return OH_ARCHIVE_PARAM_ERROR;
+    }
+    for (uint32_t i = 0; i < extensionNum; i++) {
+        if (storeExtensions[i] == NULL || storeExtensions[i][0] == '\0') {
+            return OH_ARCHIVE_PARAM_ERROR;
+        }
+    }
+    // the plugin writer picks the method of each entry itself
+    if (!WriterIsBuiltIn(arc)) {
+        return OH_ARCHIVE_UNSUPPORTED_ERROR;
+    }
+
+    FreeStoreExtensions(arc);
+    if (extensionNum > 0) {
+        arc->storeExtensions = (char **)calloc(extensionNum, sizeof(char *));
+        if (arc->storeExtensions == NULL) {
+            return OH_ARCHIVE_MEM_ERROR;
+        }
+    }
+    for (uint32_t i = 0; i < extensionNum; i++) {
+        arc->storeExtensions[i] = strdup(storeExtensions[i]);
+        if (arc->storeExtensions[i] == NULL) {
+            arc->storeExtensionNum = extensionNum;
+            FreeStoreExtensions(arc);
+            return OH_ARCHIVE_MEM_ERROR;
+        }
+    }
+    arc->storeExtensionNum = extensionNum;
+    arc->minSavingPercent = minSavingPercent;
+    return OH_ARCHIVE_OK;
+}
+
 ARCHIVE_API OH_Archive_ErrCode OH_Archive_Writer_Add(OH_Archive_Writer_Ctx arc,
                                                      const char** infiles,
                                                      uint64_t fileNum)
@@ -186,6 +271,7 @@ ARCHIVE_API OH_Archive_ErrCode OH_Archive_Writer_Close(OH_Archive_Writer_Ctx arc
         ret = WriteConvertErrCode(arc->fmtOps->close(arc));
     }
 
+    FreeStoreExtensions(arc);
     free(arc);
     return ret;
 }
\ No newline at end of file
@@ -39,6 +39,13 @@ struct ArchiveWriteCtx {
     const FmtWriterOps *fmtOps;
     void *fmtInfo;
     int append;
+    // auto store, minimum trial deflate saving in percent and extensions that are never deflated
+    uint32_t minSavingPercent;
+    char **storeExtensions;
+    uint32_t storeExtensionNum;
+    // file stream backend and its buffer size, see OH_Archive_FileIoOptions
+    uint32_t fileIoMode;
+    uint32_t fileIoBufferSize;
 };
 
 #endif
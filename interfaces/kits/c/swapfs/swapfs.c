@@ -68,6 +68,26 @@ __attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_SwapIn(
     return SwapfsNativeSwapIn(manager, request, readSize);
 }
 
+__attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_MapIn(
+    OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsMapView *view)
+{
+    if (manager == NULL || view == NULL) {
+        LogNullPointer(__func__);
+        return SWAPFS_E_INVAL;
+    }
+    return SwapfsNativeMapIn(manager, keyId, view);
+}
+
+__attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_UnmapView(
+    OH_SwapfsManager *manager, OH_SwapfsMapView *view)
+{
+    if (manager == NULL || view == NULL) {
+        LogNullPointer(__func__);
+        return SWAPFS_E_INVAL;
+    }
+    return SwapfsNativeUnmapView(manager, view);
+}
+
 __attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_QueryData(
     OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsDataInfo *info)
 {
@@ -88,6 +108,36 @@ __attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_GetStats(
     return SwapfsNativeGetStats(manager, stats);
 }
 
+__attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_SetEvictionConfig(
+    OH_SwapfsManager *manager, const OH_SwapfsEvictionConfig *config)
+{
+    if (manager == NULL || config == NULL) {
+        LogNullPointer(__func__);
+        return SWAPFS_E_INVAL;
+    }
+    return SwapfsNativeSetEvictionConfig(manager, config);
+}
+
+__attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_QueryAccessInfo(
+    OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsAccessInfo *info)
+{
+    if (manager == NULL || info == NULL) {
+        LogNullPointer(__func__);
+        return SWAPFS_E_INVAL;
+    }
+    return SwapfsNativeQueryAccessInfo(manager, keyId, info);
+}
+
+__attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_GetEvictionStats(
+    OH_SwapfsManager *manager, OH_SwapfsEvictionStats *stats)
+{
+    if (manager == NULL || stats == NULL) {
+        LogNullPointer(__func__);
+        return SWAPFS_E_INVAL;
+    }
+    return SwapfsNativeGetEvictionStats(manager, stats);
+}
+
 __attribute__((visibility("default"))) OH_Swapfs_ErrCode OH_Swapfs_RemoveData(
     OH_SwapfsManager *manager, uint64_t keyId)
 {
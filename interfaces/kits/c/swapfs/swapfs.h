@@ -38,8 +38,25 @@ typedef enum OH_SwapfsDisableReason {
     OH_SWAPFS_DISABLE_REASON_NOSPC = 1,
 } OH_SwapfsDisableReason;
 
+typedef enum OH_SwapfsEvictionPolicy {
+    /* Managed-cache mode off: SwapOut fails once spaceLimitBytes is reached. */
+    OH_SWAPFS_EVICTION_NONE = 0,
+    /* Evict the least recently swapped-in key first. */
+    OH_SWAPFS_EVICTION_LRU = 1,
+    /* Evict the least frequently swapped-in key first, oldest access breaking ties. */
+    OH_SWAPFS_EVICTION_LFU = 2,
+    /* Evict the largest key first, oldest access breaking ties. */
+    OH_SWAPFS_EVICTION_SIZE = 3,
+} OH_SwapfsEvictionPolicy;
+
 typedef struct OH_SwapfsManager OH_SwapfsManager;
 
+/*
+ * Invoked on the SwapOut thread, without internal locks held, for every key dropped by eviction.
+ * The callback may call back into the manager but must not destroy it.
+ */
+typedef void (*OH_SwapfsEvictionCallback)(uint64_t keyId, uint64_t dataSize, void *userData);
+
 typedef struct OH_SwapfsConfig {
     /* Base path. Swapfs stores data in its fixed "swapfs" child directory. */
     const char *swapRootPath;
@@ -47,6 +64,17 @@ typedef struct OH_SwapfsConfig {
     bool useDirectIo;
 } OH_SwapfsConfig;
 
+/*
+ * Managed-cache settings applied by OH_Swapfs_SetEvictionConfig. When a SwapOut reaches
+ * spaceLimitBytes, idle keys are evicted in policy order until the new data fits.
+ */
+typedef struct OH_SwapfsEvictionConfig {
+    OH_SwapfsEvictionPolicy policy;
+    /* Optional, may be NULL. */
+    OH_SwapfsEvictionCallback onEvicted;
+    void *userData;
+} OH_SwapfsEvictionConfig;
+
 typedef struct OH_SwapfsSwapOutRequest {
     const void *buffer;
     uint64_t bufferSize;
@@ -58,6 +86,17 @@ typedef struct OH_SwapfsSwapInRequest {
     uint64_t bufferSize;
 } OH_SwapfsSwapInRequest;
 
+/*
+ * Read-only mapping of a key's data returned by OH_Swapfs_MapIn. While the view is mapped the key
+ * is pinned: RemoveData is deferred until OH_Swapfs_UnmapView, and RemoveAllData and
+ * DestroyManager report SWAPFS_E_BUSY. Pages are faulted in lazily and bypass useDirectIo.
+ */
+typedef struct OH_SwapfsMapView {
+    uint64_t keyId;
+    const void *data;
+    uint64_t dataSize;
+} OH_SwapfsMapView;
+
 typedef struct OH_SwapfsDataInfo {
     uint64_t keyId;
     uint64_t dataSize;
@@ -67,6 +106,13 @@ typedef struct OH_SwapfsDataInfo {
     bool canSwapIn;
 } OH_SwapfsDataInfo;
 
+typedef struct OH_SwapfsAccessInfo {
+    uint64_t keyId;
+    /* Time of the last SwapIn or MapIn, the creation time when the key was never read. */
+    int64_t lastAccessTime;
+    uint64_t accessCount;
+} OH_SwapfsAccessInfo;
+
 typedef struct OH_SwapfsStats {
     uint64_t totalKeys;
     uint64_t totalDataSize;
@@ -79,6 +125,11 @@ typedef struct OH_SwapfsStats {
     uint64_t availableDeviceSpace;
 } OH_SwapfsStats;
 
+typedef struct OH_SwapfsEvictionStats {
+    uint64_t evictedKeys;
+    uint64_t evictedBytes;
+} OH_SwapfsEvictionStats;
+
 OH_Swapfs_ErrCode OH_Swapfs_CreateManager(
     const OH_SwapfsConfig *config, OH_SwapfsManager **manager);
 OH_Swapfs_ErrCode OH_Swapfs_DestroyManager(OH_SwapfsManager *manager);
@@ -86,9 +137,18 @@ OH_Swapfs_ErrCode OH_Swapfs_SwapOut(
     OH_SwapfsManager *manager, const OH_SwapfsSwapOutRequest *request, uint64_t *keyId);
 OH_Swapfs_ErrCode OH_Swapfs_SwapIn(
     OH_SwapfsManager *manager, const OH_SwapfsSwapInRequest *request, uint64_t *readSize);
+OH_Swapfs_ErrCode OH_Swapfs_MapIn(
+    OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsMapView *view);
+OH_Swapfs_ErrCode OH_Swapfs_UnmapView(OH_SwapfsManager *manager, OH_SwapfsMapView *view);
 OH_Swapfs_ErrCode OH_Swapfs_QueryData(
     OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsDataInfo *info);
 OH_Swapfs_ErrCode OH_Swapfs_GetStats(OH_SwapfsManager *manager, OH_SwapfsStats *stats);
+/* Eviction is off until a policy other than OH_SWAPFS_EVICTION_NONE is set. */
+OH_Swapfs_ErrCode OH_Swapfs_SetEvictionConfig(
+    OH_SwapfsManager *manager, const OH_SwapfsEvictionConfig *config);
+OH_Swapfs_ErrCode OH_Swapfs_QueryAccessInfo(
+    OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsAccessInfo *info);
+OH_Swapfs_ErrCode OH_Swapfs_GetEvictionStats(OH_SwapfsManager *manager, OH_SwapfsEvictionStats *stats);
 OH_Swapfs_ErrCode OH_Swapfs_RemoveData(OH_SwapfsManager *manager, uint64_t keyId);
 OH_Swapfs_ErrCode OH_Swapfs_RemoveAllData(OH_SwapfsManager *manager);
 
@@ -131,17 +131,12 @@ int64_t FsStat::GetCtimeNs()
 #if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
 int32_t FsStat::GetLocation()
 {
-    std::unique_ptr<char[]> value = CreateUniquePtr<char[]>(MAX_ATTR_NAME);
-    if (value == nullptr) {
-        HILOGE("Getxattr memory out, errno is %{public}d", errno);
-        return ENOMEM;
-    }
-
+    char value[MAX_ATTR_NAME];
     ssize_t size = 0;
     if (entity->fileInfo_->isPath) {
-        size = getxattr(entity->fileInfo_->path.get(), CLOUD_LOCATION_ATTR.c_str(), value.get(), MAX_ATTR_NAME);
+        size = getxattr(entity->fileInfo_->path.get(), CLOUD_LOCATION_ATTR.c_str(), value, sizeof(value));
     } else {
-        size = fgetxattr(entity->fileInfo_->fdg->GetFD(), CLOUD_LOCATION_ATTR.c_str(), value.get(), MAX_ATTR_NAME);
+        size = fgetxattr(entity->fileInfo_->fdg->GetFD(), CLOUD_LOCATION_ATTR.c_str(), value, sizeof(value));
     }
 
     Location defaultLocation = LOCAL;
@@ -151,7 +146,7 @@ int32_t FsStat::GetLocation()
         }
         return static_cast<int32_t>(defaultLocation);
     }
-    std::string location = string(value.get(), static_cast<size_t>(size));
+    std::string location = string(value, static_cast<size_t>(size));
     if (!std::all_of(location.begin(), location.end(), ::isdigit)) {
         HILOGE("Getxattr location is not all digit!");
         return static_cast<int32_t>(defaultLocation);
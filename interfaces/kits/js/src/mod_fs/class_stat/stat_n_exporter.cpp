@@ -28,6 +28,9 @@
 #include "file_fs_trace.h"
 #include "file_utils.h"
 #include "filemgmt_libhilog.h"
+#if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+#include "metadata_cache.h"
+#endif
 
 namespace OHOS::FileManagement::ModuleFileIO {
 using namespace std;
@@ -314,6 +317,31 @@ napi_value StatNExporter::GetCtimeNs(napi_env env, napi_callback_info info)
 }
 
 #if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+static int32_t ReadLocation(const FileInfo &fileInfo)
+{
+    char value[MAX_ATTR_NAME];
+    ssize_t size = 0;
+    if (fileInfo.isPath) {
+        size = getxattr(fileInfo.path.get(), CLOUD_LOCATION_ATTR.c_str(), value, sizeof(value));
+    } else {
+        size = fgetxattr(fileInfo.fdg->GetFD(), CLOUD_LOCATION_ATTR.c_str(), value, sizeof(value));
+    }
+    Location defaultLocation = LOCAL;
+    if (size <= 0) {
+        if (errno != ENODATA && errno != EOPNOTSUPP) {
+            HILOGE("Getxattr value failed, errno is %{public}d", errno);
+        }
+        return static_cast<int32_t>(defaultLocation);
+    }
+    std::string location = string(value, static_cast<size_t>(size));
+    if (!std::all_of(location.begin(), location.end(), ::isdigit)) {
+        HILOGE("Getxattr location is not all digit!");
+        return static_cast<int32_t>(defaultLocation);
+    }
+    defaultLocation = static_cast<Location>(atoi(location.c_str()));
+    return static_cast<int32_t>(defaultLocation);
+}
+
 napi_value StatNExporter::GetLocation(napi_env env, napi_callback_info info)
 {
     NFuncArg funcArg(env, info);
@@ -328,33 +356,13 @@ napi_value StatNExporter::GetLocation(napi_env env, napi_callback_info info)
         HILOGE("Failed to get stat entity");
         return nullptr;
     }
-    std::unique_ptr<char[]> value = CreateUniquePtr<char[]>(MAX_ATTR_NAME);
-    if (value == nullptr) {
-        HILOGE("Getxattr memory out, errno is %{public}d", errno);
-        NError(ENOMEM).ThrowErr(env);
-        return nullptr;
+    const FileInfo &fileInfo = *statEntity->fileInfo_;
+    auto &cache = MetadataCache::GetInstance();
+    if (fileInfo.isPath && cache.IsEnabled()) {
+        int32_t location = cache.GetLocation(fileInfo.path.get(), [&fileInfo]() { return ReadLocation(fileInfo); });
+        return NVal::CreateInt32(env, location).val_;
     }
-
-    ssize_t size = 0;
-    if (statEntity->fileInfo_->isPath) {
-        size = getxattr(statEntity->fileInfo_->path.get(), CLOUD_LOCATION_ATTR.c_str(), value.get(), MAX_ATTR_NAME);
-    } else {
-        size = fgetxattr(statEntity->fileInfo_->fdg->GetFD(), CLOUD_LOCATION_ATTR.c_str(), value.get(), MAX_ATTR_NAME);
-    }
-    Location defaultLocation = LOCAL;
-    if (size <= 0) {
-        if (errno != ENODATA && errno != EOPNOTSUPP) {
-            HILOGE("Getxattr value failed, errno is %{public}d", errno);
-        }
-        return NVal::CreateInt32(env, static_cast<int32_t>(defaultLocation)).val_;
-    }
-    std::string location = string(value.get(), static_cast<size_t>(size));
-    if (!std::all_of(location.begin(), location.end(), ::isdigit)) {
-        HILOGE("Getxattr location is not all digit!");
-        return NVal::CreateInt32(env, static_cast<int32_t>(defaultLocation)).val_;
-    }
-    defaultLocation = static_cast<Location>(atoi(location.c_str()));
-    return NVal::CreateInt32(env, static_cast<int32_t>(defaultLocation)).val_;
+    return NVal::CreateInt32(env, ReadLocation(fileInfo)).val_;
 }
 #endif
 
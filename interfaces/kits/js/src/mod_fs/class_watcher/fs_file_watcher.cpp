@@ -47,6 +47,7 @@ bool FsFileWatcher::InitNotify()
         notifyFd_ = -1;
         return false;
     }
+    notifyGeneration_++;
     return true;
 }
 
@@ -193,12 +194,15 @@ void FsFileWatcher::ReadNotifyEvent()
 {
     int32_t len = 0;
     uint32_t index = 0;
-    char buf[BUF_SIZE] = { 0 };
     struct inotify_event *event = nullptr;
     uint32_t eventSize = static_cast<uint32_t>(sizeof(struct inotify_event));
+    if (readBuf_.empty()) {
+        readBuf_.resize(BUF_SIZE);
+    }
+    char *buf = readBuf_.data();
 
     do {
-        len = read(notifyFd_, &buf, sizeof(buf));
+        len = read(notifyFd_, buf, readBuf_.size());
         if (len < 0 && errno != EINTR) {
             HILOGE("Read notify event failed! ret: %d", errno);
             break;
@@ -266,33 +270,39 @@ void FsFileWatcher::GetNotifyEvent()
     run_ = true;
     nfds_t nfds = 2;
     struct pollfd fds[2] = { { -1 } };
-    fds[0].fd = eventFd_;
-    fds[0].events = POLLIN;
-    fds[1].fd = notifyFd_;
-    fds[1].events = POLLIN;
+    uint64_t generation = 0;
     int32_t ret = 0;
 
-    while (run_) {
-        ret = poll(fds, nfds, pollTimeoutMs);
-        if (ret > 0) {
-            if (static_cast<unsigned short>(fds[0].revents) & POLLNVAL) {
-                run_ = false;
-                break;
-            }
-            if (static_cast<unsigned short>(fds[0].revents) & POLLIN) {
-                run_ = false;
+    do {
+        {
+            lock_guard<mutex> lock(notifyMutex_);
+            generation = notifyGeneration_;
+            fds[0].fd = eventFd_;
+            fds[0].events = POLLIN;
+            fds[1].fd = notifyFd_;
+            fds[1].events = POLLIN;
+        }
+        while (run_) {
+            ret = poll(fds, nfds, pollTimeoutMs);
+            if (ret > 0) {
+                if (static_cast<unsigned short>(fds[0].revents) & POLLNVAL) {
+                    run_ = false;
+                    break;
+                }
+                if (static_cast<unsigned short>(fds[0].revents) & POLLIN) {
+                    run_ = false;
+                    break;
+                }
+                if (static_cast<unsigned short>(fds[1].revents) & POLLIN) {
+                    ReadNotifyEventLocked();
+                }
+            } else if (ret < 0 && errno != EINTR) {
+                HILOGE("Failed to poll NotifyFd, errno=%{public}d", errno);
                 break;
             }
-            if (static_cast<unsigned short>(fds[1].revents) & POLLIN) {
-                ReadNotifyEventLocked();
-            }
-        } else if (ret < 0 && errno != EINTR) {
-            HILOGE("Failed to poll NotifyFd, errno=%{public}d", errno);
-            break;
+            // Ignore cases where poll returns 0 (timeout) or EINTR (interrupted system call)
         }
-        // Ignore cases where poll returns 0 (timeout) or EINTR (interrupted system call)
-    }
-    DestroyTaskThread();
+    } while (StopOrRestartTask(generation));
     HILOGD("The task has been completed.");
 }
 
@@ -328,10 +338,10 @@ void FsFileWatcher::NotifyEvent(const struct inotify_event *event)
         return;
     }
 
+    if (event->len > 0) {
+        fileName += "/" + string(event->name);
+    }
     for (const auto &info : watcherInfos) {
-        if (event->len > 0) {
-            fileName += "/" + string(event->name);
-        }
         info->TriggerCallback(fileName, event->mask & IN_ALL_EVENTS, event->cookie);
     }
 }
@@ -359,6 +369,19 @@ void FsFileWatcher::DestroyTaskThread()
     }
 }
 
+// Watches started while the task was stopping found it still running and did not start another one, so the task
+// polls their fds instead of leaving them unread
+bool FsFileWatcher::StopOrRestartTask(uint64_t generation)
+{
+    lock_guard<mutex> lock(notifyMutex_);
+    if (notifyFd_ >= 0 && notifyGeneration_ != generation) {
+        run_ = true;
+        return true;
+    }
+    DestroyTaskThread();
+    return false;
+}
+
 void FsFileWatcher::WakeupThread()
 {
     if (taskRunning_ && eventFd_ >= 0 && taskThread_.joinable()) {
@@ -18,6 +18,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <sys/inotify.h>
 
@@ -29,7 +30,8 @@
 namespace OHOS::FileManagement::ModuleFileIO {
 using namespace std;
 
-constexpr int32_t BUF_SIZE = 1024;
+// Large enough to drain a burst of events with one read instead of one read per few events
+constexpr int32_t BUF_SIZE = 64 * 1024;
 
 class FsFileWatcher : public Singleton<FsFileWatcher> {
 public:
@@ -57,6 +59,7 @@ private:
     void ReadNotifyEvent();
     void ReadNotifyEventLocked();
     void DestroyTaskThread();
+    bool StopOrRestartTask(uint64_t generation);
     void WakeupThread();
 
 private:
@@ -74,6 +77,9 @@ private:
     atomic<bool> closed_ { false };
     int32_t notifyFd_ = -1;
     int32_t eventFd_ = -1;
+    // Bumped whenever the fds are opened again, guarded by notifyMutex_
+    uint64_t notifyGeneration_ = 0;
+    vector<char> readBuf_;
     WatcherDataCache dataCache_;
 };
 
@@ -17,12 +17,17 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 
 #include "i_watcher_callback.h"
 
 namespace OHOS::FileManagement::ModuleFileIO {
 
+class RecursiveWatcher;
+
+constexpr uint32_t DEFAULT_MAX_RECURSIVE_WATCHES = 8192;
+
 struct WatchEvent {
     std::string fileName = "";
     uint32_t event = 0;
@@ -33,6 +38,9 @@ struct WatcherInfo {
     std::string fileName = "";
     uint32_t events = 0;
     int32_t wd = -1;
+    // A recursive watcher watches the whole tree below fileName with a RecursiveWatcher of its own
+    bool recursive = false;
+    uint32_t maxWatches = DEFAULT_MAX_RECURSIVE_WATCHES;
     std::shared_ptr<IWatcherCallback> callback;
 
     explicit WatcherInfo(std::shared_ptr<IWatcherCallback> callback) : callback(std::move(callback)) {}
@@ -45,6 +53,7 @@ struct WatcherInfo {
 
 struct FsWatchEntity {
     std::shared_ptr<WatcherInfo> watcherInfo;
+    std::shared_ptr<RecursiveWatcher> recursiveWatcher;
 };
 
 } // namespace OHOS::FileManagement::ModuleFileIO
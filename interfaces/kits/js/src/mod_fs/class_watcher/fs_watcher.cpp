@@ -20,6 +20,7 @@
 #include "filemgmt_libhilog.h"
 #include "fs_file_watcher.h"
 #include "fs_watch_entity.h"
+#include "recursive_watcher.h"
 #include "securec.h"
 
 namespace OHOS::FileManagement::ModuleFileIO {
@@ -43,6 +44,14 @@ FsResult<FsWatcher *> FsWatcher::Constructor()
     return FsResult<FsWatcher *>::Success(move(watcherPtr));
 }
 
+FsWatcher::~FsWatcher()
+{
+    // A watcher released without stop must not leave its thread behind
+    if (watchEntity && watchEntity->recursiveWatcher) {
+        watchEntity->recursiveWatcher->Stop();
+    }
+}
+
 FsResult<void> FsWatcher::Stop()
 {
     FileFsTrace traceFsWatcherStop("FsWatcherStop");
@@ -50,6 +59,11 @@ FsResult<void> FsWatcher::Stop()
         HILOGE("Failed to get watchEntity when stop.");
         return FsResult<void>::Error(EINVAL);
     }
+    if (watchEntity->recursiveWatcher) {
+        watchEntity->recursiveWatcher->Stop();
+        watchEntity->recursiveWatcher.reset();
+        return FsResult<void>::Success();
+    }
     int ret = FsFileWatcher::GetInstance().StopNotify(watchEntity->watcherInfo);
     if (ret != ERRNO_NOERR) {
         HILOGE("Failed to stopNotify errno:%{public}d", errno);
@@ -67,6 +81,9 @@ FsResult<void> FsWatcher::Start()
     }
 
     shared_ptr<WatcherInfo> info = watchEntity->watcherInfo;
+    if (info && info->recursive) {
+        return StartRecursive();
+    }
     int ret = FsFileWatcher::GetInstance().StartNotify(info);
     if (ret != ERRNO_NOERR) {
         HILOGE("Failed to startNotify.");
@@ -78,4 +95,28 @@ FsResult<void> FsWatcher::Start()
     return FsResult<void>::Success();
 }
 
+FsResult<void> FsWatcher::StartRecursive()
+{
+    if (watchEntity->recursiveWatcher) {
+        return FsResult<void>::Success();
+    }
+    shared_ptr<WatcherInfo> info = watchEntity->watcherInfo;
+    auto recursiveWatcher = CreateSharedPtr<RecursiveWatcher>(info->fileName, info->events, info->maxWatches);
+    if (recursiveWatcher == nullptr) {
+        HILOGE("Failed to request heap memory.");
+        return FsResult<void>::Error(ENOMEM);
+    }
+    int ret = recursiveWatcher->Start([info](vector<WatchEvent> &&events) {
+        for (const auto &event : events) {
+            info->TriggerCallback(event.fileName, event.event, event.cookie);
+        }
+    });
+    if (ret != ERRNO_NOERR) {
+        HILOGE("Failed to start recursive watch.");
+        return FsResult<void>::Error(ret);
+    }
+    watchEntity->recursiveWatcher = move(recursiveWatcher);
+    return FsResult<void>::Success();
+}
+
 } // namespace OHOS::FileManagement::ModuleFileIO
@@ -38,9 +38,11 @@ public:
     FsWatcher(FsWatcher &&) noexcept = default;
     FsWatcher &operator=(FsWatcher &&) noexcept = default;
 
-    ~FsWatcher() = default;
+    ~FsWatcher();
 
 private:
+    FsResult<void> StartRecursive();
+
     unique_ptr<FsWatchEntity> watchEntity;
     explicit FsWatcher(unique_ptr<FsWatchEntity> entity) : watchEntity(move(entity)) {}
 };
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "recursive_watcher.h"
+
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <system_error>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "fd_guard.h"
+#include "filemgmt_libfs.h"
+#include "filemgmt_libhilog.h"
+#include "listfile_walker.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+
+namespace {
+// Watched on every directory whatever the caller asked for, they keep the tree in sync
+constexpr uint32_t TREE_EVENTS = IN_CREATE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+constexpr uint32_t WATCH_FLAGS = IN_ONLYDIR | IN_DONT_FOLLOW;
+} // namespace
+
+static string JoinPath(const string &dir, const char *name)
+{
+    return dir.empty() ? string(name) : dir + "/" + name;
+}
+
+RecursiveWatcher::RecursiveWatcher(const string &root, uint32_t events, uint32_t maxWatches)
+    : root_(root), events_(events), maxWatches_(maxWatches)
+{
+    while (root_.size() > 1 && root_.back() == '/') {
+        root_.pop_back();
+    }
+}
+
+RecursiveWatcher::~RecursiveWatcher()
+{
+    CloseFds();
+}
+
+void RecursiveWatcher::CloseFds()
+{
+    if (notifyFd_ >= 0) {
+        close(notifyFd_); // Ignore the result of close
+        notifyFd_ = -1;
+    }
+    if (eventFd_ >= 0) {
+        close(eventFd_); // Ignore the result of close
+        eventFd_ = -1;
+    }
+}
+
+string RecursiveWatcher::ToAbsolutePath(const string &relPath) const
+{
+    if (relPath.empty()) {
+        return root_;
+    }
+    return root_.back() == '/' ? root_ + relPath : root_ + "/" + relPath;
+}
+
+int32_t RecursiveWatcher::AddWatch(const string &relPath)
+{
+    auto pathIter = pathWds_.find(relPath);
+    if (pathIter == pathWds_.end() && pathWds_.size() >= maxWatches_) {
+        overflow_ = true;
+        return ENOSPC;
+    }
+    int32_t wd = inotify_add_watch(notifyFd_, ToAbsolutePath(relPath).c_str(), events_ | TREE_EVENTS | WATCH_FLAGS);
+    if (wd < 0) {
+        int32_t err = errno;
+        if (err == ENOSPC) {
+            overflow_ = true;
+        } else if (err != ENOENT && err != ENOTDIR) {
+            HILOGE("Failed to add recursive watch errCode:%{public}d", err);
+        }
+        return err;
+    }
+    auto wdIter = wdPaths_.find(wd);
+    if (wdIter != wdPaths_.end() && wdIter->second != relPath) {
+        // The same directory reached twice through a bind mount, its subtree is already watched
+        return EEXIST;
+    }
+    if (pathIter != pathWds_.end() && pathIter->second != wd) {
+        // The directory was replaced, the watch of the old one goes away with it
+        wdPaths_.erase(pathIter->second);
+    }
+    wdPaths_[wd] = relPath;
+    pathWds_[relPath] = wd;
+    return ERRNO_NOERR;
+}
+
+// Watches every directory of the subtree before listing it, so that nothing created during the walk is missed
+void RecursiveWatcher::AddTree(const string &relPath, vector<WatchEvent> *created)
+{
+    vector<string> dirs = { relPath };
+    while (!dirs.empty()) {
+        string dir = move(dirs.back());
+        dirs.pop_back();
+        if (AddWatch(dir) != ERRNO_NOERR) {
+            if (overflow_) {
+                return;
+            }
+            continue;
+        }
+        DistributedFS::FDGuard dirFd(
+            open(ToAbsolutePath(dir).c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC));
+        if (!dirFd) {
+            continue;
+        }
+        ListFileWalker::ForEachDirent(dirFd.GetFD(), direntBuf_,
+            [this, &dir, &dirs, &dirFd, created](const char *name, unsigned char type) {
+                string child = JoinPath(dir, name);
+                // The content of a new directory was never reported by the kernel
+                if (created != nullptr && (events_ & IN_CREATE)) {
+                    created->push_back({ child, IN_CREATE, 0 });
+                }
+                if (ListFileWalker::ResolveType(dirFd.GetFD(), name, type) == DT_DIR) {
+                    dirs.push_back(move(child));
+                }
+                return true;
+            });
+    }
+}
+
+void RecursiveWatcher::RemoveTree(const string &relPath)
+{
+    auto forget = [this](map<string, int32_t>::iterator begin, map<string, int32_t>::iterator end) {
+        for (auto iter = begin; iter != end; ++iter) {
+            inotify_rm_watch(notifyFd_, iter->second); // The directory may be gone already
+            wdPaths_.erase(iter->second);
+        }
+        pathWds_.erase(begin, end);
+    };
+    auto self = pathWds_.find(relPath);
+    if (self != pathWds_.end()) {
+        forget(self, next(self));
+    }
+    // "dir/" up to "dir0" holds exactly the paths below dir
+    forget(pathWds_.lower_bound(relPath + "/"), pathWds_.lower_bound(relPath + "0"));
+}
+
+void RecursiveWatcher::RenameTree(const string &fromPath, const string &toPath)
+{
+    if (fromPath == toPath) {
+        return;
+    }
+    vector<pair<string, int32_t>> moved;
+    auto collect = [this, &fromPath, &toPath, &moved](map<string, int32_t>::iterator begin,
+        map<string, int32_t>::iterator end) {
+        for (auto iter = begin; iter != end; ++iter) {
+            moved.emplace_back(toPath + iter->first.substr(fromPath.size()), iter->second);
+        }
+        pathWds_.erase(begin, end);
+    };
+    auto self = pathWds_.find(fromPath);
+    if (self != pathWds_.end()) {
+        collect(self, next(self));
+    }
+    collect(pathWds_.lower_bound(fromPath + "/"), pathWds_.lower_bound(fromPath + "0"));
+    // A directory renamed over an empty one replaces it
+    RemoveTree(toPath);
+    for (auto &[path, wd] : moved) {
+        wdPaths_[wd] = path;
+        pathWds_[move(path)] = wd;
+    }
+}
+
+void RecursiveWatcher::ForgetWatch(int32_t wd)
+{
+    auto wdIter = wdPaths_.find(wd);
+    if (wdIter == wdPaths_.end()) {
+        return;
+    }
+    auto pathIter = pathWds_.find(wdIter->second);
+    if (pathIter != pathWds_.end() && pathIter->second == wd) {
+        pathWds_.erase(pathIter);
+    }
+    wdPaths_.erase(wdIter);
+}
+
+void RecursiveWatcher::HandleEvent(const struct inotify_event *event, vector<WatchEvent> &events)
+{
+    if (event->mask & IN_Q_OVERFLOW) {
+        overflow_ = true;
+        return;
+    }
+    auto wdIter = wdPaths_.find(event->wd);
+    if (wdIter == wdPaths_.end()) {
+        return;
+    }
+    if (event->mask & IN_IGNORED) {
+        ForgetWatch(event->wd);
+        return;
+    }
+
+    const string dir = wdIter->second;
+    string path = event->len > 0 ? JoinPath(dir, event->name) : dir;
+    // A subdirectory going away is reported by its parent already, only the root reports itself
+    bool isSelf = (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0;
+    if ((event->mask & events_) != 0 && (!isSelf || dir.empty())) {
+        events.push_back({ path, event->mask & IN_ALL_EVENTS, event->cookie });
+    }
+    if (!(event->mask & IN_ISDIR) || event->len == 0) {
+        return;
+    }
+    if (event->mask & IN_CREATE) {
+        AddTree(path, &events);
+    } else if (event->mask & IN_MOVED_FROM) {
+        pendingMoves_[event->cookie] = move(path);
+    } else if (event->mask & IN_MOVED_TO) {
+        auto moveIter = pendingMoves_.find(event->cookie);
+        if (moveIter != pendingMoves_.end()) {
+            RenameTree(moveIter->second, path);
+            pendingMoves_.erase(moveIter);
+        } else {
+            AddTree(path, nullptr);
+        }
+    }
+}
+
+void RecursiveWatcher::ReadEvents(vector<WatchEvent> &events)
+{
+    if (readBuf_.empty()) {
+        readBuf_.resize(readBufSize);
+    }
+    char *buf = readBuf_.data();
+    ssize_t len = 0;
+    do {
+        len = read(notifyFd_, buf, readBuf_.size());
+    } while (len < 0 && errno == EINTR);
+    if (len < 0) {
+        HILOGE("Failed to read recursive watch events errCode:%{public}d", errno);
+        return;
+    }
+
+    size_t eventSize = sizeof(struct inotify_event);
+    size_t index = 0;
+    while (static_cast<size_t>(len) - index >= eventSize) {
+        auto *event = reinterpret_cast<struct inotify_event *>(buf + index);
+        if (event->len > static_cast<size_t>(len) - index - eventSize) {
+            HILOGE("Out of bounds access, index: %{public}zu, event: %{public}u, len: %{public}zd",
+                index, event->len, len);
+            break;
+        }
+        HandleEvent(event, events);
+        index += eventSize + event->len;
+    }
+    // Moved out of the tree, or to the other half of a rename that did not fit into this read
+    for (const auto &[cookie, path] : pendingMoves_) {
+        RemoveTree(path);
+    }
+    pendingMoves_.clear();
+    watchCount_.store(pathWds_.size(), memory_order_relaxed);
+    if (overflow_) {
+        events.push_back({ "", IN_Q_OVERFLOW, 0 });
+        overflow_ = false;
+    }
+}
+
+void RecursiveWatcher::Run()
+{
+    if (!startEvents_.empty()) {
+        handler_(move(startEvents_));
+        startEvents_.clear();
+    }
+    struct pollfd fds[2] = { { eventFd_, POLLIN, 0 }, { notifyFd_, POLLIN, 0 } };
+    while (run_) {
+        int ret = poll(fds, 2, -1);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            HILOGE("Failed to poll recursive watch errCode:%{public}d", errno);
+            break;
+        }
+        if (static_cast<unsigned short>(fds[0].revents) & (POLLIN | POLLNVAL)) {
+            break;
+        }
+        if (static_cast<unsigned short>(fds[1].revents) & POLLIN) {
+            vector<WatchEvent> events;
+            ReadEvents(events);
+            if (!events.empty() && run_) {
+                handler_(move(events));
+            }
+        }
+    }
+}
+
+int32_t RecursiveWatcher::Start(RecursiveWatchHandler handler)
+{
+    if (run_) {
+        return ERRNO_NOERR;
+    }
+    CloseFds();
+    wdPaths_.clear();
+    pathWds_.clear();
+    watchCount_.store(0, memory_order_relaxed);
+    notifyFd_ = inotify_init1(IN_CLOEXEC);
+    if (notifyFd_ < 0) {
+        int32_t err = errno;
+        HILOGE("Failed to init recursive notify errCode:%{public}d", err);
+        return err;
+    }
+    eventFd_ = eventfd(0, EFD_CLOEXEC);
+    if (eventFd_ < 0) {
+        int32_t err = errno;
+        HILOGE("Failed to init recursive eventfd errCode:%{public}d", err);
+        CloseFds();
+        return err;
+    }
+    int32_t err = AddWatch("");
+    if (err != ERRNO_NOERR) {
+        HILOGE("Failed to watch root errCode:%{public}d", err);
+        CloseFds();
+        overflow_ = false;
+        return err;
+    }
+    AddTree("", nullptr);
+    watchCount_.store(pathWds_.size(), memory_order_relaxed);
+    if (overflow_) {
+        startEvents_.push_back({ "", IN_Q_OVERFLOW, 0 });
+        overflow_ = false;
+    }
+
+    handler_ = move(handler);
+    run_ = true;
+    try {
+        lock_guard<mutex> lock(threadMutex_);
+        thread_ = thread([self = shared_from_this()]() { self->Run(); });
+    } catch (const system_error &e) {
+        HILOGE("Failed to start recursive watch thread: %{public}s", e.what());
+        run_ = false;
+        CloseFds();
+        return EAGAIN;
+    }
+    return ERRNO_NOERR;
+}
+
+void RecursiveWatcher::Stop()
+{
+    if (!run_.exchange(false)) {
+        return;
+    }
+    ssize_t ret = write(eventFd_, &wakeupSignal, sizeof(wakeupSignal));
+    if (ret != sizeof(wakeupSignal)) {
+        HILOGE("Failed to wakeup recursive watch errCode:%{public}d", errno);
+    }
+    thread worker;
+    {
+        lock_guard<mutex> lock(threadMutex_);
+        if (!thread_.joinable()) {
+            return;
+        }
+        if (thread_.get_id() == this_thread::get_id()) {
+            // The descriptors are closed with the watcher once the handler returned
+            thread_.detach();
+            return;
+        }
+        worker = move(thread_);
+    }
+    worker.join();
+    CloseFds();
+}
+
+} // namespace OHOS::FileManagement::ModuleFileIO
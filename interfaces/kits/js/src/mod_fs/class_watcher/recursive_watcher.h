@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_CLASS_WATCHER_RECURSIVE_WATCHER_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_CLASS_WATCHER_RECURSIVE_WATCHER_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/inotify.h>
+
+#include "fs_watch_entity.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+
+// Receives the events of one read, file names are relative to the watched root which itself is ""
+using RecursiveWatchHandler = std::function<void(std::vector<WatchEvent> &&events)>;
+
+/*
+ * Watches a directory tree with an inotify instance of its own, so its watch descriptors and masks never mix with
+ * the ones of the single path watchers. Directories created or moved into the tree are watched as they appear and
+ * the ones deleted or moved out are forgotten. When the tree needs more than maxWatches watches, the kernel queue
+ * overflows or the kernel runs out of watches, an IN_Q_OVERFLOW event on the root is reported once per read and the
+ * caller is expected to rescan.
+ */
+class RecursiveWatcher : public std::enable_shared_from_this<RecursiveWatcher> {
+public:
+    RecursiveWatcher(const std::string &root, uint32_t events, uint32_t maxWatches = DEFAULT_MAX_RECURSIVE_WATCHES);
+    ~RecursiveWatcher();
+
+    RecursiveWatcher(const RecursiveWatcher &) = delete;
+    RecursiveWatcher &operator=(const RecursiveWatcher &) = delete;
+
+    // Watches the tree and starts the thread calling the handler, returns an errno
+    int32_t Start(RecursiveWatchHandler handler);
+    // Safe to call from the handler, the thread then finishes once the handler returned
+    void Stop();
+    // The number of watched directories as of the last read, safe to call from any thread
+    size_t GetWatchCount() const
+    {
+        return watchCount_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::string ToAbsolutePath(const std::string &relPath) const;
+    int32_t AddWatch(const std::string &relPath);
+    void AddTree(const std::string &relPath, std::vector<WatchEvent> *created);
+    void RemoveTree(const std::string &relPath);
+    void RenameTree(const std::string &fromPath, const std::string &toPath);
+    void ForgetWatch(int32_t wd);
+    void HandleEvent(const struct inotify_event *event, std::vector<WatchEvent> &events);
+    void ReadEvents(std::vector<WatchEvent> &events);
+    void Run();
+    void CloseFds();
+
+private:
+    static constexpr uint64_t wakeupSignal = 1;
+    static constexpr size_t readBufSize = 64 * 1024;
+
+    std::string root_;
+    uint32_t events_ = 0;
+    uint32_t maxWatches_ = DEFAULT_MAX_RECURSIVE_WATCHES;
+    int32_t notifyFd_ = -1;
+    int32_t eventFd_ = -1;
+    std::atomic<bool> run_ { false };
+    // Guards thread_, which Stop may reach from the handler while Start is still storing it
+    std::mutex threadMutex_;
+    std::thread thread_;
+    RecursiveWatchHandler handler_;
+    // Only touched by the thread after Start returned
+    std::unordered_map<int32_t, std::string> wdPaths_;
+    // Ordered so that the watches below a directory are one range of keys
+    std::map<std::string, int32_t> pathWds_;
+    // Size of pathWds_ published for GetWatchCount
+    std::atomic<size_t> watchCount_ { 0 };
+    // Directories moved away in the current read, keyed by cookie until their IN_MOVED_TO shows up
+    std::unordered_map<uint32_t, std::string> pendingMoves_;
+    std::vector<char> readBuf_;
+    std::vector<char> direntBuf_;
+    std::vector<WatchEvent> startEvents_;
+    bool overflow_ = false;
+};
+
+} // namespace OHOS::FileManagement::ModuleFileIO
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_CLASS_WATCHER_RECURSIVE_WATCHER_H
@@ -14,6 +14,8 @@
  */
 #include "watcher_data_cache.h"
 
+#include <algorithm>
+
 #include "filemgmt_libhilog.h"
 
 namespace OHOS::FileManagement::ModuleFileIO {
@@ -21,8 +23,9 @@ namespace OHOS::FileManagement::ModuleFileIO {
 bool WatcherDataCache::AddWatcherInfo(std::shared_ptr<WatcherInfo> info)
 {
     std::lock_guard<std::mutex> lock(cacheMutex_);
-    for (auto &iter : watcherInfoCache_) {
-        if (iter->fileName == info->fileName && iter->events == info->events) {
+    auto &infos = watcherInfoCache_[info->fileName];
+    for (auto &iter : infos) {
+        if (iter->events == info->events) {
             bool isSame = iter->callback->IsStrictEquals(info->callback);
             if (isSame) {
                 HILOGE("Failed to add watcher, fileName:%{private}s the callback is same", info->fileName.c_str());
@@ -30,31 +33,47 @@ bool WatcherDataCache::AddWatcherInfo(std::shared_ptr<WatcherInfo> info)
             }
         }
     }
-    watcherInfoCache_.push_back(info);
+    infos.push_back(info);
     return true;
 }
 
 uint32_t WatcherDataCache::RemoveWatcherInfo(std::shared_ptr<WatcherInfo> info)
 {
     std::lock_guard<std::mutex> lock(cacheMutex_);
-    auto it = std::find(watcherInfoCache_.begin(), watcherInfoCache_.end(), info);
-    if (it != watcherInfoCache_.end()) {
-        watcherInfoCache_.erase(it);
+    auto cacheIter = watcherInfoCache_.find(info->fileName);
+    if (cacheIter == watcherInfoCache_.end()) {
+        return 0;
+    }
+    auto &infos = cacheIter->second;
+    auto it = std::find(infos.begin(), infos.end(), info);
+    if (it != infos.end()) {
+        infos.erase(it);
     }
 
     uint32_t remainingEvents = 0;
-    for (const auto &iter : watcherInfoCache_) {
-        if (iter->fileName == info->fileName && iter->wd > 0) {
+    for (const auto &iter : infos) {
+        if (iter->wd > 0) {
             remainingEvents |= iter->events;
         }
     }
+    if (infos.empty()) {
+        watcherInfoCache_.erase(cacheIter);
+    }
     return remainingEvents;
 }
 
 void WatcherDataCache::RemoveWatchedEvents(const std::string &fileName)
 {
     std::lock_guard<std::mutex> lock(cacheMutex_);
-    wdFileNameCache_.erase(fileName);
+    auto iter = wdFileNameCache_.find(fileName);
+    if (iter == wdFileNameCache_.end()) {
+        return;
+    }
+    auto indexIter = wdIndex_.find(iter->second.first);
+    if (indexIter != wdIndex_.end() && indexIter->second == fileName) {
+        wdIndex_.erase(indexIter);
+    }
+    wdFileNameCache_.erase(iter);
 }
 
 std::tuple<bool, int32_t, uint32_t> WatcherDataCache::FindWatchedEvents(const std::string &fileName, uint32_t event)
@@ -80,7 +99,15 @@ std::tuple<bool, int32_t, uint32_t> WatcherDataCache::FindWatchedEvents(const st
 void WatcherDataCache::UpdateWatchedEvents(const std::string &fileName, int32_t wd, uint32_t events)
 {
     std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto iter = wdFileNameCache_.find(fileName);
+    if (iter != wdFileNameCache_.end() && iter->second.first != wd) {
+        auto indexIter = wdIndex_.find(iter->second.first);
+        if (indexIter != wdIndex_.end() && indexIter->second == fileName) {
+            wdIndex_.erase(indexIter);
+        }
+    }
     wdFileNameCache_[fileName] = std::make_pair(wd, events);
+    wdIndex_[wd] = fileName;
 }
 
 static bool CheckIncludeEvent(uint32_t mask, uint32_t event)
@@ -92,28 +119,19 @@ std::tuple<bool, std::string, std::vector<std::shared_ptr<WatcherInfo>>> Watcher
     int32_t wd, uint32_t eventMask)
 {
     std::lock_guard<std::mutex> lock(cacheMutex_);
-    std::string fileName;
-    bool found = false;
-    for (const auto &[key, val] : wdFileNameCache_) {
-        if (val.first == wd) {
-            fileName = key;
-            found = true;
-            break;
-        }
-    }
-
-    if (!found) {
+    auto indexIter = wdIndex_.find(wd);
+    if (indexIter == wdIndex_.end()) {
         return { false, "", {} };
     }
 
+    const std::string &fileName = indexIter->second;
     std::vector<std::shared_ptr<WatcherInfo>> matchedInfos;
-    for (const auto &info : watcherInfoCache_) {
-        uint32_t watchEvent = 0;
-        if ((info->fileName == fileName) && (info->wd > 0)) {
-            watchEvent = info->events;
-        }
-        if (CheckIncludeEvent(eventMask, watchEvent)) {
-            matchedInfos.push_back(info);
+    auto cacheIter = watcherInfoCache_.find(fileName);
+    if (cacheIter != watcherInfoCache_.end()) {
+        for (const auto &info : cacheIter->second) {
+            if (info->wd > 0 && CheckIncludeEvent(eventMask, info->events)) {
+                matchedInfos.push_back(info);
+            }
         }
     }
     return { !matchedInfos.empty(), fileName, matchedInfos };
@@ -130,6 +148,7 @@ void WatcherDataCache::ClearCache()
     std::lock_guard<std::mutex> lock(cacheMutex_);
     watcherInfoCache_.clear();
     wdFileNameCache_.clear();
+    wdIndex_.clear();
 }
 
 } // namespace OHOS::FileManagement::ModuleFileIO
\ No newline at end of file
@@ -45,8 +45,11 @@ public:
 
 private:
     mutable std::mutex cacheMutex_;
-    std::vector<std::shared_ptr<WatcherInfo>> watcherInfoCache_;
+    // Watchers grouped by the file they watch, a file without watchers has no entry
+    std::unordered_map<std::string, std::vector<std::shared_ptr<WatcherInfo>>> watcherInfoCache_;
     std::unordered_map<std::string, std::pair<int32_t, uint32_t>> wdFileNameCache_;
+    // Reverse index of wdFileNameCache_, resolves the wd of an inotify event to the watched file
+    std::unordered_map<int32_t, std::string> wdIndex_;
 };
 
 } // namespace OHOS::FileManagement::ModuleFileIO
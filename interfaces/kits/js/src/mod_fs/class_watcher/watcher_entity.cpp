@@ -23,6 +23,7 @@
 
 #include "file_fs_trace.h"
 #include "filemgmt_libhilog.h"
+#include "recursive_watcher.h"
 #include "uv.h"
 
 namespace OHOS::FileManagement::ModuleFileIO {
@@ -31,6 +32,14 @@ using namespace std;
 
 mutex FileWatcher::watchMutex_;
 
+WatcherInfoArg::~WatcherInfoArg()
+{
+    // A watcher collected without stop must not leave its thread behind
+    if (recursiveWatcher) {
+        recursiveWatcher->Stop();
+    }
+}
+
 FileWatcher::FileWatcher() {}
 
 FileWatcher::~FileWatcher() {}
@@ -104,8 +113,7 @@ int FileWatcher::StartNotify(shared_ptr<WatcherInfoArg> arg)
         return errno;
     }
     arg->wd = newWd;
-    wdFileNameMap_[arg->fileName].first = newWd;
-    wdFileNameMap_[arg->fileName].second = watchEvents;
+    UpdateWatchedWd(arg->fileName, newWd, watchEvents);
     HILOGI("File watcher started, notifyFd_: %{public}d, wd: %{public}d", notifyFd_, newWd);
     return ERRNO_NOERR;
 }
@@ -129,7 +137,7 @@ int FileWatcher::NotifyToWatchNewEvents(const string &fileName, const int &wd, c
 int FileWatcher::CloseNotifyFd()
 {
     int closeRet = ERRNO_NOERR;
-    if (watcherInfoSet_.size() == 0 && run_) {
+    if (watcherInfoMap_.empty() && run_) {
         run_ = false;
         closeRet = close(notifyFd_);
         if (closeRet != 0) {
@@ -187,12 +195,12 @@ int FileWatcher::StopNotify(shared_ptr<WatcherInfoArg> arg)
         int rmErr = errno;
         if (access(arg->fileName.c_str(), F_OK) == 0) {
             HILOGE("Failed to stop notify errCode:%{public}d", rmErr);
-            wdFileNameMap_.erase(arg->fileName);
+            RemoveWatchedWd(arg->fileName);
             CloseNotifyFdLocked();
             return rmErr;
         }
     }
-    wdFileNameMap_.erase(arg->fileName);
+    RemoveWatchedWd(arg->fileName);
     return CloseNotifyFdLocked();
 }
 
@@ -200,9 +208,12 @@ void FileWatcher::ReadNotifyEvent(WatcherCallback callback)
 {
     int len = 0;
     int index = 0;
-    char buf[BUF_SIZE] = {0};
     struct inotify_event *event = nullptr;
-    while (((len = read(notifyFd_, &buf, sizeof(buf))) < 0) && (errno == EINTR)) {};
+    if (readBuf_.empty()) {
+        readBuf_.resize(BUF_SIZE);
+    }
+    char *buf = readBuf_.data();
+    while (((len = read(notifyFd_, buf, readBuf_.size())) < 0) && (errno == EINTR)) {};
     while (index < len) {
         event = reinterpret_cast<inotify_event *>(buf + index);
         if (static_cast<unsigned int>(len - index) < sizeof(struct inotify_event)) {
@@ -220,6 +231,7 @@ void FileWatcher::ReadNotifyEvent(WatcherCallback callback)
         NotifyEvent(event, callback);
         index += sizeof(struct inotify_event) + static_cast<int>(event->len);
     }
+    FlushPendingEvents(callback);
 }
 
 void FileWatcher::ReadNotifyEventLocked(WatcherCallback callback)
@@ -259,8 +271,10 @@ void FileWatcher::GetNotifyEvent(WatcherCallback callback)
     fds[1].events = POLLIN;
     int ret = 0;
     while (run_) {
-        ret = poll(fds, nfds, -1);
-        if (ret > 0) {
+        ret = poll(fds, nfds, NextFlushTimeout());
+        if (ret == 0) {
+            FlushPendingEvents(callback);
+        } else if (ret > 0) {
             if (static_cast<unsigned short>(fds[0].revents) & POLLNVAL) {
                 run_ = false;
                 return;
@@ -279,8 +293,10 @@ void FileWatcher::GetNotifyEvent(WatcherCallback callback)
 
 bool FileWatcher::AddWatcherInfo(const string &fileName, shared_ptr<WatcherInfoArg> arg)
 {
-    for (auto &iter : watcherInfoSet_) {
-        if (iter->fileName == arg->fileName && iter->events == arg->events) {
+    lock_guard<mutex> lock(watchMutex_);
+    auto &infos = watcherInfoMap_[arg->fileName];
+    for (auto &iter : infos) {
+        if (iter->events == arg->events) {
             bool isSame = false;
             napi_strict_equals(iter->env, iter->nRef.Deref(iter->env).val_, arg->nRef.Deref(arg->env).val_, &isSame);
             if (isSame) {
@@ -289,22 +305,61 @@ bool FileWatcher::AddWatcherInfo(const string &fileName, shared_ptr<WatcherInfoA
             }
         }
     }
-    watcherInfoSet_.insert(arg);
+    infos.insert(arg);
     return true;
 }
 
 uint32_t FileWatcher::RemoveWatcherInfo(shared_ptr<WatcherInfoArg> arg)
 {
-    watcherInfoSet_.erase(arg);
+    // Events read for a stopped watcher are dropped rather than delivered after stop returned
+    pendingArgs_.erase(arg);
+    arg->pending.clear();
+    arg->pendingKeys.clear();
+
+    auto mapIter = watcherInfoMap_.find(arg->fileName);
+    if (mapIter == watcherInfoMap_.end()) {
+        return 0;
+    }
+    auto &infos = mapIter->second;
+    infos.erase(arg);
     uint32_t otherEvents = 0;
-    for (const auto &iter : watcherInfoSet_) {
-        if (iter->fileName == arg->fileName && iter->wd > 0) {
+    for (const auto &iter : infos) {
+        if (iter->wd > 0) {
             otherEvents |= iter->events;
         }
     }
+    if (infos.empty()) {
+        watcherInfoMap_.erase(mapIter);
+    }
     return otherEvents;
 }
 
+void FileWatcher::UpdateWatchedWd(const string &fileName, int wd, uint32_t events)
+{
+    auto iter = wdFileNameMap_.find(fileName);
+    if (iter != wdFileNameMap_.end() && iter->second.first != wd) {
+        auto indexIter = wdIndex_.find(iter->second.first);
+        if (indexIter != wdIndex_.end() && indexIter->second == fileName) {
+            wdIndex_.erase(indexIter);
+        }
+    }
+    wdFileNameMap_[fileName] = make_pair(wd, events);
+    wdIndex_[wd] = fileName;
+}
+
+void FileWatcher::RemoveWatchedWd(const string &fileName)
+{
+    auto iter = wdFileNameMap_.find(fileName);
+    if (iter == wdFileNameMap_.end()) {
+        return;
+    }
+    auto indexIter = wdIndex_.find(iter->second.first);
+    if (indexIter != wdIndex_.end() && indexIter->second == fileName) {
+        wdIndex_.erase(indexIter);
+    }
+    wdFileNameMap_.erase(iter);
+}
+
 bool CheckIncludeEvent(const uint32_t &mask, const uint32_t &event)
 {
     if ((mask & event) > 0) {
@@ -316,32 +371,83 @@ bool CheckIncludeEvent(const uint32_t &mask, const uint32_t &event)
 void FileWatcher::NotifyEvent(const struct inotify_event *event, WatcherCallback callback)
 {
     lock_guard<mutex> lock(watchMutex_);
-    string tempFileName;
-    auto found = find_if(wdFileNameMap_.begin(), wdFileNameMap_.end(),
-        [event](const pair<std::string, std::pair<int, uint32_t>> &iter) {
-            return iter.second.first == event->wd;
-    });
-    if (found != wdFileNameMap_.end()) {
-        tempFileName = found->first;
-    }
-
-    for (const auto &iter : watcherInfoSet_) {
-        string fileName = tempFileName;
-        uint32_t watchEvent = 0;
-        if ((iter->fileName == fileName) && (iter->wd > 0)) {
-            watchEvent = iter->events;
-        }
-        if (!CheckIncludeEvent(event->mask, watchEvent)) {
+    auto indexIter = wdIndex_.find(event->wd);
+    if (indexIter == wdIndex_.end()) {
+        return;
+    }
+    auto mapIter = watcherInfoMap_.find(indexIter->second);
+    if (mapIter == watcherInfoMap_.end()) {
+        return;
+    }
+
+    string fileName = indexIter->second;
+    if (event->len > 0) {
+        fileName += "/" + string(event->name);
+    }
+    for (const auto &iter : mapIter->second) {
+        if (iter->wd <= 0 || !CheckIncludeEvent(event->mask, iter->events)) {
             continue;
         }
-        if (event->len > 0) {
-            fileName += "/" + string(event->name);
-        }
         if (FileApiDebug::isLogEnabled) {
-            HILOGD("Watcher event %{public}d, event->mask %{public}d", watchEvent, event->mask);
+            HILOGD("Watcher event %{public}d, event->mask %{public}d", iter->events, event->mask);
+        }
+        QueueEvent(iter, { fileName, event->mask & IN_ALL_EVENTS, event->cookie });
+    }
+}
+
+// Called with watchMutex_ held. A batched watcher keeps one event per (fileName, event, cookie) until its window ends
+void FileWatcher::QueueEvent(shared_ptr<WatcherInfoArg> arg, WatchEvent &&event)
+{
+    if (arg->batchWindow > 0) {
+        string key = event.fileName + '\0' + to_string(event.event) + '\0' + to_string(event.cookie);
+        if (!arg->pendingKeys.insert(move(key)).second) {
+            return;
+        }
+        if (arg->pending.empty()) {
+            arg->deadline = chrono::steady_clock::now() + chrono::milliseconds(arg->batchWindow);
         }
-        callback(iter->env, iter->nRef, fileName, event->mask & IN_ALL_EVENTS, event->cookie);
     }
+    arg->pending.push_back(move(event));
+    pendingArgs_.insert(arg);
+}
+
+// Every watcher gets the events of one read in a single task on the JS thread instead of one task per event
+void FileWatcher::FlushPendingEvents(WatcherCallback callback)
+{
+    lock_guard<mutex> lock(watchMutex_);
+    if (pendingArgs_.empty()) {
+        return;
+    }
+    auto now = chrono::steady_clock::now();
+    for (auto iter = pendingArgs_.begin(); iter != pendingArgs_.end();) {
+        auto arg = *iter;
+        if (arg->batchWindow > 0 && arg->deadline > now) {
+            ++iter;
+            continue;
+        }
+        callback(arg->env, arg->nRef, move(arg->pending), arg->batchWindow != NO_BATCH_WINDOW);
+        arg->pending.clear();
+        arg->pendingKeys.clear();
+        iter = pendingArgs_.erase(iter);
+    }
+}
+
+int FileWatcher::NextFlushTimeout()
+{
+    lock_guard<mutex> lock(watchMutex_);
+    if (pendingArgs_.empty()) {
+        return -1;
+    }
+    auto next = chrono::steady_clock::time_point::max();
+    for (const auto &arg : pendingArgs_) {
+        next = min(next, arg->batchWindow > 0 ? arg->deadline : chrono::steady_clock::time_point::min());
+    }
+    auto now = chrono::steady_clock::now();
+    if (next <= now) {
+        return 0;
+    }
+    // One more millisecond so that poll does not wake up just before the deadline
+    return static_cast<int>(chrono::duration_cast<chrono::milliseconds>(next - now).count()) + 1;
 }
 
 bool FileWatcher::CheckEventValid(const uint32_t &event)
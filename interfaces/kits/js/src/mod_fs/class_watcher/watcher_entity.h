@@ -16,6 +16,7 @@
 #define INTERFACES_KITS_JS_SRC_MOD_FS_CLASS_WATCHER_WATCHER_ENTITY_H
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -23,25 +24,39 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <uv.h>
+#include <vector>
 
 #include "filemgmt_libn.h"
+#include "fs_watch_entity.h"
 #include "singleton.h"
 namespace OHOS::FileManagement::ModuleFileIO {
+// Hands the events of one watcher to JS, batched watchers get them as one array instead of one call per event
 using WatcherCallback = void (*)(napi_env env,
                                  LibN::NRef &callback,
-                                 const std::string &filename,
-                                 const uint32_t &event,
-                                 const uint32_t &cookie);
+                                 std::vector<WatchEvent> &&events,
+                                 bool batched);
 
-constexpr int BUF_SIZE = 1024;
+// Large enough to drain a burst of events with one read instead of one read per few events
+constexpr int BUF_SIZE = 64 * 1024;
+constexpr int32_t NO_BATCH_WINDOW = -1;
 struct WatcherInfoArg {
     std::string fileName = "";
     uint32_t events = 0;
     int wd = -1;
     napi_env env = nullptr;
     LibN::NRef nRef;
+    // Milliseconds identical events are coalesced for before delivery, NO_BATCH_WINDOW delivers them one by one
+    int32_t batchWindow = NO_BATCH_WINDOW;
+    // Events read but not yet delivered, guarded by the watch mutex of the FileWatcher
+    std::vector<WatchEvent> pending;
+    std::unordered_set<std::string> pendingKeys;
+    std::chrono::steady_clock::time_point deadline;
+    // A recursive watcher watches the whole tree below fileName with a RecursiveWatcher of its own
+    bool recursive = false;
+    uint32_t maxWatches = DEFAULT_MAX_RECURSIVE_WATCHES;
+    std::shared_ptr<RecursiveWatcher> recursiveWatcher;
     explicit WatcherInfoArg(LibN::NVal jsVal) : nRef(jsVal) {}
-    ~WatcherInfoArg() = default;
+    ~WatcherInfoArg();
 };
 
 class FileWatcher : public Singleton<FileWatcher> {
@@ -65,6 +80,11 @@ private:
     uint32_t RemoveWatcherInfo(std::shared_ptr<WatcherInfoArg> arg);
     std::tuple<bool, int> CheckEventWatched(const std::string &fileName, const uint32_t &event);
     void NotifyEvent(const struct inotify_event *event, WatcherCallback callback);
+    void QueueEvent(std::shared_ptr<WatcherInfoArg> arg, WatchEvent &&event);
+    void FlushPendingEvents(WatcherCallback callback);
+    int NextFlushTimeout();
+    void UpdateWatchedWd(const std::string &fileName, int wd, uint32_t events);
+    void RemoveWatchedWd(const std::string &fileName);
     int CloseNotifyFd();
     int CloseNotifyFdLocked();
     int NotifyToWatchNewEvents(const std::string &fileName, const int &wd, const uint32_t &watchEvents);
@@ -77,8 +97,14 @@ private:
     bool closed_ = false;
     int32_t notifyFd_ = -1;
     int32_t eventFd_ = -1;
-    std::unordered_set<std::shared_ptr<WatcherInfoArg>> watcherInfoSet_;
+    std::vector<char> readBuf_;
+    // Watchers grouped by the file they watch, a file without watchers has no entry
+    std::unordered_map<std::string, std::unordered_set<std::shared_ptr<WatcherInfoArg>>> watcherInfoMap_;
     std::unordered_map<std::string, std::pair<int, uint32_t>> wdFileNameMap_;
+    // Reverse index of wdFileNameMap_, resolves the wd of an inotify event to the watched file
+    std::unordered_map<int, std::string> wdIndex_;
+    // Watchers holding events that still have to be handed to JS
+    std::unordered_set<std::shared_ptr<WatcherInfoArg>> pendingArgs_;
 };
 
 struct WatcherEntity {
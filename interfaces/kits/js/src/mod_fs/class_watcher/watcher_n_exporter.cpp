@@ -26,6 +26,7 @@
 #include "file_utils.h"
 #include "filemgmt_libhilog.h"
 #include "filemgmt_libn.h"
+#include "recursive_watcher.h"
 #include "securec.h"
 
 namespace OHOS::FileManagement::ModuleFileIO {
@@ -72,6 +73,11 @@ napi_value WatcherNExporter::Stop(napi_env env, napi_callback_info info)
         NError(EINVAL).ThrowErr(env);
         return nullptr;
     }
+    if (watchEntity->data_ && watchEntity->data_->recursiveWatcher) {
+        watchEntity->data_->recursiveWatcher->Stop();
+        watchEntity->data_->recursiveWatcher.reset();
+        return NVal::CreateUndefined(env).val_;
+    }
     int ret = FileWatcher::GetInstance().StopNotify(watchEntity->data_);
     if (ret != ERRNO_NOERR) {
         HILOGE("Failed to stopNotify errno:%{public}d", errno);
@@ -82,6 +88,59 @@ napi_value WatcherNExporter::Stop(napi_env env, napi_callback_info info)
     return NVal::CreateUndefined(env).val_;
 }
 
+static void WatcherCallbackComplete(WatcherNExporter::JSCallbackContext *callbackContext);
+
+// The WatcherInfoArg is only locked on the JS thread, so that its NRef is never released on the watcher thread
+static void PostRecursiveEvents(napi_env env, weak_ptr<WatcherInfoArg> weakArg, vector<WatchEvent> &&events,
+    bool batched)
+{
+    if (events.empty()) {
+        return;
+    }
+    auto task = [weakArg, events = move(events), batched]() mutable {
+        auto arg = weakArg.lock();
+        if (arg == nullptr || !arg->nRef) {
+            return;
+        }
+        auto *callbackContext = new (std::nothrow) WatcherNExporter::JSCallbackContext(arg->nRef);
+        if (callbackContext == nullptr) {
+            return;
+        }
+        callbackContext->env_ = arg->env;
+        callbackContext->events_ = move(events);
+        callbackContext->batched_ = batched;
+        WatcherCallbackComplete(callbackContext);
+    };
+    auto ret = napi_send_event(env, task, napi_eprio_immediate, "fs.watcher");
+    if (ret != 0) {
+        HILOGE("Failed to call napi_send_event, ret: %{public}d", ret);
+    }
+}
+
+// The tree is watched on a thread of the RecursiveWatcher, its events reach JS the same way as the shared ones
+static int StartRecursiveWatch(shared_ptr<WatcherInfoArg> arg)
+{
+    if (arg->recursiveWatcher) {
+        return ERRNO_NOERR;
+    }
+    auto recursiveWatcher = CreateSharedPtr<RecursiveWatcher>(arg->fileName, arg->events, arg->maxWatches);
+    if (recursiveWatcher == nullptr) {
+        HILOGE("Failed to request heap memory.");
+        return ENOMEM;
+    }
+    weak_ptr<WatcherInfoArg> weakArg = arg;
+    napi_env env = arg->env;
+    bool batched = arg->batchWindow != NO_BATCH_WINDOW;
+    int ret = recursiveWatcher->Start([env, weakArg, batched](vector<WatchEvent> &&events) {
+        PostRecursiveEvents(env, weakArg, move(events), batched);
+    });
+    if (ret != ERRNO_NOERR) {
+        return ret;
+    }
+    arg->recursiveWatcher = move(recursiveWatcher);
+    return ERRNO_NOERR;
+}
+
 napi_value WatcherNExporter::Start(napi_env env, napi_callback_info info)
 {
     FileFsTrace traceWatcherStart("WatcherStart");
@@ -100,7 +159,9 @@ napi_value WatcherNExporter::Start(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    int ret = FileWatcher::GetInstance().StartNotify(watchEntity->data_);
+    bool recursive = watchEntity->data_ && watchEntity->data_->recursive;
+    int ret = recursive ? StartRecursiveWatch(watchEntity->data_) :
+        FileWatcher::GetInstance().StartNotify(watchEntity->data_);
     if (ret != ERRNO_NOERR) {
         HILOGE("Failed to startNotify.");
         METRICS_ERROR("CoreFileKit.fileio.Dyn.Watcher.start.Err", NError(ret).GetErrCode());
@@ -108,8 +169,10 @@ napi_value WatcherNExporter::Start(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    auto cbExec = []() -> NError {
-        FileWatcher::GetInstance().GetNotifyEvent(WatcherCallback);
+    auto cbExec = [recursive]() -> NError {
+        if (!recursive) {
+            FileWatcher::GetInstance().GetNotifyEvent(WatcherCallback);
+        }
         return NError(ERRNO_NOERR);
     };
 
@@ -126,6 +189,24 @@ napi_value WatcherNExporter::Start(napi_env env, napi_callback_info info)
     return NAsyncWorkPromise(env, thisVar).Schedule(procedureName, cbExec, cbCompl).val_;
 }
 
+static NVal CreateWatchEvent(napi_env env, const WatchEvent &event)
+{
+    NVal objn = NVal::CreateObject(env);
+    objn.AddProp("fileName", NVal::CreateUTF8String(env, event.fileName).val_);
+    objn.AddProp("event", NVal::CreateUint32(env, event.event).val_);
+    objn.AddProp("cookie", NVal::CreateUint32(env, event.cookie).val_);
+    return objn;
+}
+
+static void CallWatcherListener(napi_env env, napi_value jsCallback, napi_value arg)
+{
+    napi_value retVal = nullptr;
+    napi_status status = napi_call_function(env, nullptr, jsCallback, 1, &arg, &retVal);
+    if (status != napi_ok) {
+        HILOGE("Failed to call napi_call_function, status: %{public}d", status);
+    }
+}
+
 static void WatcherCallbackComplete(WatcherNExporter::JSCallbackContext *callbackContext)
 {
     do {
@@ -137,47 +218,61 @@ static void WatcherCallbackComplete(WatcherNExporter::JSCallbackContext *callbac
             HILOGE("Failed to get nref reference");
             break;
         }
-        napi_handle_scope scope = nullptr;
-        napi_status status = napi_open_handle_scope(callbackContext->env_, &scope);
-        if (status != napi_ok) {
-            HILOGE("Failed to open handle scope, status: %{public}d", status);
-            break;
-        }
         napi_env env = callbackContext->env_;
-        napi_value jsCallback = callbackContext->ref_.Deref(env).val_;
-        NVal objn = NVal::CreateObject(env);
-        objn.AddProp("fileName", NVal::CreateUTF8String(env, callbackContext->fileName_).val_);
-        objn.AddProp("event", NVal::CreateUint32(env, callbackContext->event_).val_);
-        objn.AddProp("cookie", NVal::CreateUint32(env, callbackContext->cookie_).val_);
-        napi_value retVal = nullptr;
-        status = napi_call_function(env, nullptr, jsCallback, 1, &(objn.val_), &retVal);
-        if (status != napi_ok) {
-            HILOGE("Failed to call napi_call_function, status: %{public}d", status);
+        if (callbackContext->batched_) {
+            napi_handle_scope scope = nullptr;
+            napi_status status = napi_open_handle_scope(env, &scope);
+            if (status != napi_ok) {
+                HILOGE("Failed to open handle scope, status: %{public}d", status);
+                break;
+            }
+            napi_value events = nullptr;
+            napi_create_array_with_length(env, callbackContext->events_.size(), &events);
+            for (size_t i = 0; i < callbackContext->events_.size(); i++) {
+                napi_set_element(env, events, i, CreateWatchEvent(env, callbackContext->events_[i]).val_);
+            }
+            CallWatcherListener(env, callbackContext->ref_.Deref(env).val_, events);
+            status = napi_close_handle_scope(env, scope);
+            if (status != napi_ok) {
+                HILOGE("Failed to close handle scope, status: %{public}d", status);
+            }
+            break;
         }
-        status = napi_close_handle_scope(callbackContext->env_, scope);
-        if (status != napi_ok) {
-            HILOGE("Failed to close handle scope, status: %{public}d", status);
+        // One call per event as before, only the task posted to the JS thread is shared
+        for (const auto &event : callbackContext->events_) {
+            napi_handle_scope scope = nullptr;
+            napi_status status = napi_open_handle_scope(env, &scope);
+            if (status != napi_ok) {
+                HILOGE("Failed to open handle scope, status: %{public}d", status);
+                break;
+            }
+            CallWatcherListener(env, callbackContext->ref_.Deref(env).val_, CreateWatchEvent(env, event).val_);
+            status = napi_close_handle_scope(env, scope);
+            if (status != napi_ok) {
+                HILOGE("Failed to close handle scope, status: %{public}d", status);
+            }
         }
     } while (0);
     delete callbackContext;
 }
 
-void WatcherNExporter::WatcherCallback(napi_env env, NRef &callback, const std::string &fileName,
-                                       const uint32_t &event, const uint32_t &cookie)
+void WatcherNExporter::WatcherCallback(napi_env env, NRef &callback, std::vector<WatchEvent> &&events, bool batched)
 {
     if (!callback) {
         HILOGE("Failed to parse watcher callback");
         return;
     }
+    if (events.empty()) {
+        return;
+    }
 
     JSCallbackContext *callbackContext = new (std::nothrow) JSCallbackContext(callback);
     if (callbackContext == nullptr) {
         return;
     }
     callbackContext->env_ = env;
-    callbackContext->fileName_ = fileName;
-    callbackContext->event_ = event;
-    callbackContext->cookie_ = cookie;
+    callbackContext->events_ = std::move(events);
+    callbackContext->batched_ = batched;
     auto task = [callbackContext] () {
         WatcherCallbackComplete(callbackContext);
     };
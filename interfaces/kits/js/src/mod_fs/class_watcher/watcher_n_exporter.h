@@ -16,6 +16,7 @@
 #ifndef INTERFACES_KITS_JS_SRC_MOD_FILEIO_CLASS_WATCHER_WATCHER_N_EXPORTER_H
 #define INTERFACES_KITS_JS_SRC_MOD_FILEIO_CLASS_WATCHER_WATCHER_N_EXPORTER_H
 #include <memory>
+#include <vector>
 
 #include "filemgmt_libn.h"
 #include "watcher_entity.h"
@@ -31,9 +32,8 @@ public:
     public:
         napi_env env_ = nullptr;
         NRef &ref_;
-        std::string fileName_;
-        uint32_t event_ = 0;
-        uint32_t cookie_ = 0;
+        std::vector<WatchEvent> events_;
+        bool batched_ = false;
     };
 
     inline static const std::string className_ = "Watcher";
@@ -44,8 +44,7 @@ public:
     static napi_value Constructor(napi_env env, napi_callback_info info);
     static napi_value Start(napi_env env, napi_callback_info info);
     static napi_value Stop(napi_env env, napi_callback_info info);
-    static void WatcherCallback(napi_env env, NRef &callback, const std::string &fileName, const uint32_t &event,
-                                const uint32_t &cookie);
+    static void WatcherCallback(napi_env env, NRef &callback, std::vector<WatchEvent> &&events, bool batched);
 
     WatcherNExporter(napi_env env, napi_value exports);
     ~WatcherNExporter() override;
@@ -22,17 +22,16 @@
 #include <unistd.h>
 #include <vector>
 
+#include "dir_copier.h"
 #include "file_utils.h"
 #include "filemgmt_libhilog.h"
+#include "listfile_walker.h"
 
 namespace OHOS {
 namespace FileManagement {
 namespace ModuleFileIO {
 using namespace std;
 
-static int RecurCopyDir(
-    const string &srcPath, const string &destPath, const int mode, vector<struct ConflictFiles> &errfiles);
-
 static bool EndWithSlash(const string &src)
 {
     return src.back() == '/';
@@ -80,136 +79,8 @@ static tuple<bool, int32_t> ParseAndCheckOperand(const string &src, const string
     return { true, modeValue };
 }
 
-static int MakeDir(const string &path)
-{
-    filesystem::path destDir(path);
-    error_code errCode;
-    if (!filesystem::create_directory(destDir, errCode)) {
-        HILOGE("Failed to create directory, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return ERRNO_NOERR;
-}
-
-struct NameList {
-    struct dirent **namelist = { nullptr };
-    int direntNum = 0;
-};
-
-static int RemoveFile(const string &destPath)
-{
-    filesystem::path destFile(destPath);
-    error_code errCode;
-    if (!filesystem::remove(destFile, errCode)) {
-        HILOGE("Failed to remove file with path, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return ERRNO_NOERR;
-}
-
-static void Deleter(struct NameList *arg)
-{
-    for (int i = 0; i < arg->direntNum; i++) {
-        free((arg->namelist)[i]);
-        (arg->namelist)[i] = nullptr;
-    }
-    free(arg->namelist);
-    arg->namelist = nullptr;
-    delete arg;
-    arg = nullptr;
-}
-
-static int CopyFile(const string &src, const string &dest, const int mode)
-{
-    filesystem::path dstPath(dest);
-    error_code errCode;
-    if (filesystem::exists(dstPath, errCode)) {
-        int ret = (mode == DIRMODE_FILE_COPY_THROW_ERR) ? EEXIST : RemoveFile(dest);
-        if (ret) {
-            HILOGE("Failed to copy file due to existing destPath with throw err");
-            return ret;
-        }
-    }
-    if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("Fs exists fail, errcode is %{public}d", errCode.value());
-        return errCode.value();
-    }
-    filesystem::path srcPath(src);
-    if (!filesystem::copy_file(srcPath, dstPath, filesystem::copy_options::overwrite_existing, errCode)) {
-        HILOGE("Failed to copy file, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return ERRNO_NOERR;
-}
-
-static int CopySubDir(
-    const string &srcPath, const string &destPath, const int mode, vector<struct ConflictFiles> &errfiles)
-{
-    error_code errCode;
-    if (!filesystem::exists(destPath, errCode) && errCode.value() == ERRNO_NOERR) {
-        int res = MakeDir(destPath);
-        if (res != ERRNO_NOERR) {
-            HILOGE("Failed to mkdir");
-            return res;
-        }
-    } else if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("Fs exists fail, errcode is %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return RecurCopyDir(srcPath, destPath, mode, errfiles);
-}
-
-static int FilterFunc(const struct dirent *filename)
-{
-    if (string_view(filename->d_name) == "." || string_view(filename->d_name) == "..") {
-        return DISMATCH;
-    }
-    return MATCH;
-}
-
-static int RecurCopyDir(
-    const string &srcPath, const string &destPath, const int mode, vector<struct ConflictFiles> &errfiles)
-{
-    unique_ptr<struct NameList, decltype(Deleter) *> pNameList = { new (nothrow) struct NameList, Deleter };
-    if (pNameList == nullptr) {
-        HILOGE("Failed to request heap memory.");
-        return ENOMEM;
-    }
-    int num = scandir(srcPath.c_str(), &(pNameList->namelist), FilterFunc, alphasort);
-    if (num < 0) {
-        HILOGE("Scandir fail errno is %{public}d", errno);
-        return errno;
-    }
-    pNameList->direntNum = num;
-
-    for (int i = 0; i < num; i++) {
-        if ((pNameList->namelist[i])->d_type == DT_DIR) {
-            string srcTemp = srcPath + '/' + string((pNameList->namelist[i])->d_name);
-            string destTemp = destPath + '/' + string((pNameList->namelist[i])->d_name);
-            int res = CopySubDir(srcTemp, destTemp, mode, errfiles);
-            if (res == ERRNO_NOERR) {
-                continue;
-            }
-            return res;
-        } else {
-            string src = srcPath + '/' + string((pNameList->namelist[i])->d_name);
-            string dest = destPath + '/' + string((pNameList->namelist[i])->d_name);
-            int res = CopyFile(src, dest, mode);
-            if (res == EEXIST) {
-                errfiles.emplace_back(src, dest);
-                continue;
-            } else if (res == ERRNO_NOERR) {
-                continue;
-            } else {
-                HILOGE("Failed to copy file for error %{public}d", res);
-                return res;
-            }
-        }
-    }
-    return ERRNO_NOERR;
-}
-
-static int CopyDirFunc(const string &src, const string &dest, const int mode, vector<struct ConflictFiles> &errfiles)
+static int CopyDirFunc(const string &src, const string &dest, const int mode, size_t workerNum,
+    vector<struct ConflictFiles> &errfiles)
 {
     size_t found = string(src).rfind('/');
     if (found == string::npos) {
@@ -217,18 +88,14 @@ static int CopyDirFunc(const string &src, const string &dest, const int mode, ve
     }
     string dirName = string(src).substr(found);
     string destStr = dest + dirName;
-    error_code errCode;
-    if (!filesystem::exists(destStr, errCode) && errCode.value() == ERRNO_NOERR) {
-        int res = MakeDir(destStr);
-        if (res != ERRNO_NOERR) {
-            HILOGE("Failed to mkdir");
-            return res;
-        }
-    } else if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("Fs exists fail, errcode is %{public}d", errCode.value());
-        return errCode.value();
+    DirCopyOptions options;
+    options.workerNum = workerNum;
+    options.replace = (mode == DIRMODE_FILE_COPY_REPLACE);
+    vector<DirCopyConflict> conflicts;
+    int res = DirCopier(options).Copy(src, destStr, conflicts);
+    for (auto &conflict : conflicts) {
+        errfiles.emplace_back(conflict.srcFile, conflict.destFile);
     }
-    int res = RecurCopyDir(src, destStr, mode, errfiles);
     if (!errfiles.empty() && res == ERRNO_NOERR) {
         return EEXIST;
     }
@@ -243,7 +110,7 @@ struct CopyDirResult CopyDirCore::DoCopyDir(const string &src, const string &des
     }
 
     vector<struct ConflictFiles> errfiles = {};
-    int ret = CopyDirFunc(src, dest, modeValue, errfiles);
+    int ret = CopyDirFunc(src, dest, modeValue, ListFileWalker::DefaultWorkerNum(), errfiles);
     if (ret == EEXIST && modeValue == DIRMODE_FILE_COPY_THROW_ERR) {
         return { FsResult<void>::Error(EEXIST), make_optional<vector<struct ConflictFiles>>(move(errfiles)) };
     } else if (ret) {
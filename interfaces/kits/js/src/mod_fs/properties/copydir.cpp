@@ -23,8 +23,11 @@
 #include <vector>
 
 #include "common_func.h"
+#include "dir_copier.h"
 #include "file_utils.h"
 #include "filemgmt_libhilog.h"
+#include "listfile_walker.h"
+#include "napi/dir_tree_options_napi.h"
 
 #include "file_fs_metrics.h"
 
@@ -37,9 +40,6 @@ using namespace OHOS::FileManagement::LibN;
 static string g_parseEmsg = "CopyDir failed. Possible causes: 1. SrcPath or DestPath is invalid. "
         "2. SrcPath or DestPath is not exist. 3.SrcPath or DestPath is not directory.";
 
-static int RecurCopyDir(const string &srcPath, const string &destPath, const int mode,
-    vector<struct ConflictFiles> &errfiles);
-
 static bool EndWithSlash(const string &src)
 {
     return src.back() == '/';
@@ -62,184 +62,53 @@ static bool AllowToCopy(const string &src, const string &dest)
     return true;
 }
 
-static tuple<bool, unique_ptr<char[]>, unique_ptr<char[]>, int> ParseAndCheckJsOperand(napi_env env,
+static tuple<bool, unique_ptr<char[]>, unique_ptr<char[]>, DirTreeOptions> ParseAndCheckJsOperand(napi_env env,
     const NFuncArg &funcArg)
 {
     auto [resGetFirstArg, src, ignore] = NVal(env, funcArg[NARG_POS::FIRST]).ToUTF8StringPath();
     std::error_code errCode;
     if (!resGetFirstArg || !filesystem::is_directory(filesystem::status(src.get(), errCode))) {
         HILOGE("Invalid src, errCode = %{public}d", errCode.value());
-        return { false, nullptr, nullptr, 0 };
+        return { false, nullptr, nullptr, DirTreeOptions() };
     }
     auto [resGetSecondArg, dest, unused] = NVal(env, funcArg[NARG_POS::SECOND]).ToUTF8StringPath();
     if (!resGetSecondArg || !filesystem::is_directory(filesystem::status(dest.get(), errCode))) {
         HILOGE("Invalid dest, errCode = %{public}d", errCode.value());
-        return { false, nullptr, nullptr, 0 };
+        return { false, nullptr, nullptr, DirTreeOptions() };
     }
     if (!AllowToCopy(src.get(), dest.get())) {
-        return { false, nullptr, nullptr, 0 };
+        return { false, nullptr, nullptr, DirTreeOptions() };
     }
-    int mode = 0;
+    DirTreeOptions options;
+    options.mode = DIRMODE_FILE_COPY_THROW_ERR;
+    options.workerNum = ListFileWalker::DefaultWorkerNum();
     if (funcArg.GetArgc() >= NARG_CNT::THREE) {
-        bool resGetThirdArg = false;
-        tie(resGetThirdArg, mode) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32(mode);
-        if (!resGetThirdArg || (mode < COPYMODE_MIN || mode > COPYMODE_MAX)) {
+        bool resGetThirdArg = DirTreeOptionsNapi::Parse(env, NVal(env, funcArg[NARG_POS::THIRD]), options);
+        if (!resGetThirdArg || (options.mode < COPYMODE_MIN || options.mode > COPYMODE_MAX)) {
             HILOGE("Invalid mode");
-            return { false, nullptr, nullptr, 0 };
+            return { false, nullptr, nullptr, DirTreeOptions() };
         }
     }
-    return { true, move(src), move(dest), mode };
-}
-
-static int MakeDir(const string &path)
-{
-    filesystem::path destDir(path);
-    std::error_code errCode;
-    if (!filesystem::create_directory(destDir, errCode)) {
-        HILOGE("Failed to create directory, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return ERRNO_NOERR;
-}
-
-struct NameList {
-    struct dirent** namelist = { nullptr };
-    int direntNum = 0;
-};
-
-static int RemoveFile(const string& destPath)
-{
-    filesystem::path destFile(destPath);
-    std::error_code errCode;
-    if (!filesystem::remove(destFile, errCode)) {
-        HILOGE("Failed to remove file with path, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return ERRNO_NOERR;
-}
-
-static void Deleter(struct NameList *arg)
-{
-    for (int i = 0; i < arg->direntNum; i++) {
-        free((arg->namelist)[i]);
-        (arg->namelist)[i] = nullptr;
-    }
-    free(arg->namelist);
-    arg->namelist = nullptr;
-    delete arg;
-    arg = nullptr;
-}
-
-static int CopyFile(const string &src, const string &dest, const int mode)
-{
-    filesystem::path dstPath(dest);
-    std::error_code errCode;
-    if (filesystem::exists(dstPath, errCode)) {
-        int ret = (mode == DIRMODE_FILE_COPY_THROW_ERR) ? EEXIST : RemoveFile(dest);
-        if (ret) {
-            HILOGE("Failed to copy file due to existing destPath with throw err");
-            return ret;
-        }
-    }
-    if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("fs exists fail, errcode is %{public}d", errCode.value());
-        return errCode.value();
-    }
-    filesystem::path srcPath(src);
-    if (!filesystem::copy_file(srcPath, dstPath, filesystem::copy_options::overwrite_existing, errCode)) {
-        HILOGE("Failed to copy file, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return ERRNO_NOERR;
+    return { true, move(src), move(dest), options };
 }
 
-static int CopySubDir(const string &srcPath, const string &destPath, const int mode,
+static int CopyDirFunc(const string &src, const string &dest, const int mode, size_t workerNum,
     vector<struct ConflictFiles> &errfiles)
-{
-    std::error_code errCode;
-    if (!filesystem::exists(destPath, errCode) && errCode.value() == ERRNO_NOERR) {
-        int res = MakeDir(destPath);
-        if (res != ERRNO_NOERR) {
-            HILOGE("Failed to mkdir");
-            return res;
-        }
-    } else if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("fs exists fail, errcode is %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return RecurCopyDir(srcPath, destPath, mode, errfiles);
-}
-
-static int FilterFunc(const struct dirent *filename)
-{
-    if (string_view(filename->d_name) == "." || string_view(filename->d_name) == "..") {
-        return DISMATCH;
-    }
-    return MATCH;
-}
-
-static int RecurCopyDir(const string &srcPath, const string &destPath, const int mode,
-    vector<struct ConflictFiles> &errfiles)
-{
-    unique_ptr<struct NameList, decltype(Deleter)*> pNameList = {new (nothrow) struct NameList, Deleter};
-    if (pNameList == nullptr) {
-        HILOGE("Failed to request heap memory.");
-        return ENOMEM;
-    }
-    int num = scandir(srcPath.c_str(), &(pNameList->namelist), FilterFunc, alphasort);
-    if (num < 0) {
-        HILOGE("scandir fail errno is %{public}d", errno);
-        return errno;
-    }
-    pNameList->direntNum = num;
-
-    for (int i = 0; i < num; i++) {
-        if ((pNameList->namelist[i])->d_type == DT_DIR) {
-            string srcTemp = srcPath + '/' + string((pNameList->namelist[i])->d_name);
-            string destTemp = destPath + '/' + string((pNameList->namelist[i])->d_name);
-            int res = CopySubDir(srcTemp, destTemp, mode, errfiles);
-            if (res == ERRNO_NOERR) {
-                continue;
-            }
-            return res;
-        } else {
-            string src = srcPath + '/' + string((pNameList->namelist[i])->d_name);
-            string dest = destPath + '/' + string((pNameList->namelist[i])->d_name);
-            int res = CopyFile(src, dest, mode);
-            if (res == EEXIST) {
-                errfiles.emplace_back(src, dest);
-                continue;
-            } else if (res == ERRNO_NOERR) {
-                continue;
-            } else {
-                HILOGE("Failed to copy file for error %{public}d", res);
-                return res;
-            }
-        }
-    }
-    return ERRNO_NOERR;
-}
-
-static int CopyDirFunc(const string &src, const string &dest, const int mode, vector<struct ConflictFiles> &errfiles)
 {
     size_t found = string(src).rfind('/');
-    if (found == std::string::npos) {
+    if (found == string::npos) {
         return EINVAL;
     }
     string dirName = string(src).substr(found);
     string destStr = dest + dirName;
-    std::error_code errCode;
-    if (!filesystem::exists(destStr, errCode) && errCode.value() == ERRNO_NOERR) {
-        int res = MakeDir(destStr);
-        if (res != ERRNO_NOERR) {
-            HILOGE("Failed to mkdir");
-            return res;
-        }
-    } else if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("fs exists fail, errcode is %{public}d", errCode.value());
-        return errCode.value();
+    DirCopyOptions options;
+    options.workerNum = workerNum;
+    options.replace = (mode == DIRMODE_FILE_COPY_REPLACE);
+    vector<DirCopyConflict> conflicts;
+    int res = DirCopier(options).Copy(src, destStr, conflicts);
+    for (auto &conflict : conflicts) {
+        errfiles.emplace_back(conflict.srcFile, conflict.destFile);
     }
-    int res = RecurCopyDir(src, destStr, mode, errfiles);
     if (!errfiles.empty() && res == ERRNO_NOERR) {
         return EEXIST;
     }
@@ -275,7 +144,7 @@ napi_value CopyDir::Sync(napi_env env, napi_callback_info info)
         NError(EINVAL, "CopyDir failed, number of arguments unmatched.").ThrowErr(env);
         return nullptr;
     }
-    auto [succ, src, dest, mode] = ParseAndCheckJsOperand(env, funcArg);
+    auto [succ, src, dest, options] = ParseAndCheckJsOperand(env, funcArg);
     if (!succ) {
         NError(EINVAL, g_parseEmsg).ThrowErr(env);
         return nullptr;
@@ -284,8 +153,8 @@ napi_value CopyDir::Sync(napi_env env, napi_callback_info info)
     METRICS_COUNT("CoreFileKit.fileio.Dyn.copyDirSync");
 
     vector<struct ConflictFiles> errfiles = {};
-    int ret = CopyDirFunc(src.get(), dest.get(), mode, errfiles);
-    if (ret == EEXIST && mode == DIRMODE_FILE_COPY_THROW_ERR) {
+    int ret = CopyDirFunc(src.get(), dest.get(), options.mode, options.workerNum, errfiles);
+    if (ret == EEXIST && options.mode == DIRMODE_FILE_COPY_THROW_ERR) {
         METRICS_ERROR("CoreFileKit.fileio.Dyn.copyDirSync.Err", NError(errno).GetErrCode());
         NError(ret).ThrowErrAddData(env, EEXIST, PushErrFilesInData(env, errfiles));
         return nullptr;
@@ -313,7 +182,7 @@ napi_value CopyDir::Async(napi_env env, napi_callback_info info)
         NError(EINVAL, "CopyDir failed. Number of arguments unmatched").ThrowErr(env);
         return nullptr;
     }
-    auto [succ, src, dest, mode] = ParseAndCheckJsOperand(env, funcArg);
+    auto [succ, src, dest, options] = ParseAndCheckJsOperand(env, funcArg);
     if (!succ) {
         NError(EINVAL, g_parseEmsg).ThrowErr(env);
         return nullptr;
@@ -325,15 +194,15 @@ napi_value CopyDir::Async(napi_env env, napi_callback_info info)
         return nullptr;
     }
     METRICS_COUNT("CoreFileKit.fileio.Dyn.copyDir");
-    auto cbExec = [srcPath = string(src.get()), destPath = string(dest.get()), mode = mode, arg]() -> NError {
-        arg->errNo = CopyDirFunc(srcPath, destPath, mode, arg->errfiles);
+    auto cbExec = [srcPath = string(src.get()), destPath = string(dest.get()), options = options, arg]() -> NError {
+        arg->errNo = CopyDirFunc(srcPath, destPath, options.mode, options.workerNum, arg->errfiles);
         if (arg->errNo) {
             METRICS_ERROR("CoreFileKit.fileio.Dyn.copyDir.Err", NError(errno).GetErrCode());
             return NError(arg->errNo);
         }
         return NError(ERRNO_NOERR);
     };
-    auto cbComplCallback = [arg, mode = mode](napi_env env, NError err) -> NVal {
+    auto cbComplCallback = [arg, mode = options.mode](napi_env env, NError err) -> NVal {
         if (arg->errNo == EEXIST && mode == DIRMODE_FILE_COPY_THROW_ERR) {
             napi_value data = err.GetNapiErr(env);
             napi_status status = napi_set_named_property(env, data, FILEIO_TAG_ERR_DATA.c_str(),
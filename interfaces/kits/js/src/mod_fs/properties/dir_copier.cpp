@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dir_copier.h"
+
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+#include "dir_tree_ops.h"
+#include "fd_guard.h"
+#include "filemgmt_libfs.h"
+#include "filemgmt_libhilog.h"
+#include "listfile_walker.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+using DistributedFS::FDGuard;
+
+namespace {
+constexpr int DIR_OPEN_FLAGS = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+
+vector<string> SplitPath(const string &path)
+{
+    vector<string> names;
+    size_t begin = 0;
+    while (begin <= path.size()) {
+        size_t end = path.find('/', begin);
+        if (end == string::npos) {
+            end = path.size();
+        }
+        if (end > begin) {
+            names.emplace_back(path, begin, end - begin);
+        }
+        begin = end + 1;
+    }
+    return names;
+}
+
+// Conflicts are only ever files, so comparing the names level by level with alphasort's strcoll gives the order in
+// which the serial copy reported them: depth first, every directory in alphasort order
+void SortInVisitOrder(vector<pair<vector<string>, DirCopyConflict>> &found)
+{
+    auto nameLess = [](const string &a, const string &b) { return strcoll(a.c_str(), b.c_str()) < 0; };
+    sort(found.begin(), found.end(), [&nameLess](const auto &a, const auto &b) {
+        return lexicographical_compare(a.first.begin(), a.first.end(), b.first.begin(), b.first.end(), nameLess);
+    });
+}
+} // namespace
+
+DirCopier::DirCopier(const DirCopyOptions &options) : options_(options)
+{
+    if (options_.workerNum == 0) {
+        options_.workerNum = 1;
+    }
+}
+
+bool DirCopier::Stopped() const
+{
+    return stop_.load(memory_order_acquire);
+}
+
+void DirCopier::Stop(int err)
+{
+    if (err != ERRNO_NOERR) {
+        int expected = ERRNO_NOERR;
+        err_.compare_exchange_strong(expected, err);
+    }
+    stop_.store(true, memory_order_release);
+    lock_guard<mutex> lock(idleMutex_);
+    idleCv_.notify_all();
+}
+
+void DirCopier::Push(Worker &worker, DirTask &&task)
+{
+    pending_.fetch_add(1);
+    {
+        lock_guard<mutex> lock(worker.mutex);
+        worker.tasks.push_back(move(task));
+    }
+    queued_.fetch_add(1);
+    lock_guard<mutex> lock(idleMutex_);
+    idleCv_.notify_one();
+}
+
+// The owner takes its newest directory to stay depth first, other workers steal the oldest one
+bool DirCopier::Pop(size_t id, DirTask &task)
+{
+    for (size_t i = 0; i < options_.workerNum; i++) {
+        Worker &victim = *workers_[(id + i) % options_.workerNum];
+        lock_guard<mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            task = move(victim.tasks.back());
+            victim.tasks.pop_back();
+        } else {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+        queued_.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+// Lists the regular files of src that already exist in dest, the sink of the walker is never called concurrently.
+// A subtree whose directory is missing in dest cannot hold conflicts and is not walked
+int DirCopier::PreScan(const string &src, const string &dest)
+{
+    ListFileWalkOptions walkOptions;
+    walkOptions.recursion = true;
+    walkOptions.workerNum = options_.workerNum;
+    walkOptions.descend = [&dest](const ListFileWalkEntry &entry) {
+        string destPath = dest + entry.relDir + '/' + entry.name;
+        struct stat info;
+        return stat(destPath.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    };
+    ListFileWalker walker(walkOptions,
+        [&dest](const ListFileWalkEntry &entry) {
+            string destPath = dest + entry.relDir + '/' + entry.name;
+            struct stat info;
+            return fstatat(AT_FDCWD, destPath.c_str(), &info, AT_SYMLINK_NOFOLLOW) == 0;
+        },
+        [this, &dest](vector<string> &&batch) {
+            for (const auto &relPath : batch) {
+                existing_.insert(dest + relPath);
+            }
+        });
+    int ret = walker.Walk(src);
+    if (ret != ERRNO_NOERR) {
+        HILOGE("Failed to scan for conflicts, error code: %{public}d", ret);
+    }
+    return ret;
+}
+
+int DirCopier::CopyFileAt(Worker &worker, int srcDirFd, int destDirFd, const char *name, const DirTask &task)
+{
+    if (!existing_.empty() && existing_.count(task.destPath + '/' + name) != 0) {
+        worker.conflicts.push_back({ task.srcPath + '/' + name, task.destPath + '/' + name });
+        return ERRNO_NOERR;
+    }
+    FDGuard srcFd(openat(srcDirFd, name, O_RDONLY | O_CLOEXEC));
+    if (!srcFd) {
+        int err = errno;
+        HILOGE("Failed to open src file, error code: %{public}d", err);
+        return err;
+    }
+    struct stat info;
+    if (fstat(srcFd.GetFD(), &info) != 0) {
+        return errno;
+    }
+    if (options_.replace && unlinkat(destDirFd, name, 0) != 0 && errno != ENOENT &&
+        (errno != EISDIR || unlinkat(destDirFd, name, AT_REMOVEDIR) != 0)) {
+        int err = errno;
+        HILOGE("Failed to remove dest file, error code: %{public}d", err);
+        return err;
+    }
+    mode_t perm = info.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO);
+    FDGuard destFd(openat(destDirFd, name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, perm));
+    if (!destFd) {
+        int err = errno;
+        // Not a regular file or created since the pre-scan, left in place all the same
+        if (err == EEXIST && !options_.replace) {
+            worker.conflicts.push_back({ task.srcPath + '/' + name, task.destPath + '/' + name });
+            return ERRNO_NOERR;
+        }
+        HILOGE("Failed to create dest file, error code: %{public}d", err);
+        return err;
+    }
+    int ret = DirTreeOps::CopyFileData(srcFd.GetFD(), destFd.GetFD(), info.st_size);
+    if (ret != ERRNO_NOERR) {
+        HILOGE("Failed to copy file, error code: %{public}d", ret);
+        return ret;
+    }
+    // The permissions given at creation are masked by the umask
+    if (fchmod(destFd.GetFD(), perm) != 0) {
+        return errno;
+    }
+    return ERRNO_NOERR;
+}
+
+int DirCopier::CopyDir(Worker &worker, const DirTask &task)
+{
+    FDGuard srcFd(open(task.srcPath.c_str(), DIR_OPEN_FLAGS));
+    if (!srcFd) {
+        int err = errno;
+        HILOGE("Failed to open src dir, error code: %{public}d", err);
+        return err;
+    }
+    FDGuard destFd(open(task.destPath.c_str(), DIR_OPEN_FLAGS));
+    if (!destFd) {
+        int err = errno;
+        HILOGE("Failed to open dest dir, error code: %{public}d", err);
+        return err;
+    }
+    int ret = ERRNO_NOERR;
+    int scanRet = ListFileWalker::ForEachDirent(srcFd.GetFD(), worker.direntBuf,
+        [this, &worker, &task, &srcFd, &destFd, &ret](const char *name, unsigned char direntType) {
+        if (Stopped()) {
+            return false;
+        }
+        unsigned char type = ListFileWalker::ResolveType(srcFd.GetFD(), name, direntType);
+        if (type != DT_DIR) {
+            ret = CopyFileAt(worker, srcFd.GetFD(), destFd.GetFD(), name, task);
+            return ret == ERRNO_NOERR;
+        }
+        if (mkdirat(destFd.GetFD(), name, MAKE_DIRS_DEFAULT_MODE) != 0 && errno != EEXIST) {
+            ret = errno;
+            HILOGE("Failed to create directory, error code: %{public}d", ret);
+            return false;
+        }
+        Push(worker, { task.srcPath + '/' + name, task.destPath + '/' + name });
+        return true;
+    });
+    return (scanRet != ERRNO_NOERR) ? scanRet : ret;
+}
+
+void DirCopier::Run(size_t id)
+{
+    Worker &worker = *workers_[id];
+    DirTask task;
+    while (!Stopped()) {
+        if (!Pop(id, task)) {
+            unique_lock<mutex> lock(idleMutex_);
+            idleCv_.wait(lock, [this] { return Stopped() || pending_.load() == 0 || queued_.load() > 0; });
+            if (pending_.load() == 0) {
+                break;
+            }
+            continue;
+        }
+        int ret = CopyDir(worker, task);
+        if (ret != ERRNO_NOERR) {
+            Stop(ret);
+        }
+        if (pending_.fetch_sub(1) == 1) {
+            lock_guard<mutex> lock(idleMutex_);
+            idleCv_.notify_all();
+        }
+    }
+}
+
+int DirCopier::Copy(const string &src, const string &dest, vector<DirCopyConflict> &conflicts)
+{
+    if (mkdir(dest.c_str(), MAKE_DIRS_DEFAULT_MODE) != 0) {
+        if (errno != EEXIST) {
+            int err = errno;
+            HILOGE("Failed to create directory, error code: %{public}d", err);
+            return err;
+        }
+        // Only an existing destination can hold conflicts
+        if (!options_.replace) {
+            int ret = PreScan(src, dest);
+            if (ret != ERRNO_NOERR) {
+                return ret;
+            }
+        }
+    }
+    for (size_t i = 0; i < options_.workerNum; i++) {
+        workers_.push_back(make_unique<Worker>());
+    }
+
+    // The top directory is copied on the calling thread, helpers are only started when it has subdirectories
+    pending_.store(1);
+    int ret = CopyDir(*workers_[0], { src, dest });
+    if (ret != ERRNO_NOERR) {
+        Stop(ret);
+    }
+    pending_.fetch_sub(1);
+
+    if (!Stopped() && queued_.load() > 0) {
+        vector<thread> helpers;
+        for (size_t i = 1; i < options_.workerNum; i++) {
+            try {
+                helpers.emplace_back(&DirCopier::Run, this, i);
+            } catch (const system_error &e) {
+                HILOGE("Failed to start copyDir worker: %{public}s", e.what());
+                break;
+            }
+        }
+        Run(0);
+        for (auto &helper : helpers) {
+            helper.join();
+        }
+    }
+    vector<pair<vector<string>, DirCopyConflict>> found;
+    for (auto &worker : workers_) {
+        for (auto &conflict : worker->conflicts) {
+            found.emplace_back(SplitPath(conflict.srcFile), move(conflict));
+        }
+    }
+    SortInVisitOrder(found);
+    for (auto &item : found) {
+        conflicts.push_back(move(item.second));
+    }
+    workers_.clear();
+    return err_.load();
+}
+
+} // namespace OHOS::FileManagement::ModuleFileIO
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_DIR_COPIER_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_DIR_COPIER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace OHOS::FileManagement::ModuleFileIO {
+
+struct DirCopyConflict {
+    std::string srcFile;
+    std::string destFile;
+};
+
+struct DirCopyOptions {
+    // Number of threads copying the tree, the calling thread is one of them
+    size_t workerNum = 1;
+    // Existing files are replaced instead of being left in place and reported
+    bool replace = false;
+};
+
+/*
+ * Copies the contents of a directory tree with several threads, sharing the directories between per worker deques
+ * as ListFileWalker does. A directory is created before it is queued, so its files can be copied by any worker. The
+ * data goes through DirTreeOps::CopyFileData and the permissions of every file are kept. When existing files are
+ * kept, the files already present in dest are listed by a parallel pre-scan before any data is copied, the copy
+ * then skips them instead of probing every destination. The first error stops the copy, unlike the serial copy the
+ * files already copied by then depend on how the directories were shared between the workers.
+ */
+class DirCopier {
+public:
+    explicit DirCopier(const DirCopyOptions &options);
+    ~DirCopier() = default;
+
+    // Copies everything below src into dest, which is created when missing. Returns 0 or an errno, the files left in
+    // place are added to conflicts in the order the serial copy reported them
+    int Copy(const std::string &src, const std::string &dest, std::vector<DirCopyConflict> &conflicts);
+
+private:
+    struct DirTask {
+        std::string srcPath;
+        std::string destPath;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<DirTask> tasks;
+        std::vector<char> direntBuf;
+        std::vector<DirCopyConflict> conflicts;
+    };
+
+    int PreScan(const std::string &src, const std::string &dest);
+    int CopyDir(Worker &worker, const DirTask &task);
+    int CopyFileAt(Worker &worker, int srcDirFd, int destDirFd, const char *name, const DirTask &task);
+    void Push(Worker &worker, DirTask &&task);
+    bool Pop(size_t id, DirTask &task);
+    void Run(size_t id);
+    void Stop(int err);
+    bool Stopped() const;
+
+    DirCopyOptions options_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    // Destination paths found by the pre-scan, only read once the copy started
+    std::unordered_set<std::string> existing_;
+    std::mutex idleMutex_;
+    std::condition_variable idleCv_;
+    std::atomic<size_t> pending_ { 0 };
+    std::atomic<size_t> queued_ { 0 };
+    std::atomic<bool> stop_ { false };
+    std::atomic<int> err_ { 0 };
+};
+
+} // namespace OHOS::FileManagement::ModuleFileIO
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_DIR_COPIER_H
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dir_tree_ops.h"
+
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "dir_copier.h"
+#include "fd_guard.h"
+#include "filemgmt_libfs.h"
+#include "filemgmt_libhilog.h"
+#include "listfile_walker.h"
+#include "tree_remover.h"
+
+#ifndef RENAME_NOREPLACE
+#define RENAME_NOREPLACE (1 << 0)
+#endif
+
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+using DistributedFS::FDGuard;
+
+namespace {
+constexpr int DIR_OPEN_FLAGS = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+constexpr size_t COPY_CHUNK_SIZE = 1024 * 1024;
+
+using DirEntries = vector<pair<string, unsigned char>>;
+
+struct MoveContext {
+    int mode;
+    deque<ErrFiles> &errFiles;
+    // getdents buffer shared by every directory of the walk, entries are collected before descending
+    vector<char> direntBuf;
+};
+} // namespace
+
+static int ReadEntries(int dirFd, vector<char> &buf, DirEntries &entries)
+{
+    return ListFileWalker::ForEachDirent(dirFd, buf, [&entries](const char *name, unsigned char type) {
+        entries.emplace_back(name, type);
+        return true;
+    });
+}
+
+static bool IsDirAt(int dirFd, const char *name)
+{
+    struct stat info;
+    return fstatat(dirFd, name, &info, 0) == 0 && S_ISDIR(info.st_mode);
+}
+
+int DirTreeOps::MakeDirs(const string &path, mode_t mode)
+{
+    if (path.empty()) {
+        return ENOENT;
+    }
+    if (mkdir(path.c_str(), mode) == 0) {
+        return ERRNO_NOERR;
+    }
+    int err = errno;
+    if (err == EEXIST) {
+        return IsDirAt(AT_FDCWD, path.c_str()) ? ERRNO_NOERR : EEXIST;
+    }
+    if (err != ENOENT) {
+        return err;
+    }
+    // Some parents are missing, create the components one by one below the fd of the previous one
+    FDGuard parent;
+    int parentFd = AT_FDCWD;
+    if (path[0] == '/') {
+        parent.SetFD(open("/", O_PATH | O_DIRECTORY | O_CLOEXEC));
+        if (!parent) {
+            return errno;
+        }
+        parentFd = parent.GetFD();
+    }
+    size_t pos = 0;
+    while (pos < path.size()) {
+        size_t next = path.find('/', pos);
+        if (next == string::npos) {
+            next = path.size();
+        }
+        string name = path.substr(pos, next - pos);
+        pos = next + 1;
+        if (name.empty() || name == ".") {
+            continue;
+        }
+        if (mkdirat(parentFd, name.c_str(), mode) != 0 && errno != EEXIST) {
+            return errno;
+        }
+        if (path.find_first_not_of('/', next) == string::npos) {
+            return IsDirAt(parentFd, name.c_str()) ? ERRNO_NOERR : EEXIST;
+        }
+        int childFd = openat(parentFd, name.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+        if (childFd < 0) {
+            return (errno == ENOTDIR) ? EEXIST : errno;
+        }
+        // SetFD does not close the fd it replaces
+        FDGuard previous(parent.GetFD());
+        parent.SetFD(childFd);
+        parentFd = childFd;
+    }
+    return ERRNO_NOERR;
+}
+
+static int RemoveContents(int dirFd, vector<char> &buf);
+
+// Removes the entry of the directory whatever its type, a directory is emptied through its fd first
+static int RemoveAt(int dirFd, const char *name, unsigned char type, vector<char> &buf)
+{
+    int unlinkErr = ERRNO_NOERR;
+    if (type != DT_DIR) {
+        if (unlinkat(dirFd, name, 0) == 0) {
+            return ERRNO_NOERR;
+        }
+        unlinkErr = errno;
+        // EPERM is what some file systems return for unlink on a directory, it is told apart by the open below
+        if (unlinkErr != EISDIR && unlinkErr != EPERM) {
+            return unlinkErr;
+        }
+    }
+    FDGuard childFd(openat(dirFd, name, DIR_OPEN_FLAGS | O_NOFOLLOW));
+    if (!childFd) {
+        int err = errno;
+        return (unlinkErr != ERRNO_NOERR && (err == ENOTDIR || err == ELOOP)) ? unlinkErr : err;
+    }
+    int ret = RemoveContents(childFd.GetFD(), buf);
+    if (ret != ERRNO_NOERR) {
+        return ret;
+    }
+    if (unlinkat(dirFd, name, AT_REMOVEDIR) != 0) {
+        return errno;
+    }
+    return ERRNO_NOERR;
+}
+
+static int RemoveContents(int dirFd, vector<char> &buf)
+{
+    DirEntries entries;
+    int ret = ReadEntries(dirFd, buf, entries);
+    if (ret != ERRNO_NOERR) {
+        return ret;
+    }
+    for (const auto &[name, type] : entries) {
+        ret = RemoveAt(dirFd, name.c_str(), type, buf);
+        // An entry removed by someone else in the meantime is not an error
+        if (ret != ERRNO_NOERR && ret != ENOENT) {
+            HILOGE("Failed to remove entry, ret: %{public}d", ret);
+            return ret;
+        }
+    }
+    return ERRNO_NOERR;
+}
+
+// renameat2 with RENAME_NOREPLACE, emulated with a check on kernels or file systems that do not support the flag
+static int RenameNoReplace(int srcDirFd, const char *srcName, int destDirFd, const char *destName)
+{
+    if (syscall(SYS_renameat2, srcDirFd, srcName, destDirFd, destName, RENAME_NOREPLACE) == 0) {
+        return ERRNO_NOERR;
+    }
+    int err = errno;
+    if (err != EINVAL && err != ENOSYS) {
+        return err;
+    }
+    struct stat info;
+    if (fstatat(destDirFd, destName, &info, AT_SYMLINK_NOFOLLOW) == 0) {
+        return EEXIST;
+    }
+    if (renameat(srcDirFd, srcName, destDirFd, destName) != 0) {
+        return errno;
+    }
+    return ERRNO_NOERR;
+}
+
+// Returns true when the data was copied or an error is set, false when the clone and copy_file_range do not apply
+static bool TryCopyFileRange(int srcFd, int destFd, off_t size, int &err)
+{
+    err = ERRNO_NOERR;
+    // A clone shares the extents of the source on the file systems that support it
+    if (ioctl(destFd, FICLONE, srcFd) == 0) {
+        return true;
+    }
+    off_t copied = 0;
+    while (copied < size) {
+        ssize_t ret = syscall(SYS_copy_file_range, srcFd, nullptr, destFd, nullptr,
+            min(static_cast<size_t>(size - copied), COPY_CHUNK_SIZE), 0);
+        if (ret > 0) {
+            copied += ret;
+            continue;
+        }
+        // Some pseudo and network file systems report nothing to copy instead of failing, the other paths read them.
+        // Running out of data after some was copied means the source is shorter than its size said
+        if (ret == 0) {
+            if (copied == 0) {
+                return false;
+            }
+            err = EIO;
+            return true;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (copied == 0 && (errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP ||
+            errno == EBADF)) {
+            return false;
+        }
+        err = errno;
+        return true;
+    }
+    return true;
+}
+
+int DirTreeOps::CopyFileData(int srcFd, int destFd, off_t size)
+{
+    if (size <= 0) {
+        return ERRNO_NOERR;
+    }
+    int err = ERRNO_NOERR;
+    if (TryCopyFileRange(srcFd, destFd, size, err)) {
+        return err;
+    }
+    off_t offset = 0;
+    while (offset < size) {
+        ssize_t ret = sendfile(destFd, srcFd, &offset, min(static_cast<size_t>(size - offset), COPY_CHUNK_SIZE));
+        if (ret == 0) {
+            return ERRNO_NOERR;
+        }
+        if (ret > 0) {
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if ((errno != EINVAL && errno != ENOSYS) || offset != 0) {
+            return errno;
+        }
+        break;
+    }
+    if (offset >= size) {
+        return ERRNO_NOERR;
+    }
+    // sendfile is not supported between these files
+    vector<char> buf(COPY_CHUNK_SIZE);
+    while (true) {
+        ssize_t readLen = read(srcFd, buf.data(), buf.size());
+        if (readLen < 0 && errno == EINTR) {
+            continue;
+        }
+        if (readLen <= 0) {
+            return (readLen == 0) ? ERRNO_NOERR : errno;
+        }
+        for (ssize_t written = 0; written < readLen;) {
+            ssize_t ret = write(destFd, buf.data() + written, readLen - written);
+            if (ret < 0 && errno != EINTR) {
+                return errno;
+            }
+            written += max(ret, static_cast<ssize_t>(0));
+        }
+    }
+}
+
+// The fallback of a rename across file systems, dest is replaced
+static int CopyAndDeleteFileAt(int srcDirFd, const char *name, int destDirFd)
+{
+    if (unlinkat(destDirFd, name, 0) != 0 && errno != ENOENT) {
+        int err = errno;
+        HILOGE("Failed to remove dest file, error code: %{public}d", err);
+        return err;
+    }
+    FDGuard srcFd(openat(srcDirFd, name, O_RDONLY | O_CLOEXEC));
+    if (!srcFd) {
+        return errno;
+    }
+    struct stat info;
+    if (fstat(srcFd.GetFD(), &info) != 0) {
+        return errno;
+    }
+    mode_t perm = info.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO);
+    FDGuard destFd(openat(destDirFd, name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, perm));
+    if (!destFd) {
+        return errno;
+    }
+    int ret = DirTreeOps::CopyFileData(srcFd.GetFD(), destFd.GetFD(), info.st_size);
+    if (ret != ERRNO_NOERR) {
+        HILOGE("Failed to copy file, error code: %{public}d", ret);
+        return ret;
+    }
+    // The permissions given at creation are masked by the umask
+    if (fchmod(destFd.GetFD(), perm) != 0) {
+        return errno;
+    }
+    if (unlinkat(srcDirFd, name, 0) != 0) {
+        return errno;
+    }
+    return ERRNO_NOERR;
+}
+
+static int MoveFileAt(MoveContext &ctx, int srcDirFd, int destDirFd, const string &name, const string &srcPath,
+    const string &destPath)
+{
+    int ret = RenameNoReplace(srcDirFd, name.c_str(), destDirFd, name.c_str());
+    if (ret == EXDEV) {
+        // Across file systems the rename fails before dest is looked at, the copy meets the same conflicts
+        struct stat info;
+        if (fstatat(destDirFd, name.c_str(), &info, AT_SYMLINK_NOFOLLOW) == 0) {
+            ret = EEXIST;
+        } else if (errno != ENOENT) {
+            return errno;
+        }
+    }
+    if (ret == EEXIST) {
+        if (IsDirAt(destDirFd, name.c_str())) {
+            ctx.errFiles.emplace_front(srcPath + '/' + name, destPath + '/' + name);
+            return ERRNO_NOERR;
+        }
+        if (ctx.mode == DIRMODE_FILE_THROW_ERR) {
+            ctx.errFiles.emplace_back(srcPath + '/' + name, destPath + '/' + name);
+            return ERRNO_NOERR;
+        }
+        ret = (renameat(srcDirFd, name.c_str(), destDirFd, name.c_str()) == 0) ? ERRNO_NOERR : errno;
+    }
+    if (ret == EXDEV) {
+        HILOGD("Failed to rename file due to EXDEV");
+        return CopyAndDeleteFileAt(srcDirFd, name.c_str(), destDirFd);
+    }
+    return ret;
+}
+
+static int MoveDirAt(MoveContext &ctx, int srcDirFd, const char *srcName, int destDirFd, const char *destName,
+    const string &srcPath, const string &destPath);
+
+// Merges the directory srcName of srcDirFd into the existing destName of destDirFd, the paths are those of the two
+static int MergeDirAt(MoveContext &ctx, int srcDirFd, const char *srcName, int destDirFd, const char *destName,
+    const string &srcPath, const string &destPath)
+{
+    if (!IsDirAt(destDirFd, destName)) {
+        ctx.errFiles.emplace_front(srcPath, destPath);
+        return ERRNO_NOERR;
+    }
+    FDGuard srcFd(openat(srcDirFd, srcName, DIR_OPEN_FLAGS));
+    if (!srcFd) {
+        return errno;
+    }
+    FDGuard destFd(openat(destDirFd, destName, DIR_OPEN_FLAGS));
+    if (!destFd) {
+        return errno;
+    }
+    DirEntries entries;
+    int ret = ReadEntries(srcFd.GetFD(), ctx.direntBuf, entries);
+    if (ret != ERRNO_NOERR) {
+        return ret;
+    }
+    // The order of scandir with alphasort, which decides the order of the reported conflicts
+    sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+        return strcoll(a.first.c_str(), b.first.c_str()) < 0;
+    });
+    for (const auto &[entryName, direntType] : entries) {
+        unsigned char type = ListFileWalker::ResolveType(srcFd.GetFD(), entryName.c_str(), direntType);
+        if (type != DT_DIR) {
+            ret = MoveFileAt(ctx, srcFd.GetFD(), destFd.GetFD(), entryName, srcPath, destPath);
+            if (ret != ERRNO_NOERR) {
+                HILOGE("Failed to rename file for error %{public}d", ret);
+                return ret;
+            }
+            continue;
+        }
+        size_t size = ctx.errFiles.size();
+        ret = MoveDirAt(ctx, srcFd.GetFD(), entryName.c_str(), destFd.GetFD(), entryName.c_str(),
+            srcPath + '/' + entryName, destPath + '/' + entryName);
+        if (ret != ERRNO_NOERR) {
+            return ret;
+        }
+        if (size != ctx.errFiles.size()) {
+            continue;
+        }
+        // Gone already when it was renamed as a whole, emptied when it was merged
+        if (unlinkat(srcFd.GetFD(), entryName.c_str(), AT_REMOVEDIR) != 0 && errno != ENOENT) {
+            int err = errno;
+            HILOGE("Failed to remove directory, error code: %{public}d", err);
+            return err;
+        }
+    }
+    return ERRNO_NOERR;
+}
+
+static int MoveDirAt(MoveContext &ctx, int srcDirFd, const char *srcName, int destDirFd, const char *destName,
+    const string &srcPath, const string &destPath)
+{
+    int ret = RenameNoReplace(srcDirFd, srcName, destDirFd, destName);
+    if (ret == EEXIST || ret == ENOTEMPTY) {
+        return MergeDirAt(ctx, srcDirFd, srcName, destDirFd, destName, srcPath, destPath);
+    }
+    if (ret == EXDEV) {
+        HILOGD("Failed to rename file due to EXDEV");
+        // An existing dest is merged into, one that is not a directory is reported as a conflict by MergeDirAt
+        if (mkdirat(destDirFd, destName, MAKE_DIRS_DEFAULT_MODE) != 0 && errno != EEXIST) {
+            int err = errno;
+            HILOGE("Failed to create directory, error code: %{public}d", err);
+            return err;
+        }
+        return MergeDirAt(ctx, srcDirFd, srcName, destDirFd, destName, srcPath, destPath);
+    }
+    if (ret != ERRNO_NOERR) {
+        HILOGE("Failed to rename file, error code: %{public}d", ret);
+    }
+    return ret;
+}
+
+// Whether the entry exists and is not empty, a directory with entries or a file with data
+static int JudgeExistAndEmptyAt(int dirFd, const char *name, bool &notEmpty, vector<char> &buf)
+{
+    notEmpty = false;
+    struct stat info;
+    if (fstatat(dirFd, name, &info, 0) != 0) {
+        return (errno == ENOENT) ? ERRNO_NOERR : errno;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        notEmpty = info.st_size != 0;
+        return ERRNO_NOERR;
+    }
+    FDGuard fd(openat(dirFd, name, DIR_OPEN_FLAGS));
+    if (!fd) {
+        return errno;
+    }
+    return ListFileWalker::ForEachDirent(fd.GetFD(), buf, [&notEmpty](const char *, unsigned char) {
+        notEmpty = true;
+        return false;
+    });
+}
+
+// Copies the tree and removes the source with several threads, for a directory to move to another file system where
+// dest is missing or empty so nothing is merged
+static int MoveAcrossDevices(const string &src, const string &destStr, size_t workerNum)
+{
+    DirCopyOptions copyOptions;
+    copyOptions.workerNum = workerNum;
+    copyOptions.replace = true;
+    vector<DirCopyConflict> conflicts;
+    int ret = DirCopier(copyOptions).Copy(src, destStr, conflicts);
+    if (ret != ERRNO_NOERR) {
+        HILOGE("Failed to copy directory across devices, error code: %{public}d", ret);
+        return ret;
+    }
+    TreeRemoveOptions removeOptions;
+    removeOptions.workerNum = workerNum;
+    return TreeRemover(removeOptions).Remove(src);
+}
+
+// The top level works on the paths as given, a src ending with a slash merges its contents into dest
+int DirTreeOps::MoveDir(const string &src, const string &dest, int mode, deque<ErrFiles> &errFiles,
+    size_t workerNum)
+{
+    size_t found = src.rfind('/');
+    if (found == string::npos) {
+        return EINVAL;
+    }
+    string destStr = dest + src.substr(found);
+    MoveContext ctx = { mode, errFiles, {} };
+    bool notEmpty = false;
+    int ret = JudgeExistAndEmptyAt(AT_FDCWD, destStr.c_str(), notEmpty, ctx.direntBuf);
+    if (ret != ERRNO_NOERR) {
+        return ret;
+    }
+    if (notEmpty && mode == DIRMODE_DIRECTORY_REPLACE) {
+        ret = RemoveAt(AT_FDCWD, destStr.c_str(), DT_UNKNOWN, ctx.direntBuf);
+        if (ret != ERRNO_NOERR) {
+            HILOGE("Failed to remove dest directory in DIRMODE_DIRECTORY_REPLACE, ret %{public}d", ret);
+            return ret;
+        }
+        notEmpty = false;
+    }
+    if (notEmpty && mode == DIRMODE_DIRECTORY_THROW_ERR) {
+        HILOGE("Failed to move directory in DIRMODE_DIRECTORY_THROW_ERR");
+        return ENOTEMPTY;
+    }
+    if (workerNum > 1 && !notEmpty) {
+        ret = RenameNoReplace(AT_FDCWD, src.c_str(), AT_FDCWD, destStr.c_str());
+        struct stat info;
+        if (ret == EXDEV && (lstat(destStr.c_str(), &info) != 0 || S_ISDIR(info.st_mode))) {
+            return MoveAcrossDevices(src, destStr, workerNum);
+        }
+        // Moved by the rename, or failed with the error the serial move would meet first
+        if (ret != EEXIST && ret != ENOTEMPTY && ret != EXDEV) {
+            return ret;
+        }
+    }
+    ret = MoveDirAt(ctx, AT_FDCWD, src.c_str(), AT_FDCWD, destStr.c_str(), src, destStr);
+    if (ret != ERRNO_NOERR) {
+        return ret;
+    }
+    if (!errFiles.empty()) {
+        HILOGE("Failed to movedir with some conflicted files");
+        return EEXIST;
+    }
+    // src may be a link to the directory, which is removed and not followed
+    ret = RemoveAt(AT_FDCWD, src.c_str(), DT_UNKNOWN, ctx.direntBuf);
+    if (ret != ERRNO_NOERR && ret != ENOENT) {
+        HILOGE("Failed to remove src directory, ret %{public}d", ret);
+        return ret;
+    }
+    return ERRNO_NOERR;
+}
+
+} // namespace OHOS::FileManagement::ModuleFileIO
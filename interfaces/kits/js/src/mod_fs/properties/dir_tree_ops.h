@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_DIR_TREE_OPS_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_DIR_TREE_OPS_H
+
+#include <deque>
+#include <string>
+#include <sys/types.h>
+
+namespace OHOS::FileManagement::ModuleFileIO {
+
+// Mode of the directories created by mkdir with the recursion option, the umask applies
+constexpr mode_t MAKE_DIRS_DEFAULT_MODE = 0777;
+
+constexpr int DIRMODE_MIN = 0;
+constexpr int DIRMODE_MAX = 3;
+
+enum ModeOfMoveDir {
+    DIRMODE_DIRECTORY_THROW_ERR = 0,
+    DIRMODE_FILE_THROW_ERR,
+    DIRMODE_FILE_REPLACE,
+    DIRMODE_DIRECTORY_REPLACE
+};
+
+struct ErrFiles {
+    std::string srcFiles;
+    std::string destFiles;
+    ErrFiles(const std::string& src, const std::string& dest) : srcFiles(src), destFiles(dest) {}
+    ~ErrFiles() = default;
+};
+
+/*
+ * Directory tree operations that reach every entry with an *at() call relative to the fd of its parent directory,
+ * which stays open while the entries below it are handled. A lookup then costs the same at any depth, paths are only
+ * built for the directories descended into and for the conflicts reported. All return 0 or an errno.
+ */
+class DirTreeOps final {
+public:
+    // Creates the directory and its missing parents, EEXIST if one of them exists but is not a directory
+    static int MakeDirs(const std::string &path, mode_t mode);
+    // Moves the directory src into the directory dest as fs.moveDir does, the conflicts the mode leaves in place are
+    // added to errFiles and fail the move with EEXIST. A move to another file system that has nothing to merge copies
+    // and removes the tree with workerNum threads
+    static int MoveDir(const std::string &src, const std::string &dest, int mode, std::deque<ErrFiles> &errFiles,
+        size_t workerNum = 1);
+    // Copies size bytes from the start of srcFd to destFd, trying a clone, then copy_file_range, then sendfile and
+    // last read and write. Both fds must be at offset 0
+    static int CopyFileData(int srcFd, int destFd, off_t size);
+};
+
+} // namespace OHOS::FileManagement::ModuleFileIO
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_DIR_TREE_OPS_H
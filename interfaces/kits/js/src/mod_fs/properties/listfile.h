@@ -17,9 +17,6 @@
 #define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_LISTFILE_H
 
 #include "filemgmt_libn.h"
-#include "file_filter.h"
-
-#include <dirent.h>
 
 namespace OHOS::FileManagement::ModuleFileIO {
 using namespace OHOS::FileManagement::LibN;
@@ -34,37 +31,6 @@ public:
     std::vector<std::string> dirents;
 };
 
-struct NameListArg {
-    struct dirent** namelist = { nullptr };
-    int direntNum = 0;
-};
-
-constexpr int DEFAULT_SIZE = -1;
-constexpr int DEFAULT_MODIFY_AFTER = -1;
-struct OptionArgs {
-    FileFilter filter = FileFilterBuilder()
-        .SetFileSizeOver(DEFAULT_SIZE)
-        .SetLastModifiedAfter(DEFAULT_MODIFY_AFTER)
-        .Build();
-    int listNum = 0;
-    int countNum = 0;
-    bool recursion = false;
-    std::string path = "";
-    void Clear()
-    {
-        filter.FilterClear();
-        filter.SetFileSizeOver(DEFAULT_SIZE);
-        filter.SetLastModifiedAfter(DEFAULT_MODIFY_AFTER);
-        listNum = 0;
-        countNum = 0;
-        recursion = false;
-        path = "";
-    }
-};
-
-constexpr int FILTER_MATCH = 1;
-constexpr int FILTER_DISMATCH = 0;
-const int32_t MAX_SUFFIX_LENGTH = 256;
 const std::string LIST_FILE_PRODUCE_NAME = "fs.listFile";
 } // namespace OHOS::FileManagement::ModuleFileIO
 #endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_LISTFILE_H
\ No newline at end of file
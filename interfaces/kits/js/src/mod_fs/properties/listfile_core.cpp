@@ -15,13 +15,13 @@
 
 #include "listfile_core.h"
 
+#include <dirent.h>
+#include <fcntl.h>
 #include <fnmatch.h>
-#include <memory>
+#include <iterator>
 #include <string_view>
 #include <string>
 #include <sys/stat.h>
-#include <thread>
-#include <tuple>
 
 #include "file_utils.h"
 #include "filemgmt_libhilog.h"
@@ -29,9 +29,24 @@
 namespace OHOS::FileManagement::ModuleFileIO {
 using namespace std;
 
-static thread_local OptionArgs g_optionArgs;
-
-static bool CheckSuffix(const vector<string> &suffixs)
+namespace {
+struct NamePattern {
+    string pattern;
+    bool literal = true;
+};
+
+// Everything a single listFile call needs, the filter is compiled once before the walk starts
+struct ListFileContext {
+    vector<string> suffixs;
+    vector<NamePattern> displayNames;
+    int64_t fileSizeOver = DEFAULT_SIZE;
+    double lastModifiedAfter = DEFAULT_MODIFY_AFTER;
+    bool needStat = false;
+    ListFileWalkOptions walkOptions;
+};
+} // namespace
+
+bool ListFileCore::CheckSuffix(const vector<string> &suffixs)
 {
     for (string suffix : suffixs) {
         if (suffix.length() <= 1 || suffix.length() > MAX_SUFFIX_LENGTH) {
@@ -49,24 +64,28 @@ static bool CheckSuffix(const vector<string> &suffixs)
     return true;
 }
 
-static bool ValidFileFilterParam(const FsFilter &fsFilter, FileFilter *filter)
+static bool ValidFileFilterParam(const FsFilter &fsFilter, ListFileContext &ctx)
 {
     if (fsFilter.suffix.has_value()) {
         vector<string> suffixs = fsFilter.suffix.value();
-        if (!CheckSuffix(suffixs) || suffixs.size() == 0) {
+        if (!ListFileCore::CheckSuffix(suffixs) || suffixs.size() == 0) {
             HILOGE("Invalid suffix.");
             return false;
         }
-        filter->SetSuffix(suffixs);
+        ctx.suffixs = move(suffixs);
     }
 
     if (fsFilter.displayName.has_value()) {
-        vector<string> displayNames = fsFilter.displayName.value();
+        const vector<string> &displayNames = fsFilter.displayName.value();
         if (displayNames.size() == 0) {
             HILOGE("Invalid displayName.");
             return false;
         }
-        filter->SetDisplayName(displayNames);
+        for (const auto &name : displayNames) {
+            // A pattern without wildcards only ever matches itself, so fnmatch can be skipped for it
+            bool literal = name.find_first_of("*?[\\") == string::npos;
+            ctx.displayNames.push_back({ name, literal });
+        }
     }
 
     if (fsFilter.fileSizeOver.has_value()) {
@@ -75,7 +94,7 @@ static bool ValidFileFilterParam(const FsFilter &fsFilter, FileFilter *filter)
             HILOGE("Failed to get fileSizeOver prop.");
             return false;
         }
-        filter->SetFileSizeOver(fileSizeOver);
+        ctx.fileSizeOver = fileSizeOver;
     }
 
     if (fsFilter.lastModifiedAfter.has_value()) {
@@ -84,32 +103,30 @@ static bool ValidFileFilterParam(const FsFilter &fsFilter, FileFilter *filter)
             HILOGE("Failed to get lastModifiedAfter prop.");
             return false;
         }
-        filter->SetLastModifiedAfter(lastModifiedAfter);
+        ctx.lastModifiedAfter = lastModifiedAfter;
     }
 
+    ctx.needStat = ctx.fileSizeOver >= 0 || ctx.lastModifiedAfter >= 0;
     return true;
 }
 
-static bool ValidOptionParam(const string &path, const optional<FsListFileOptions> &opt, OptionArgs &optionArgs)
+static bool ValidOptionParam(const optional<FsListFileOptions> &opt, ListFileContext &ctx)
 {
-    g_optionArgs.Clear();
-    g_optionArgs.path = path;
-
     if (opt.has_value()) {
-        auto op = opt.value();
+        auto &op = opt.value();
         if (op.listNum.has_value()) {
             auto listNum = op.listNum.value();
             if (listNum < 0) {
                 HILOGE("Failed to get listNum prop");
                 return false;
             }
-            optionArgs.listNum = listNum;
+            ctx.walkOptions.listNum = listNum;
         }
 
-        optionArgs.recursion = op.recursion;
+        ctx.walkOptions.recursion = op.recursion;
 
         if (op.filter.has_value()) {
-            bool ret = ValidFileFilterParam(op.filter.value(), &(optionArgs.filter));
+            bool ret = ValidFileFilterParam(op.filter.value(), ctx);
             if (!ret) {
                 HILOGE("Failed to get filter prop.");
                 return false;
@@ -120,16 +137,16 @@ static bool ValidOptionParam(const string &path, const optional<FsListFileOption
     return true;
 }
 
-static bool FilterSuffix(const vector<string> &suffixs, const struct dirent &filename)
+static bool FilterSuffix(const vector<string> &suffixs, string_view name, unsigned char type)
 {
-    if (filename.d_type == DT_DIR) {
+    if (type == DT_DIR) {
         return true;
     }
-    size_t found = string(filename.d_name).rfind('.');
-    if (found == std::string::npos) {
+    size_t found = name.rfind('.');
+    if (found == string_view::npos) {
         return false;
     }
-    string suffixStr = string(filename.d_name).substr(found);
+    string_view suffixStr = name.substr(found);
     for (const auto &iter : suffixs) {
         if (iter == suffixStr) {
             return true;
@@ -138,175 +155,84 @@ static bool FilterSuffix(const vector<string> &suffixs, const struct dirent &fil
     return false;
 }
 
-static bool FilterDisplayname(const vector<string> &displaynames, const struct dirent &filename)
+static bool FilterDisplayname(const vector<NamePattern> &displayNames, const char *name)
 {
-    for (const auto &iter : displaynames) {
-        int ret = fnmatch(iter.c_str(), filename.d_name, FNM_PATHNAME | FNM_PERIOD);
-        if (ret == 0) {
+    for (const auto &iter : displayNames) {
+        if (iter.literal) {
+            if (iter.pattern == name) {
+                return true;
+            }
+        } else if (fnmatch(iter.pattern.c_str(), name, FNM_PATHNAME | FNM_PERIOD) == 0) {
             return true;
         }
     }
     return false;
 }
 
-static bool FilterFilesizeOver(const int64_t fFileSizeOver, const struct dirent &filename)
+static bool FilterMetadata(const ListFileContext &ctx, int dirFd, const char *name)
 {
-    if (fFileSizeOver < 0) {
-        return true;
-    }
     struct stat info;
-    string stPath = (g_optionArgs.path + '/' + string(filename.d_name));
-    int32_t res = stat(stPath.c_str(), &info);
-    if (res != 0) {
+    if (fstatat(dirFd, name, &info, 0) != 0) {
         HILOGE("Failed to stat file.");
         return false;
     }
-    if (info.st_size > fFileSizeOver) {
-        return true;
-    }
-    return false;
-}
-
-static bool FilterLastModifyTime(const double lastModifiedAfter, const struct dirent &filename)
-{
-    if (lastModifiedAfter < 0) {
-        return true;
-    }
-    struct stat info;
-    string stPath = g_optionArgs.path + '/' + string(filename.d_name);
-    int32_t res = stat(stPath.c_str(), &info);
-    if (res != 0) {
-        HILOGE("Failed to stat file.");
+    if (ctx.fileSizeOver >= 0 && info.st_size <= ctx.fileSizeOver) {
         return false;
     }
-    if (static_cast<double>(info.st_mtime) > lastModifiedAfter) {
-        return true;
+    if (ctx.lastModifiedAfter >= 0 && static_cast<double>(info.st_mtime) <= ctx.lastModifiedAfter) {
+        return false;
     }
-    return false;
+    return true;
 }
 
-static bool FilterResult(const struct dirent &filename)
+// Name checks come first so that an entry is only stat'ed when it survived them and a metadata filter is set
+static bool FilterEntry(const ListFileContext &ctx, const ListFileWalkEntry &entry)
 {
-    vector<string> fSuffixs = g_optionArgs.filter.GetSuffix();
-    if (!FilterSuffix(fSuffixs, filename) && fSuffixs.size() > 0) {
+    if (!ctx.suffixs.empty() && !FilterSuffix(ctx.suffixs, entry.name, entry.type)) {
         return false;
     }
-    vector<string> fDisplaynames = g_optionArgs.filter.GetDisplayName();
-    if (!FilterDisplayname(fDisplaynames, filename) && fDisplaynames.size() > 0) {
+    if (!ctx.displayNames.empty() && !FilterDisplayname(ctx.displayNames, entry.name)) {
         return false;
     }
-    int64_t fFileSizeOver = g_optionArgs.filter.GetFileSizeOver();
-    if (!FilterFilesizeOver(fFileSizeOver, filename)) {
+    if (ctx.needStat && !FilterMetadata(ctx, entry.dirFd, entry.name)) {
         return false;
     }
-    double fLastModifiedAfter = g_optionArgs.filter.GetLastModifiedAfter();
-    if (!FilterLastModifyTime(fLastModifiedAfter, filename)) {
-        return false;
-    }
-    g_optionArgs.countNum++;
     return true;
 }
 
-static int32_t FilterFunc(const struct dirent *filename)
-{
-    if (string_view(filename->d_name) == "." || string_view(filename->d_name) == "..") {
-        return FILTER_DISMATCH;
-    }
-
-    if (g_optionArgs.countNum < g_optionArgs.listNum || g_optionArgs.listNum == 0) {
-        if ((filename->d_type == DT_DIR && g_optionArgs.recursion) || FilterResult(*filename)) {
-            return FILTER_MATCH;
-        }
-    }
-    return FILTER_DISMATCH;
-}
-
-static void Deleter(struct NameListArg *arg)
-{
-    for (int i = 0; i < arg->direntNum; i++) {
-        free((arg->namelist)[i]);
-        (arg->namelist)[i] = nullptr;
-    }
-    free(arg->namelist);
-    arg->namelist = nullptr;
-    delete arg;
-    arg = nullptr;
-}
-
-static int FilterFileRes(const string &path, vector<string> &dirents)
-{
-    unique_ptr<struct NameListArg, decltype(Deleter) *> pNameList = { new (nothrow) struct NameListArg, Deleter };
-    if (!pNameList) {
-        HILOGE("Failed to request heap memory.");
-        return ENOMEM;
-    }
-    int num = scandir(path.c_str(), &(pNameList->namelist), FilterFunc, nullptr);
-    if (num < 0) {
-        HILOGE("Failed to scan dir");
-        return errno;
-    }
-    pNameList->direntNum = num;
-    for (int i = 0; i < num; i++) {
-        dirents.emplace_back(pNameList->namelist[i]->d_name);
-    }
-    return ERRNO_NOERR;
-}
-
-static int RecursiveFunc(const string &path, vector<string> &dirents)
+FsResult<void> ListFileCore::DoListFile(
+    const string &path, const optional<FsListFileOptions> &opt, const ListFileBatchSink &sink)
 {
-    unique_ptr<struct NameListArg, decltype(Deleter) *> pNameList = { new (nothrow) struct NameListArg, Deleter };
-    if (!pNameList) {
-        HILOGE("Failed to request heap memory.");
-        return ENOMEM;
-    }
-    int num = scandir(path.c_str(), &(pNameList->namelist), FilterFunc, nullptr);
-    if (num < 0) {
-        HILOGE("Failed to scan dir");
-        return errno;
-    }
-    pNameList->direntNum = num;
-    for (int i = 0; i < num; i++) {
-        if ((*(pNameList->namelist[i])).d_type == DT_REG) {
-            dirents.emplace_back(path + '/' + pNameList->namelist[i]->d_name);
-        } else if ((*(pNameList->namelist[i])).d_type == DT_DIR) {
-            string pathTemp = g_optionArgs.path;
-            g_optionArgs.path += '/' + string((*(pNameList->namelist[i])).d_name);
-            int ret = RecursiveFunc(g_optionArgs.path, dirents);
-            if (ret != ERRNO_NOERR) {
-                return ret;
-            }
-            g_optionArgs.path = pathTemp;
-        }
+    ListFileContext ctx;
+    if (!ValidOptionParam(opt, ctx)) {
+        HILOGE("Invalid options");
+        return FsResult<void>::Error(EINVAL);
     }
-    return ERRNO_NOERR;
-}
 
-static void DoListFileVector(const string &path, vector<string> &dirents, bool recursion)
-{
-    if (recursion) {
-        for (size_t i = 0; i < dirents.size(); i++) {
-            dirents[i] = dirents[i].substr(path.length());
-        }
+    ctx.walkOptions.workerNum = ListFileWalker::DefaultWorkerNum();
+    auto matcher = [&ctx](const ListFileWalkEntry &entry) { return FilterEntry(ctx, entry); };
+    int ret = ListFileWalker(ctx.walkOptions, matcher, sink).Walk(path);
+    if (ret) {
+        return FsResult<void>::Error(ret);
     }
+    return FsResult<void>::Success();
 }
 
 FsResult<std::vector<std::string>> ListFileCore::DoListFile(const string &path, const optional<FsListFileOptions> &opt)
 {
-    if (!ValidOptionParam(path, opt, g_optionArgs)) {
-        HILOGE("Invalid options");
-        return FsResult<std::vector<std::string>>::Error(EINVAL);
-    }
-
-    vector<string> direntsRes;
-    int ret = 0;
-    ret = g_optionArgs.recursion ? RecursiveFunc(path, direntsRes) : FilterFileRes(path, direntsRes);
-    if (ret) {
-        return FsResult<std::vector<std::string>>::Error(ret);
+    vector<string> dirents;
+    auto sink = [&dirents](vector<string> &&batch) {
+        if (dirents.empty()) {
+            dirents = move(batch);
+            return;
+        }
+        dirents.insert(dirents.end(), make_move_iterator(batch.begin()), make_move_iterator(batch.end()));
+    };
+    auto ret = DoListFile(path, opt, sink);
+    if (!ret.IsSuccess()) {
+        return FsResult<std::vector<std::string>>::Error(ret.GetError().GetErrNo());
     }
-    DoListFileVector(path, direntsRes, g_optionArgs.recursion);
-    g_optionArgs.Clear();
-
-    return FsResult<std::vector<std::string>>::Success(direntsRes);
+    return FsResult<std::vector<std::string>>::Success(move(dirents));
 }
 
 } // namespace OHOS::FileManagement::ModuleFileIO
\ No newline at end of file
@@ -16,39 +16,18 @@
 #ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_LISTFILE_CORE_H
 #define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_LISTFILE_CORE_H
 
-#include <dirent.h>
+#include <optional>
+#include <string>
+#include <vector>
 
-#include "file_filter.h"
 #include "filemgmt_libfs.h"
+#include "listfile_walker.h"
 
 namespace OHOS::FileManagement::ModuleFileIO {
 using namespace std;
 
-struct NameListArg {
-    struct dirent **namelist = { nullptr };
-    int direntNum = 0;
-};
-
 constexpr int DEFAULT_SIZE = -1;
 constexpr int DEFAULT_MODIFY_AFTER = -1;
-struct OptionArgs {
-    FileFilter filter =
-        FileFilterBuilder().SetFileSizeOver(DEFAULT_SIZE).SetLastModifiedAfter(DEFAULT_MODIFY_AFTER).Build();
-    int listNum = 0;
-    int countNum = 0;
-    bool recursion = false;
-    std::string path = "";
-    void Clear()
-    {
-        filter.FilterClear();
-        filter.SetFileSizeOver(DEFAULT_SIZE);
-        filter.SetLastModifiedAfter(DEFAULT_MODIFY_AFTER);
-        listNum = 0;
-        countNum = 0;
-        recursion = false;
-        path = "";
-    }
-};
 
 struct FsFilter {
     std::optional<std::vector<std::string>> suffix = std::nullopt;
@@ -68,10 +47,13 @@ class ListFileCore {
 public:
     static FsResult<std::vector<std::string>> DoListFile(
         const std::string &path, const optional<FsListFileOptions> &opt = nullopt);
+    // Delivers the names in batches while the directory is walked, the order of the names is unspecified
+    static FsResult<void> DoListFile(
+        const std::string &path, const optional<FsListFileOptions> &opt, const ListFileBatchSink &sink);
+    // Every suffix is a '.' followed by letters and digits only, so the bindings can reject one before calling in
+    static bool CheckSuffix(const std::vector<std::string> &suffixs);
 };
 
-constexpr int FILTER_MATCH = 1;
-constexpr int FILTER_DISMATCH = 0;
 const int32_t MAX_SUFFIX_LENGTH = 256;
 
 } // namespace OHOS::FileManagement::ModuleFileIO
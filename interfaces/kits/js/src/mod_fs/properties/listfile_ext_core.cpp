@@ -15,199 +15,89 @@
 
 #include "listfile_ext_core.h"
 
-#include <dirent.h>
-#include <memory>
-#include <string_view>
+#include <iterator>
 #include <string>
 
-#include <sys/stat.h>
-
 #include "file_utils.h"
 #include "filemgmt_libhilog.h"
 #include "i_file_filter.h"
 
 namespace OHOS::FileManagement::ModuleFileIO {
 
-namespace {
-constexpr int32_t FILTER_MATCH = 1;
-constexpr int32_t FILTER_DISMATCH = 0;
-
-struct NameListArg {
-    struct dirent **namelist = { nullptr };
-    int direntNum = 0;
-};
-
-struct OptionArgs {
-    std::shared_ptr<IFileFilter> fileFilter = nullptr;
-    int listNum = 0;
-    int countNum = 0;
-    bool recursion = false;
-    std::string path = "";
-    std::string originalPath = "";
-    void Clear()
-    {
-        fileFilter = nullptr;
-        listNum = 0;
-        countNum = 0;
-        recursion = false;
-        path = "";
-        originalPath = "";
-    }
-};
-} // namespace
-
-static thread_local OptionArgs g_optionArgs;
-
-static bool ValidOptionParam(const string &path, const optional<ListFileExtOptions> &options, OptionArgs &optionArgs)
+static bool ValidOptionParam(const std::optional<ListFileExtOptions> &options, ListFileWalkOptions &walkOptions,
+    std::shared_ptr<IFileFilter> &fileFilter)
 {
-    g_optionArgs.Clear();
-    g_optionArgs.path = path;
-    g_optionArgs.originalPath = path;
-
     if (options.has_value()) {
-        auto op = options.value();
+        auto &op = options.value();
         if (op.listNum.has_value()) {
             auto listNum = op.listNum.value();
             if (listNum < 0) {
                 HILOGE("Failed to get listNum prop");
                 return false;
             }
-            optionArgs.listNum = listNum;
+            walkOptions.listNum = listNum;
         }
 
-        optionArgs.recursion = op.recursion;
-
-        if (op.fileFilter != nullptr) {
-            optionArgs.fileFilter = op.fileFilter;
-        }
+        walkOptions.recursion = op.recursion;
+        fileFilter = op.fileFilter;
     }
 
     return true;
 }
 
-static bool FilterResult(const struct dirent &filename)
-{
-    if (g_optionArgs.fileFilter) {
-        std::string filterName;
-        if (g_optionArgs.recursion) {
-            if (g_optionArgs.path == g_optionArgs.originalPath) {
-                filterName = "/" + std::string(filename.d_name);
-            } else {
-                filterName = g_optionArgs.path.substr(g_optionArgs.originalPath.length()) + '/' + filename.d_name;
-            }
-        } else {
-            filterName = filename.d_name;
-        }
-        auto matched = g_optionArgs.fileFilter->Filter(filterName);
-        if (!matched) {
-            return false;
-        }
-    }
-    g_optionArgs.countNum++;
-    return true;
-}
-
-static int32_t FilterFunc(const struct dirent *filename)
-{
-    if (string_view(filename->d_name) == "." || string_view(filename->d_name) == "..") {
-        return FILTER_DISMATCH;
-    }
-
-    if (g_optionArgs.countNum < g_optionArgs.listNum || g_optionArgs.listNum == 0) {
-        if ((filename->d_type == DT_DIR && g_optionArgs.recursion) || FilterResult(*filename)) {
-            return FILTER_MATCH;
-        }
-    }
-    return FILTER_DISMATCH;
-}
-
-static void Deleter(struct NameListArg *arg)
+static bool FilterResult(IFileFilter &fileFilter, bool recursion, const ListFileWalkEntry &entry)
 {
-    for (int i = 0; i < arg->direntNum; i++) {
-        free((arg->namelist)[i]);
-        (arg->namelist)[i] = nullptr;
+    if (!recursion) {
+        return fileFilter.Filter(entry.name);
     }
-    free(arg->namelist);
-    arg->namelist = nullptr;
-    delete arg;
-    arg = nullptr;
+    std::string filterName = entry.relDir + '/';
+    filterName.append(entry.name);
+    return fileFilter.Filter(filterName);
 }
 
-static int FilterFileRes(const string &path, vector<string> &dirents)
+FsResult<void> ListFileExtCore::DoListFileExt(
+    const std::string &path, const std::optional<ListFileExtOptions> &options, const ListFileBatchSink &sink)
 {
-    unique_ptr<struct NameListArg, decltype(Deleter) *> pNameList = { new (nothrow) struct NameListArg, Deleter };
-    if (!pNameList) {
-        HILOGE("Failed to request heap memory.");
-        return ENOMEM;
-    }
-    int num = scandir(path.c_str(), &(pNameList->namelist), FilterFunc, nullptr);
-    if (num < 0) {
-        HILOGE("Failed to scan dir");
-        return errno;
-    }
-    pNameList->direntNum = num;
-    for (int i = 0; i < num; i++) {
-        dirents.emplace_back(pNameList->namelist[i]->d_name);
+    ListFileWalkOptions walkOptions;
+    std::shared_ptr<IFileFilter> fileFilter = nullptr;
+    if (!ValidOptionParam(options, walkOptions, fileFilter)) {
+        HILOGE("Invalid options");
+        return FsResult<void>::Error(EINVAL);
     }
-    return ERRNO_NOERR;
-}
 
-static int RecursiveFunc(const string &path, vector<string> &dirents)
-{
-    unique_ptr<struct NameListArg, decltype(Deleter) *> pNameList = { new (nothrow) struct NameListArg, Deleter };
-    if (!pNameList) {
-        HILOGE("Failed to request heap memory.");
-        return ENOMEM;
-    }
-    int num = scandir(path.c_str(), &(pNameList->namelist), FilterFunc, nullptr);
-    if (num < 0) {
-        HILOGE("Failed to scan dir");
-        return errno;
-    }
-    pNameList->direntNum = num;
-    for (int i = 0; i < num; i++) {
-        if ((*(pNameList->namelist[i])).d_type == DT_REG) {
-            dirents.emplace_back(path + '/' + pNameList->namelist[i]->d_name);
-        } else if ((*(pNameList->namelist[i])).d_type == DT_DIR) {
-            string pathTemp = g_optionArgs.path;
-            g_optionArgs.path += '/' + string((*(pNameList->namelist[i])).d_name);
-            int ret = RecursiveFunc(g_optionArgs.path, dirents);
-            if (ret != ERRNO_NOERR) {
-                return ret;
-            }
-            g_optionArgs.path = pathTemp;
-        }
+    ListFileMatcher matcher = nullptr;
+    if (fileFilter) {
+        // The filter calls back into JS and has to be called from one thread at a time
+        walkOptions.workerNum = 1;
+        matcher = [fileFilter, recursion = walkOptions.recursion](const ListFileWalkEntry &entry) {
+            return FilterResult(*fileFilter, recursion, entry);
+        };
+    } else {
+        walkOptions.workerNum = ListFileWalker::DefaultWorkerNum();
     }
-    return ERRNO_NOERR;
-}
-
-static void DoListFileExtVector(const string &path, vector<string> &dirents, bool recursion)
-{
-    if (recursion) {
-        for (size_t i = 0; i < dirents.size(); i++) {
-            dirents[i] = dirents[i].substr(path.length());
-        }
+    int ret = ListFileWalker(walkOptions, matcher, sink).Walk(path);
+    if (ret) {
+        return FsResult<void>::Error(ret);
     }
+    return FsResult<void>::Success();
 }
 
 FsResult<std::vector<std::string>> ListFileExtCore::DoListFileExt(
-    const string &path, const std::optional<ListFileExtOptions> &options)
+    const std::string &path, const std::optional<ListFileExtOptions> &options)
 {
-    if (!ValidOptionParam(path, options, g_optionArgs)) {
-        HILOGE("Invalid options");
-        return FsResult<std::vector<std::string>>::Error(EINVAL);
-    }
-
-    vector<string> direntsRes;
-    int ret = 0;
-    ret = g_optionArgs.recursion ? RecursiveFunc(path, direntsRes) : FilterFileRes(path, direntsRes);
-    if (ret) {
-        return FsResult<std::vector<std::string>>::Error(ret);
+    std::vector<std::string> dirents;
+    auto sink = [&dirents](std::vector<std::string> &&batch) {
+        if (dirents.empty()) {
+            dirents = std::move(batch);
+            return;
+        }
+        dirents.insert(dirents.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    };
+    auto ret = DoListFileExt(path, options, sink);
+    if (!ret.IsSuccess()) {
+        return FsResult<std::vector<std::string>>::Error(ret.GetError().GetErrNo());
     }
-    DoListFileExtVector(path, direntsRes, g_optionArgs.recursion);
-    g_optionArgs.Clear();
-
-    return FsResult<std::vector<std::string>>::Success(direntsRes);
+    return FsResult<std::vector<std::string>>::Success(std::move(dirents));
 }
 
 } // namespace OHOS::FileManagement::ModuleFileIO
@@ -20,6 +20,7 @@
 
 #include "filemgmt_libfs.h"
 #include "i_file_filter.h"
+#include "listfile_walker.h"
 
 namespace OHOS::FileManagement::ModuleFileIO {
 
@@ -33,6 +34,9 @@ class ListFileExtCore {
 public:
     static FsResult<std::vector<std::string>> DoListFileExt(
         const std::string &path, const std::optional<ListFileExtOptions> &options = std::nullopt);
+    // Delivers the names in batches while the directory is walked, the order of the names is unspecified
+    static FsResult<void> DoListFileExt(
+        const std::string &path, const std::optional<ListFileExtOptions> &options, const ListFileBatchSink &sink);
 };
 
 } // namespace OHOS::FileManagement::ModuleFileIO
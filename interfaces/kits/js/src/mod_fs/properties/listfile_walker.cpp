@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "listfile_walker.h"
+
+#include <algorithm>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+#include "fd_guard.h"
+#include "filemgmt_libfs.h"
+#include "filemgmt_libhilog.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+
+namespace {
+constexpr size_t DIRENT_BUFFER_SIZE = 32 * 1024;
+constexpr size_t EMIT_BATCH_SIZE = 512;
+constexpr size_t MAX_WORKER_NUM = 4;
+
+// Layout of the records returned by getdents64
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+} // namespace
+
+ListFileWalker::ListFileWalker(const ListFileWalkOptions &options, ListFileMatcher matcher, ListFileBatchSink sink)
+    : options_(options), matcher_(move(matcher)), sink_(move(sink))
+{
+    if (!options_.recursion || options_.workerNum == 0) {
+        options_.workerNum = 1;
+    }
+}
+
+size_t ListFileWalker::DefaultWorkerNum()
+{
+    size_t cpuNum = thread::hardware_concurrency();
+    return max<size_t>(1, min(cpuNum, MAX_WORKER_NUM));
+}
+
+unsigned char ListFileWalker::ResolveType(int dirFd, const char *name, unsigned char type)
+{
+    if (type != DT_UNKNOWN) {
+        return type;
+    }
+    struct stat info;
+    if (fstatat(dirFd, name, &info, AT_SYMLINK_NOFOLLOW) != 0) {
+        return DT_UNKNOWN;
+    }
+    return S_ISDIR(info.st_mode) ? DT_DIR : (S_ISREG(info.st_mode) ? DT_REG : DT_UNKNOWN);
+}
+
+int ListFileWalker::ForEachDirent(int dirFd, vector<char> &buf,
+    const function<bool(const char *name, unsigned char type)> &visitor)
+{
+    if (buf.size() < DIRENT_BUFFER_SIZE) {
+        buf.resize(DIRENT_BUFFER_SIZE);
+    }
+    while (true) {
+        long nread = syscall(SYS_getdents64, dirFd, buf.data(), buf.size());
+        if (nread < 0) {
+            int err = errno;
+            HILOGE("Failed to scan dir with errno: %{public}d", err);
+            return err;
+        }
+        if (nread == 0) {
+            return ERRNO_NOERR;
+        }
+        for (long pos = 0; pos < nread;) {
+            auto dirent = reinterpret_cast<const LinuxDirent64 *>(buf.data() + pos);
+            pos += dirent->d_reclen;
+            string_view name(dirent->d_name);
+            if (name == "." || name == "..") {
+                continue;
+            }
+            if (!visitor(dirent->d_name, dirent->d_type)) {
+                return ERRNO_NOERR;
+            }
+        }
+    }
+}
+
+bool ListFileWalker::Stopped() const
+{
+    return stop_.load(memory_order_acquire);
+}
+
+void ListFileWalker::Stop(int err)
+{
+    if (err != ERRNO_NOERR) {
+        int expected = ERRNO_NOERR;
+        err_.compare_exchange_strong(expected, err);
+    }
+    stop_.store(true, memory_order_release);
+    lock_guard<mutex> lock(idleMutex_);
+    idleCv_.notify_all();
+}
+
+void ListFileWalker::Flush(Worker &worker)
+{
+    if (worker.batch.empty()) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(sinkMutex_);
+        sink_(move(worker.batch));
+    }
+    worker.batch.clear();
+}
+
+void ListFileWalker::Emit(Worker &worker, string &&name)
+{
+    worker.batch.push_back(move(name));
+    if (worker.batch.size() >= EMIT_BATCH_SIZE) {
+        Flush(worker);
+    }
+}
+
+void ListFileWalker::Push(Worker &worker, DirTask &&task)
+{
+    pending_.fetch_add(1);
+    {
+        lock_guard<mutex> lock(worker.mutex);
+        worker.tasks.push_back(move(task));
+    }
+    queued_.fetch_add(1);
+    lock_guard<mutex> lock(idleMutex_);
+    idleCv_.notify_one();
+}
+
+// The owner takes its newest directory to stay depth first, other workers steal the oldest one
+bool ListFileWalker::Pop(size_t id, DirTask &task)
+{
+    for (size_t i = 0; i < options_.workerNum; i++) {
+        Worker &victim = *workers_[(id + i) % options_.workerNum];
+        lock_guard<mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            task = move(victim.tasks.back());
+            victim.tasks.pop_back();
+        } else {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+        queued_.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+int ListFileWalker::ScanDir(Worker &worker, const DirTask &task)
+{
+    DistributedFS::FDGuard dirFd(open(task.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (!dirFd) {
+        int err = errno;
+        HILOGE("Failed to open dir with errno: %{public}d", err);
+        return err;
+    }
+    return ForEachDirent(dirFd.GetFD(), worker.direntBuf, [this, &worker, &task, &dirFd](const char *name,
+        unsigned char direntType) {
+        if (Stopped()) {
+            return false;
+        }
+        unsigned char type = ResolveType(dirFd.GetFD(), name, direntType);
+        if (options_.recursion && type == DT_DIR) {
+            if (!options_.descend || options_.descend({ dirFd.GetFD(), name, type, task.relPath })) {
+                Push(worker, { task.path + '/' + name, task.relPath + '/' + name });
+            }
+            return true;
+        }
+        if (matcher_ && !matcher_({ dirFd.GetFD(), name, type, task.relPath })) {
+            return true;
+        }
+        int64_t count = countNum_.fetch_add(1) + 1;
+        if (options_.listNum != 0 && count > options_.listNum) {
+            Stop(ERRNO_NOERR);
+            return false;
+        }
+        if (!options_.recursion) {
+            Emit(worker, name);
+        } else if (type == DT_REG) {
+            Emit(worker, task.relPath + '/' + name);
+        }
+        if (options_.listNum != 0 && count == options_.listNum) {
+            Stop(ERRNO_NOERR);
+            return false;
+        }
+        return true;
+    });
+}
+
+void ListFileWalker::Run(size_t id)
+{
+    Worker &worker = *workers_[id];
+    DirTask task;
+    while (!Stopped()) {
+        if (!Pop(id, task)) {
+            unique_lock<mutex> lock(idleMutex_);
+            idleCv_.wait(lock, [this] { return Stopped() || pending_.load() == 0 || queued_.load() > 0; });
+            if (pending_.load() == 0) {
+                break;
+            }
+            continue;
+        }
+        int ret = ScanDir(worker, task);
+        if (ret != ERRNO_NOERR) {
+            Stop(ret);
+        }
+        if (pending_.fetch_sub(1) == 1) {
+            lock_guard<mutex> lock(idleMutex_);
+            idleCv_.notify_all();
+        }
+    }
+    Flush(worker);
+}
+
+int ListFileWalker::Walk(const string &path)
+{
+    for (size_t i = 0; i < options_.workerNum; i++) {
+        workers_.push_back(make_unique<Worker>());
+    }
+
+    // The listed directory is read on the calling thread, helpers are only started when it has subdirectories
+    pending_.store(1);
+    int ret = ScanDir(*workers_[0], { path, "" });
+    if (ret != ERRNO_NOERR) {
+        Stop(ret);
+    }
+    pending_.fetch_sub(1);
+
+    if (!Stopped() && queued_.load() > 0) {
+        vector<thread> helpers;
+        for (size_t i = 1; i < options_.workerNum; i++) {
+            try {
+                helpers.emplace_back(&ListFileWalker::Run, this, i);
+            } catch (const system_error &e) {
+                HILOGE("Failed to start listFile worker: %{public}s", e.what());
+                break;
+            }
+        }
+        Run(0);
+        for (auto &helper : helpers) {
+            helper.join();
+        }
+    }
+    Flush(*workers_[0]);
+    return err_.load();
+}
+
+} // namespace OHOS::FileManagement::ModuleFileIO
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_LISTFILE_WALKER_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_LISTFILE_WALKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS::FileManagement::ModuleFileIO {
+
+// An entry handed to the matcher, dirFd stays open only for the duration of the call
+struct ListFileWalkEntry {
+    int dirFd = -1;
+    const char *name = nullptr;
+    unsigned char type = 0;
+    const std::string &relDir;
+};
+
+struct ListFileWalkOptions {
+    bool recursion = false;
+    int64_t listNum = 0;
+    // Number of threads walking the tree, the calling thread is one of them
+    size_t workerNum = 1;
+    // In recursion, called for every subdirectory before it is queued, returning false skips its subtree. It is
+    // called concurrently as the matcher is
+    std::function<bool(const ListFileWalkEntry &entry)> descend;
+};
+
+using ListFileMatcher = std::function<bool(const ListFileWalkEntry &entry)>;
+using ListFileBatchSink = std::function<void(std::vector<std::string> &&batch)>;
+
+/*
+ * Walks a directory with getdents64 and hands the matched entries to the sink in batches. Names are relative to the
+ * listed directory, in recursion they start with '/'. Subdirectories are shared between the workers through per
+ * worker deques, an idle worker steals the oldest directory of another one. The walk stops as soon as listNum entries
+ * matched or a directory failed to be read. With more than one worker the matcher is called concurrently and the
+ * order of the results is unspecified. The sink is never called concurrently.
+ */
+class ListFileWalker {
+public:
+    ListFileWalker(const ListFileWalkOptions &options, ListFileMatcher matcher, ListFileBatchSink sink);
+    ~ListFileWalker() = default;
+
+    int Walk(const std::string &path);
+
+    static size_t DefaultWorkerNum();
+    // Reads every record of an open directory with getdents64 except "." and "..", the visitor returns false to stop
+    static int ForEachDirent(int dirFd, std::vector<char> &buf,
+        const std::function<bool(const char *name, unsigned char type)> &visitor);
+    // Fills in DT_UNKNOWN from lstat for file systems that do not report d_type
+    static unsigned char ResolveType(int dirFd, const char *name, unsigned char type);
+
+private:
+    struct DirTask {
+        std::string path;
+        std::string relPath;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<DirTask> tasks;
+        std::vector<char> direntBuf;
+        std::vector<std::string> batch;
+    };
+
+    int ScanDir(Worker &worker, const DirTask &task);
+    void Emit(Worker &worker, std::string &&name);
+    void Flush(Worker &worker);
+    void Push(Worker &worker, DirTask &&task);
+    bool Pop(size_t id, DirTask &task);
+    void Run(size_t id);
+    void Stop(int err);
+    bool Stopped() const;
+
+    ListFileWalkOptions options_;
+    ListFileMatcher matcher_;
+    ListFileBatchSink sink_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex sinkMutex_;
+    std::mutex idleMutex_;
+    std::condition_variable idleCv_;
+    std::atomic<size_t> pending_ { 0 };
+    std::atomic<size_t> queued_ { 0 };
+    std::atomic<int64_t> countNum_ { 0 };
+    std::atomic<bool> stop_ { false };
+    std::atomic<int> err_ { 0 };
+};
+
+} // namespace OHOS::FileManagement::ModuleFileIO
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_LISTFILE_WALKER_H
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "metadata_cache.h"
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <vector>
+
+#include "file_utils.h"
+#include "filemgmt_libhilog.h"
+#include "fs_file_watcher.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+
+namespace {
+// Everything that can change the metadata or the existence of an entry of the directory, or of the directory itself
+constexpr uint32_t DIR_WATCH_EVENTS = IN_ATTRIB | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+    IN_DELETE_SELF | IN_MOVE_SELF;
+// The events of a directory entry that also change the stat of the directory
+constexpr uint32_t DIR_CONTENT_EVENTS = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+class MetadataCacheCallback : public IWatcherCallback {
+public:
+    bool IsStrictEquals(const shared_ptr<IWatcherCallback> &other) const override
+    {
+        return other.get() == this;
+    }
+
+    void InvokeCallback(const string &fileName, uint32_t event, uint32_t cookie) const override
+    {
+        MetadataCache::GetInstance().OnEvent(fileName, event);
+    }
+
+    string GetClassName() const override
+    {
+        return "MetadataCacheCallback";
+    }
+};
+} // namespace
+
+// Only absolute paths outside of the root directory are cached, the key is the path without trailing slashes
+static bool ToCacheKey(const string &path, string &key, string &dir)
+{
+    if (path.empty() || path[0] != '/') {
+        return false;
+    }
+    size_t end = path.find_last_not_of('/');
+    if (end == string::npos) {
+        return false;
+    }
+    key = path.substr(0, end + 1);
+    size_t pos = key.rfind('/');
+    if (pos == 0) {
+        return false;
+    }
+    dir = key.substr(0, pos);
+    return true;
+}
+
+static bool IsStableError(int32_t ret)
+{
+    return ret == 0 || ret == UV_ENOENT || ret == UV_ENOTDIR;
+}
+
+int32_t MetadataCache::Enable(const MetadataCacheOptions &options)
+{
+    if (options.capacity == 0 || options.ttlMs < 0) {
+        HILOGE("Invalid metadata cache options");
+        return EINVAL;
+    }
+    lock_guard<mutex> lock(mutex_);
+    if (callback_ == nullptr) {
+        callback_ = CreateSharedPtr<MetadataCacheCallback>();
+        if (callback_ == nullptr) {
+            HILOGE("Failed to request heap memory.");
+            return ENOMEM;
+        }
+    }
+    capacity_ = options.capacity;
+    ttlMs_ = options.ttlMs;
+    while (lru_.size() > capacity_) {
+        EraseLocked(prev(lru_.end()));
+        stats_.evictions++;
+    }
+    enabled_ = true;
+    return ERRNO_NOERR;
+}
+
+void MetadataCache::Disable()
+{
+    lock_guard<mutex> lock(mutex_);
+    enabled_ = false;
+    ClearLocked();
+    stats_ = MetadataCacheStats();
+}
+
+void MetadataCache::Invalidate(const string &path)
+{
+    lock_guard<mutex> lock(mutex_);
+    generation_++;
+    if (path.empty()) {
+        stats_.invalidations += lru_.size();
+        while (!lru_.empty()) {
+            EraseLocked(lru_.begin());
+        }
+        return;
+    }
+    string key;
+    string dir;
+    if (ToCacheKey(path, key, dir)) {
+        InvalidateLocked(key);
+    }
+}
+
+MetadataCacheStats MetadataCache::GetStats()
+{
+    lock_guard<mutex> lock(mutex_);
+    MetadataCacheStats stats = stats_;
+    stats.size = lru_.size();
+    stats.watches = dirs_.size();
+    return stats;
+}
+
+void MetadataCache::OnEvent(const string &fileName, uint32_t event)
+{
+    lock_guard<mutex> lock(mutex_);
+    if (!enabled_) {
+        return;
+    }
+    generation_++;
+    // A self event names the watched directory, which drops everything below it
+    InvalidateLocked(fileName);
+    size_t pos = fileName.rfind('/');
+    if ((event & DIR_CONTENT_EVENTS) == 0 || pos == string::npos || pos == 0) {
+        return;
+    }
+    auto it = index_.find(fileName.substr(0, pos));
+    if (it != index_.end() && it->second->selfWatched) {
+        stats_.invalidations++;
+        EraseLocked(it->second);
+    }
+}
+
+MetadataCache::CacheEntry *MetadataCache::FindLocked(const string &path)
+{
+    auto it = index_.find(path);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    EntryIter iter = it->second;
+    if (iter->expiry <= chrono::steady_clock::now()) {
+        EraseLocked(iter);
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, iter);
+    return &*iter;
+}
+
+// The directory is watched before the result is loaded, so a change made after the load cannot be missed
+shared_ptr<WatcherInfo> MetadataCache::PinDirLocked(const string &dir)
+{
+    if (!WatchDirLocked(dir)) {
+        return nullptr;
+    }
+    DirWatch &watch = dirs_[dir];
+    watch.loading++;
+    return watch.info;
+}
+
+// A directory found without a watch of its own is watched now and loaded again, for the same reason
+bool MetadataCache::BeginSelfLoad(LoadState &state)
+{
+    lock_guard<mutex> lock(mutex_);
+    auto dirIter = dirs_.find(state.dir);
+    if (!enabled_ || dirIter == dirs_.end() || dirIter->second.info != state.info) {
+        return false;
+    }
+    state.selfInfo = PinDirLocked(state.path);
+    state.generation = generation_;
+    return state.selfInfo != nullptr;
+}
+
+void MetadataCache::EndLoad(const LoadState &state, bool isDir, const EntryUpdater &update)
+{
+    lock_guard<mutex> lock(mutex_);
+    auto dirIter = dirs_.find(state.dir);
+    if (dirIter == dirs_.end() || dirIter->second.info != state.info) {
+        // The cache was cleared during the load and the watches it was counted in are gone
+        return;
+    }
+    dirIter->second.loading--;
+    auto selfIter = dirs_.end();
+    if (state.selfInfo != nullptr) {
+        selfIter = dirs_.find(state.path);
+        if (selfIter != dirs_.end() && selfIter->second.info == state.selfInfo) {
+            selfIter->second.loading--;
+        } else {
+            selfIter = dirs_.end();
+        }
+    }
+    bool watched = !isDir || selfIter != dirs_.end();
+    if (enabled_ && update != nullptr && state.generation == generation_ && watched) {
+        auto it = index_.find(state.path);
+        if (it == index_.end()) {
+            CacheEntry entry;
+            entry.path = state.path;
+            entry.dir = state.dir;
+            entry.expiry = (ttlMs_ > 0) ? chrono::steady_clock::now() + chrono::milliseconds(ttlMs_) :
+                chrono::steady_clock::time_point::max();
+            lru_.push_front(move(entry));
+            it = index_.emplace(state.path, lru_.begin()).first;
+            dirIter->second.entries++;
+        }
+        update(*it->second);
+        if (isDir && !it->second->selfWatched) {
+            it->second->selfWatched = true;
+            selfIter->second.entries++;
+        }
+        while (lru_.size() > capacity_) {
+            EraseLocked(prev(lru_.end()));
+            stats_.evictions++;
+        }
+    }
+    if (state.selfInfo != nullptr) {
+        ReleaseDirLocked(state.path);
+    }
+    ReleaseDirLocked(state.dir);
+}
+
+bool MetadataCache::WatchDirLocked(const string &dir)
+{
+    if (dirs_.find(dir) != dirs_.end()) {
+        return true;
+    }
+    auto &watcher = FsFileWatcher::GetInstance();
+    if (!watcher.TryInitNotify()) {
+        HILOGE("Failed to init notify for metadata cache, errno:%{public}d", errno);
+        return false;
+    }
+    auto info = CreateSharedPtr<WatcherInfo>(callback_);
+    if (info == nullptr) {
+        HILOGE("Failed to request heap memory.");
+        return false;
+    }
+    info->fileName = dir;
+    info->events = DIR_WATCH_EVENTS;
+    if (!watcher.AddWatcherInfo(info)) {
+        return false;
+    }
+    int32_t ret = watcher.StartNotify(info);
+    if (ret != ERRNO_NOERR) {
+        HILOGD("Failed to watch dir for metadata cache, ret:%{public}d", ret);
+        watcher.StopNotify(info);
+        return false;
+    }
+    watcher.AsyncGetNotifyEvent();
+    dirs_[dir].info = move(info);
+    return true;
+}
+
+void MetadataCache::ReleaseDirLocked(const string &dir)
+{
+    auto it = dirs_.find(dir);
+    if (it == dirs_.end() || it->second.entries != 0 || it->second.loading != 0) {
+        return;
+    }
+    FsFileWatcher::GetInstance().StopNotify(it->second.info);
+    dirs_.erase(it);
+}
+
+void MetadataCache::EraseLocked(EntryIter iter)
+{
+    string dir = move(iter->dir);
+    if (iter->selfWatched) {
+        auto self = dirs_.find(iter->path);
+        if (self != dirs_.end()) {
+            self->second.entries--;
+            ReleaseDirLocked(iter->path);
+        }
+    }
+    index_.erase(iter->path);
+    lru_.erase(iter);
+    auto it = dirs_.find(dir);
+    if (it != dirs_.end()) {
+        it->second.entries--;
+        ReleaseDirLocked(dir);
+    }
+}
+
+void MetadataCache::InvalidateLocked(const string &path)
+{
+    vector<EntryIter> dropped;
+    auto exact = index_.find(path);
+    if (exact != index_.end()) {
+        dropped.push_back(exact->second);
+    }
+    // '0' follows '/', so this is the range of the paths below path
+    auto first = index_.lower_bound(path + "/");
+    auto last = index_.lower_bound(path + "0");
+    for (auto it = first; it != last; ++it) {
+        dropped.push_back(it->second);
+    }
+    stats_.invalidations += dropped.size();
+    for (auto iter : dropped) {
+        EraseLocked(iter);
+    }
+}
+
+void MetadataCache::ClearLocked()
+{
+    generation_++;
+    lru_.clear();
+    index_.clear();
+    for (auto &[dir, watch] : dirs_) {
+        FsFileWatcher::GetInstance().StopNotify(watch.info);
+    }
+    dirs_.clear();
+}
+
+template <typename Find, typename Load, typename Store, typename IsDir>
+int32_t MetadataCache::Lookup(const string &path, Find find, Load load, Store store, IsDir isDir)
+{
+    LoadState state;
+    if (!enabled_ || !ToCacheKey(path, state.path, state.dir)) {
+        return load();
+    }
+    {
+        lock_guard<mutex> lock(mutex_);
+        CacheEntry *entry = FindLocked(state.path);
+        int32_t ret = 0;
+        if (entry != nullptr && find(*entry, ret)) {
+            stats_.hits++;
+            return ret;
+        }
+        stats_.misses++;
+        state.info = PinDirLocked(state.dir);
+        if (state.info != nullptr) {
+            auto self = dirs_.find(state.path);
+            if (self != dirs_.end()) {
+                self->second.loading++;
+                state.selfInfo = self->second.info;
+            }
+        }
+        state.generation = generation_;
+    }
+    int32_t ret = load();
+    if (state.info == nullptr) {
+        return ret;
+    }
+    if (isDir(ret) && state.selfInfo == nullptr && BeginSelfLoad(state)) {
+        ret = load();
+    }
+    EndLoad(state, isDir(ret), store(ret));
+    return ret;
+}
+
+int32_t MetadataCache::GetStat(const string &path, uv_stat_t &buf, const StatLoader &loader)
+{
+    return Lookup(path,
+        [&buf](const CacheEntry &entry, int32_t &ret) {
+            if (!entry.hasStat) {
+                return false;
+            }
+            ret = entry.statRet;
+            buf = entry.stat;
+            return true;
+        },
+        [&buf, &loader]() { return loader(buf); },
+        [&buf](int32_t ret) -> EntryUpdater {
+            if (!IsStableError(ret)) {
+                return nullptr;
+            }
+            return [&buf, ret](CacheEntry &entry) {
+                entry.hasStat = true;
+                entry.statRet = ret;
+                entry.stat = buf;
+            };
+        },
+        [&buf](int32_t ret) { return ret == 0 && S_ISDIR(buf.st_mode); });
+}
+
+int32_t MetadataCache::GetAccess(const string &path, int32_t mode, const AccessLoader &loader)
+{
+    if (mode < 0 || mode >= accessModes) {
+        return loader();
+    }
+    uint8_t bit = static_cast<uint8_t>(1U << static_cast<uint32_t>(mode));
+    return Lookup(path,
+        [mode, bit](const CacheEntry &entry, int32_t &ret) {
+            if ((entry.accessKnown & bit) == 0) {
+                return false;
+            }
+            ret = entry.accessRets[mode];
+            return true;
+        },
+        loader,
+        [mode, bit](int32_t ret) -> EntryUpdater {
+            if (!IsStableError(ret)) {
+                return nullptr;
+            }
+            return [mode, bit, ret](CacheEntry &entry) {
+                entry.accessKnown |= bit;
+                entry.accessRets[mode] = ret;
+            };
+        },
+        [](int32_t) { return false; });
+}
+
+int32_t MetadataCache::GetLocation(const string &path, const LocationLoader &loader)
+{
+    return Lookup(path,
+        [](const CacheEntry &entry, int32_t &ret) {
+            if (!entry.hasLocation) {
+                return false;
+            }
+            ret = entry.location;
+            return true;
+        },
+        loader,
+        [](int32_t ret) -> EntryUpdater {
+            if (ret <= 0) {
+                return nullptr;
+            }
+            return [ret](CacheEntry &entry) {
+                entry.hasLocation = true;
+                entry.location = ret;
+            };
+        },
+        [](int32_t) { return false; });
+}
+
+} // namespace OHOS::FileManagement::ModuleFileIO
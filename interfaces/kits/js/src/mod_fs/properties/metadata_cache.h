@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_METADATA_CACHE_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_METADATA_CACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "filemgmt_libfs.h"
+#include "fs_watch_entity.h"
+#include "singleton.h"
+#include "uv.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+
+constexpr size_t DEFAULT_METADATA_CACHE_CAPACITY = 1024;
+constexpr int64_t DEFAULT_METADATA_CACHE_TTL_MS = 10000;
+
+struct MetadataCacheOptions {
+    size_t capacity = DEFAULT_METADATA_CACHE_CAPACITY;
+    // 0 keeps entries until the watcher or invalidate drops them
+    int64_t ttlMs = DEFAULT_METADATA_CACHE_TTL_MS;
+};
+
+struct MetadataCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;
+    size_t size = 0;
+    size_t watches = 0;
+};
+
+// Loaders run on a miss and return what the uncached call returns, 0 or a negative uv error code for stat and access
+using StatLoader = std::function<int32_t(uv_stat_t &buf)>;
+using AccessLoader = std::function<int32_t()>;
+using LocationLoader = std::function<int32_t()>;
+
+/*
+ * Opt-in per-process cache of stat, access and cloud location results keyed by absolute path, bounded in entries
+ * and LRU ordered. The parent directory of every cached path is watched through FsFileWatcher and any change below
+ * it drops the entries concerned. A directory whose stat is cached is watched itself as well, since its own stat
+ * changes with its content, which the watch of its parent does not report. Events are handled on the watcher
+ * thread, so a change made right before a lookup may still be answered from the cache until its event is read; the
+ * TTL bounds how long this can last, including for changes the watch cannot see such as a rename of a grandparent
+ * or a lost event. Callers that need the effect of their own change at once call Invalidate.
+ */
+class MetadataCache : public Singleton<MetadataCache> {
+public:
+    int32_t Enable(const MetadataCacheOptions &options);
+    void Disable();
+    bool IsEnabled() const
+    {
+        return enabled_.load();
+    }
+    // Drops the path and everything cached below it, an empty path drops everything
+    void Invalidate(const std::string &path);
+    MetadataCacheStats GetStats();
+
+    int32_t GetStat(const std::string &path, uv_stat_t &buf, const StatLoader &loader);
+    int32_t GetAccess(const std::string &path, int32_t mode, const AccessLoader &loader);
+    int32_t GetLocation(const std::string &path, const LocationLoader &loader);
+
+    // Called by the directory watches
+    void OnEvent(const std::string &fileName, uint32_t event);
+
+public:
+    MetadataCache() = default;
+    ~MetadataCache() = default;
+    MetadataCache(const MetadataCache &) = delete;
+    MetadataCache &operator=(const MetadataCache &) = delete;
+
+private:
+    static constexpr int32_t accessModes = 8;
+
+    struct CacheEntry {
+        std::string path;
+        std::string dir;
+        std::chrono::steady_clock::time_point expiry;
+        bool hasStat = false;
+        int32_t statRet = 0;
+        uv_stat_t stat {};
+        uint8_t accessKnown = 0;
+        int32_t accessRets[accessModes] = { 0 };
+        bool hasLocation = false;
+        int32_t location = 0;
+        // Counted in the watch of the path itself, held while a directory stat is cached
+        bool selfWatched = false;
+    };
+
+    struct DirWatch {
+        std::shared_ptr<WatcherInfo> info;
+        size_t entries = 0;
+        size_t loading = 0;
+    };
+
+    struct LoadState {
+        std::string path;
+        std::string dir;
+        std::shared_ptr<WatcherInfo> info;
+        // Watch of the path itself if it has one, a directory stat is only kept under it
+        std::shared_ptr<WatcherInfo> selfInfo;
+        uint64_t generation = 0;
+    };
+
+    using EntryIter = std::list<CacheEntry>::iterator;
+    using EntryUpdater = std::function<void(CacheEntry &entry)>;
+
+    CacheEntry *FindLocked(const std::string &path);
+    std::shared_ptr<WatcherInfo> PinDirLocked(const std::string &dir);
+    bool BeginSelfLoad(LoadState &state);
+    // A null update leaves the cache as it is, the result is not worth keeping
+    void EndLoad(const LoadState &state, bool isDir, const EntryUpdater &update);
+    bool WatchDirLocked(const std::string &dir);
+    void ReleaseDirLocked(const std::string &dir);
+    void EraseLocked(EntryIter iter);
+    void InvalidateLocked(const std::string &path);
+    void ClearLocked();
+    template <typename Find, typename Load, typename Store, typename IsDir>
+    int32_t Lookup(const std::string &path, Find find, Load load, Store store, IsDir isDir);
+
+private:
+    std::mutex mutex_;
+    std::atomic<bool> enabled_ { false };
+    size_t capacity_ = DEFAULT_METADATA_CACHE_CAPACITY;
+    int64_t ttlMs_ = DEFAULT_METADATA_CACHE_TTL_MS;
+    // Bumped by every invalidation, a result loaded across one is not stored
+    uint64_t generation_ = 0;
+    // Front is the most recently used entry
+    std::list<CacheEntry> lru_;
+    // Ordered so that the entries below a directory are one range of keys
+    std::map<std::string, EntryIter> index_;
+    std::unordered_map<std::string, DirWatch> dirs_;
+    std::shared_ptr<IWatcherCallback> callback_;
+    MetadataCacheStats stats_;
+};
+
+} // namespace OHOS::FileManagement::ModuleFileIO
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_METADATA_CACHE_H
@@ -20,13 +20,14 @@
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "file_fs_trace.h"
 #include "filemgmt_libhilog.h"
 
 #if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
-#include "rust_file.h"
+#include "dir_tree_ops.h"
 #endif
 
 #ifdef FILE_API_TRACE
@@ -75,9 +76,11 @@ static int32_t MkdirExec(const string &path, bool recursion, bool hasOption)
             HILOGE("Failed to check for illegal path or request for heap memory");
             return ret;
         }
-        if (::Mkdirs(path.c_str(), static_cast<MakeDirectionMode>(recursion)) < 0) {
-            HILOGD("Failed to create directories, error: %{public}d", errno);
-            return errno;
+        ret = recursion ? DirTreeOps::MakeDirs(path, MAKE_DIRS_DEFAULT_MODE) :
+            ((mkdir(path.c_str(), MAKE_DIRS_DEFAULT_MODE) == 0) ? ERRNO_NOERR : errno);
+        if (ret != ERRNO_NOERR) {
+            HILOGD("Failed to create directories, error: %{public}d", ret);
+            return ret;
         }
         ret = UvAccess(path, 0);
         if (ret) {
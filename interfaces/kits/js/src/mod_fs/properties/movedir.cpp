@@ -15,17 +15,16 @@
 
 #include "movedir.h"
 
-#include <dirent.h>
 #include <filesystem>
 #include <memory>
-#include <string_view>
 #include <tuple>
-#include <unistd.h>
 #include <deque>
 
 #include "common_func.h"
 #include "file_utils.h"
 #include "filemgmt_libhilog.h"
+#include "listfile_walker.h"
+#include "napi/dir_tree_options_napi.h"
 
 #include "file_fs_metrics.h"
 
@@ -35,255 +34,31 @@ namespace ModuleFileIO {
 using namespace std;
 using namespace OHOS::FileManagement::LibN;
 
-static int RecurMoveDir(const string &srcPath, const string &destPath, const int mode,
-    deque<struct ErrFiles> &errfiles);
-
-static tuple<bool, bool> JudgeExistAndEmpty(const string &path)
-{
-    std::error_code errCode;
-    filesystem::path pathName(path);
-    if (filesystem::exists(pathName, errCode)) {
-        if (filesystem::is_empty(pathName, errCode)) {
-            return { true, true };
-        }
-        return { true, false };
-    }
-    return { false, false };
-}
-
-static int RmDirectory(const string &path)
-{
-    filesystem::path pathName(path);
-    std::error_code existsErrCode;
-    if (filesystem::exists(pathName, existsErrCode)) {
-        std::error_code removeErrCode;
-        (void)filesystem::remove_all(pathName, removeErrCode);
-        if (removeErrCode.value() != 0) {
-            HILOGE("Failed to remove directory, error code: %{public}d", removeErrCode.value());
-            return removeErrCode.value();
-        }
-    } else if (existsErrCode.value() != ERRNO_NOERR) {
-        HILOGE("fs exists fail, errcode is %{public}d", existsErrCode.value());
-        return existsErrCode.value();
-    }
-    return ERRNO_NOERR;
-}
-
-static int RemovePath(const string& pathStr)
-{
-    filesystem::path pathTarget(pathStr);
-    std::error_code errCode;
-    if (!filesystem::remove(pathTarget, errCode)) {
-        HILOGE("Failed to remove file or directory, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return ERRNO_NOERR;
-}
-
-static tuple<bool, unique_ptr<char[]>, unique_ptr<char[]>, int> ParseJsOperand(napi_env env, const NFuncArg& funcArg)
+static tuple<bool, unique_ptr<char[]>, unique_ptr<char[]>, DirTreeOptions> ParseJsOperand(napi_env env,
+    const NFuncArg& funcArg)
 {
     auto [resGetFirstArg, src, ignore] = NVal(env, funcArg[NARG_POS::FIRST]).ToUTF8StringPath();
     std::error_code errCode;
     if (!resGetFirstArg || !filesystem::is_directory(filesystem::status(src.get(), errCode))) {
         HILOGE("Invalid src, errCode = %{public}d", errCode.value());
-        return { false, nullptr, nullptr, 0 };
+        return { false, nullptr, nullptr, DirTreeOptions() };
     }
     auto [resGetSecondArg, dest, unused] = NVal(env, funcArg[NARG_POS::SECOND]).ToUTF8StringPath();
     if (!resGetSecondArg || !filesystem::is_directory(filesystem::status(dest.get(), errCode))) {
         HILOGE("Invalid dest,errCode = %{public}d", errCode.value());
-        return { false, nullptr, nullptr, 0 };
+        return { false, nullptr, nullptr, DirTreeOptions() };
     }
-    int mode = 0;
+    DirTreeOptions options;
+    options.mode = DIRMODE_DIRECTORY_THROW_ERR;
+    options.workerNum = ListFileWalker::DefaultWorkerNum();
     if (funcArg.GetArgc() >= NARG_CNT::THREE) {
-        bool resGetThirdArg = false;
-        tie(resGetThirdArg, mode) = NVal(env, funcArg[NARG_POS::THIRD]).ToInt32(mode);
-        if (!resGetThirdArg || (mode < DIRMODE_MIN || mode > DIRMODE_MAX)) {
+        bool resGetThirdArg = DirTreeOptionsNapi::Parse(env, NVal(env, funcArg[NARG_POS::THIRD]), options);
+        if (!resGetThirdArg || (options.mode < DIRMODE_MIN || options.mode > DIRMODE_MAX)) {
             HILOGE("Invalid mode");
-            return { false, nullptr, nullptr, 0 };
-        }
-    }
-    return { true, move(src), move(dest), mode };
-}
-
-static int CopyAndDeleteFile(const string &src, const string &dest)
-{
-    filesystem::path dstPath(dest);
-    std::error_code errCode;
-    if (filesystem::exists(dstPath, errCode)) {
-        int removeRes = RemovePath(dest);
-        if (removeRes != 0) {
-            HILOGE("Failed to remove dest file");
-            return removeRes;
-        }
-    }
-    filesystem::path srcPath(src);
-    if (!filesystem::copy_file(srcPath, dstPath, filesystem::copy_options::overwrite_existing, errCode)) {
-        HILOGE("Failed to copy file, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return RemovePath(src);
-}
-
-static int RenameFile(const string &src, const string &dest, const int mode, deque<struct ErrFiles> &errfiles)
-{
-    filesystem::path dstPath(dest);
-    std::error_code errCode;
-    if (filesystem::exists(dstPath, errCode)) {
-        if (filesystem::is_directory(dstPath, errCode)) {
-            errfiles.emplace_front(src, dest);
-            return ERRNO_NOERR;
-        }
-        if (mode == DIRMODE_FILE_THROW_ERR) {
-            errfiles.emplace_back(src, dest);
-            return ERRNO_NOERR;
-        }
-    }
-    if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("fs exists or is_directory fail, errcode is %{public}d", errCode.value());
-    }
-    filesystem::path srcPath(src);
-    filesystem::rename(srcPath, dstPath, errCode);
-    if (errCode.value() == EXDEV) {
-        HILOGD("Failed to rename file due to EXDEV");
-        return CopyAndDeleteFile(src, dest);
-    }
-    return errCode.value();
-}
-
-static int32_t FilterFunc(const struct dirent *filename)
-{
-    if (string_view(filename->d_name) == "." || string_view(filename->d_name) == "..") {
-        return FILE_DISMATCH;
-    }
-    return FILE_MATCH;
-}
-
-static int RenameDir(const string &src, const string &dest, const int mode, deque<struct ErrFiles> &errfiles)
-{
-    filesystem::path destPath(dest);
-    std::error_code errCode;
-    if (filesystem::exists(destPath, errCode)) {
-        return RecurMoveDir(src, dest, mode, errfiles);
-    } else if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("fs exists fail, errcode is %{public}d", errCode.value());
-        return errCode.value();
-    }
-    filesystem::path srcPath(src);
-    filesystem::rename(srcPath, destPath, errCode);
-    if (errCode.value() == EXDEV) {
-        HILOGD("Failed to rename file due to EXDEV");
-        if (!filesystem::create_directory(destPath, errCode)) {
-            HILOGE("Failed to create directory, error code: %{public}d", errCode.value());
-            return errCode.value();
+            return { false, nullptr, nullptr, DirTreeOptions() };
         }
-        return RecurMoveDir(src, dest, mode, errfiles);
-    }
-    if (errCode.value() != 0) {
-        HILOGE("Failed to rename file, error code: %{public}d", errCode.value());
-        return errCode.value();
-    }
-    return ERRNO_NOERR;
-}
-
-struct NameListArg {
-    struct dirent** namelist;
-    int num;
-};
-
-static void Deleter(struct NameListArg *arg)
-{
-    for (int i = 0; i < arg->num; i++) {
-        free((arg->namelist)[i]);
-        (arg->namelist)[i] = nullptr;
-    }
-    free(arg->namelist);
-    arg->namelist = nullptr;
-    delete arg;
-    arg = nullptr;
-}
-
-static int RecurMoveDir(const string &srcPath, const string &destPath, const int mode,
-    deque<struct ErrFiles> &errfiles)
-{
-    filesystem::path dpath(destPath);
-    std::error_code errCode;
-    if (!filesystem::is_directory(dpath, errCode)) {
-        errfiles.emplace_front(srcPath, destPath);
-        return ERRNO_NOERR;
-    }
-
-    unique_ptr<struct NameListArg, decltype(Deleter)*> ptr = { new (std::nothrow) struct NameListArg, Deleter };
-    if (!ptr) {
-        HILOGE("Failed to request heap memory.");
-        return ENOMEM;
     }
-    int num = scandir(srcPath.c_str(), &(ptr->namelist), FilterFunc, alphasort);
-    ptr->num = num;
-
-    for (int i = 0; i < num; i++) {
-        if ((ptr->namelist[i])->d_type == DT_DIR) {
-            string srcTemp = srcPath + '/' + string((ptr->namelist[i])->d_name);
-            string destTemp = destPath + '/' + string((ptr->namelist[i])->d_name);
-            size_t size = errfiles.size();
-            int res = RenameDir(srcTemp, destTemp, mode, errfiles);
-            if (res != ERRNO_NOERR) {
-                return res;
-            }
-            if (size != errfiles.size()) {
-                continue;
-            }
-            res = RemovePath(srcTemp);
-            if (res) {
-                return res;
-            }
-        } else {
-            string src = srcPath + '/' + string((ptr->namelist[i])->d_name);
-            string dest = destPath + '/' + string((ptr->namelist[i])->d_name);
-            int res = RenameFile(src, dest, mode, errfiles);
-            if (res != ERRNO_NOERR) {
-                HILOGE("Failed to rename file for error %{public}d", res);
-                return res;
-            }
-        }
-    }
-    return ERRNO_NOERR;
-}
-
-static int MoveDirFunc(const string &src, const string &dest, const int mode, deque<struct ErrFiles> &errfiles)
-{
-    size_t found = string(src).rfind('/');
-    if (found == std::string::npos) {
-        return EINVAL;
-    }
-    string dirName = string(src).substr(found);
-    string destStr = dest + dirName;
-    auto [destStrExist, destStrEmpty] = JudgeExistAndEmpty(destStr);
-    if (destStrExist && !destStrEmpty) {
-        if (mode == DIRMODE_DIRECTORY_REPLACE) {
-            int removeRes = RmDirectory(destStr);
-            if (removeRes) {
-                HILOGE("Failed to remove dest directory in DIRMODE_DIRECTORY_REPLACE, ret %{public}d", removeRes);
-                return removeRes;
-            }
-        }
-        if (mode == DIRMODE_DIRECTORY_THROW_ERR) {
-            HILOGE("Failed to move directory in DIRMODE_DIRECTORY_THROW_ERR");
-            return ENOTEMPTY;
-        }
-    }
-    int res = RenameDir(src, destStr, mode, errfiles);
-    if (res == ERRNO_NOERR) {
-        if (!errfiles.empty()) {
-            HILOGE("Failed to movedir with some conflicted files");
-            return EEXIST;
-        }
-        int removeRes = RmDirectory(src);
-        if (removeRes) {
-            HILOGE("Failed to remove src directory, ret %{public}d", removeRes);
-            return removeRes;
-        }
-    }
-    return res;
+    return { true, move(src), move(dest), options };
 }
 
 static napi_value GetErrData(napi_env env, deque<struct ErrFiles> &errfiles)
@@ -316,7 +91,7 @@ napi_value MoveDir::Sync(napi_env env, napi_callback_info info)
         NError(EINVAL).ThrowErr(env);
         return nullptr;
     }
-    auto [succ, src, dest, mode] = ParseJsOperand(env, funcArg);
+    auto [succ, src, dest, options] = ParseJsOperand(env, funcArg);
     if (!succ) {
         NError(EINVAL).ThrowErr(env);
         return nullptr;
@@ -324,7 +99,7 @@ napi_value MoveDir::Sync(napi_env env, napi_callback_info info)
 
     deque<struct ErrFiles> errfiles = {};
     METRICS_COUNT("CoreFileKit.fileio.Dyn.moveDirSync");
-    int ret = MoveDirFunc(src.get(), dest.get(), mode, errfiles);
+    int ret = DirTreeOps::MoveDir(src.get(), dest.get(), options.mode, errfiles, options.workerNum);
     if (ret == EEXIST) {
         METRICS_ERROR("CoreFileKit.fileio.Dyn.moveDirSync.Err", NError(ret).GetErrCode());
         NError(ret).ThrowErrAddData(env, EEXIST, GetErrData(env, errfiles));
@@ -351,7 +126,7 @@ napi_value MoveDir::Async(napi_env env, napi_callback_info info)
         NError(EINVAL).ThrowErr(env);
         return nullptr;
     }
-    auto [succ, src, dest, mode] = ParseJsOperand(env, funcArg);
+    auto [succ, src, dest, options] = ParseJsOperand(env, funcArg);
     if (!succ) {
         NError(EINVAL).ThrowErr(env);
         return nullptr;
@@ -363,15 +138,15 @@ napi_value MoveDir::Async(napi_env env, napi_callback_info info)
         return nullptr;
     }
     METRICS_COUNT("CoreFileKit.fileio.Dyn.moveDir");
-    auto cbExec = [srcPath = string(src.get()), destPath = string(dest.get()), mode = mode, arg]() -> NError {
-        arg->errNo = MoveDirFunc(srcPath, destPath, mode, arg->errfiles);
+    auto cbExec = [srcPath = string(src.get()), destPath = string(dest.get()), options = options, arg]() -> NError {
+        arg->errNo = DirTreeOps::MoveDir(srcPath, destPath, options.mode, arg->errfiles, options.workerNum);
         if (arg->errNo) {
             METRICS_ERROR("CoreFileKit.fileio.Dyn.moveDir.Err", NError(arg->errNo).GetErrCode());
             return NError(arg->errNo);
         }
         return NError(ERRNO_NOERR);
     };
-    auto cbComplCallback = [arg, mode = mode](napi_env env, NError err) -> NVal {
+    auto cbComplCallback = [arg](napi_env env, NError err) -> NVal {
         if (arg->errNo == EEXIST) {
             napi_value data = err.GetNapiErr(env);
             napi_status status = napi_set_named_property(env, data, FILEIO_TAG_ERR_DATA.c_str(),
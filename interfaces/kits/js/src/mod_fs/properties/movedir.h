@@ -18,39 +18,19 @@
 
 #include <string>
 
+#include "dir_tree_ops.h"
 #include "filemgmt_libn.h"
 
 namespace OHOS {
 namespace FileManagement {
 namespace ModuleFileIO {
 
-constexpr int DIRMODE_MIN = 0;
-constexpr int DIRMODE_MAX = 3;
-
-constexpr int FILE_DISMATCH = 0;
-constexpr int FILE_MATCH = 1;
-constexpr int MOVEDIR_DEFAULT_PERM = 0770;
-
-enum ModeOfMoveDir {
-    DIRMODE_DIRECTORY_THROW_ERR = 0,
-    DIRMODE_FILE_THROW_ERR,
-    DIRMODE_FILE_REPLACE,
-    DIRMODE_DIRECTORY_REPLACE
-};
-
 class MoveDir final {
 public:
     static napi_value Sync(napi_env env, napi_callback_info info);
     static napi_value Async(napi_env env, napi_callback_info info);
 };
 
-struct ErrFiles {
-    std::string srcFiles;
-    std::string destFiles;
-    ErrFiles(const std::string& src, const std::string& dest) : srcFiles(src), destFiles(dest) {}
-    ~ErrFiles() = default;
-};
-
 const std::string PROCEDURE_MOVEDIR_NAME = "fs.moveDir";
 } // namespace ModuleFileIO
 } // namespace FileManagement
@@ -19,6 +19,7 @@
 #include <deque>
 #include <string>
 
+#include "dir_tree_ops.h"
 #include "filemgmt_libfs.h"
 #include "fs_utils.h"
 
@@ -26,27 +27,6 @@ namespace OHOS {
 namespace FileManagement {
 namespace ModuleFileIO {
 
-constexpr int DIRMODE_MIN = 0;
-constexpr int DIRMODE_MAX = 3;
-
-constexpr int FILE_DISMATCH = 0;
-constexpr int FILE_MATCH = 1;
-constexpr int MOVEDIR_DEFAULT_PERM = 0770;
-
-enum ModeOfMoveDir {
-    DIRMODE_DIRECTORY_THROW_ERR = 0,
-    DIRMODE_FILE_THROW_ERR,
-    DIRMODE_FILE_REPLACE,
-    DIRMODE_DIRECTORY_REPLACE
-};
-
-struct ErrFiles {
-    std::string srcFiles;
-    std::string destFiles;
-    ErrFiles(const std::string& src, const std::string& dest) : srcFiles(src), destFiles(dest) {}
-    ~ErrFiles() = default;
-};
-
 struct MoveDirResult {
     FsResult<void> fsResult;
     optional<deque<struct ErrFiles>> errFiles;
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "napi/dir_tree_options_napi.h"
+
+#include <tuple>
+
+#include "filemgmt_libhilog.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+using namespace std;
+using namespace OHOS::FileManagement::LibN;
+
+bool DirTreeOptionsNapi::Parse(napi_env env, const NVal &op, DirTreeOptions &options)
+{
+    if (!op.TypeIs(napi_object)) {
+        auto [succ, mode] = op.ToInt32(options.mode);
+        options.mode = mode;
+        return succ;
+    }
+    if (op.HasProp("mode") && !op.GetProp("mode").TypeIs(napi_undefined)) {
+        auto [succ, mode] = op.GetProp("mode").ToInt32();
+        if (!succ) {
+            HILOGE("Illegal options.mode type");
+            return false;
+        }
+        options.mode = mode;
+    }
+    if (op.HasProp("concurrency") && !op.GetProp("concurrency").TypeIs(napi_undefined)) {
+        auto [succ, concurrency] = op.GetProp("concurrency").ToInt32();
+        if (!succ || concurrency <= 0 || concurrency > MAX_DIR_TREE_CONCURRENCY) {
+            HILOGE("Illegal options.concurrency");
+            return false;
+        }
+        options.workerNum = static_cast<size_t>(concurrency);
+    }
+    return true;
+}
+
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
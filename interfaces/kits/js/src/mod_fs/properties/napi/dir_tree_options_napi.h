@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_NAPI_DIR_TREE_OPTIONS_NAPI_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_NAPI_DIR_TREE_OPTIONS_NAPI_H
+
+#include <cstddef>
+
+#include "filemgmt_libn.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+
+// Every worker is a thread, a larger concurrency is rejected rather than left to fail inside the async work
+constexpr int32_t MAX_DIR_TREE_CONCURRENCY = 64;
+
+struct DirTreeOptions {
+    int mode = 0;
+    size_t workerNum = 1;
+};
+
+class DirTreeOptionsNapi final {
+public:
+    // The third argument of copyDir and moveDir is the mode, or an object with the mode and the number of threads
+    // walking the tree. The fields left out keep the values options already holds
+    static bool Parse(napi_env env, const LibN::NVal &op, DirTreeOptions &options);
+};
+
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_NAPI_DIR_TREE_OPTIONS_NAPI_H
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "napi/metadata_cache_napi.h"
+
+#include <tuple>
+#include <vector>
+
+#include "filemgmt_libhilog.h"
+#include "filemgmt_libn.h"
+#include "metadata_cache.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+using namespace std;
+using namespace OHOS::FileManagement::LibN;
+
+static tuple<bool, MetadataCacheOptions> ParseOptions(napi_env env, const NFuncArg &funcArg)
+{
+    MetadataCacheOptions options;
+    if (funcArg.GetArgc() == NARG_CNT::ZERO) {
+        return { true, options };
+    }
+    NVal op(env, funcArg[NARG_POS::FIRST]);
+    if (op.TypeIs(napi_undefined)) {
+        return { true, options };
+    }
+    if (!op.TypeIs(napi_object)) {
+        HILOGE("Invalid options");
+        return { false, options };
+    }
+    if (op.HasProp("capacity") && !op.GetProp("capacity").TypeIs(napi_undefined)) {
+        auto [succ, capacity] = op.GetProp("capacity").ToInt64();
+        if (!succ || capacity <= 0) {
+            HILOGE("Invalid capacity");
+            return { false, options };
+        }
+        options.capacity = static_cast<size_t>(capacity);
+    }
+    if (op.HasProp("ttl") && !op.GetProp("ttl").TypeIs(napi_undefined)) {
+        auto [succ, ttl] = op.GetProp("ttl").ToInt64();
+        if (!succ || ttl < 0) {
+            HILOGE("Invalid ttl");
+            return { false, options };
+        }
+        options.ttlMs = ttl;
+    }
+    return { true, options };
+}
+
+napi_value MetadataCacheNapi::Enable(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ZERO, NARG_CNT::ONE)) {
+        HILOGE("Number of arguments unmatched");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succ, options] = ParseOptions(env, funcArg);
+    if (!succ) {
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    int32_t ret = MetadataCache::GetInstance().Enable(options);
+    if (ret != ERRNO_NOERR) {
+        NError(ret).ThrowErr(env);
+        return nullptr;
+    }
+    return NVal::CreateUndefined(env).val_;
+}
+
+napi_value MetadataCacheNapi::Disable(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+        HILOGE("Number of arguments unmatched");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    MetadataCache::GetInstance().Disable();
+    return NVal::CreateUndefined(env).val_;
+}
+
+napi_value MetadataCacheNapi::Invalidate(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ZERO, NARG_CNT::ONE)) {
+        HILOGE("Number of arguments unmatched");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    if (funcArg.GetArgc() == NARG_CNT::ZERO || NVal(env, funcArg[NARG_POS::FIRST]).TypeIs(napi_undefined)) {
+        MetadataCache::GetInstance().Invalidate("");
+        return NVal::CreateUndefined(env).val_;
+    }
+    auto [succ, path, unused] = NVal(env, funcArg[NARG_POS::FIRST]).ToUTF8StringPath();
+    if (!succ || path.get()[0] == '\0') {
+        HILOGE("Invalid path");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    MetadataCache::GetInstance().Invalidate(path.get());
+    return NVal::CreateUndefined(env).val_;
+}
+
+napi_value MetadataCacheNapi::GetStats(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ZERO)) {
+        HILOGE("Number of arguments unmatched");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    MetadataCacheStats stats = MetadataCache::GetInstance().GetStats();
+    NVal obj = NVal::CreateObject(env);
+    vector<pair<const char *, int64_t>> props = {
+        { "hits", static_cast<int64_t>(stats.hits) },
+        { "misses", static_cast<int64_t>(stats.misses) },
+        { "evictions", static_cast<int64_t>(stats.evictions) },
+        { "invalidations", static_cast<int64_t>(stats.invalidations) },
+        { "size", static_cast<int64_t>(stats.size) },
+        { "watches", static_cast<int64_t>(stats.watches) },
+    };
+    for (const auto &[name, val] : props) {
+        if (!obj.AddProp(name, NVal::CreateInt64(env, val).val_)) {
+            HILOGE("Failed to set %{public}s", name);
+            NError(ENOMEM).ThrowErr(env);
+            return nullptr;
+        }
+    }
+    return obj.val_;
+}
+
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_NAPI_METADATA_CACHE_NAPI_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_NAPI_METADATA_CACHE_NAPI_H
+
+#include "filemgmt_libn.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+
+class MetadataCacheNapi final {
+public:
+    static napi_value Enable(napi_env env, napi_callback_info info);
+    static napi_value Disable(napi_env env, napi_callback_info info);
+    static napi_value Invalidate(napi_env env, napi_callback_info info);
+    static napi_value GetStats(napi_env env, napi_callback_info info);
+};
+
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_NAPI_METADATA_CACHE_NAPI_H
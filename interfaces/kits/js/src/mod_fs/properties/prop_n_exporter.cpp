@@ -54,6 +54,7 @@
 #include "create_randomaccessfile.h"
 #include "create_stream.h"
 #include "create_streamrw.h"
+#include "dir_tree_ops.h"
 #include "disconnectdfs.h"
 #include "dup.h"
 #include "fdopen_stream.h"
@@ -62,12 +63,16 @@
 #include "listfile_ext_napi.h"
 #include "listfile.h"
 #include "lseek.h"
+#include "metadata_cache.h"
+#include "napi/metadata_cache_napi.h"
 #include "napi/mmap_napi.h"
 #include "move.h"
 #include "movedir.h"
+#include "read_dir_with_stats.h"
 #include "read_lines.h"
 #include "read_text.h"
 #include "rust_file.h"
+#include "stat_batch.h"
 #include "symlink.h"
 #include "system_ability_definition.h"
 #include "watcher.h"
@@ -211,6 +216,19 @@ static int AccessCore(const string &path, int mode, int flag = DEFAULT_FLAG)
     return UvAccess(path, mode);
 }
 
+// Only the access API answers from the metadata cache, the existence checks done for other APIs always go to the
+// file system
+static int AccessWithCache(const string &path, int mode, int flag)
+{
+#if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+    auto &cache = MetadataCache::GetInstance();
+    if (flag == DEFAULT_FLAG && cache.IsEnabled()) {
+        return cache.GetAccess(path, mode, [&path, mode]() { return AccessCore(path, mode); });
+    }
+#endif
+    return AccessCore(path, mode, flag);
+}
+
 static int GetMode(NVal secondVar, bool *hasMode)
 {
     if (secondVar.TypeIs(napi_number)) {
@@ -273,7 +291,7 @@ napi_value PropNExporter::AccessSync(napi_env env, napi_callback_info info)
     }
 
     bool isAccess = false;
-    int ret = AccessCore(args.path, args.mode, args.flag);
+    int ret = AccessWithCache(args.path, args.mode, args.flag);
     if (ret < 0 && (string_view(uv_err_name(ret)) != "ENOENT")) {
         HILOGE("Failed to access file by path, ret:%{public}d", ret);
         METRICS_ERROR("CoreFileKit.fileio.Dyn.accessSync.Err", NError(ret).GetErrCode());
@@ -309,7 +327,7 @@ napi_value PropNExporter::Access(napi_env env, napi_callback_info info)
         return nullptr;
     }
     auto cbExec = [path = args.path, result, mode = args.mode, flag = args.flag]() -> NError {
-        int ret = AccessCore(path, mode, flag);
+        int ret = AccessWithCache(path, mode, flag);
         if (ret == 0) {
             result->isAccess = true;
         }
@@ -452,9 +470,11 @@ static NError MkdirExec(const string &path, bool recursion, bool hasOption)
             HILOGE("Failed to check for illegal path or request for heap memory, ret: %{public}d", ret);
             return NError(ret);
         }
-        if (::Mkdirs(path.c_str(), static_cast<MakeDirectionMode>(recursion)) < 0) {
-            HILOGE("Failed to create directories, error: %{public}d", errno);
-            return NError(errno);
+        ret = recursion ? DirTreeOps::MakeDirs(path, MAKE_DIRS_DEFAULT_MODE) :
+            ((mkdir(path.c_str(), MAKE_DIRS_DEFAULT_MODE) == 0) ? ERRNO_NOERR : errno);
+        if (ret != ERRNO_NOERR) {
+            HILOGE("Failed to create directories, error: %{public}d", ret);
+            return NError(ret);
         }
         ret = AccessCore(path, 0);
         if (ret) {
@@ -852,15 +872,21 @@ bool PropNExporter::ExportSync()
         NVal::DeclareNapiFunction("createReadStream", CreateStreamRw::Read),
         NVal::DeclareNapiFunction("createWriteStream", CreateStreamRw::Write),
         NVal::DeclareNapiFunction("dup", Dup::Sync),
+        NVal::DeclareNapiFunction("disableMetadataCache", MetadataCacheNapi::Disable),
+        NVal::DeclareNapiFunction("enableMetadataCache", MetadataCacheNapi::Enable),
         NVal::DeclareNapiFunction("fdopenStreamSync", FdopenStream::Sync),
+        NVal::DeclareNapiFunction("getMetadataCacheStats", MetadataCacheNapi::GetStats),
+        NVal::DeclareNapiFunction("invalidateMetadataCache", MetadataCacheNapi::Invalidate),
         NVal::DeclareNapiFunction("listFileExtSync", ListFileExtNapi::Sync),
         NVal::DeclareNapiFunction("listFileSync", ListFile::Sync),
         NVal::DeclareNapiFunction("lseek", Lseek::Sync),
         NVal::DeclareNapiFunction("mmapSync", MmapNapi::Sync),
         NVal::DeclareNapiFunction("moveDirSync", MoveDir::Sync),
         NVal::DeclareNapiFunction("moveFileSync", Move::Sync),
+        NVal::DeclareNapiFunction("readDirWithStatsSync", ReadDirWithStats::Sync),
         NVal::DeclareNapiFunction("readLinesSync", ReadLines::Sync),
         NVal::DeclareNapiFunction("readTextSync", ReadText::Sync),
+        NVal::DeclareNapiFunction("statBatchSync", StatBatch::Sync),
         NVal::DeclareNapiFunction("symlinkSync", Symlink::Sync),
         NVal::DeclareNapiFunction("setxattrSync", Xattr::SetSync),
         NVal::DeclareNapiFunction("getxattrSync", Xattr::GetSync),
@@ -900,8 +926,10 @@ bool PropNExporter::ExportAsync()
         NVal::DeclareNapiFunction("mmap", MmapNapi::Async),
         NVal::DeclareNapiFunction("moveDir", MoveDir::Async),
         NVal::DeclareNapiFunction("moveFile", Move::Async),
+        NVal::DeclareNapiFunction("readDirWithStats", ReadDirWithStats::Async),
         NVal::DeclareNapiFunction("readLines", ReadLines::Async),
         NVal::DeclareNapiFunction("readText", ReadText::Async),
+        NVal::DeclareNapiFunction("statBatch", StatBatch::Async),
         NVal::DeclareNapiFunction("symlink", Symlink::Async),
         NVal::DeclareNapiFunction("createWatcher", Watcher::CreateWatcher),
         NVal::DeclareNapiFunction("connectDfs", ConnectDfs::Async),
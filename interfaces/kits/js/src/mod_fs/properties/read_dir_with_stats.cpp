@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "read_dir_with_stats.h"
+
+#include <memory>
+#include <securec.h>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "file_utils.h"
+#include "filemgmt_libhilog.h"
+
+#include "file_fs_metrics.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+using namespace OHOS::FileManagement::LibN;
+
+static tuple<bool, uint32_t> ParseFields(napi_env env, const NFuncArg &funcArg)
+{
+    if (funcArg.GetArgc() == NARG_CNT::ONE) {
+        return { true, DIR_STATS_FIELD_ALL };
+    }
+    NVal fieldsArg(env, funcArg[NARG_POS::SECOND]);
+    if (fieldsArg.TypeIs(napi_undefined) || fieldsArg.TypeIs(napi_function)) {
+        return { true, DIR_STATS_FIELD_ALL };
+    }
+    auto [succ, names, unused] = fieldsArg.ToStringArray();
+    if (!succ || names.empty()) {
+        HILOGE("Failed to get fields");
+        return { false, 0 };
+    }
+    static const unordered_map<string, uint32_t> fieldMap = {
+        { "type", DIR_STATS_FIELD_TYPE },
+        { "size", DIR_STATS_FIELD_SIZE },
+        { "mode", DIR_STATS_FIELD_MODE },
+        { "mtime", DIR_STATS_FIELD_MTIME },
+        { "ino", DIR_STATS_FIELD_INO },
+    };
+    uint32_t fields = 0;
+    for (const auto &name : names) {
+        auto it = fieldMap.find(name);
+        if (it == fieldMap.end()) {
+            HILOGE("Unknown field");
+            return { false, 0 };
+        }
+        fields |= it->second;
+    }
+    return { true, fields };
+}
+
+// Copies a column into a new ArrayBuffer viewed as a typed array of the same element type
+template <typename T>
+static napi_value CreateTypedArray(napi_env env, napi_typedarray_type type, const vector<T> &column)
+{
+    size_t byteLen = column.size() * sizeof(T);
+    auto [buffer, data] = NVal::CreateArrayBuffer(env, byteLen);
+    if (buffer.val_ == nullptr) {
+        return nullptr;
+    }
+    if (byteLen != 0 && data != nullptr) {
+        if (memcpy_s(data, byteLen, column.data(), byteLen) != EOK) {
+            HILOGE("Failed to copy column");
+            return nullptr;
+        }
+    }
+    napi_value array = nullptr;
+    if (napi_create_typedarray(env, type, column.size(), buffer.val_, 0, &array) != napi_ok) {
+        return nullptr;
+    }
+    return array;
+}
+
+// Sizes and mtimes are handed to JS as doubles, which is what fs.stat does for the same values
+static vector<double> ToDoubles(const vector<int64_t> &column)
+{
+    return vector<double>(column.begin(), column.end());
+}
+
+static napi_value CreateDirStats(napi_env env, const FsDirStats &stats, uint32_t fields)
+{
+    NVal obj = NVal::CreateObject(env);
+    vector<pair<const char *, napi_value>> props = {
+        { "names", NVal::CreateArrayString(env, stats.names).val_ },
+    };
+    if (fields & DIR_STATS_FIELD_TYPE) {
+        props.emplace_back("types", CreateTypedArray(env, napi_uint8_array, stats.types));
+    }
+    if (fields & DIR_STATS_FIELD_SIZE) {
+        props.emplace_back("sizes", CreateTypedArray(env, napi_float64_array, ToDoubles(stats.sizes)));
+    }
+    if (fields & DIR_STATS_FIELD_MODE) {
+        props.emplace_back("modes", CreateTypedArray(env, napi_uint32_array, stats.modes));
+    }
+    if (fields & DIR_STATS_FIELD_MTIME) {
+        props.emplace_back("mtimes", CreateTypedArray(env, napi_float64_array, ToDoubles(stats.mtimes)));
+    }
+    if (fields & DIR_STATS_FIELD_INO) {
+        props.emplace_back("inos", CreateTypedArray(env, napi_biguint64_array, stats.inos));
+    }
+    for (const auto &[name, val] : props) {
+        if (val == nullptr || !obj.AddProp(name, val)) {
+            HILOGE("Failed to set %{public}s", name);
+            return nullptr;
+        }
+    }
+    return obj.val_;
+}
+
+napi_value ReadDirWithStats::Sync(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::TWO)) {
+        HILOGE("Number of arguments unmatched");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succPath, path, unused] = NVal(env, funcArg[NARG_POS::FIRST]).ToUTF8StringPath();
+    if (!succPath) {
+        HILOGE("Invalid path");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succFields, fields] = ParseFields(env, funcArg);
+    if (!succFields) {
+        HILOGE("Invalid fields");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto ret = ReadDirWithStatsCore::DoReadDirWithStats(string(path.get()), fields);
+    if (!ret.IsSuccess()) {
+        METRICS_ERROR("CoreFileKit.fileio.Dyn.readDirWithStatsSync.Err", ret.GetError().GetErrNo());
+        NError(ret.GetError().GetErrNo()).ThrowErr(env);
+        return nullptr;
+    }
+    napi_value result = CreateDirStats(env, ret.GetData().value(), fields);
+    if (result == nullptr) {
+        NError(ENOMEM).ThrowErr(env);
+    }
+    return result;
+}
+
+napi_value ReadDirWithStats::Async(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::THREE)) {
+        HILOGE("Number of arguments unmatched");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succPath, path, unused] = NVal(env, funcArg[NARG_POS::FIRST]).ToUTF8StringPath();
+    if (!succPath) {
+        HILOGE("Invalid path");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succFields, fields] = ParseFields(env, funcArg);
+    if (!succFields) {
+        HILOGE("Invalid fields");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto arg = CreateSharedPtr<ReadDirWithStatsArgs>();
+    if (arg == nullptr) {
+        HILOGE("Failed to request heap memory.");
+        NError(ENOMEM).ThrowErr(env);
+        return nullptr;
+    }
+    arg->fields = fields;
+    auto cbExec = [arg, pathStr = string(path.get())]() -> NError {
+        auto ret = ReadDirWithStatsCore::DoReadDirWithStats(pathStr, arg->fields);
+        if (!ret.IsSuccess()) {
+            METRICS_ERROR("CoreFileKit.fileio.Dyn.readDirWithStats.Err", ret.GetError().GetErrNo());
+            return NError(ret.GetError().GetErrNo());
+        }
+        arg->stats = move(ret.GetData().value());
+        return NError(ERRNO_NOERR);
+    };
+    auto cbCompl = [arg](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        napi_value result = CreateDirStats(env, arg->stats, arg->fields);
+        if (result == nullptr) {
+            return { env, NError(ENOMEM).GetNapiErr(env) };
+        }
+        return { env, result };
+    };
+    NVal thisVar(env, funcArg.GetThisVar());
+    if (funcArg.GetArgc() == NARG_CNT::ONE || (funcArg.GetArgc() == NARG_CNT::TWO &&
+        !NVal(env, funcArg[NARG_POS::SECOND]).TypeIs(napi_function))) {
+        return NAsyncWorkPromise(env, thisVar).Schedule(READ_DIR_WITH_STATS_PRODUCE_NAME, cbExec, cbCompl).val_;
+    } else {
+        NVal cb(env, funcArg[((funcArg.GetArgc() == NARG_CNT::TWO) ? NARG_POS::SECOND : NARG_POS::THIRD)]);
+        return NAsyncWorkCallback(env, thisVar, cb, READ_DIR_WITH_STATS_PRODUCE_NAME)
+            .Schedule(READ_DIR_WITH_STATS_PRODUCE_NAME, cbExec, cbCompl).val_;
+    }
+}
+} // namespace OHOS::FileManagement::ModuleFileIO
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "read_dir_with_stats_core.h"
+
+#include <algorithm>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+#include "fd_guard.h"
+#include "file_utils.h"
+#include "filemgmt_libhilog.h"
+#include "listfile_walker.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+
+namespace {
+// Below this many entries per thread the stat calls are not worth a thread
+constexpr size_t PARALLEL_STAT_MIN_ENTRIES = 1024;
+constexpr uint32_t DIR_STATS_FIELD_STAT_NEEDED =
+    DIR_STATS_FIELD_SIZE | DIR_STATS_FIELD_MODE | DIR_STATS_FIELD_MTIME | DIR_STATS_FIELD_INO;
+
+struct StatRange {
+    size_t begin = 0;
+    size_t end = 0;
+    int err = ERRNO_NOERR;
+};
+} // namespace
+
+static uint8_t TypeFromDirent(unsigned char type)
+{
+    switch (type) {
+        case DT_REG:
+            return DIR_ENTRY_TYPE_FILE;
+        case DT_DIR:
+            return DIR_ENTRY_TYPE_DIRECTORY;
+        case DT_LNK:
+            return DIR_ENTRY_TYPE_SYMLINK;
+        case DT_UNKNOWN:
+            return DIR_ENTRY_TYPE_UNKNOWN;
+        default:
+            return DIR_ENTRY_TYPE_OTHER;
+    }
+}
+
+static uint8_t TypeFromMode(mode_t mode)
+{
+    if (S_ISREG(mode)) {
+        return DIR_ENTRY_TYPE_FILE;
+    }
+    if (S_ISDIR(mode)) {
+        return DIR_ENTRY_TYPE_DIRECTORY;
+    }
+    if (S_ISLNK(mode)) {
+        return DIR_ENTRY_TYPE_SYMLINK;
+    }
+    return DIR_ENTRY_TYPE_OTHER;
+}
+
+// Entries describe themselves like lstat does, statx is asked only for the fields that were requested
+static int StatEntry(int dirFd, size_t index, uint32_t fields, FsDirStats &stats)
+{
+    const char *name = stats.names[index].c_str();
+#if defined(STATX_BASIC_STATS) && defined(SYS_statx)
+    unsigned int mask = STATX_TYPE;
+    mask |= (fields & DIR_STATS_FIELD_MODE) ? STATX_MODE : 0;
+    mask |= (fields & DIR_STATS_FIELD_SIZE) ? STATX_SIZE : 0;
+    mask |= (fields & DIR_STATS_FIELD_MTIME) ? STATX_MTIME : 0;
+    mask |= (fields & DIR_STATS_FIELD_INO) ? STATX_INO : 0;
+    struct statx info;
+    if (syscall(SYS_statx, dirFd, name, AT_SYMLINK_NOFOLLOW, mask, &info) != 0) {
+        return errno;
+    }
+    mode_t mode = info.stx_mode;
+    int64_t size = static_cast<int64_t>(info.stx_size);
+    int64_t mtime = info.stx_mtime.tv_sec;
+    uint64_t ino = info.stx_ino;
+#else
+    struct stat info;
+    if (fstatat(dirFd, name, &info, AT_SYMLINK_NOFOLLOW) != 0) {
+        return errno;
+    }
+    mode_t mode = info.st_mode;
+    int64_t size = info.st_size;
+    int64_t mtime = info.st_mtime;
+    uint64_t ino = info.st_ino;
+#endif
+    if (fields & DIR_STATS_FIELD_TYPE) {
+        stats.types[index] = TypeFromMode(mode);
+    }
+    if (fields & DIR_STATS_FIELD_MODE) {
+        stats.modes[index] = static_cast<uint32_t>(mode);
+    }
+    if (fields & DIR_STATS_FIELD_SIZE) {
+        stats.sizes[index] = size;
+    }
+    if (fields & DIR_STATS_FIELD_MTIME) {
+        stats.mtimes[index] = mtime;
+    }
+    if (fields & DIR_STATS_FIELD_INO) {
+        stats.inos[index] = ino;
+    }
+    return ERRNO_NOERR;
+}
+
+// Every thread owns a contiguous range of the columns, an entry removed after it was read is marked for compaction
+static void StatRangeEntries(
+    int dirFd, uint32_t fields, FsDirStats &stats, vector<uint8_t> &removed, StatRange &range)
+{
+    for (size_t i = range.begin; i < range.end; i++) {
+        int ret = StatEntry(dirFd, i, fields, stats);
+        if (ret == ENOENT) {
+            removed[i] = 1;
+        } else if (ret != ERRNO_NOERR) {
+            HILOGE("Failed to stat entry with errno: %{public}d", ret);
+            range.err = ret;
+            return;
+        }
+    }
+}
+
+static int StatEntries(int dirFd, uint32_t fields, FsDirStats &stats, vector<uint8_t> &removed)
+{
+    size_t count = stats.names.size();
+    size_t threadNum = min(ListFileWalker::DefaultWorkerNum(), max<size_t>(1, count / PARALLEL_STAT_MIN_ENTRIES));
+    vector<StatRange> ranges(threadNum);
+    size_t step = (count + threadNum - 1) / threadNum;
+    for (size_t i = 0; i < threadNum; i++) {
+        ranges[i].begin = min(count, i * step);
+        ranges[i].end = min(count, ranges[i].begin + step);
+    }
+
+    vector<thread> helpers;
+    size_t started = 1;
+    for (; started < threadNum; started++) {
+        try {
+            helpers.emplace_back(StatRangeEntries, dirFd, fields, ref(stats), ref(removed), ref(ranges[started]));
+        } catch (const system_error &e) {
+            HILOGE("Failed to start stat worker: %{public}s", e.what());
+            break;
+        }
+    }
+    // Ranges without a thread are done on the calling thread
+    StatRangeEntries(dirFd, fields, stats, removed, ranges[0]);
+    for (size_t i = started; i < threadNum; i++) {
+        StatRangeEntries(dirFd, fields, stats, removed, ranges[i]);
+    }
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+    for (const auto &range : ranges) {
+        if (range.err != ERRNO_NOERR) {
+            return range.err;
+        }
+    }
+    return ERRNO_NOERR;
+}
+
+template <typename T>
+static void CompactColumn(vector<T> &column, const vector<uint8_t> &removed)
+{
+    if (column.empty()) {
+        return;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < column.size(); i++) {
+        if (!removed[i]) {
+            column[kept++] = move(column[i]);
+        }
+    }
+    column.resize(kept);
+}
+
+static void CompactRemoved(FsDirStats &stats, const vector<uint8_t> &removed)
+{
+    if (find(removed.begin(), removed.end(), 1) == removed.end()) {
+        return;
+    }
+    CompactColumn(stats.names, removed);
+    CompactColumn(stats.types, removed);
+    CompactColumn(stats.sizes, removed);
+    CompactColumn(stats.modes, removed);
+    CompactColumn(stats.mtimes, removed);
+    CompactColumn(stats.inos, removed);
+}
+
+FsResult<FsDirStats> ReadDirWithStatsCore::DoReadDirWithStats(const string &path, uint32_t fields)
+{
+    if (fields == 0 || (fields & ~static_cast<uint32_t>(DIR_STATS_FIELD_ALL)) != 0) {
+        HILOGE("Invalid fields");
+        return FsResult<FsDirStats>::Error(EINVAL);
+    }
+
+    DistributedFS::FDGuard dirFd(open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (!dirFd) {
+        int err = errno;
+        HILOGE("Failed to open dir with errno: %{public}d", err);
+        return FsResult<FsDirStats>::Error(err);
+    }
+
+    FsDirStats stats;
+    vector<unsigned char> direntTypes;
+    vector<char> direntBuf;
+    int ret = ListFileWalker::ForEachDirent(dirFd.GetFD(), direntBuf,
+        [&stats, &direntTypes](const char *name, unsigned char type) {
+            stats.names.emplace_back(name);
+            direntTypes.push_back(type);
+            return true;
+        });
+    if (ret != ERRNO_NOERR) {
+        return FsResult<FsDirStats>::Error(ret);
+    }
+
+    size_t count = stats.names.size();
+    if (fields & DIR_STATS_FIELD_TYPE) {
+        stats.types.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            stats.types[i] = TypeFromDirent(direntTypes[i]);
+        }
+    }
+    if ((fields & DIR_STATS_FIELD_STAT_NEEDED) == 0) {
+        // Only the type was asked for, it is known from d_type unless the file system did not report it
+        for (size_t i = 0; i < count; i++) {
+            if (stats.types[i] == DIR_ENTRY_TYPE_UNKNOWN) {
+                auto type = ListFileWalker::ResolveType(dirFd.GetFD(), stats.names[i].c_str(), DT_UNKNOWN);
+                stats.types[i] = TypeFromDirent(type);
+            }
+        }
+        return FsResult<FsDirStats>::Success(move(stats));
+    }
+
+    stats.sizes.resize((fields & DIR_STATS_FIELD_SIZE) ? count : 0);
+    stats.modes.resize((fields & DIR_STATS_FIELD_MODE) ? count : 0);
+    stats.mtimes.resize((fields & DIR_STATS_FIELD_MTIME) ? count : 0);
+    stats.inos.resize((fields & DIR_STATS_FIELD_INO) ? count : 0);
+    vector<uint8_t> removed(count, 0);
+    ret = StatEntries(dirFd.GetFD(), fields, stats, removed);
+    if (ret != ERRNO_NOERR) {
+        return FsResult<FsDirStats>::Error(ret);
+    }
+    CompactRemoved(stats, removed);
+    return FsResult<FsDirStats>::Success(move(stats));
+}
+
+} // namespace OHOS::FileManagement::ModuleFileIO
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_READ_DIR_WITH_STATS_CORE_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_READ_DIR_WITH_STATS_CORE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "filemgmt_libfs.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+
+enum DirStatsField : uint32_t {
+    DIR_STATS_FIELD_TYPE = 1U << 0,
+    DIR_STATS_FIELD_SIZE = 1U << 1,
+    DIR_STATS_FIELD_MODE = 1U << 2,
+    DIR_STATS_FIELD_MTIME = 1U << 3,
+    DIR_STATS_FIELD_INO = 1U << 4,
+    DIR_STATS_FIELD_ALL = (1U << 5) - 1,
+};
+
+enum DirEntryType : uint8_t {
+    DIR_ENTRY_TYPE_UNKNOWN = 0,
+    DIR_ENTRY_TYPE_FILE = 1,
+    DIR_ENTRY_TYPE_DIRECTORY = 2,
+    DIR_ENTRY_TYPE_SYMLINK = 3,
+    DIR_ENTRY_TYPE_OTHER = 4,
+};
+
+// One column per requested field, every column is indexed like names and the ones not requested stay empty
+struct FsDirStats {
+    std::vector<std::string> names;
+    std::vector<uint8_t> types;
+    std::vector<int64_t> sizes;
+    std::vector<uint32_t> modes;
+    std::vector<int64_t> mtimes;
+    std::vector<uint64_t> inos;
+};
+
+class ReadDirWithStatsCore {
+public:
+    static FsResult<FsDirStats> DoReadDirWithStats(const std::string &path, uint32_t fields = DIR_STATS_FIELD_ALL);
+};
+
+} // namespace OHOS::FileManagement::ModuleFileIO
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_READ_DIR_WITH_STATS_CORE_H
@@ -15,6 +15,7 @@
 
 #include "rmdirent.h"
 
+#include <atomic>
 #include <cstring>
 #include <dirent.h>
 #include <filesystem>
@@ -24,6 +25,12 @@
 #include <unistd.h>
 
 #include "common_func.h"
+#if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+#include "class_tasksignal/task_signal_entity.h"
+#include "file_utils.h"
+#include "listfile_walker.h"
+#include "tree_remover.h"
+#endif
 #include "filemgmt_libhilog.h"
 #include "file_fs_metrics.h"
 #include "uv.h"
@@ -34,28 +41,133 @@ namespace ModuleFileIO {
 using namespace std;
 using namespace OHOS::FileManagement::LibN;
 
-#ifdef __MUSL__
-static NError RmDirent(const string &fpath)
+#if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+// removed is written by the remover, reported and settled are only touched on the JS thread
+struct RmdirProgressListener {
+    napi_env env = nullptr;
+    NRef nRef;
+    atomic<uint64_t> removed { 0 };
+    uint64_t reported = 0;
+    bool settled = false;
+    explicit RmdirProgressListener(napi_env env, NVal jsVal) : env(env), nRef(jsVal) {}
+};
+
+struct RmdirArgs {
+    bool trash = false;
+    shared_ptr<DistributedFS::ModuleTaskSignal::TaskSignal> taskSignal = nullptr;
+    shared_ptr<RmdirProgressListener> progressListener = nullptr;
+};
+
+static bool GetRmdirArgs(napi_env env, const NVal &op, RmdirArgs &args)
 {
-    std::filesystem::path strToPath(fpath);
-    std::error_code errCode;
-    std::uintmax_t num = std::filesystem::remove_all(strToPath, errCode);
-    if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("Failed to remove directory, error code: %{public}d", errCode.value());
-        return NError(errCode.value());
+    if (op.TypeIs(napi_undefined) || op.TypeIs(napi_null)) {
+        return true;
     }
-    if (!num || std::filesystem::exists(strToPath, errCode)) {
-        HILOGE("Failed to remove directory, dirPath does not exist");
-        return NError(ENOENT);
+    if (!op.TypeIs(napi_object)) {
+        HILOGE("Illegal options type");
+        return false;
     }
-    if (errCode.value() != ERRNO_NOERR) {
-        HILOGE("fs exists fail, error code: %{public}d", errCode.value());
-        return NError(errCode.value());
+    if (op.HasProp("trash") && !op.GetProp("trash").TypeIs(napi_undefined)) {
+        auto [succ, trash] = op.GetProp("trash").ToBool(false);
+        if (!succ) {
+            HILOGE("Illegal options.trash type");
+            return false;
+        }
+        args.trash = trash;
     }
-    return NError(ERRNO_NOERR);
+    if (op.HasProp("taskSignal") && !op.GetProp("taskSignal").TypeIs(napi_undefined)) {
+        NVal signal = op.GetProp("taskSignal");
+        auto taskSignalEntity = signal.TypeIs(napi_object) ?
+            NClass::GetEntityOf<TaskSignalEntity>(env, signal.val_) : nullptr;
+        if (taskSignalEntity == nullptr || taskSignalEntity->taskSignal_ == nullptr) {
+            HILOGE("Illegal options.taskSignal type");
+            return false;
+        }
+        args.taskSignal = taskSignalEntity->taskSignal_;
+    }
+    if (op.HasProp("progressListener") && !op.GetProp("progressListener").TypeIs(napi_undefined)) {
+        NVal listener = op.GetProp("progressListener");
+        if (!listener.TypeIs(napi_function)) {
+            HILOGE("Illegal options.progressListener type");
+            return false;
+        }
+        args.progressListener = CreateSharedPtr<RmdirProgressListener>(env, listener);
+        if (args.progressListener == nullptr) {
+            HILOGE("Failed to request heap memory.");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Events still queued once the call has settled are dropped, the count they carry was already reported
+static void RmdirProgressComplete(shared_ptr<RmdirProgressListener> listener)
+{
+    uint64_t removed = listener->removed.load();
+    if (listener->settled || removed <= listener->reported) {
+        return;
+    }
+    listener->reported = removed;
+    napi_handle_scope scope = nullptr;
+    napi_status status = napi_open_handle_scope(listener->env, &scope);
+    if (status != napi_ok) {
+        HILOGE("Failed to open handle scope, status: %{public}d.", status);
+        return;
+    }
+    NVal obj = NVal::CreateObject(listener->env);
+    obj.AddProp("removedCount", NVal::CreateInt64(listener->env, static_cast<int64_t>(removed)).val_);
+    napi_value result = nullptr;
+    napi_value jsCallback = listener->nRef.Deref(listener->env).val_;
+    status = napi_call_function(listener->env, nullptr, jsCallback, 1, &(obj.val_), &result);
+    if (status != napi_ok) {
+        HILOGE("Failed to call progress listener, status: %{public}d.", status);
+    }
+    status = napi_close_handle_scope(listener->env, scope);
+    if (status != napi_ok) {
+        HILOGE("Failed to close scope, status: %{public}d.", status);
+    }
+}
+
+// In trash mode the call returns once the directory is renamed away, the signal and the listener are not used
+static NError RmDirent(const string &fpath, const RmdirArgs &args)
+{
+    int ret = ERRNO_NOERR;
+    if (args.trash) {
+        ret = TreeRemover::RemoveInBackground(fpath, ListFileWalker::DefaultWorkerNum());
+    } else {
+        TreeRemoveOptions options;
+        options.workerNum = ListFileWalker::DefaultWorkerNum();
+        if (args.taskSignal != nullptr) {
+            options.isCanceled = [taskSignal = args.taskSignal]() { return taskSignal->IsCanceled(); };
+        }
+        if (args.progressListener != nullptr) {
+            options.progress = [listener = args.progressListener](uint64_t removed) {
+                listener->removed.store(removed);
+                auto task = [listener]() {
+                    RmdirProgressComplete(listener);
+                };
+                auto ret = napi_send_event(listener->env, task, napi_eprio_immediate, "fs.rmdir.ProgressListener");
+                if (ret != 0) {
+                    HILOGE("Failed to call napi_send_event, ret: %{public}d", ret);
+                }
+            };
+        }
+        ret = TreeRemover(options).Remove(fpath);
+    }
+    if (ret != ERRNO_NOERR) {
+        HILOGE("Failed to remove directory, error code: %{public}d", ret);
+    }
+    return NError(ret);
 }
 
 #else
+struct RmdirArgs {};
+
+static bool GetRmdirArgs(napi_env env, const NVal &op, RmdirArgs &args)
+{
+    return true;
+}
+
 static NError RmDirent(const string &fpath)
 {
     std::unique_ptr<uv_fs_t, decltype(CommonFunc::fs_req_cleanup)*> scandir_req = {
@@ -105,12 +217,17 @@ static NError RmDirent(const string &fpath)
     }
     return NError(ERRNO_NOERR);
 }
+
+static NError RmDirent(const string &fpath, const RmdirArgs &args)
+{
+    return RmDirent(fpath);
+}
 #endif
 
 napi_value Rmdirent::Sync(napi_env env, napi_callback_info info)
 {
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE)) {
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::TWO)) {
         HILOGE("Number of arguments unmatched");
         NError(EINVAL).ThrowErr(env);
         return nullptr;
@@ -123,7 +240,18 @@ napi_value Rmdirent::Sync(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    auto err = RmDirent(string(path.get()));
+    RmdirArgs args;
+    if (funcArg.GetArgc() == NARG_CNT::TWO && !GetRmdirArgs(env, NVal(env, funcArg[NARG_POS::SECOND]), args)) {
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    // Nothing can cancel or observe a call that blocks the JS thread, only trash applies
+#if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+    args.taskSignal = nullptr;
+    args.progressListener = nullptr;
+#endif
+
+    auto err = RmDirent(string(path.get()), args);
     if (err) {
         METRICS_ERROR("CoreFileKit.fileio.Dyn.rmdirSync.Err", err.GetErrCode());
         err.ThrowErr(env);
@@ -136,7 +264,7 @@ napi_value Rmdirent::Sync(napi_env env, napi_callback_info info)
 napi_value Rmdirent::Async(napi_env env, napi_callback_info info)
 {
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::TWO)) {
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::THREE)) {
         HILOGE("Number of arguments unmatched");
         NError(EINVAL).ThrowErr(env);
         return nullptr;
@@ -149,14 +277,33 @@ napi_value Rmdirent::Async(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    auto cbExec = [tmpPath = string(path.get())]() -> NError {
-        auto err = RmDirent(tmpPath);
+    // The options take the second position when it is not the callback
+    size_t cbPos = NARG_POS::SECOND;
+    RmdirArgs args;
+    if (funcArg.GetArgc() >= NARG_CNT::TWO && !NVal(env, funcArg[NARG_POS::SECOND]).TypeIs(napi_function)) {
+        if (!GetRmdirArgs(env, NVal(env, funcArg[NARG_POS::SECOND]), args)) {
+            NError(EINVAL).ThrowErr(env);
+            return nullptr;
+        }
+        cbPos = NARG_POS::THIRD;
+    }
+
+    auto cbExec = [tmpPath = string(path.get()), args]() -> NError {
+        auto err = RmDirent(tmpPath, args);
         if (err) {
             METRICS_ERROR("CoreFileKit.fileio.Dyn.rmdir.Err", err.GetErrCode());
         }
         return err;
     };
-    auto cbCompl = [](napi_env env, NError err) -> NVal {
+    // Also holds the listener, so that its reference is released on the JS thread
+    auto cbCompl = [args](napi_env env, NError err) -> NVal {
+#if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+        // The final count may still be queued behind this callback, report it before the call settles
+        if (args.progressListener != nullptr) {
+            RmdirProgressComplete(args.progressListener);
+            args.progressListener->settled = true;
+        }
+#endif
         if (err) {
             return { env, err.GetNapiErr(env) };
         } else {
@@ -166,10 +313,10 @@ napi_value Rmdirent::Async(napi_env env, napi_callback_info info)
 
     NVal thisVar(env, funcArg.GetThisVar());
     size_t argc = funcArg.GetArgc();
-    if (argc == NARG_CNT::ONE) {
+    if (argc <= cbPos) {
         return NAsyncWorkPromise(env, thisVar).Schedule(PROCEDURE_RMDIRENT_NAME, cbExec, cbCompl).val_;
     } else {
-        NVal cb(env, funcArg[NARG_POS::SECOND]);
+        NVal cb(env, funcArg[cbPos]);
         return NAsyncWorkCallback(env, thisVar, cb, PROCEDURE_RMDIRENT_NAME)
             .Schedule(PROCEDURE_RMDIRENT_NAME, cbExec, cbCompl).val_;
     }
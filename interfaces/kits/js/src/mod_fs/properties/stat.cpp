@@ -26,6 +26,9 @@
 #include "file_utils.h"
 #include "filemgmt_libhilog.h"
 #include "file_fs_metrics.h"
+#if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+#include "metadata_cache.h"
+#endif
 
 namespace OHOS::FileManagement::ModuleFileIO {
 using namespace std;
@@ -82,11 +85,52 @@ static tuple<bool, FileInfo> ParseJsFile(napi_env env, napi_value pathOrFdFromJs
     return { false, FileInfo { false, {}, {} } };
 };
 
-static NError CheckFsStat(const FileInfo &fileInfo, uv_fs_t* req)
+static int StatPath(const char *path, uv_stat_t &buf)
+{
+    std::unique_ptr<uv_fs_t, decltype(CommonFunc::fs_req_cleanup)*> stat_req = {
+        new (std::nothrow) uv_fs_t, CommonFunc::fs_req_cleanup };
+    if (!stat_req) {
+        HILOGE("Failed to request heap memory.");
+        return -ENOMEM;
+    }
+    int ret = uv_fs_stat(nullptr, stat_req.get(), path, nullptr);
+    if (ret == 0) {
+        buf = stat_req->statbuf;
+    }
+    return ret;
+}
+
+static int StatFd(int fd, uv_stat_t &buf)
+{
+    std::unique_ptr<uv_fs_t, decltype(CommonFunc::fs_req_cleanup)*> stat_req = {
+        new (std::nothrow) uv_fs_t, CommonFunc::fs_req_cleanup };
+    if (!stat_req) {
+        HILOGE("Failed to request heap memory.");
+        return -ENOMEM;
+    }
+    int ret = uv_fs_fstat(nullptr, stat_req.get(), fd, nullptr);
+    if (ret == 0) {
+        buf = stat_req->statbuf;
+    }
+    return ret;
+}
+
+static NError CheckFsStat(const FileInfo &fileInfo, uv_stat_t &buf)
 {
     FileFsTrace traceCheckFsStat("CheckFsStat");
     if (fileInfo.isPath) {
-        int ret = uv_fs_stat(nullptr, req, fileInfo.path.get(), nullptr);
+        const char *path = fileInfo.path.get();
+#if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
+        int ret = 0;
+        auto &cache = MetadataCache::GetInstance();
+        if (cache.IsEnabled()) {
+            ret = cache.GetStat(path, buf, [path](uv_stat_t &statBuf) { return StatPath(path, statBuf); });
+        } else {
+            ret = StatPath(path, buf);
+        }
+#else
+        int ret = StatPath(path, buf);
+#endif
         if (ret < 0) {
             HILOGE("Failed to stat file with path, ret is %{public}d", ret);
             if (FileApiDebug::isLogEnabled) {
@@ -95,7 +139,7 @@ static NError CheckFsStat(const FileInfo &fileInfo, uv_fs_t* req)
             return NError(ret, "Stat failed, path is: " + AnonymizePath(fileInfo.path.get()));
         }
     } else {
-        int ret = uv_fs_fstat(nullptr, req, fileInfo.fdg->GetFD(), nullptr);
+        int ret = StatFd(fileInfo.fdg->GetFD(), buf);
         if (ret < 0) {
             HILOGE("Failed to stat file with fd, ret is %{public}d", ret);
             return NError(ret);
@@ -118,15 +162,8 @@ napi_value Stat::Sync(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    std::unique_ptr<uv_fs_t, decltype(CommonFunc::fs_req_cleanup)*> stat_req = {
-        new (std::nothrow) uv_fs_t, CommonFunc::fs_req_cleanup };
-    if (!stat_req) {
-        HILOGE("Failed to request heap memory.");
-        METRICS_ERROR("CoreFileKit.fileio.Dyn.statSync.Err", NError(ENOMEM).GetErrCode());
-        NError(ENOMEM).ThrowErr(env);
-        return nullptr;
-    }
-    auto err = CheckFsStat(fileInfo, stat_req.get());
+    uv_stat_t buf {};
+    auto err = CheckFsStat(fileInfo, buf);
     if (err) {
         METRICS_ERROR("CoreFileKit.fileio.Dyn.statSync.Err", err.GetErrCode());
         err.ThrowErr(env);
@@ -139,9 +176,9 @@ napi_value Stat::Sync(napi_env env, napi_callback_info info)
         NError(ENOMEM).ThrowErr(env);
         return nullptr;
     }
-    auto stat = CommonFunc::InstantiateStat(env, stat_req->statbuf, arg).val_;
+    auto stat = CommonFunc::InstantiateStat(env, buf, arg).val_;
 #else
-    auto stat = CommonFunc::InstantiateStat(env, stat_req->statbuf).val_;
+    auto stat = CommonFunc::InstantiateStat(env, buf).val_;
 #endif
     return stat;
 }
@@ -165,19 +202,11 @@ napi_value Stat::Async(napi_env env, napi_callback_info info)
         return nullptr;
     }
     auto cbExec = [arg, fileInfo = make_shared<FileInfo>(move(fileInfo))]() -> NError {
-        std::unique_ptr<uv_fs_t, decltype(CommonFunc::fs_req_cleanup)*> stat_req = {
-            new (std::nothrow) uv_fs_t, CommonFunc::fs_req_cleanup };
-        if (!stat_req) {
-            HILOGE("Failed to request heap memory.");
-            METRICS_ERROR("CoreFileKit.fileio.Dyn.stat.Err", NError(ENOMEM).GetErrCode());
-            return NError(ENOMEM);
-        }
-        auto err = CheckFsStat(*fileInfo, stat_req.get());
+        auto err = CheckFsStat(*fileInfo, arg->stat_);
         if (err) {
             METRICS_ERROR("CoreFileKit.fileio.Dyn.stat.Err", err.GetErrCode());
             return err;
         }
-        arg->stat_ = stat_req->statbuf;
 #if !defined(WIN_PLATFORM) && !defined(IOS_PLATFORM)
         arg->fileInfo_ = fileInfo;
 #endif
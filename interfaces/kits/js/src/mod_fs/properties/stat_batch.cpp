@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stat_batch.h"
+
+#include <memory>
+#include <securec.h>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "file_utils.h"
+#include "filemgmt_libhilog.h"
+
+#include "file_fs_metrics.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+using namespace OHOS::FileManagement::LibN;
+
+static bool ParseFields(const NVal &options, StatBatchOptions &batchOptions)
+{
+    if (!options.HasProp("fields") || options.GetProp("fields").TypeIs(napi_undefined)) {
+        return true;
+    }
+    auto [succ, names, unused] = options.GetProp("fields").ToStringArray();
+    if (!succ || names.empty()) {
+        HILOGE("Failed to get fields");
+        return false;
+    }
+    static const unordered_map<string, uint32_t> fieldMap = {
+        { "mode", STAT_BATCH_FIELD_MODE },
+        { "size", STAT_BATCH_FIELD_SIZE },
+        { "ino", STAT_BATCH_FIELD_INO },
+        { "uid", STAT_BATCH_FIELD_UID },
+        { "gid", STAT_BATCH_FIELD_GID },
+        { "atime", STAT_BATCH_FIELD_ATIME },
+        { "mtime", STAT_BATCH_FIELD_MTIME },
+        { "ctime", STAT_BATCH_FIELD_CTIME },
+        { "location", STAT_BATCH_FIELD_LOCATION },
+    };
+    uint32_t fields = 0;
+    for (const auto &name : names) {
+        auto it = fieldMap.find(name);
+        if (it == fieldMap.end()) {
+            HILOGE("Unknown field");
+            return false;
+        }
+        fields |= it->second;
+    }
+    batchOptions.fields = fields;
+    return true;
+}
+
+static tuple<bool, StatBatchOptions> ParseOptions(napi_env env, const NFuncArg &funcArg)
+{
+    StatBatchOptions batchOptions;
+    if (funcArg.GetArgc() == NARG_CNT::ONE) {
+        return { true, batchOptions };
+    }
+    NVal options(env, funcArg[NARG_POS::SECOND]);
+    if (options.TypeIs(napi_undefined) || options.TypeIs(napi_function)) {
+        return { true, batchOptions };
+    }
+    if (!options.TypeIs(napi_object) || !ParseFields(options, batchOptions)) {
+        return { false, batchOptions };
+    }
+    if (options.HasProp("dontSync") && !options.GetProp("dontSync").TypeIs(napi_undefined)) {
+        auto [succ, dontSync] = options.GetProp("dontSync").ToBool();
+        if (!succ) {
+            HILOGE("Failed to get dontSync");
+            return { false, batchOptions };
+        }
+        batchOptions.dontSync = dontSync;
+    }
+    return { true, batchOptions };
+}
+
+static tuple<bool, vector<string>, StatBatchOptions> ParseArgs(napi_env env, const NFuncArg &funcArg)
+{
+    auto [succPaths, paths, unused] = NVal(env, funcArg[NARG_POS::FIRST]).ToStringArray();
+    if (!succPaths) {
+        HILOGE("Invalid paths");
+        return { false, {}, {} };
+    }
+    auto [succOptions, options] = ParseOptions(env, funcArg);
+    if (!succOptions) {
+        HILOGE("Invalid options");
+        return { false, {}, {} };
+    }
+    return { true, move(paths), options };
+}
+
+// Copies a column into a new ArrayBuffer viewed as a typed array of the same element type
+template <typename T>
+static napi_value CreateTypedArray(napi_env env, napi_typedarray_type type, const vector<T> &column)
+{
+    size_t byteLen = column.size() * sizeof(T);
+    auto [buffer, data] = NVal::CreateArrayBuffer(env, byteLen);
+    if (buffer.val_ == nullptr) {
+        return nullptr;
+    }
+    if (byteLen != 0 && data != nullptr) {
+        if (memcpy_s(data, byteLen, column.data(), byteLen) != EOK) {
+            HILOGE("Failed to copy column");
+            return nullptr;
+        }
+    }
+    napi_value array = nullptr;
+    if (napi_create_typedarray(env, type, column.size(), buffer.val_, 0, &array) != napi_ok) {
+        return nullptr;
+    }
+    return array;
+}
+
+// Sizes and times are handed to JS as doubles, which is what fs.stat does for the same values
+static vector<double> ToDoubles(const vector<int64_t> &column)
+{
+    return vector<double>(column.begin(), column.end());
+}
+
+// Failed paths carry the same error code fs.stat would have thrown for them, the others 0
+static vector<int32_t> ToErrCodes(const vector<int32_t> &errs)
+{
+    vector<int32_t> codes(errs.size(), 0);
+    for (size_t i = 0; i < errs.size(); i++) {
+        if (errs[i] != ERRNO_NOERR) {
+            codes[i] = NError(errs[i]).GetErrCode();
+        }
+    }
+    return codes;
+}
+
+static napi_value CreateBatchStats(napi_env env, const FsBatchStats &stats, uint32_t fields)
+{
+    NVal obj = NVal::CreateObject(env);
+    vector<pair<const char *, napi_value>> props = {
+        { "errors", CreateTypedArray(env, napi_int32_array, ToErrCodes(stats.errs)) },
+    };
+    if (fields & STAT_BATCH_FIELD_MODE) {
+        props.emplace_back("modes", CreateTypedArray(env, napi_uint32_array, stats.modes));
+    }
+    if (fields & STAT_BATCH_FIELD_SIZE) {
+        props.emplace_back("sizes", CreateTypedArray(env, napi_float64_array, ToDoubles(stats.sizes)));
+    }
+    if (fields & STAT_BATCH_FIELD_INO) {
+        props.emplace_back("inos", CreateTypedArray(env, napi_biguint64_array, stats.inos));
+    }
+    if (fields & STAT_BATCH_FIELD_UID) {
+        props.emplace_back("uids", CreateTypedArray(env, napi_uint32_array, stats.uids));
+    }
+    if (fields & STAT_BATCH_FIELD_GID) {
+        props.emplace_back("gids", CreateTypedArray(env, napi_uint32_array, stats.gids));
+    }
+    if (fields & STAT_BATCH_FIELD_ATIME) {
+        props.emplace_back("atimes", CreateTypedArray(env, napi_float64_array, ToDoubles(stats.atimes)));
+    }
+    if (fields & STAT_BATCH_FIELD_MTIME) {
+        props.emplace_back("mtimes", CreateTypedArray(env, napi_float64_array, ToDoubles(stats.mtimes)));
+    }
+    if (fields & STAT_BATCH_FIELD_CTIME) {
+        props.emplace_back("ctimes", CreateTypedArray(env, napi_float64_array, ToDoubles(stats.ctimes)));
+    }
+    if (fields & STAT_BATCH_FIELD_LOCATION) {
+        props.emplace_back("locations", CreateTypedArray(env, napi_int32_array, stats.locations));
+    }
+    for (const auto &[name, val] : props) {
+        if (val == nullptr || !obj.AddProp(name, val)) {
+            HILOGE("Failed to set %{public}s", name);
+            return nullptr;
+        }
+    }
+    return obj.val_;
+}
+
+napi_value StatBatch::Sync(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::TWO)) {
+        HILOGE("Number of arguments unmatched");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succ, paths, options] = ParseArgs(env, funcArg);
+    if (!succ) {
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto ret = StatBatchCore::DoStatBatch(paths, options);
+    if (!ret.IsSuccess()) {
+        METRICS_ERROR("CoreFileKit.fileio.Dyn.statBatchSync.Err", ret.GetError().GetErrNo());
+        NError(ret.GetError().GetErrNo()).ThrowErr(env);
+        return nullptr;
+    }
+    napi_value result = CreateBatchStats(env, ret.GetData().value(), options.fields);
+    if (result == nullptr) {
+        NError(ENOMEM).ThrowErr(env);
+    }
+    return result;
+}
+
+napi_value StatBatch::Async(napi_env env, napi_callback_info info)
+{
+    NFuncArg funcArg(env, info);
+    if (!funcArg.InitArgs(NARG_CNT::ONE, NARG_CNT::THREE)) {
+        HILOGE("Number of arguments unmatched");
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto [succ, paths, options] = ParseArgs(env, funcArg);
+    if (!succ) {
+        NError(EINVAL).ThrowErr(env);
+        return nullptr;
+    }
+    auto arg = CreateSharedPtr<StatBatchArgs>();
+    if (arg == nullptr) {
+        HILOGE("Failed to request heap memory.");
+        NError(ENOMEM).ThrowErr(env);
+        return nullptr;
+    }
+    arg->options = options;
+    auto cbExec = [arg, paths = move(paths)]() -> NError {
+        auto ret = StatBatchCore::DoStatBatch(paths, arg->options);
+        if (!ret.IsSuccess()) {
+            METRICS_ERROR("CoreFileKit.fileio.Dyn.statBatch.Err", ret.GetError().GetErrNo());
+            return NError(ret.GetError().GetErrNo());
+        }
+        arg->stats = move(ret.GetData().value());
+        return NError(ERRNO_NOERR);
+    };
+    auto cbCompl = [arg](napi_env env, NError err) -> NVal {
+        if (err) {
+            return { env, err.GetNapiErr(env) };
+        }
+        napi_value result = CreateBatchStats(env, arg->stats, arg->options.fields);
+        if (result == nullptr) {
+            return { env, NError(ENOMEM).GetNapiErr(env) };
+        }
+        return { env, result };
+    };
+    NVal thisVar(env, funcArg.GetThisVar());
+    if (funcArg.GetArgc() == NARG_CNT::ONE || (funcArg.GetArgc() == NARG_CNT::TWO &&
+        !NVal(env, funcArg[NARG_POS::SECOND]).TypeIs(napi_function))) {
+        return NAsyncWorkPromise(env, thisVar).Schedule(STAT_BATCH_PRODUCE_NAME, cbExec, cbCompl).val_;
+    } else {
+        NVal cb(env, funcArg[((funcArg.GetArgc() == NARG_CNT::TWO) ? NARG_POS::SECOND : NARG_POS::THIRD)]);
+        return NAsyncWorkCallback(env, thisVar, cb, STAT_BATCH_PRODUCE_NAME)
+            .Schedule(STAT_BATCH_PRODUCE_NAME, cbExec, cbCompl).val_;
+    }
+}
+} // namespace OHOS::FileManagement::ModuleFileIO
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stat_batch_core.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/xattr.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+#include "file_fs_trace.h"
+#include "filemgmt_libhilog.h"
+#include "fs_stat.h"
+#include "listfile_walker.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+
+namespace {
+// Resolving a path costs more than a directory entry, a thread pays off with fewer paths than in readDirWithStats
+constexpr size_t PARALLEL_STAT_MIN_PATHS = 256;
+constexpr uint32_t STAT_BATCH_FIELD_STAT_NEEDED = STAT_BATCH_FIELD_ALL & ~STAT_BATCH_FIELD_LOCATION;
+
+struct StatRange {
+    size_t begin = 0;
+    size_t end = 0;
+};
+} // namespace
+
+static int32_t ReadLocation(const char *path)
+{
+    char value[MAX_ATTR_NAME];
+    ssize_t size = getxattr(path, CLOUD_LOCATION_ATTR.c_str(), value, sizeof(value));
+    if (size <= 0) {
+        if (errno != ENODATA && errno != EOPNOTSUPP) {
+            HILOGE("Getxattr value failed, errno is %{public}d", errno);
+        }
+        return static_cast<int32_t>(LOCAL);
+    }
+    if (!all_of(value, value + size, ::isdigit)) {
+        HILOGE("Getxattr location is not all digit!");
+        return static_cast<int32_t>(LOCAL);
+    }
+    return atoi(string(value, static_cast<size_t>(size)).c_str());
+}
+
+// Follows symlinks like fs.stat does, statx is asked only for the fields that were requested
+static int StatPath(const char *path, size_t index, const StatBatchOptions &options, FsBatchStats &stats)
+{
+    uint32_t fields = options.fields;
+#if defined(STATX_BASIC_STATS) && defined(SYS_statx)
+    unsigned int mask = 0;
+    mask |= (fields & STAT_BATCH_FIELD_MODE) ? (STATX_TYPE | STATX_MODE) : 0;
+    mask |= (fields & STAT_BATCH_FIELD_SIZE) ? STATX_SIZE : 0;
+    mask |= (fields & STAT_BATCH_FIELD_INO) ? STATX_INO : 0;
+    mask |= (fields & STAT_BATCH_FIELD_UID) ? STATX_UID : 0;
+    mask |= (fields & STAT_BATCH_FIELD_GID) ? STATX_GID : 0;
+    mask |= (fields & STAT_BATCH_FIELD_ATIME) ? STATX_ATIME : 0;
+    mask |= (fields & STAT_BATCH_FIELD_MTIME) ? STATX_MTIME : 0;
+    mask |= (fields & STAT_BATCH_FIELD_CTIME) ? STATX_CTIME : 0;
+    int flags = options.dontSync ? AT_STATX_DONT_SYNC : AT_STATX_SYNC_AS_STAT;
+    struct statx info;
+    if (syscall(SYS_statx, AT_FDCWD, path, flags, mask, &info) != 0) {
+        return errno;
+    }
+    uint32_t mode = info.stx_mode;
+    int64_t size = static_cast<int64_t>(info.stx_size);
+    uint64_t ino = info.stx_ino;
+    uint32_t uid = info.stx_uid;
+    uint32_t gid = info.stx_gid;
+    int64_t atime = info.stx_atime.tv_sec;
+    int64_t mtime = info.stx_mtime.tv_sec;
+    int64_t ctime = info.stx_ctime.tv_sec;
+#else
+    struct stat info;
+    if (stat(path, &info) != 0) {
+        return errno;
+    }
+    uint32_t mode = info.st_mode;
+    int64_t size = info.st_size;
+    uint64_t ino = info.st_ino;
+    uint32_t uid = info.st_uid;
+    uint32_t gid = info.st_gid;
+    int64_t atime = info.st_atime;
+    int64_t mtime = info.st_mtime;
+    int64_t ctime = info.st_ctime;
+#endif
+    if (fields & STAT_BATCH_FIELD_MODE) {
+        stats.modes[index] = mode;
+    }
+    if (fields & STAT_BATCH_FIELD_SIZE) {
+        stats.sizes[index] = size;
+    }
+    if (fields & STAT_BATCH_FIELD_INO) {
+        stats.inos[index] = ino;
+    }
+    if (fields & STAT_BATCH_FIELD_UID) {
+        stats.uids[index] = uid;
+    }
+    if (fields & STAT_BATCH_FIELD_GID) {
+        stats.gids[index] = gid;
+    }
+    if (fields & STAT_BATCH_FIELD_ATIME) {
+        stats.atimes[index] = atime;
+    }
+    if (fields & STAT_BATCH_FIELD_MTIME) {
+        stats.mtimes[index] = mtime;
+    }
+    if (fields & STAT_BATCH_FIELD_CTIME) {
+        stats.ctimes[index] = ctime;
+    }
+    return ERRNO_NOERR;
+}
+
+static int CheckAccessible(const char *path)
+{
+    return access(path, F_OK) == 0 ? ERRNO_NOERR : errno;
+}
+
+// Every thread owns a contiguous range of the columns, so no slot is written twice
+static void StatRangePaths(
+    const vector<string> &paths, const StatBatchOptions &options, FsBatchStats &stats, const StatRange &range)
+{
+    for (size_t i = range.begin; i < range.end; i++) {
+        const char *path = paths[i].c_str();
+        int ret = (options.fields & STAT_BATCH_FIELD_STAT_NEEDED) ?
+            StatPath(path, i, options, stats) : CheckAccessible(path);
+        if (ret != ERRNO_NOERR) {
+            stats.errs[i] = ret;
+            continue;
+        }
+        if (options.fields & STAT_BATCH_FIELD_LOCATION) {
+            stats.locations[i] = ReadLocation(path);
+        }
+    }
+}
+
+static void StatPaths(const vector<string> &paths, const StatBatchOptions &options, FsBatchStats &stats)
+{
+    size_t count = paths.size();
+    size_t threadNum = min(ListFileWalker::DefaultWorkerNum(), max<size_t>(1, count / PARALLEL_STAT_MIN_PATHS));
+    vector<StatRange> ranges(threadNum);
+    size_t step = (count + threadNum - 1) / threadNum;
+    for (size_t i = 0; i < threadNum; i++) {
+        ranges[i].begin = min(count, i * step);
+        ranges[i].end = min(count, ranges[i].begin + step);
+    }
+
+    vector<thread> helpers;
+    size_t started = 1;
+    for (; started < threadNum; started++) {
+        try {
+            helpers.emplace_back(StatRangePaths, cref(paths), cref(options), ref(stats), cref(ranges[started]));
+        } catch (const system_error &e) {
+            HILOGE("Failed to start stat worker: %{public}s", e.what());
+            break;
+        }
+    }
+    // Ranges without a thread are done on the calling thread
+    StatRangePaths(paths, options, stats, ranges[0]);
+    for (size_t i = started; i < threadNum; i++) {
+        StatRangePaths(paths, options, stats, ranges[i]);
+    }
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+}
+
+FsResult<FsBatchStats> StatBatchCore::DoStatBatch(const vector<string> &paths, const StatBatchOptions &options)
+{
+    FileFsTrace traceDoStatBatch("DoStatBatch");
+    uint32_t fields = options.fields;
+    if (fields == 0 || (fields & ~static_cast<uint32_t>(STAT_BATCH_FIELD_ALL)) != 0) {
+        HILOGE("Invalid fields");
+        return FsResult<FsBatchStats>::Error(EINVAL);
+    }
+    for (const auto &path : paths) {
+        if (path.empty()) {
+            HILOGE("Invalid path");
+            return FsResult<FsBatchStats>::Error(EINVAL);
+        }
+    }
+
+    size_t count = paths.size();
+    FsBatchStats stats;
+    stats.errs.resize(count, ERRNO_NOERR);
+    stats.modes.resize((fields & STAT_BATCH_FIELD_MODE) ? count : 0);
+    stats.sizes.resize((fields & STAT_BATCH_FIELD_SIZE) ? count : 0);
+    stats.inos.resize((fields & STAT_BATCH_FIELD_INO) ? count : 0);
+    stats.uids.resize((fields & STAT_BATCH_FIELD_UID) ? count : 0);
+    stats.gids.resize((fields & STAT_BATCH_FIELD_GID) ? count : 0);
+    stats.atimes.resize((fields & STAT_BATCH_FIELD_ATIME) ? count : 0);
+    stats.mtimes.resize((fields & STAT_BATCH_FIELD_MTIME) ? count : 0);
+    stats.ctimes.resize((fields & STAT_BATCH_FIELD_CTIME) ? count : 0);
+    stats.locations.resize((fields & STAT_BATCH_FIELD_LOCATION) ? count : 0);
+    if (count != 0) {
+        StatPaths(paths, options, stats);
+    }
+    return FsResult<FsBatchStats>::Success(move(stats));
+}
+
+} // namespace OHOS::FileManagement::ModuleFileIO
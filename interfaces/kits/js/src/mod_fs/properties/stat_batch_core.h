@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_STAT_BATCH_CORE_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_STAT_BATCH_CORE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "filemgmt_libfs.h"
+
+namespace OHOS::FileManagement::ModuleFileIO {
+
+enum StatBatchField : uint32_t {
+    STAT_BATCH_FIELD_MODE = 1U << 0,
+    STAT_BATCH_FIELD_SIZE = 1U << 1,
+    STAT_BATCH_FIELD_INO = 1U << 2,
+    STAT_BATCH_FIELD_UID = 1U << 3,
+    STAT_BATCH_FIELD_GID = 1U << 4,
+    STAT_BATCH_FIELD_ATIME = 1U << 5,
+    STAT_BATCH_FIELD_MTIME = 1U << 6,
+    STAT_BATCH_FIELD_CTIME = 1U << 7,
+    STAT_BATCH_FIELD_LOCATION = 1U << 8,
+    STAT_BATCH_FIELD_ALL = (1U << 9) - 1,
+};
+
+struct StatBatchOptions {
+    uint32_t fields = STAT_BATCH_FIELD_ALL;
+    // Take whatever attributes are cached instead of asking a cloud or remote file system for fresh ones
+    bool dontSync = false;
+};
+
+/*
+ * One column per requested field, indexed like the paths of the request. A path that could not be stat'ed has its
+ * errno in errs and zeros in the other columns, the ones not requested stay empty. Times are in seconds like
+ * the ones of fs.stat.
+ */
+struct FsBatchStats {
+    std::vector<int32_t> errs;
+    std::vector<uint32_t> modes;
+    std::vector<int64_t> sizes;
+    std::vector<uint64_t> inos;
+    std::vector<uint32_t> uids;
+    std::vector<uint32_t> gids;
+    std::vector<int64_t> atimes;
+    std::vector<int64_t> mtimes;
+    std::vector<int64_t> ctimes;
+    std::vector<int32_t> locations;
+};
+
+class StatBatchCore {
+public:
+    static FsResult<FsBatchStats> DoStatBatch(
+        const std::vector<std::string> &paths, const StatBatchOptions &options = StatBatchOptions());
+};
+
+} // namespace OHOS::FileManagement::ModuleFileIO
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_STAT_BATCH_CORE_H
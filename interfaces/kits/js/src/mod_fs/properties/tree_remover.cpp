@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tree_remover.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+#include "fd_guard.h"
+#include "filemgmt_libfs.h"
+#include "filemgmt_libhilog.h"
+#include "listfile_walker.h"
+
+#ifndef RENAME_NOREPLACE
+#define RENAME_NOREPLACE 1
+#endif
+
+namespace OHOS::FileManagement::ModuleFileIO {
+using namespace std;
+
+namespace {
+constexpr uint64_t PROGRESS_INTERVAL = 4096;
+constexpr int TRASH_RENAME_RETRIES = 8;
+const string TRASH_NAME_INFIX = ".trash.";
+} // namespace
+
+TreeRemover::TreeRemover(const TreeRemoveOptions &options) : options_(options)
+{
+    if (options_.workerNum == 0) {
+        options_.workerNum = 1;
+    }
+}
+
+bool TreeRemover::Stopped() const
+{
+    return stop_.load(memory_order_acquire);
+}
+
+void TreeRemover::Stop(int err)
+{
+    if (err != ERRNO_NOERR) {
+        int expected = ERRNO_NOERR;
+        err_.compare_exchange_strong(expected, err);
+    }
+    stop_.store(true, memory_order_release);
+    lock_guard<mutex> lock(idleMutex_);
+    idleCv_.notify_all();
+}
+
+void TreeRemover::ReportProgress()
+{
+    lock_guard<mutex> lock(progressMutex_);
+    uint64_t removed = removed_.load();
+    if (removed > reported_) {
+        reported_ = removed;
+        options_.progress(removed);
+    }
+}
+
+void TreeRemover::CountRemoved()
+{
+    uint64_t removed = removed_.fetch_add(1) + 1;
+    if (options_.progress && removed % PROGRESS_INTERVAL == 0) {
+        ReportProgress();
+    }
+}
+
+void TreeRemover::Push(Worker &worker, shared_ptr<DirNode> &&node)
+{
+    pending_.fetch_add(1);
+    {
+        lock_guard<mutex> lock(worker.mutex);
+        worker.tasks.push_back(move(node));
+    }
+    queued_.fetch_add(1);
+    lock_guard<mutex> lock(idleMutex_);
+    idleCv_.notify_one();
+}
+
+// The owner takes its newest directory to stay depth first, other workers steal the oldest one
+bool TreeRemover::Pop(size_t id, shared_ptr<DirNode> &node)
+{
+    for (size_t i = 0; i < options_.workerNum; i++) {
+        Worker &victim = *workers_[(id + i) % options_.workerNum];
+        lock_guard<mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            node = move(victim.tasks.back());
+            victim.tasks.pop_back();
+        } else {
+            node = move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+        queued_.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+// Unlinks the non-directories and queues the subdirectories, the directory itself is left to Release
+int TreeRemover::ScanDir(Worker &worker, const shared_ptr<DirNode> &node)
+{
+    DistributedFS::FDGuard dirFd(open(node->path.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC));
+    if (!dirFd) {
+        int err = errno;
+        HILOGE("Failed to open dir with errno: %{public}d", err);
+        return err;
+    }
+    int ret = ERRNO_NOERR;
+    int scanRet = ListFileWalker::ForEachDirent(dirFd.GetFD(), worker.direntBuf,
+        [this, &worker, &node, &dirFd, &ret](const char *name, unsigned char direntType) {
+        if (Stopped()) {
+            return false;
+        }
+        if (options_.isCanceled && options_.isCanceled()) {
+            ret = ECANCELED;
+            return false;
+        }
+        unsigned char type = ListFileWalker::ResolveType(dirFd.GetFD(), name, direntType);
+        if (type != DT_DIR) {
+            if (unlinkat(dirFd.GetFD(), name, 0) == 0) {
+                CountRemoved();
+                return true;
+            }
+            if (errno == ENOENT) {
+                return true;
+            }
+            if (errno != EISDIR) {
+                ret = errno;
+                HILOGE("Failed to unlink file with errno: %{public}d", ret);
+                return false;
+            }
+        }
+        auto child = make_shared<DirNode>();
+        child->path = node->path + '/' + name;
+        child->parent = node;
+        node->pending.fetch_add(1);
+        Push(worker, move(child));
+        return true;
+    });
+    return (scanRet != ERRNO_NOERR) ? scanRet : ret;
+}
+
+// Drops the hold of a finished scan or subdirectory, the directory that reaches zero is removed and releases its parent
+int TreeRemover::Release(shared_ptr<DirNode> node)
+{
+    while (node != nullptr && node->pending.fetch_sub(1) == 1) {
+        if (rmdir(node->path.c_str()) != 0 && errno != ENOENT) {
+            int err = errno;
+            HILOGE("Failed to remove dir with errno: %{public}d", err);
+            return err;
+        }
+        CountRemoved();
+        auto parent = node->parent;
+        node = move(parent);
+    }
+    return ERRNO_NOERR;
+}
+
+void TreeRemover::Run(size_t id)
+{
+    Worker &worker = *workers_[id];
+    shared_ptr<DirNode> node;
+    while (!Stopped()) {
+        if (!Pop(id, node)) {
+            unique_lock<mutex> lock(idleMutex_);
+            idleCv_.wait(lock, [this] { return Stopped() || pending_.load() == 0 || queued_.load() > 0; });
+            if (pending_.load() == 0) {
+                break;
+            }
+            continue;
+        }
+        int ret = ScanDir(worker, node);
+        if (ret == ERRNO_NOERR && !Stopped()) {
+            ret = Release(move(node));
+        }
+        node = nullptr;
+        if (ret != ERRNO_NOERR) {
+            Stop(ret);
+        }
+        if (pending_.fetch_sub(1) == 1) {
+            lock_guard<mutex> lock(idleMutex_);
+            idleCv_.notify_all();
+        }
+    }
+}
+
+int TreeRemover::Remove(const string &path)
+{
+    struct stat info;
+    if (path.empty() || lstat(path.c_str(), &info) != 0) {
+        int err = path.empty() ? ENOENT : errno;
+        HILOGE("Failed to stat with errno: %{public}d", err);
+        return err;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        if (unlink(path.c_str()) != 0) {
+            int err = errno;
+            HILOGE("Failed to unlink file with errno: %{public}d", err);
+            return err;
+        }
+        CountRemoved();
+    } else {
+        for (size_t i = 0; i < options_.workerNum; i++) {
+            workers_.push_back(make_unique<Worker>());
+        }
+        // The top directory is read on the calling thread, helpers are only started when it has subdirectories
+        auto root = make_shared<DirNode>();
+        root->path = path;
+        pending_.store(1);
+        int ret = ScanDir(*workers_[0], root);
+        if (ret == ERRNO_NOERR) {
+            ret = Release(move(root));
+        }
+        if (ret != ERRNO_NOERR) {
+            Stop(ret);
+        }
+        pending_.fetch_sub(1);
+
+        if (!Stopped() && queued_.load() > 0) {
+            vector<thread> helpers;
+            for (size_t i = 1; i < options_.workerNum; i++) {
+                try {
+                    helpers.emplace_back(&TreeRemover::Run, this, i);
+                } catch (const system_error &e) {
+                    HILOGE("Failed to start rmdir worker: %{public}s", e.what());
+                    break;
+                }
+            }
+            Run(0);
+            for (auto &helper : helpers) {
+                helper.join();
+            }
+        }
+        workers_.clear();
+    }
+    if (options_.progress) {
+        ReportProgress();
+    }
+    return err_.load();
+}
+
+int TreeRemover::RemoveInBackground(const string &path, size_t workerNum)
+{
+    TreeRemoveOptions options;
+    options.workerNum = workerNum;
+    struct stat info;
+    size_t end = path.find_last_not_of('/');
+    if (end == string::npos || lstat(path.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return TreeRemover(options).Remove(path);
+    }
+    // The trash stays in the same directory, so the rename never crosses a mount point
+    string base = path.substr(0, end + 1);
+    size_t pos = base.rfind('/');
+    string dir = (pos == string::npos) ? "" : base.substr(0, pos + 1);
+    string name = (pos == string::npos) ? base : base.substr(pos + 1);
+    static atomic<uint32_t> trashSeq { 0 };
+    string trash;
+    int err = EEXIST;
+    for (int i = 0; i < TRASH_RENAME_RETRIES && err == EEXIST; i++) {
+        trash = dir + "." + name + TRASH_NAME_INFIX + to_string(getpid()) + "." + to_string(trashSeq.fetch_add(1));
+        err = (syscall(SYS_renameat2, AT_FDCWD, base.c_str(), AT_FDCWD, trash.c_str(), RENAME_NOREPLACE) == 0) ?
+            ERRNO_NOERR : errno;
+    }
+    if (err == EINVAL || err == ENOSYS || err == ENAMETOOLONG || err == EEXIST) {
+        // No safe name for the trash, remove in place
+        return TreeRemover(options).Remove(path);
+    }
+    if (err != ERRNO_NOERR) {
+        HILOGE("Failed to move dir to trash with errno: %{public}d", err);
+        return err;
+    }
+    try {
+        thread([trash, options]() {
+            int ret = TreeRemover(options).Remove(trash);
+            if (ret != ERRNO_NOERR) {
+                HILOGE("Failed to remove trash dir with errno: %{public}d", ret);
+            }
+        }).detach();
+    } catch (const system_error &e) {
+        HILOGE("Failed to start trash remover: %{public}s", e.what());
+        return TreeRemover(options).Remove(trash);
+    }
+    return ERRNO_NOERR;
+}
+
+} // namespace OHOS::FileManagement::ModuleFileIO
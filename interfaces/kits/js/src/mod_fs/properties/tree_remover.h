@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_TREE_REMOVER_H
+#define INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_TREE_REMOVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS::FileManagement::ModuleFileIO {
+
+struct TreeRemoveOptions {
+    // Number of threads removing the tree, the calling thread is one of them
+    size_t workerNum = 1;
+    // Polled between entries, the removal stops with ECANCELED once it returns true
+    std::function<bool()> isCanceled;
+    // Called with the number of entries removed so far
+    std::function<void(uint64_t removed)> progress;
+};
+
+/*
+ * Removes a directory tree with several threads. Every worker reads a directory with getdents64, unlinks its files
+ * with unlinkat relative to the directory fd and queues its subdirectories in per worker deques, an idle worker
+ * steals the oldest directory of another one. A directory counts the subdirectories it still waits for and is
+ * removed by the worker that finishes the last of them, so directories go bottom-up without a second pass. Symbolic
+ * links are removed and never followed. The first error or a cancel stops the removal and leaves the entries not
+ * reached yet in place. Progress is reported every few thousand entries and once at the end, never concurrently.
+ */
+class TreeRemover {
+public:
+    explicit TreeRemover(const TreeRemoveOptions &options);
+    ~TreeRemover() = default;
+
+    // Removes the path whatever its type and everything below it, returns 0 or an errno
+    int Remove(const std::string &path);
+    // Renames a directory to a hidden sibling and removes it on a detached thread, so the call costs one rename. The
+    // background removal is not reported, a failure leaves the hidden directory behind
+    static int RemoveInBackground(const std::string &path, size_t workerNum);
+
+private:
+    struct DirNode {
+        std::string path;
+        std::shared_ptr<DirNode> parent;
+        // The scan of the directory itself plus one per subdirectory not removed yet
+        std::atomic<size_t> pending { 1 };
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<DirNode>> tasks;
+        std::vector<char> direntBuf;
+    };
+
+    int ScanDir(Worker &worker, const std::shared_ptr<DirNode> &node);
+    int Release(std::shared_ptr<DirNode> node);
+    void CountRemoved();
+    void ReportProgress();
+    void Push(Worker &worker, std::shared_ptr<DirNode> &&node);
+    bool Pop(size_t id, std::shared_ptr<DirNode> &node);
+    void Run(size_t id);
+    void Stop(int err);
+    bool Stopped() const;
+
+    TreeRemoveOptions options_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex progressMutex_;
+    uint64_t reported_ = 0;
+    std::mutex idleMutex_;
+    std::condition_variable idleCv_;
+    std::atomic<size_t> pending_ { 0 };
+    std::atomic<size_t> queued_ { 0 };
+    std::atomic<uint64_t> removed_ { 0 };
+    std::atomic<bool> stop_ { false };
+    std::atomic<int> err_ { 0 };
+};
+
+} // namespace OHOS::FileManagement::ModuleFileIO
+#endif // INTERFACES_KITS_JS_SRC_MOD_FS_PROPERTIES_TREE_REMOVER_H
@@ -45,10 +45,61 @@ static tuple<napi_value, int32_t> CreateAndCheckForWatcherEntity(napi_env env)
     return {objWatcher, ERRNO_NOERR};
 }
 
+static bool ParseBatchWindow(const NVal &options, WatcherInfoArg &infoArg)
+{
+    if (!options.HasProp("batchWindow") || options.GetProp("batchWindow").TypeIs(napi_undefined)) {
+        return true;
+    }
+    auto [succ, window] = options.GetProp("batchWindow").ToInt32();
+    if (!succ || window < 0) {
+        HILOGE("Failed to get watcher batchWindow.");
+        return false;
+    }
+    infoArg.batchWindow = window;
+    return true;
+}
+
+static bool ParseRecursive(const NVal &options, WatcherInfoArg &infoArg)
+{
+    if (options.HasProp("recursive") && !options.GetProp("recursive").TypeIs(napi_undefined)) {
+        auto [succ, recursive] = options.GetProp("recursive").ToBool();
+        if (!succ) {
+            HILOGE("Failed to get watcher recursive.");
+            return false;
+        }
+        infoArg.recursive = recursive;
+    }
+    if (options.HasProp("maxWatches") && !options.GetProp("maxWatches").TypeIs(napi_undefined)) {
+        auto [succ, maxWatches] = options.GetProp("maxWatches").ToInt32();
+        if (!succ || maxWatches <= 0) {
+            HILOGE("Failed to get watcher maxWatches.");
+            return false;
+        }
+        infoArg.maxWatches = static_cast<uint32_t>(maxWatches);
+    }
+    return true;
+}
+
+static bool ParseWatcherOptions(const napi_env &env, const NFuncArg &funcArg, WatcherInfoArg &infoArg)
+{
+    if (funcArg.GetArgc() < NARG_CNT::FOUR) {
+        return true;
+    }
+    NVal options(env, funcArg[NARG_POS::FOURTH]);
+    if (options.TypeIs(napi_undefined)) {
+        return true;
+    }
+    if (!options.TypeIs(napi_object)) {
+        HILOGE("Failed to get watcher options.");
+        return false;
+    }
+    return ParseBatchWindow(options, infoArg) && ParseRecursive(options, infoArg);
+}
+
 shared_ptr<WatcherInfoArg> ParseParam(const napi_env &env, const napi_callback_info &info, int32_t &errCode)
 {
     NFuncArg funcArg(env, info);
-    if (!funcArg.InitArgs(NARG_CNT::THREE)) {
+    if (!funcArg.InitArgs(NARG_CNT::THREE, NARG_CNT::FOUR)) {
         HILOGE("Failed to get param.");
         errCode = EINVAL;
         return nullptr;
@@ -73,6 +124,7 @@ shared_ptr<WatcherInfoArg> ParseParam(const napi_env &env, const napi_callback_i
         errCode = EINVAL;
         return nullptr;
     }
+
     auto infoArg = CreateSharedPtr<WatcherInfoArg>(NVal(env, funcArg[NARG_POS::THIRD]));
     if (infoArg == nullptr) {
         HILOGE("Failed to request heap memory.");
@@ -82,6 +134,10 @@ shared_ptr<WatcherInfoArg> ParseParam(const napi_env &env, const napi_callback_i
     infoArg->events = static_cast<uint32_t>(events);
     infoArg->env = env;
     infoArg->fileName = string(filename.get());
+    if (!ParseWatcherOptions(env, funcArg, *infoArg)) {
+        errCode = EINVAL;
+        return nullptr;
+    }
 
     return infoArg;
 }
@@ -112,6 +168,9 @@ napi_value Watcher::CreateWatcher(napi_env env, napi_callback_info info)
         return nullptr;
     }
     watcherEntity->data_ = infoArg;
+    if (infoArg->recursive) {
+        return objWatcher;
+    }
 
     bool ret = FileWatcher::GetInstance().AddWatcherInfo(infoArg->fileName, infoArg);
     if (!ret) {
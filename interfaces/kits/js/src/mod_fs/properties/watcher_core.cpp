@@ -26,9 +26,10 @@
 namespace OHOS::FileManagement::ModuleFileIO {
 using namespace std;
 
-static FsResult<FsWatcher *> InstantiateWatcher()
+static FsResult<FsWatcher *> InstantiateWatcher(bool recursive)
 {
-    if (!FsFileWatcher::GetInstance().TryInitNotify()) {
+    // A recursive watcher brings its own inotify instance
+    if (!recursive && !FsFileWatcher::GetInstance().TryInitNotify()) {
         HILOGE("Failed to get notifyId or initnotify fail");
         return FsResult<FsWatcher *>::Error(errno);
     }
@@ -41,8 +42,8 @@ static FsResult<FsWatcher *> InstantiateWatcher()
     return result;
 }
 
-shared_ptr<WatcherInfo> ToWatcherInfo(
-    const string &path, const int32_t events, shared_ptr<IWatcherCallback> callback, int32_t &errCode)
+shared_ptr<WatcherInfo> ToWatcherInfo(const string &path, const int32_t events, shared_ptr<IWatcherCallback> callback,
+    const WatcherOptions &options, int32_t &errCode)
 {
     if (events <= 0 || !FsFileWatcher::GetInstance().CheckEventValid(events)) {
         HILOGE("Failed to get watcher event.");
@@ -56,6 +57,12 @@ shared_ptr<WatcherInfo> ToWatcherInfo(
         return nullptr;
     }
 
+    if (options.recursive && options.maxWatches == 0) {
+        HILOGE("Invalid maxWatches");
+        errCode = EINVAL;
+        return nullptr;
+    }
+
     auto info = CreateSharedPtr<WatcherInfo>(callback);
     if (info == nullptr) {
         HILOGE("Failed to request heap memory.");
@@ -65,20 +72,22 @@ shared_ptr<WatcherInfo> ToWatcherInfo(
 
     info->events = static_cast<uint32_t>(events);
     info->fileName = move(path);
+    info->recursive = options.recursive;
+    info->maxWatches = options.maxWatches;
     return info;
 }
 
-FsResult<FsWatcher *> WatcherCore::DoCreateWatcher(
-    const string &path, const int32_t events, shared_ptr<IWatcherCallback> callback)
+FsResult<FsWatcher *> WatcherCore::DoCreateWatcher(const string &path, const int32_t events,
+    shared_ptr<IWatcherCallback> callback, const WatcherOptions &options)
 {
     int errCode = 0;
-    auto info = ToWatcherInfo(path, events, callback, errCode);
+    auto info = ToWatcherInfo(path, events, callback, options, errCode);
     if (errCode != 0) {
         HILOGE("Failed to parse param");
         return FsResult<FsWatcher *>::Error(errCode);
     }
 
-    auto result = InstantiateWatcher();
+    auto result = InstantiateWatcher(info->recursive);
     if (!result.IsSuccess()) {
         return result;
     }
@@ -98,6 +107,9 @@ FsResult<FsWatcher *> WatcherCore::DoCreateWatcher(
     }
 
     watchEntity->watcherInfo = info;
+    if (info->recursive) {
+        return result;
+    }
 
     bool ret = FsFileWatcher::GetInstance().AddWatcherInfo(info);
     if (!ret) {
@@ -22,10 +22,16 @@
 
 namespace OHOS::FileManagement::ModuleFileIO {
 
+struct WatcherOptions {
+    // Watch every directory below path, events then carry paths relative to it
+    bool recursive = false;
+    uint32_t maxWatches = DEFAULT_MAX_RECURSIVE_WATCHES;
+};
+
 class WatcherCore final {
 public:
-    static FsResult<FsWatcher *> DoCreateWatcher(
-        const std::string &path, const int32_t events, std::shared_ptr<IWatcherCallback> callback);
+    static FsResult<FsWatcher *> DoCreateWatcher(const std::string &path, const int32_t events,
+        std::shared_ptr<IWatcherCallback> callback, const WatcherOptions &options = WatcherOptions());
 };
 
 } // namespace OHOS::FileManagement::ModuleFileIO
@@ -32,8 +32,15 @@ SWAPFS_NATIVE_API int SwapfsNativeSwapOut(
     OH_SwapfsManager *manager, const OH_SwapfsSwapOutRequest *request, uint64_t *keyId);
 SWAPFS_NATIVE_API int SwapfsNativeSwapIn(
     OH_SwapfsManager *manager, const OH_SwapfsSwapInRequest *request, uint64_t *readSize);
+SWAPFS_NATIVE_API int SwapfsNativeMapIn(OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsMapView *view);
+SWAPFS_NATIVE_API int SwapfsNativeUnmapView(OH_SwapfsManager *manager, OH_SwapfsMapView *view);
 SWAPFS_NATIVE_API int SwapfsNativeQueryData(OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsDataInfo *info);
 SWAPFS_NATIVE_API int SwapfsNativeGetStats(OH_SwapfsManager *manager, OH_SwapfsStats *stats);
+SWAPFS_NATIVE_API int SwapfsNativeSetEvictionConfig(
+    OH_SwapfsManager *manager, const OH_SwapfsEvictionConfig *config);
+SWAPFS_NATIVE_API int SwapfsNativeQueryAccessInfo(
+    OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsAccessInfo *info);
+SWAPFS_NATIVE_API int SwapfsNativeGetEvictionStats(OH_SwapfsManager *manager, OH_SwapfsEvictionStats *stats);
 SWAPFS_NATIVE_API int SwapfsNativeRemoveData(OH_SwapfsManager *manager, uint64_t keyId);
 SWAPFS_NATIVE_API int SwapfsNativeRemoveAllData(OH_SwapfsManager *manager);
 
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_FILEMANAGEMENT_FILE_API_NATIVE_SWAPFS_EVICTION_H
+#define OHOS_FILEMANAGEMENT_FILE_API_NATIVE_SWAPFS_EVICTION_H
+
+#include <vector>
+
+#include "swapfs.h"
+#include "swapfs_key_index.h"
+
+namespace OHOS::FileManagement::Swapfs {
+bool IsValidEvictionPolicy(OH_SwapfsEvictionPolicy policy);
+/* Orders candidates so that the entry to evict first comes first. */
+void SortEvictionCandidates(OH_SwapfsEvictionPolicy policy, std::vector<SwapKeyEntry> &candidates);
+} // namespace OHOS::FileManagement::Swapfs
+
+#endif
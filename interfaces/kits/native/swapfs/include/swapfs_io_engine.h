@@ -31,6 +31,12 @@ public:
     int Write(const std::string &path, const void *buffer, size_t size, bool useDirectIo);
 };
 
+class MmapReadEngine {
+public:
+    int Map(const std::string &path, size_t size, const void *&data);
+    static void Unmap(const void *data, size_t size);
+};
+
 bool IsDioAligned(const void *buffer, size_t size);
 int OpenSwapFileForRead(const std::string &path, uint32_t extraFlags);
 } // namespace OHOS::FileManagement::Swapfs
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_FILEMANAGEMENT_FILE_API_NATIVE_SWAPFS_KEY_INDEX_H
+#define OHOS_FILEMANAGEMENT_FILE_API_NATIVE_SWAPFS_KEY_INDEX_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "swapfs.h"
+
+namespace OHOS::FileManagement::Swapfs {
+/* Copyable snapshot of an index slot; the swap file path is derived from keyId. */
+struct SwapKeyEntry {
+    uint64_t keyId = 0;
+    uint64_t dataSize = 0;
+    int64_t createTime = 0;
+    OH_SwapfsKeyStatus status = OH_SWAPFS_KEY_STATUS_ACTIVE;
+    uint32_t readCount = 0;
+    int64_t lastAccessTime = 0;
+    uint64_t accessCount = 0;
+};
+
+struct SwapKeySlot {
+    uint64_t dataSize = 0;
+    int64_t createTime = 0;
+    OH_SwapfsKeyStatus status = OH_SWAPFS_KEY_STATUS_ACTIVE;
+    std::atomic<uint32_t> readCount { 0 };
+    std::atomic<int64_t> lastAccessTime { 0 };
+    std::atomic<uint64_t> accessCount { 0 };
+};
+
+/*
+ * Key table split into independently locked shards. Readers take the shard lock shared and
+ * bump the slot read counter atomically; status transitions take the shard lock exclusively,
+ * so a status observed under a shared lock stays stable until that lock is released.
+ */
+class SwapKeyIndex {
+public:
+    void Insert(const SwapKeyEntry &entry);
+    int Query(uint64_t keyId, SwapKeyEntry &entry) const;
+    int AcquireRead(uint64_t keyId, int64_t accessTime, SwapKeyEntry &entry);
+    int ReleaseRead(uint64_t keyId, SwapKeyEntry &entry, bool &removeNow);
+    int MarkRemoving(uint64_t keyId, SwapKeyEntry &entry, bool &removeNow);
+    int TryMarkEvicting(uint64_t keyId, SwapKeyEntry &entry);
+    bool FinishRemove(uint64_t keyId, bool removed);
+    void MarkAllRemoving(std::vector<SwapKeyEntry> &entries);
+    void CollectEvictionCandidates(std::vector<SwapKeyEntry> &entries) const;
+    void Clear();
+    void GetTotals(uint64_t &totalKeys, uint64_t &totalDataSize) const;
+    bool Empty() const;
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<uint64_t, SwapKeySlot> slots;
+        std::atomic<uint64_t> keyCount { 0 };
+        std::atomic<uint64_t> dataSize { 0 };
+    };
+
+    Shard &ShardOf(uint64_t keyId);
+    const Shard &ShardOf(uint64_t keyId) const;
+    static void FillEntry(uint64_t keyId, const SwapKeySlot &slot, SwapKeyEntry &entry);
+    static void EraseLocked(Shard &shard, std::unordered_map<uint64_t, SwapKeySlot>::iterator iter);
+
+    std::array<Shard, SHARD_COUNT> shards_;
+};
+} // namespace OHOS::FileManagement::Swapfs
+
+#endif
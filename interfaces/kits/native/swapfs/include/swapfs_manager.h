@@ -16,16 +16,19 @@
 #ifndef OHOS_FILEMANAGEMENT_FILE_API_NATIVE_SWAPFS_MANAGER_H
 #define OHOS_FILEMANAGEMENT_FILE_API_NATIVE_SWAPFS_MANAGER_H
 
+#include <atomic>
 #include <cstdint>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "swapfs.h"
 #include "swapfs_control.h"
+#include "swapfs_key_index.h"
 #include "swapfs_proxy_control.h"
 #include "swapfs_uring_read_engine.h"
 
@@ -41,15 +44,6 @@ struct SwapfsConfigInner {
     std::string managerId;
 };
 
-struct SwapKeyEntry {
-    uint64_t keyId = 0;
-    std::string path;
-    uint64_t dataSize = 0;
-    int64_t createTime = 0;
-    OH_SwapfsKeyStatus status = OH_SWAPFS_KEY_STATUS_ACTIVE;
-    uint32_t readCount = 0;
-};
-
 class SwapfsManager {
 public:
     SwapfsManager();
@@ -60,8 +54,13 @@ public:
     int Destroy();
     int SwapOut(const OH_SwapfsSwapOutRequest *request, uint64_t *keyId);
     int SwapIn(const OH_SwapfsSwapInRequest *request, uint64_t *readSize);
+    int MapIn(uint64_t keyId, OH_SwapfsMapView *view);
+    int UnmapView(OH_SwapfsMapView *view);
     int QueryData(uint64_t keyId, OH_SwapfsDataInfo *info);
     int GetStats(OH_SwapfsStats *stats);
+    int SetEvictionConfig(const OH_SwapfsEvictionConfig *config);
+    int QueryAccessInfo(uint64_t keyId, OH_SwapfsAccessInfo *info);
+    int GetEvictionStats(OH_SwapfsEvictionStats *stats);
     int RemoveData(uint64_t keyId);
     int RemoveAllData();
 
@@ -96,26 +95,44 @@ private:
     void RemoveSessionDir();
     int PrepareForSwapOut(const OH_SwapfsSwapOutRequest *request, SwapOutContext &context);
     void CommitSwapOutEntry(const SwapKeyEntry &entry, uint64_t *keyId);
+    int ReserveSwapOut(uint64_t occupiedSize);
+    int EvictForReserve(uint64_t occupiedSize, OH_SwapfsEvictionPolicy policy,
+        std::vector<SwapKeyEntry> &evicted);
+    bool EvictEntry(const SwapKeyEntry &candidate);
     int PrepareForSwapIn(bool &useDirectIo);
     int LookupKeyForSwapIn(uint64_t keyId, SwapKeyEntry &entry);
-    int ExecuteSwapInRead(const SwapKeyEntry &entry, void *buffer, size_t readIoSize,
+    int ExecuteSwapInRead(const std::string &path, void *buffer, size_t readIoSize,
         bool useDirectIo);
     void FinishSwapIn(uint64_t keyId);
-    int PrepareRemoveEntry(uint64_t keyId, SwapKeyEntry &entry);
+    bool TakeMappedView(const OH_SwapfsMapView &view);
+    void UnmapAllViews();
+    std::string BuildKeyPath(uint64_t keyId, const char *suffix) const;
+    int PrepareRemoveEntry(uint64_t keyId, SwapKeyEntry &entry, bool &removeNow);
     void FinalizeRemoveEntry(const SwapKeyEntry &entry, bool removed);
     int CollectRemovableEntries(std::vector<SwapKeyEntry> &entriesToRemove);
     bool AllEntriesCleanLocked();
     bool WaitForActiveOps(uint32_t timeoutMs);
 
-    std::mutex mutex_;
-    std::condition_variable activeOpsCv_;
+    // Guards lifecycle flags only: data-path ops hold it shared, lifecycle transitions exclusively.
+    std::shared_mutex mutex_;
+    std::condition_variable_any activeOpsCv_;
     SwapfsConfigInner config_;
     std::unique_ptr<SwapControlProvider> control_;
     UringReadEngine uringReader_;
-    std::unordered_map<uint64_t, SwapKeyEntry> entries_;
+    SwapKeyIndex keyIndex_;
     std::string sessionPath_;
-    uint64_t nextKeyId_ = 1;
-    uint32_t activeOps_ = 0;
+    std::string dataRoot_;
+    std::atomic<uint64_t> nextKeyId_ { 1 };
+    std::atomic<uint32_t> activeOps_ { 0 };
+    // Serializes evictions and guards eviction_; evictionPolicy_ mirrors its policy for the fast path.
+    std::mutex evictionMutex_;
+    OH_SwapfsEvictionConfig eviction_ {};
+    std::atomic<OH_SwapfsEvictionPolicy> evictionPolicy_ { OH_SWAPFS_EVICTION_NONE };
+    std::atomic<uint64_t> evictedKeys_ { 0 };
+    std::atomic<uint64_t> evictedBytes_ { 0 };
+    // Live MapIn views keyed by mapping address; each holds a key read reference and an active op.
+    std::mutex viewMutex_;
+    std::unordered_map<const void *, OH_SwapfsMapView> mappedViews_;
     int sessionLockFd_ = -1;
     bool removeAllInProgress_ = false;
     bool initialized_ = false;
@@ -176,6 +176,32 @@ __attribute__((visibility("default"))) int SwapfsNativeSwapIn(
     return manager->impl.SwapIn(request, readSize);
 }
 
+__attribute__((visibility("default"))) int SwapfsNativeMapIn(
+    OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsMapView *view)
+{
+    if (keyId == 0 || view == nullptr) {
+        return SWAPFS_E_INVAL;
+    }
+    ApiCallGuard guard(manager);
+    if (guard.Status() != SWAPFS_E_OK) {
+        return guard.Status();
+    }
+    return manager->impl.MapIn(keyId, view);
+}
+
+__attribute__((visibility("default"))) int SwapfsNativeUnmapView(
+    OH_SwapfsManager *manager, OH_SwapfsMapView *view)
+{
+    if (view == nullptr) {
+        return SWAPFS_E_INVAL;
+    }
+    ApiCallGuard guard(manager);
+    if (guard.Status() != SWAPFS_E_OK) {
+        return guard.Status();
+    }
+    return manager->impl.UnmapView(view);
+}
+
 __attribute__((visibility("default"))) int SwapfsNativeQueryData(
     OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsDataInfo *info)
 {
@@ -202,6 +228,45 @@ __attribute__((visibility("default"))) int SwapfsNativeGetStats(
     return manager->impl.GetStats(stats);
 }
 
+__attribute__((visibility("default"))) int SwapfsNativeSetEvictionConfig(
+    OH_SwapfsManager *manager, const OH_SwapfsEvictionConfig *config)
+{
+    if (config == nullptr) {
+        return SWAPFS_E_INVAL;
+    }
+    ApiCallGuard guard(manager);
+    if (guard.Status() != SWAPFS_E_OK) {
+        return guard.Status();
+    }
+    return manager->impl.SetEvictionConfig(config);
+}
+
+__attribute__((visibility("default"))) int SwapfsNativeQueryAccessInfo(
+    OH_SwapfsManager *manager, uint64_t keyId, OH_SwapfsAccessInfo *info)
+{
+    if (keyId == 0 || info == nullptr) {
+        return SWAPFS_E_INVAL;
+    }
+    ApiCallGuard guard(manager);
+    if (guard.Status() != SWAPFS_E_OK) {
+        return guard.Status();
+    }
+    return manager->impl.QueryAccessInfo(keyId, info);
+}
+
+__attribute__((visibility("default"))) int SwapfsNativeGetEvictionStats(
+    OH_SwapfsManager *manager, OH_SwapfsEvictionStats *stats)
+{
+    if (stats == nullptr) {
+        return SWAPFS_E_INVAL;
+    }
+    ApiCallGuard guard(manager);
+    if (guard.Status() != SWAPFS_E_OK) {
+        return guard.Status();
+    }
+    return manager->impl.GetEvictionStats(stats);
+}
+
 __attribute__((visibility("default"))) int SwapfsNativeRemoveData(
     OH_SwapfsManager *manager, uint64_t keyId)
 {
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "swapfs_eviction.h"
+
+#include <algorithm>
+
+namespace OHOS::FileManagement::Swapfs {
+namespace {
+bool OlderAccess(const SwapKeyEntry &lhs, const SwapKeyEntry &rhs)
+{
+    if (lhs.lastAccessTime != rhs.lastAccessTime) {
+        return lhs.lastAccessTime < rhs.lastAccessTime;
+    }
+    return lhs.keyId < rhs.keyId;
+}
+
+bool LessFrequent(const SwapKeyEntry &lhs, const SwapKeyEntry &rhs)
+{
+    if (lhs.accessCount != rhs.accessCount) {
+        return lhs.accessCount < rhs.accessCount;
+    }
+    return OlderAccess(lhs, rhs);
+}
+
+bool Larger(const SwapKeyEntry &lhs, const SwapKeyEntry &rhs)
+{
+    if (lhs.dataSize != rhs.dataSize) {
+        return lhs.dataSize > rhs.dataSize;
+    }
+    return OlderAccess(lhs, rhs);
+}
+} // namespace
+
+bool IsValidEvictionPolicy(OH_SwapfsEvictionPolicy policy)
+{
+    switch (policy) {
+        case OH_SWAPFS_EVICTION_NONE:
+        case OH_SWAPFS_EVICTION_LRU:
+        case OH_SWAPFS_EVICTION_LFU:
+        case OH_SWAPFS_EVICTION_SIZE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void SortEvictionCandidates(OH_SwapfsEvictionPolicy policy, std::vector<SwapKeyEntry> &candidates)
+{
+    switch (policy) {
+        case OH_SWAPFS_EVICTION_LRU:
+            std::sort(candidates.begin(), candidates.end(), OlderAccess);
+            break;
+        case OH_SWAPFS_EVICTION_LFU:
+            std::sort(candidates.begin(), candidates.end(), LessFrequent);
+            break;
+        case OH_SWAPFS_EVICTION_SIZE:
+            std::sort(candidates.begin(), candidates.end(), Larger);
+            break;
+        default:
+            candidates.clear();
+            break;
+    }
+}
+} // namespace OHOS::FileManagement::Swapfs
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "swapfs_key_index.h"
+
+#include <mutex>
+
+#include "swapfs_errcode.h"
+
+namespace OHOS::FileManagement::Swapfs {
+SwapKeyIndex::Shard &SwapKeyIndex::ShardOf(uint64_t keyId)
+{
+    return shards_[keyId % SHARD_COUNT];
+}
+
+const SwapKeyIndex::Shard &SwapKeyIndex::ShardOf(uint64_t keyId) const
+{
+    return shards_[keyId % SHARD_COUNT];
+}
+
+void SwapKeyIndex::FillEntry(uint64_t keyId, const SwapKeySlot &slot, SwapKeyEntry &entry)
+{
+    entry.keyId = keyId;
+    entry.dataSize = slot.dataSize;
+    entry.createTime = slot.createTime;
+    entry.status = slot.status;
+    entry.readCount = slot.readCount.load(std::memory_order_acquire);
+    entry.lastAccessTime = slot.lastAccessTime.load(std::memory_order_relaxed);
+    entry.accessCount = slot.accessCount.load(std::memory_order_relaxed);
+}
+
+void SwapKeyIndex::EraseLocked(
+    Shard &shard, std::unordered_map<uint64_t, SwapKeySlot>::iterator iter)
+{
+    shard.keyCount.fetch_sub(1, std::memory_order_relaxed);
+    shard.dataSize.fetch_sub(iter->second.dataSize, std::memory_order_relaxed);
+    shard.slots.erase(iter);
+}
+
+void SwapKeyIndex::Insert(const SwapKeyEntry &entry)
+{
+    Shard &shard = ShardOf(entry.keyId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto result = shard.slots.try_emplace(entry.keyId);
+    SwapKeySlot &slot = result.first->second;
+    if (!result.second) {
+        shard.dataSize.fetch_sub(slot.dataSize, std::memory_order_relaxed);
+    } else {
+        shard.keyCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot.dataSize = entry.dataSize;
+    slot.createTime = entry.createTime;
+    slot.status = entry.status;
+    slot.readCount.store(entry.readCount, std::memory_order_release);
+    slot.lastAccessTime.store(entry.lastAccessTime, std::memory_order_relaxed);
+    slot.accessCount.store(entry.accessCount, std::memory_order_relaxed);
+    shard.dataSize.fetch_add(entry.dataSize, std::memory_order_relaxed);
+}
+
+int SwapKeyIndex::Query(uint64_t keyId, SwapKeyEntry &entry) const
+{
+    const Shard &shard = ShardOf(keyId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto iter = shard.slots.find(keyId);
+    if (iter == shard.slots.end()) {
+        return SWAPFS_E_KEY_NOT_FOUND;
+    }
+    FillEntry(keyId, iter->second, entry);
+    return SWAPFS_E_OK;
+}
+
+int SwapKeyIndex::AcquireRead(uint64_t keyId, int64_t accessTime, SwapKeyEntry &entry)
+{
+    Shard &shard = ShardOf(keyId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto iter = shard.slots.find(keyId);
+    if (iter == shard.slots.end()) {
+        return SWAPFS_E_KEY_NOT_FOUND;
+    }
+    if (iter->second.status != OH_SWAPFS_KEY_STATUS_ACTIVE) {
+        return SWAPFS_E_KEY_STATE_INVALID;
+    }
+    iter->second.readCount.fetch_add(1, std::memory_order_acq_rel);
+    iter->second.lastAccessTime.store(accessTime, std::memory_order_relaxed);
+    iter->second.accessCount.fetch_add(1, std::memory_order_relaxed);
+    FillEntry(keyId, iter->second, entry);
+    return SWAPFS_E_OK;
+}
+
+int SwapKeyIndex::ReleaseRead(uint64_t keyId, SwapKeyEntry &entry, bool &removeNow)
+{
+    Shard &shard = ShardOf(keyId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto iter = shard.slots.find(keyId);
+    if (iter == shard.slots.end()) {
+        return SWAPFS_E_KEY_NOT_FOUND;
+    }
+    uint32_t previous = iter->second.readCount.fetch_sub(1, std::memory_order_acq_rel);
+    removeNow = iter->second.status == OH_SWAPFS_KEY_STATUS_REMOVING && previous == 1;
+    FillEntry(keyId, iter->second, entry);
+    return SWAPFS_E_OK;
+}
+
+int SwapKeyIndex::MarkRemoving(uint64_t keyId, SwapKeyEntry &entry, bool &removeNow)
+{
+    Shard &shard = ShardOf(keyId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto iter = shard.slots.find(keyId);
+    if (iter == shard.slots.end()) {
+        return SWAPFS_E_KEY_NOT_FOUND;
+    }
+    if (iter->second.status != OH_SWAPFS_KEY_STATUS_ACTIVE) {
+        return SWAPFS_E_KEY_STATE_INVALID;
+    }
+    iter->second.status = OH_SWAPFS_KEY_STATUS_REMOVING;
+    removeNow = iter->second.readCount.load(std::memory_order_acquire) == 0;
+    FillEntry(keyId, iter->second, entry);
+    return SWAPFS_E_OK;
+}
+
+int SwapKeyIndex::TryMarkEvicting(uint64_t keyId, SwapKeyEntry &entry)
+{
+    Shard &shard = ShardOf(keyId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto iter = shard.slots.find(keyId);
+    if (iter == shard.slots.end()) {
+        return SWAPFS_E_KEY_NOT_FOUND;
+    }
+    if (iter->second.status != OH_SWAPFS_KEY_STATUS_ACTIVE ||
+        iter->second.readCount.load(std::memory_order_acquire) != 0) {
+        return SWAPFS_E_KEY_STATE_INVALID;
+    }
+    iter->second.status = OH_SWAPFS_KEY_STATUS_REMOVING;
+    FillEntry(keyId, iter->second, entry);
+    return SWAPFS_E_OK;
+}
+
+bool SwapKeyIndex::FinishRemove(uint64_t keyId, bool removed)
+{
+    Shard &shard = ShardOf(keyId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto iter = shard.slots.find(keyId);
+    if (iter == shard.slots.end()) {
+        return false;
+    }
+    if (removed) {
+        EraseLocked(shard, iter);
+    } else {
+        iter->second.status = OH_SWAPFS_KEY_STATUS_ACTIVE;
+    }
+    return true;
+}
+
+void SwapKeyIndex::MarkAllRemoving(std::vector<SwapKeyEntry> &entries)
+{
+    for (auto &shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto &item : shard.slots) {
+            SwapKeyEntry entry;
+            FillEntry(item.first, item.second, entry);
+            entries.emplace_back(entry);
+            item.second.status = OH_SWAPFS_KEY_STATUS_REMOVING;
+        }
+    }
+}
+
+void SwapKeyIndex::CollectEvictionCandidates(std::vector<SwapKeyEntry> &entries) const
+{
+    for (const auto &shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto &item : shard.slots) {
+            if (item.second.status != OH_SWAPFS_KEY_STATUS_ACTIVE ||
+                item.second.readCount.load(std::memory_order_acquire) != 0) {
+                continue;
+            }
+            SwapKeyEntry entry;
+            FillEntry(item.first, item.second, entry);
+            entries.emplace_back(entry);
+        }
+    }
+}
+
+void SwapKeyIndex::Clear()
+{
+    for (auto &shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.slots.clear();
+        shard.keyCount.store(0, std::memory_order_relaxed);
+        shard.dataSize.store(0, std::memory_order_relaxed);
+    }
+}
+
+void SwapKeyIndex::GetTotals(uint64_t &totalKeys, uint64_t &totalDataSize) const
+{
+    totalKeys = 0;
+    totalDataSize = 0;
+    for (const auto &shard : shards_) {
+        totalKeys += shard.keyCount.load(std::memory_order_relaxed);
+        totalDataSize += shard.dataSize.load(std::memory_order_relaxed);
+    }
+}
+
+bool SwapKeyIndex::Empty() const
+{
+    uint64_t totalKeys = 0;
+    uint64_t totalDataSize = 0;
+    GetTotals(totalKeys, totalDataSize);
+    return totalKeys == 0;
+}
+} // namespace OHOS::FileManagement::Swapfs
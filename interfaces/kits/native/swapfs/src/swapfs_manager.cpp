@@ -22,6 +22,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <utility>
@@ -36,6 +37,7 @@
 #include "filemgmt_libhilog.h"
 #include "ipc_skeleton.h"
 #include "swapfs_err_mapper.h"
+#include "swapfs_eviction.h"
 #include "swapfs_io_engine.h"
 #include "swapfs_session_cleaner.h"
 #include "tokenid_kit.h"
@@ -155,16 +157,17 @@ SwapfsManager::SwapfsManager(std::unique_ptr<SwapControlProvider> controlProvide
 SwapfsManager::~SwapfsManager()
 {
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         if (!initialized_) { return; }
         shuttingDown_ = true;
         HILOGI("[Swapfs] destructor initiated, rejecting new ops");
     }
+    UnmapAllViews();
 
     bool clean = WaitForActiveOps(DESTRUCTOR_WAIT_TIMEOUT_MS);
 
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         if (!initialized_) { return; }
         if (clean) {
             RemoveSessionDir();
@@ -173,7 +176,7 @@ SwapfsManager::~SwapfsManager()
             HILOGW("[Swapfs] destructor wait timed out, leaving data for session cleaner");
         }
         CloseSessionLock();
-        entries_.clear();
+        keyIndex_.Clear();
         control_->OnAllEntriesRemoved();
         initialized_ = false;
         shuttingDown_ = false;
@@ -305,6 +308,7 @@ int SwapfsManager::CreateSessionLocked(int rootFd)
         return MapErrno(err, SwapfsErrContext::PATH_OPERATION);
     }
     sessionPath_ = config_.swapRootPath + "/" + finalName;
+    dataRoot_ = BuildDataRoot(sessionPath_);
     return SWAPFS_E_OK;
 }
 
@@ -314,7 +318,7 @@ int SwapfsManager::Init(const OH_SwapfsConfig *config)
         HILOGE("[Swapfs] Init rejected, caller is not a system app");
         return COMMON_E_PERMISSION_SYS;
     }
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     if (initialized_) {
         HILOGW("[Swapfs] already initialized, skip");
         return SWAPFS_E_BUSY;
@@ -338,6 +342,13 @@ int SwapfsManager::Init(const OH_SwapfsConfig *config)
         CloseSessionLock();
         return ret;
     }
+    {
+        std::lock_guard<std::mutex> evictionLock(evictionMutex_);
+        eviction_ = OH_SwapfsEvictionConfig {};
+        evictionPolicy_.store(OH_SWAPFS_EVICTION_NONE, std::memory_order_release);
+    }
+    evictedKeys_.store(0, std::memory_order_relaxed);
+    evictedBytes_.store(0, std::memory_order_relaxed);
     initialized_ = true;
     HILOGI("[Swapfs] Init success");
     return SWAPFS_E_OK;
@@ -362,12 +373,13 @@ void SwapfsManager::RemoveSessionDir()
         HILOGE("[Swapfs] RemoveSessionDir failed, ret: %{public}d", ret);
     }
     sessionPath_.clear();
+    dataRoot_.clear();
 }
 
 int SwapfsManager::Destroy()
 {
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         shuttingDown_ = true;
         HILOGI("[Swapfs] Destroy initiated, rejecting new ops");
     }
@@ -375,7 +387,7 @@ int SwapfsManager::Destroy()
     bool clean = WaitForActiveOps(DESTROY_WAIT_TIMEOUT_MS);
 
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         if (!clean) {
             shuttingDown_ = false;
             HILOGW("[Swapfs] Destroy E_BUSY, shuttingDown reset");
@@ -383,7 +395,7 @@ int SwapfsManager::Destroy()
         }
         RemoveSessionDir();
         CloseSessionLock();
-        entries_.clear();
+        keyIndex_.Clear();
         control_->OnAllEntriesRemoved();
         initialized_ = false;
         shuttingDown_ = false;
@@ -394,13 +406,13 @@ int SwapfsManager::Destroy()
 
 bool SwapfsManager::AllEntriesCleanLocked()
 {
-    return activeOps_ == 0;
+    return activeOps_.load(std::memory_order_acquire) == 0;
 }
 
 bool SwapfsManager::WaitForActiveOps(uint32_t timeoutMs)
 {
     auto timeout = std::chrono::milliseconds(timeoutMs);
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     bool clean = activeOpsCv_.wait_for(lock, timeout, [this] {
         return AllEntriesCleanLocked();
     });
@@ -414,21 +426,23 @@ bool SwapfsManager::WaitForActiveOps(uint32_t timeoutMs)
 
 void SwapfsManager::EndOperation()
 {
-    bool notify = false;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        --activeOps_;
-        notify = AllEntriesCleanLocked();
-    }
-    if (notify) {
-        activeOpsCv_.notify_all();
+    if (activeOps_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
     }
+    // Taking the lock orders the notify after a waiter that has already checked the predicate.
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    activeOpsCv_.notify_all();
+}
+
+std::string SwapfsManager::BuildKeyPath(uint64_t keyId, const char *suffix) const
+{
+    return dataRoot_ + "/" + std::to_string(keyId) + suffix;
 }
 
 int SwapfsManager::PrepareForSwapOut(const OH_SwapfsSwapOutRequest *request,
     SwapOutContext &context)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!initialized_) {
         HILOGW("[Swapfs] SwapOut not initialized");
         return SWAPFS_E_INVAL;
@@ -448,22 +462,87 @@ int SwapfsManager::PrepareForSwapOut(const OH_SwapfsSwapOutRequest *request,
         HILOGW("[Swapfs] SwapOut rejected, RemoveAllData in progress");
         return SWAPFS_E_BUSY;
     }
-    ++activeOps_;
-    context.keyId = nextKeyId_++;
-    std::string dataRoot = BuildDataRoot(sessionPath_);
-    context.tmpPath = dataRoot + "/" + std::to_string(context.keyId) + ".tmp";
-    context.swapPath = dataRoot + "/" + std::to_string(context.keyId) + ".swap";
+    activeOps_.fetch_add(1, std::memory_order_acq_rel);
+    context.keyId = nextKeyId_.fetch_add(1, std::memory_order_relaxed);
+    context.tmpPath = BuildKeyPath(context.keyId, ".tmp");
+    context.swapPath = BuildKeyPath(context.keyId, ".swap");
     return SWAPFS_E_OK;
 }
 
 void SwapfsManager::CommitSwapOutEntry(const SwapKeyEntry &entry, uint64_t *keyId)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    entries_[entry.keyId] = entry;
+    keyIndex_.Insert(entry);
     control_->OnSwapOutCommitted(entry.dataSize, entry.dataSize);
     *keyId = entry.keyId;
 }
 
+bool SwapfsManager::EvictEntry(const SwapKeyEntry &candidate)
+{
+    SwapKeyEntry entry;
+    if (keyIndex_.TryMarkEvicting(candidate.keyId, entry) != SWAPFS_E_OK) {
+        return false;
+    }
+    bool removed = RemoveSwapFile(BuildKeyPath(entry.keyId, ".swap"), "Evict", false) == SWAPFS_E_OK;
+    if (!keyIndex_.FinishRemove(entry.keyId, removed) || !removed) {
+        return false;
+    }
+    control_->OnEntryRemoved(entry.dataSize, entry.dataSize);
+    evictedKeys_.fetch_add(1, std::memory_order_relaxed);
+    evictedBytes_.fetch_add(entry.dataSize, std::memory_order_relaxed);
+    HILOGI("[Swapfs] Evicted keyId: %{public}" PRIu64 ", size: %{public}" PRIu64,
+        entry.keyId, entry.dataSize);
+    return true;
+}
+
+int SwapfsManager::EvictForReserve(uint64_t occupiedSize, OH_SwapfsEvictionPolicy policy,
+    std::vector<SwapKeyEntry> &evicted)
+{
+    int ret = control_->ReserveSwapOut(occupiedSize);
+    if (ret != SWAPFS_E_QUOTA_EXCEEDED || policy == OH_SWAPFS_EVICTION_NONE) {
+        return ret;
+    }
+    std::vector<SwapKeyEntry> candidates;
+    keyIndex_.CollectEvictionCandidates(candidates);
+    SortEvictionCandidates(policy, candidates);
+    for (const auto &candidate : candidates) {
+        if (!EvictEntry(candidate)) {
+            continue;
+        }
+        evicted.emplace_back(candidate);
+        ret = control_->ReserveSwapOut(occupiedSize);
+        if (ret != SWAPFS_E_QUOTA_EXCEEDED) {
+            return ret;
+        }
+    }
+    HILOGW("[Swapfs] SwapOut eviction could not free enough space");
+    return ret;
+}
+
+int SwapfsManager::ReserveSwapOut(uint64_t occupiedSize)
+{
+    int ret = control_->ReserveSwapOut(occupiedSize);
+    if (ret != SWAPFS_E_QUOTA_EXCEEDED ||
+        evictionPolicy_.load(std::memory_order_acquire) == OH_SWAPFS_EVICTION_NONE ||
+        occupiedSize > config_.spaceLimitBytes) {
+        return ret;
+    }
+    std::vector<SwapKeyEntry> evicted;
+    OH_SwapfsEvictionConfig eviction;
+    {
+        // One evictor at a time, so concurrent SwapOut calls do not drop more keys than needed.
+        std::lock_guard<std::mutex> lock(evictionMutex_);
+        eviction = eviction_;
+        ret = EvictForReserve(occupiedSize, eviction.policy, evicted);
+    }
+    // Callbacks run once the lock is released, so they may call SwapOut or RemoveData.
+    if (eviction.onEvicted != nullptr) {
+        for (const auto &entry : evicted) {
+            eviction.onEvicted(entry.keyId, entry.dataSize, eviction.userData);
+        }
+    }
+    return ret;
+}
+
 int SwapfsManager::SwapOut(const OH_SwapfsSwapOutRequest *request, uint64_t *keyId)
 {
     if (request == nullptr || request->buffer == nullptr ||
@@ -477,7 +556,7 @@ int SwapfsManager::SwapOut(const OH_SwapfsSwapOutRequest *request, uint64_t *key
         return prepRet;
     }
     ActiveOperationGuard operation(*this);
-    int reserveRet = control_->ReserveSwapOut(request->bufferSize);
+    int reserveRet = ReserveSwapOut(request->bufferSize);
     if (reserveRet != SWAPFS_E_OK) {
         HILOGW("[Swapfs] SwapOut reserve failed, ret: %{public}d", reserveRet);
         return reserveRet;
@@ -501,9 +580,9 @@ int SwapfsManager::SwapOut(const OH_SwapfsSwapOutRequest *request, uint64_t *key
 
     SwapKeyEntry entry;
     entry.keyId = context.keyId;
-    entry.path = context.swapPath;
     entry.dataSize = request->bufferSize;
     entry.createTime = NowMs();
+    entry.lastAccessTime = entry.createTime;
     entry.status = OH_SWAPFS_KEY_STATUS_ACTIVE;
     CommitSwapOutEntry(entry, keyId);
     HILOGI("[Swapfs] SwapOut success, keyId: %{public}" PRIu64 ", size: %{public}" PRIu64,
@@ -513,7 +592,7 @@ int SwapfsManager::SwapOut(const OH_SwapfsSwapOutRequest *request, uint64_t *key
 
 int SwapfsManager::PrepareForSwapIn(bool &useDirectIo)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!initialized_) {
         HILOGW("[Swapfs] SwapIn not initialized");
         return SWAPFS_E_INVAL;
@@ -523,41 +602,35 @@ int SwapfsManager::PrepareForSwapIn(bool &useDirectIo)
         return SWAPFS_E_SHUTTING_DOWN;
     }
     useDirectIo = config_.useDirectIo;
-    ++activeOps_;
+    activeOps_.fetch_add(1, std::memory_order_acq_rel);
     return SWAPFS_E_OK;
 }
 
 int SwapfsManager::LookupKeyForSwapIn(uint64_t keyId, SwapKeyEntry &entry)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iter = entries_.find(keyId);
-    if (iter == entries_.end()) {
+    int ret = keyIndex_.AcquireRead(keyId, NowMs(), entry);
+    if (ret == SWAPFS_E_KEY_NOT_FOUND) {
         HILOGW("[Swapfs] SwapIn key not found, keyId: %{public}" PRIu64, keyId);
-        return SWAPFS_E_KEY_NOT_FOUND;
-    }
-    if (iter->second.status != OH_SWAPFS_KEY_STATUS_ACTIVE) {
+    } else if (ret == SWAPFS_E_KEY_STATE_INVALID) {
         HILOGW("[Swapfs] SwapIn key state invalid");
-        return SWAPFS_E_KEY_STATE_INVALID;
     }
-    ++iter->second.readCount;
-    entry = iter->second;
-    return SWAPFS_E_OK;
+    return ret;
 }
 
 int SwapfsManager::ExecuteSwapInRead(
-    const SwapKeyEntry &entry, void *buffer, size_t readIoSize, bool useDirectIo)
+    const std::string &path, void *buffer, size_t readIoSize, bool useDirectIo)
 {
     if (useDirectIo) {
         if (uringReader_.IsAvailable()) {
             HILOGD("[Swapfs] Use io_uring");
-            return uringReader_.Read(entry.path, buffer, readIoSize, 0);
+            return uringReader_.Read(path, buffer, readIoSize, 0);
         }
         HILOGD("[Swapfs] Use SyncDio");
         SyncReadEngine reader;
-        return reader.Read(entry.path, buffer, readIoSize, 0, true);
+        return reader.Read(path, buffer, readIoSize, 0, true);
     }
     SyncReadEngine reader;
-    return reader.Read(entry.path, buffer, readIoSize, 0, false);
+    return reader.Read(path, buffer, readIoSize, 0, false);
 }
 
 int SwapfsManager::SwapIn(const OH_SwapfsSwapInRequest *request, uint64_t *readSize)
@@ -590,8 +663,8 @@ int SwapfsManager::SwapIn(const OH_SwapfsSwapInRequest *request, uint64_t *readS
         FinishSwapIn(request->keyId);
         return SWAPFS_E_BUFFER_TOO_SMALL;
     }
-    int ret = ExecuteSwapInRead(
-        entry, request->buffer, static_cast<size_t>(entry.dataSize), useDirectIo);
+    int ret = ExecuteSwapInRead(BuildKeyPath(entry.keyId, ".swap"), request->buffer,
+        static_cast<size_t>(entry.dataSize), useDirectIo);
     if (ret != SWAPFS_E_OK) {
         HILOGE("[Swapfs] SwapIn read failed, ret: %{public}d", ret);
         FinishSwapIn(request->keyId);
@@ -608,37 +681,114 @@ int SwapfsManager::SwapIn(const OH_SwapfsSwapInRequest *request, uint64_t *readS
 
 void SwapfsManager::FinishSwapIn(uint64_t keyId)
 {
-    std::string pathToRemove;
-    uint64_t removedSize = 0;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto iter = entries_.find(keyId);
-        if (iter == entries_.end()) {
-            HILOGW("[Swapfs] FinishSwapIn key not found");
-            return;
-        }
-        --iter->second.readCount;
-        if (iter->second.status != OH_SWAPFS_KEY_STATUS_REMOVING ||
-            iter->second.readCount > 0) {
-            return;
-        }
-        pathToRemove = iter->second.path;
-        removedSize = iter->second.dataSize;
+    SwapKeyEntry entry;
+    bool removeNow = false;
+    if (keyIndex_.ReleaseRead(keyId, entry, removeNow) != SWAPFS_E_OK) {
+        HILOGW("[Swapfs] FinishSwapIn key not found");
+        return;
     }
-    bool removed = RemoveSwapFile(pathToRemove, "FinishSwapIn", false) == SWAPFS_E_OK;
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iter = entries_.find(keyId);
-    if (iter == entries_.end()) {
+    if (!removeNow) {
+        return;
+    }
+    bool removed = RemoveSwapFile(BuildKeyPath(keyId, ".swap"), "FinishSwapIn", false) == SWAPFS_E_OK;
+    if (!keyIndex_.FinishRemove(keyId, removed)) {
         HILOGW("[Swapfs] FinishSwapIn key removed before deferred cleanup");
         return;
     }
     if (!removed) {
-        iter->second.status = OH_SWAPFS_KEY_STATUS_ACTIVE;
         HILOGW("[Swapfs] FinishSwapIn deferred delete failed, reverting status to ACTIVE");
         return;
     }
-    control_->OnEntryRemoved(removedSize, removedSize);
-    entries_.erase(iter);
+    control_->OnEntryRemoved(entry.dataSize, entry.dataSize);
+}
+
+int SwapfsManager::MapIn(uint64_t keyId, OH_SwapfsMapView *view)
+{
+    if (keyId == 0 || view == nullptr) {
+        HILOGW("[Swapfs] MapIn invalid params");
+        return SWAPFS_E_INVAL;
+    }
+    bool useDirectIo = false;
+    int prepRet = PrepareForSwapIn(useDirectIo);
+    if (prepRet != SWAPFS_E_OK) {
+        return prepRet;
+    }
+    ActiveOperationGuard operation(*this);
+    SwapKeyEntry entry;
+    int lookupRet = LookupKeyForSwapIn(keyId, entry);
+    if (lookupRet != SWAPFS_E_OK) {
+        return lookupRet;
+    }
+    const void *data = nullptr;
+    MmapReadEngine mapper;
+    int ret = mapper.Map(BuildKeyPath(keyId, ".swap"), static_cast<size_t>(entry.dataSize), data);
+    if (ret != SWAPFS_E_OK) {
+        HILOGE("[Swapfs] MapIn map failed, ret: %{public}d", ret);
+        FinishSwapIn(keyId);
+        return ret;
+    }
+    view->keyId = keyId;
+    view->data = data;
+    view->dataSize = entry.dataSize;
+    {
+        std::lock_guard<std::mutex> lock(viewMutex_);
+        mappedViews_.emplace(data, *view);
+    }
+    // The view keeps the operation open so Destroy and RemoveAllData wait for UnmapView.
+    activeOps_.fetch_add(1, std::memory_order_acq_rel);
+    HILOGI("[Swapfs] MapIn success, keyId: %{public}" PRIu64 ", size: %{public}" PRIu64,
+        keyId, entry.dataSize);
+    return SWAPFS_E_OK;
+}
+
+bool SwapfsManager::TakeMappedView(const OH_SwapfsMapView &view)
+{
+    std::lock_guard<std::mutex> lock(viewMutex_);
+    auto iter = mappedViews_.find(view.data);
+    if (iter == mappedViews_.end() || iter->second.keyId != view.keyId ||
+        iter->second.dataSize != view.dataSize) {
+        return false;
+    }
+    mappedViews_.erase(iter);
+    return true;
+}
+
+// Views still mapped at destruction would outlive the manager, so they are released here.
+void SwapfsManager::UnmapAllViews()
+{
+    std::unordered_map<const void *, OH_SwapfsMapView> views;
+    {
+        std::lock_guard<std::mutex> lock(viewMutex_);
+        views.swap(mappedViews_);
+    }
+    for (const auto &item : views) {
+        const OH_SwapfsMapView &view = item.second;
+        MmapReadEngine::Unmap(view.data, static_cast<size_t>(view.dataSize));
+        FinishSwapIn(view.keyId);
+        EndOperation();
+    }
+    if (!views.empty()) {
+        HILOGW("[Swapfs] destructor unmapped %{public}zu live views", views.size());
+    }
+}
+
+int SwapfsManager::UnmapView(OH_SwapfsMapView *view)
+{
+    if (view == nullptr || view->data == nullptr) {
+        HILOGW("[Swapfs] UnmapView invalid params");
+        return SWAPFS_E_INVAL;
+    }
+    if (!TakeMappedView(*view)) {
+        HILOGW("[Swapfs] UnmapView unknown view, keyId: %{public}" PRIu64, view->keyId);
+        return SWAPFS_E_INVAL;
+    }
+    ActiveOperationGuard operation(*this);
+    MmapReadEngine::Unmap(view->data, static_cast<size_t>(view->dataSize));
+    FinishSwapIn(view->keyId);
+    HILOGI("[Swapfs] UnmapView success, keyId: %{public}" PRIu64, view->keyId);
+    view->data = nullptr;
+    view->dataSize = 0;
+    return SWAPFS_E_OK;
 }
 
 int SwapfsManager::QueryData(uint64_t keyId, OH_SwapfsDataInfo *info)
@@ -647,7 +797,7 @@ int SwapfsManager::QueryData(uint64_t keyId, OH_SwapfsDataInfo *info)
         HILOGW("[Swapfs] QueryData invalid params");
         return SWAPFS_E_INVAL;
     }
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!initialized_) {
         HILOGW("[Swapfs] QueryData not initialized");
         return SWAPFS_E_INVAL;
@@ -656,12 +806,11 @@ int SwapfsManager::QueryData(uint64_t keyId, OH_SwapfsDataInfo *info)
         HILOGW("[Swapfs] QueryData rejected, manager shutting down");
         return SWAPFS_E_SHUTTING_DOWN;
     }
-    auto iter = entries_.find(keyId);
-    if (iter == entries_.end()) {
+    SwapKeyEntry entry;
+    if (keyIndex_.Query(keyId, entry) != SWAPFS_E_OK) {
         HILOGW("[Swapfs] QueryData key not found, keyId: %{public}" PRIu64, keyId);
         return SWAPFS_E_KEY_NOT_FOUND;
     }
-    const SwapKeyEntry &entry = iter->second;
     if (entry.status != OH_SWAPFS_KEY_STATUS_ACTIVE) {
         HILOGW("[Swapfs] QueryData key state invalid");
         return SWAPFS_E_KEY_STATE_INVALID;
@@ -684,7 +833,7 @@ int SwapfsManager::GetStats(OH_SwapfsStats *stats)
         return SWAPFS_E_INVAL;
     }
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_lock<std::shared_mutex> lock(mutex_);
         if (!initialized_) {
             HILOGW("[Swapfs] GetStats not initialized");
             return SWAPFS_E_INVAL;
@@ -693,17 +842,91 @@ int SwapfsManager::GetStats(OH_SwapfsStats *stats)
             HILOGW("[Swapfs] GetStats rejected, manager shutting down");
             return SWAPFS_E_SHUTTING_DOWN;
         }
-        ++activeOps_;
+        activeOps_.fetch_add(1, std::memory_order_acq_rel);
     }
     ActiveOperationGuard operation(*this);
     control_->FillStats(*stats);
+    keyIndex_.GetTotals(stats->totalKeys, stats->totalDataSize);
+    stats->totalOccupiedSize = stats->totalDataSize;
     HILOGI("[Swapfs] GetStats success");
     return SWAPFS_E_OK;
 }
 
-int SwapfsManager::PrepareRemoveEntry(uint64_t keyId, SwapKeyEntry &entry)
+int SwapfsManager::SetEvictionConfig(const OH_SwapfsEvictionConfig *config)
+{
+    if (config == nullptr || !IsValidEvictionPolicy(config->policy)) {
+        HILOGW("[Swapfs] SetEvictionConfig invalid params");
+        return SWAPFS_E_INVAL;
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!initialized_) {
+        HILOGW("[Swapfs] SetEvictionConfig not initialized");
+        return SWAPFS_E_INVAL;
+    }
+    if (shuttingDown_) {
+        HILOGW("[Swapfs] SetEvictionConfig rejected, manager shutting down");
+        return SWAPFS_E_SHUTTING_DOWN;
+    }
+    std::lock_guard<std::mutex> evictionLock(evictionMutex_);
+    eviction_ = *config;
+    evictionPolicy_.store(config->policy, std::memory_order_release);
+    HILOGI("[Swapfs] SetEvictionConfig success, policy: %{public}d", config->policy);
+    return SWAPFS_E_OK;
+}
+
+int SwapfsManager::QueryAccessInfo(uint64_t keyId, OH_SwapfsAccessInfo *info)
+{
+    if (keyId == 0 || info == nullptr) {
+        HILOGW("[Swapfs] QueryAccessInfo invalid params");
+        return SWAPFS_E_INVAL;
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!initialized_) {
+        HILOGW("[Swapfs] QueryAccessInfo not initialized");
+        return SWAPFS_E_INVAL;
+    }
+    if (shuttingDown_) {
+        HILOGW("[Swapfs] QueryAccessInfo rejected, manager shutting down");
+        return SWAPFS_E_SHUTTING_DOWN;
+    }
+    SwapKeyEntry entry;
+    if (keyIndex_.Query(keyId, entry) != SWAPFS_E_OK) {
+        HILOGW("[Swapfs] QueryAccessInfo key not found, keyId: %{public}" PRIu64, keyId);
+        return SWAPFS_E_KEY_NOT_FOUND;
+    }
+    if (entry.status != OH_SWAPFS_KEY_STATUS_ACTIVE) {
+        HILOGW("[Swapfs] QueryAccessInfo key state invalid");
+        return SWAPFS_E_KEY_STATE_INVALID;
+    }
+    info->keyId = entry.keyId;
+    info->lastAccessTime = entry.lastAccessTime;
+    info->accessCount = entry.accessCount;
+    return SWAPFS_E_OK;
+}
+
+int SwapfsManager::GetEvictionStats(OH_SwapfsEvictionStats *stats)
+{
+    if (stats == nullptr) {
+        HILOGW("[Swapfs] GetEvictionStats invalid params");
+        return SWAPFS_E_INVAL;
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!initialized_) {
+        HILOGW("[Swapfs] GetEvictionStats not initialized");
+        return SWAPFS_E_INVAL;
+    }
+    if (shuttingDown_) {
+        HILOGW("[Swapfs] GetEvictionStats rejected, manager shutting down");
+        return SWAPFS_E_SHUTTING_DOWN;
+    }
+    stats->evictedKeys = evictedKeys_.load(std::memory_order_relaxed);
+    stats->evictedBytes = evictedBytes_.load(std::memory_order_relaxed);
+    return SWAPFS_E_OK;
+}
+
+int SwapfsManager::PrepareRemoveEntry(uint64_t keyId, SwapKeyEntry &entry, bool &removeNow)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!initialized_) {
         HILOGW("[Swapfs] RemoveData not initialized");
         return SWAPFS_E_INVAL;
@@ -712,38 +935,29 @@ int SwapfsManager::PrepareRemoveEntry(uint64_t keyId, SwapKeyEntry &entry)
         HILOGW("[Swapfs] RemoveData rejected, manager shutting down");
         return SWAPFS_E_SHUTTING_DOWN;
     }
-    auto iter = entries_.find(keyId);
-    if (iter == entries_.end()) {
+    int ret = keyIndex_.MarkRemoving(keyId, entry, removeNow);
+    if (ret == SWAPFS_E_KEY_NOT_FOUND) {
         HILOGW("[Swapfs] RemoveData key not found");
-        return SWAPFS_E_KEY_NOT_FOUND;
+        return ret;
     }
-    if (iter->second.status != OH_SWAPFS_KEY_STATUS_ACTIVE) {
+    if (ret == SWAPFS_E_KEY_STATE_INVALID) {
         HILOGW("[Swapfs] RemoveData key state invalid");
-        return SWAPFS_E_KEY_STATE_INVALID;
+        return ret;
     }
-    iter->second.status = OH_SWAPFS_KEY_STATUS_REMOVING;
-    if (iter->second.readCount == 0) {
-        entry = iter->second;
-        ++activeOps_;
+    if (removeNow) {
+        activeOps_.fetch_add(1, std::memory_order_acq_rel);
     }
     return SWAPFS_E_OK;
 }
 
 void SwapfsManager::FinalizeRemoveEntry(const SwapKeyEntry &entry, bool removed)
 {
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto iter = entries_.find(entry.keyId);
-        if (iter == entries_.end()) {
-            HILOGW("[Swapfs] RemoveData key removed before finalize");
-            return;
-        }
-        if (removed) {
-            control_->OnEntryRemoved(entry.dataSize, entry.dataSize);
-            entries_.erase(iter);
-        } else {
-            iter->second.status = OH_SWAPFS_KEY_STATUS_ACTIVE;
-        }
+    if (!keyIndex_.FinishRemove(entry.keyId, removed)) {
+        HILOGW("[Swapfs] RemoveData key removed before finalize");
+        return;
+    }
+    if (removed) {
+        control_->OnEntryRemoved(entry.dataSize, entry.dataSize);
     }
 }
 
@@ -754,16 +968,17 @@ int SwapfsManager::RemoveData(uint64_t keyId)
         return SWAPFS_E_INVAL;
     }
     SwapKeyEntry entry;
-    int prepRet = PrepareRemoveEntry(keyId, entry);
+    bool removeNow = false;
+    int prepRet = PrepareRemoveEntry(keyId, entry, removeNow);
     if (prepRet != SWAPFS_E_OK) {
         return prepRet;
     }
-    if (entry.path.empty()) {
+    if (!removeNow) {
         HILOGI("[Swapfs] RemoveData deferred, keyId: %{public}" PRIu64, keyId);
         return SWAPFS_E_OK;
     }
     ActiveOperationGuard operation(*this);
-    int removeRet = RemoveSwapFile(entry.path, "RemoveData", false);
+    int removeRet = RemoveSwapFile(BuildKeyPath(keyId, ".swap"), "RemoveData", false);
     bool removed = removeRet == SWAPFS_E_OK;
     FinalizeRemoveEntry(entry, removed);
     if (!removed) {
@@ -775,7 +990,7 @@ int SwapfsManager::RemoveData(uint64_t keyId)
 
 int SwapfsManager::CollectRemovableEntries(std::vector<SwapKeyEntry> &entriesToRemove)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     if (!initialized_) {
         HILOGW("[Swapfs] RemoveAllData not initialized");
         return SWAPFS_E_INVAL;
@@ -784,20 +999,15 @@ int SwapfsManager::CollectRemovableEntries(std::vector<SwapKeyEntry> &entriesToR
         HILOGW("[Swapfs] RemoveAllData rejected, manager shutting down");
         return SWAPFS_E_SHUTTING_DOWN;
     }
-    if (activeOps_ > 0) {
-        HILOGW("[Swapfs] RemoveAllData rejected, active ops: %{public}u", activeOps_);
+    uint32_t activeOps = activeOps_.load(std::memory_order_acquire);
+    if (activeOps > 0) {
+        HILOGW("[Swapfs] RemoveAllData rejected, active ops: %{public}u", activeOps);
         return SWAPFS_E_BUSY;
     }
-    entriesToRemove.reserve(entries_.size());
-    for (const auto &item : entries_) {
-        entriesToRemove.emplace_back(item.second);
-    }
-    for (auto &item : entries_) {
-        item.second.status = OH_SWAPFS_KEY_STATUS_REMOVING;
-    }
+    keyIndex_.MarkAllRemoving(entriesToRemove);
     if (!entriesToRemove.empty()) {
         removeAllInProgress_ = true;
-        ++activeOps_;
+        activeOps_.fetch_add(1, std::memory_order_acq_rel);
     }
     return SWAPFS_E_OK;
 }
@@ -819,28 +1029,21 @@ int SwapfsManager::RemoveAllData()
     removedEntries.reserve(entriesToRemove.size());
     int firstError = SWAPFS_E_OK;
     for (const auto &entry : entriesToRemove) {
-        int removeRet = RemoveSwapFile(entry.path, "RemoveAllData", false);
+        int removeRet = RemoveSwapFile(BuildKeyPath(entry.keyId, ".swap"), "RemoveAllData", false);
         bool removed = removeRet == SWAPFS_E_OK;
         removedEntries.emplace_back(removed);
         if (!removed && firstError == SWAPFS_E_OK) {
             firstError = removeRet;
         }
     }
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        for (size_t index = 0; index < entriesToRemove.size(); ++index) {
-            const auto &entry = entriesToRemove[index];
-            auto iter = entries_.find(entry.keyId);
-            if (iter == entries_.end()) {
-                continue;
-            }
-            if (removedEntries[index]) {
-                control_->OnEntryRemoved(entry.dataSize, entry.dataSize);
-                entries_.erase(iter);
-            } else {
-                iter->second.status = OH_SWAPFS_KEY_STATUS_ACTIVE;
-            }
+    for (size_t index = 0; index < entriesToRemove.size(); ++index) {
+        const auto &entry = entriesToRemove[index];
+        if (keyIndex_.FinishRemove(entry.keyId, removedEntries[index]) && removedEntries[index]) {
+            control_->OnEntryRemoved(entry.dataSize, entry.dataSize);
         }
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         removeAllInProgress_ = false;
     }
     if (firstError != SWAPFS_E_OK) {
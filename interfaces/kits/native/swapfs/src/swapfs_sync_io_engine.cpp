@@ -19,6 +19,7 @@
 #include <cstdint>
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -145,4 +146,41 @@ int SyncWriteEngine::Write(
     (void)close(fd);
     return ret;
 }
+
+int MmapReadEngine::Map(const std::string &path, size_t size, const void *&data)
+{
+    data = nullptr;
+    if (size == 0) {
+        HILOGW("[Swapfs] Map invalid params");
+        return SWAPFS_E_INVAL;
+    }
+    int fd = OpenSwapFileForRead(path, 0);
+    if (fd < 0) {
+        HILOGE("[Swapfs] Map open failed, errno: %{public}d", errno);
+        return MapErrno(errno, SwapfsErrContext::KEY_OPERATION);
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size < 0 || static_cast<uint64_t>(st.st_size) < size) {
+        // Touching pages past EOF would raise SIGBUS in the caller, so reject short files here.
+        HILOGE("[Swapfs] Map swap file shorter than recorded size");
+        (void)close(fd);
+        return SWAPFS_E_IO_ERROR;
+    }
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    int err = errno;
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+        HILOGE("[Swapfs] mmap failed, errno: %{public}d", err);
+        return MapErrno(err, SwapfsErrContext::KEY_OPERATION);
+    }
+    data = addr;
+    return SWAPFS_E_OK;
+}
+
+void MmapReadEngine::Unmap(const void *data, size_t size)
+{
+    if (data != nullptr && munmap(const_cast<void *>(data), size) != 0) {
+        HILOGE("[Swapfs] munmap failed, errno: %{public}d", errno);
+    }
+}
 } // namespace OHOS::FileManagement::Swapfs
@@ -0,0 +1,847 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * End-to-end harness for the archive module. Synthetic corpora are generated under the root directory, then
+ * every case runs --repeat times and the fastest run is reported:
+ *   writer_add      OH_Archive_Writer_Add of one corpus directory, per level and file I/O mode
+ *   reader_extract  OH_Archive_Reader_ExtractAllFile of the archive written at the default level
+ *   stream_write    OH_Archive_StreamWrite_* over an in-memory input, per block size, thread count and level
+ *   stream_read     OH_Archive_StreamRead_* of the stream_write output, per block size
+ *   buffer_write    OH_Archive_BufferWrite of many payloads, per payload size and level
+ *   buffer_read     OH_Archive_BufferRead of the buffer_write output, per payload size
+ *   codec_write     OH_Archive_Codec_CompressBatch of the same payloads, per payload size, level and thread count
+ * With --path=both the cases run once through the hispeed plugin, when it is installed, and once built-in.
+ *
+ * Usage: archive_benchmark [--cases=writer_add,reader_extract,...] [--corpora=small,large,random,text]
+ *                          [--data=64M] [--levels=1,6,9] [--io=default,mapped] [--block-sizes=64K,1M]
+ *                          [--threads=1,4] [--payload-sizes=4K,64K] [--repeat=3] [--path=both|plugin|builtin]
+ *                          [--root=/data/local/tmp/archive_bench] [--keep=0] [--format=text|json]
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ftw.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include "oh_archive.h"
+#include "oh_archive_plugin.h"
+
+namespace {
+constexpr uint64_t KIB = 1024ULL;
+constexpr uint64_t MIB = 1024ULL * KIB;
+constexpr uint64_t GIB = 1024ULL * MIB;
+constexpr double NS_PER_SEC = 1e9;
+constexpr double US_PER_SEC = 1e6;
+constexpr uint64_t SMALL_FILE_SIZE = 4 * KIB;
+constexpr uint64_t MEDIUM_FILE_SIZE = 1 * MIB;
+constexpr uint32_t LARGE_FILE_COUNT = 4;
+constexpr uint64_t STREAM_UPDATE_SIZE = 256 * KIB;
+// one stripe in this many of the mixed input is incompressible
+constexpr uint32_t MIXED_RANDOM_STRIPE = 4;
+constexpr int DEFAULT_LEVEL = 6;
+constexpr uint32_t MAX_CODEC_THREADS = 16;
+constexpr int NFTW_FD_LIMIT = 16;
+
+const char *const ALL_CASES[] = {
+    "writer_add", "reader_extract", "stream_write", "stream_read", "buffer_write", "buffer_read", "codec_write"
+};
+
+enum class DataKind {
+    TEXT,
+    RANDOM,
+    MIXED,
+};
+
+struct Corpus {
+    std::string name;
+    uint32_t fileCount = 0;
+    uint64_t fileSize = 0;
+    DataKind kind = DataKind::TEXT;
+};
+
+struct BenchOptions {
+    std::vector<std::string> cases { std::begin(ALL_CASES), std::end(ALL_CASES) };
+    std::vector<std::string> corpora = { "small", "large", "random", "text" };
+    uint64_t dataSize = 64 * MIB;
+    std::vector<int32_t> levels = { 1, 6, 9 };
+    std::vector<std::string> ioModes = { "default", "mapped" };
+    std::vector<uint32_t> blockSizes = { 64 * KIB, 1 * MIB };
+    std::vector<uint32_t> threads = { 1, 4 };
+    std::vector<uint64_t> payloadSizes = { 4 * KIB, 64 * KIB };
+    uint32_t repeat = 3;
+    std::string path = "both";
+    std::string rootPath = "/data/local/tmp/archive_bench";
+    bool keep = false;
+    bool json = false;
+};
+
+// Parameters that do not apply to a case stay at -1 and are left out of the report.
+struct CaseResult {
+    std::string name;
+    std::string path;
+    std::string corpus;
+    std::string io;
+    int64_t level = -1;
+    int64_t blockSize = -1;
+    int64_t threads = -1;
+    int64_t payloadSize = -1;
+    int error = OH_ARCHIVE_OK;
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    double wallSec = 0;
+    double cpuSec = 0;
+    int64_t peakRssKb = -1;
+};
+
+struct Sample {
+    double wallSec = 0;
+    double cpuSec = 0;
+    int64_t peakRssKb = -1;
+};
+
+bool ParseSize(const std::string &text, uint64_t &value)
+{
+    char *end = nullptr;
+    unsigned long long parsed = strtoull(text.c_str(), &end, 10);
+    if (end == text.c_str()) {
+        return false;
+    }
+    uint64_t scale = 1;
+    if (*end == 'K' || *end == 'k') {
+        scale = KIB;
+        ++end;
+    } else if (*end == 'M' || *end == 'm') {
+        scale = MIB;
+        ++end;
+    } else if (*end == 'G' || *end == 'g') {
+        scale = GIB;
+        ++end;
+    }
+    if (*end != '\0' || parsed == 0) {
+        return false;
+    }
+    value = static_cast<uint64_t>(parsed) * scale;
+    return true;
+}
+
+template <typename T>
+bool ParseList(const std::string &text, char separator, std::vector<T> &values)
+{
+    values.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, separator)) {
+        uint64_t value = 0;
+        if (!ParseSize(item, value)) {
+            return false;
+        }
+        values.emplace_back(static_cast<T>(value));
+    }
+    return !values.empty();
+}
+
+bool ParseNames(const std::string &text, const std::vector<std::string> &allowed, std::vector<std::string> &values)
+{
+    values.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (std::find(allowed.begin(), allowed.end(), item) == allowed.end()) {
+            return false;
+        }
+        values.emplace_back(item);
+    }
+    return !values.empty();
+}
+
+// Levels may be 0, which ParseSize rejects.
+bool ParseLevels(const std::string &text, std::vector<int32_t> &levels)
+{
+    levels.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        char *end = nullptr;
+        long level = strtol(item.c_str(), &end, 10);
+        if (end == item.c_str() || *end != '\0' || level < 0 || level > 9) { // deflate levels 0-9
+            return false;
+        }
+        levels.emplace_back(static_cast<int32_t>(level));
+    }
+    return !levels.empty();
+}
+
+bool ParseOption(const std::string &arg, BenchOptions &options)
+{
+    size_t eq = arg.find('=');
+    if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+        return false;
+    }
+    std::string key = arg.substr(2, eq - 2);
+    std::string value = arg.substr(eq + 1);
+    if (key == "cases") {
+        return ParseNames(value, { std::begin(ALL_CASES), std::end(ALL_CASES) }, options.cases);
+    } else if (key == "corpora") {
+        return ParseNames(value, { "small", "large", "random", "text" }, options.corpora);
+    } else if (key == "io") {
+        return ParseNames(value, { "default", "mapped" }, options.ioModes);
+    } else if (key == "levels") {
+        return ParseLevels(value, options.levels);
+    } else if (key == "block-sizes") {
+        return ParseList(value, ',', options.blockSizes);
+    } else if (key == "threads") {
+        return ParseList(value, ',', options.threads) &&
+            *std::max_element(options.threads.begin(), options.threads.end()) <= MAX_CODEC_THREADS;
+    } else if (key == "payload-sizes") {
+        return ParseList(value, ',', options.payloadSizes);
+    } else if (key == "data") {
+        return ParseSize(value, options.dataSize);
+    } else if (key == "repeat") {
+        uint64_t repeat = 0;
+        options.repeat = ParseSize(value, repeat) ? static_cast<uint32_t>(repeat) : 0;
+        return options.repeat > 0;
+    } else if (key == "path") {
+        options.path = value;
+        return value == "both" || value == "plugin" || value == "builtin";
+    } else if (key == "root") {
+        options.rootPath = value;
+        return !value.empty();
+    } else if (key == "keep") {
+        options.keep = value == "1";
+        return value == "0" || value == "1";
+    } else if (key == "format") {
+        options.json = value == "json";
+        return value == "json" || value == "text";
+    }
+    return false;
+}
+
+bool HasCase(const BenchOptions &options, const char *name)
+{
+    return std::find(options.cases.begin(), options.cases.end(), name) != options.cases.end();
+}
+
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+double CpuSec()
+{
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+        static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / US_PER_SEC;
+}
+
+// Writing 5 to clear_refs resets VmHWM, so each case reports its own peak instead of the process one.
+void ResetPeakRss()
+{
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+}
+
+int64_t ReadPeakRssKb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return strtoll(line.c_str() + strlen("VmHWM:"), nullptr, 10);
+        }
+    }
+    struct rusage usage {};
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<int64_t>(usage.ru_maxrss) : -1;
+}
+
+// Runs the body --repeat times and keeps the fastest run, setup and checks stay outside the timed body.
+int Measure(uint32_t repeat, const std::function<int()> &body, Sample &best)
+{
+    best = Sample {};
+    for (uint32_t i = 0; i < repeat; ++i) {
+        ResetPeakRss();
+        double cpuBegin = CpuSec();
+        uint64_t begin = NowNs();
+        int ret = body();
+        Sample sample;
+        sample.wallSec = static_cast<double>(NowNs() - begin) / NS_PER_SEC;
+        sample.cpuSec = CpuSec() - cpuBegin;
+        sample.peakRssKb = ReadPeakRssKb();
+        if (ret != OH_ARCHIVE_OK) {
+            return ret;
+        }
+        if (i == 0 || sample.wallSec < best.wallSec) {
+            best = sample;
+        }
+    }
+    return OH_ARCHIVE_OK;
+}
+
+void FillData(std::vector<uint8_t> &data, DataKind kind, uint32_t seed)
+{
+    static const char *const words[] = {
+        "archive", "entry", "deflate", "stream", "buffer", "central", "directory", "header", "block", "level",
+        "file", "path", "record", "value", "index", "offset", "size", "name", "{", "}", ":", ",", "\n"
+    };
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<size_t> pickWord(0, sizeof(words) / sizeof(words[0]) - 1);
+    size_t pos = 0;
+    uint64_t stripe = 0;
+    while (pos < data.size()) {
+        size_t stripeEnd = std::min(data.size(), pos + static_cast<size_t>(MEDIUM_FILE_SIZE));
+        bool incompressible = kind == DataKind::RANDOM ||
+            (kind == DataKind::MIXED && stripe % MIXED_RANDOM_STRIPE == 0);
+        while (pos < stripeEnd) {
+            if (incompressible) {
+                uint32_t value = random();
+                size_t len = std::min(sizeof(value), stripeEnd - pos);
+                memcpy(&data[pos], &value, len);
+                pos += len;
+            } else {
+                const char *word = words[pickWord(random)];
+                size_t len = std::min(strlen(word), stripeEnd - pos);
+                memcpy(&data[pos], word, len);
+                pos += len;
+                if (pos < stripeEnd) {
+                    data[pos++] = ' ';
+                }
+            }
+        }
+        ++stripe;
+    }
+}
+
+Corpus MakeCorpus(const std::string &name, uint64_t dataSize)
+{
+    Corpus corpus;
+    corpus.name = name;
+    if (name == "small") {
+        corpus.fileSize = SMALL_FILE_SIZE;
+        corpus.kind = DataKind::TEXT;
+    } else if (name == "large") {
+        corpus.fileSize = std::max<uint64_t>(dataSize / LARGE_FILE_COUNT, 1);
+        corpus.kind = DataKind::MIXED;
+    } else {
+        corpus.fileSize = MEDIUM_FILE_SIZE;
+        corpus.kind = name == "random" ? DataKind::RANDOM : DataKind::TEXT;
+    }
+    corpus.fileCount = static_cast<uint32_t>(std::max<uint64_t>(dataSize / corpus.fileSize, 1));
+    return corpus;
+}
+
+int WriteCorpus(const Corpus &corpus, const std::string &dir)
+{
+    if (mkdir(dir.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+        return errno;
+    }
+    std::vector<uint8_t> data(corpus.fileSize);
+    for (uint32_t i = 0; i < corpus.fileCount; ++i) {
+        FillData(data, corpus.kind, i + 1);
+        std::string path = dir + "/file" + std::to_string(i) + ".dat";
+        FILE *file = fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            return errno;
+        }
+        size_t written = fwrite(data.data(), 1, data.size(), file);
+        int closeRet = fclose(file);
+        if (written != data.size() || closeRet != 0) {
+            return EIO;
+        }
+    }
+    return 0;
+}
+
+int RemoveEntry(const char *path, const struct stat *, int, struct FTW *)
+{
+    return remove(path);
+}
+
+void RemoveTree(const std::string &path)
+{
+    (void)nftw(path.c_str(), RemoveEntry, NFTW_FD_LIMIT, FTW_DEPTH | FTW_PHYS);
+}
+
+uint64_t FileSize(const std::string &path)
+{
+    struct stat statBuf {};
+    return stat(path.c_str(), &statBuf) == 0 ? static_cast<uint64_t>(statBuf.st_size) : 0;
+}
+
+OH_Archive_FileIoOptions IoOptions(const std::string &io)
+{
+    OH_Archive_FileIoOptions options {};
+    options.ioMode = io == "mapped" ? OH_ARCHIVE_FILE_IO_MAPPED : OH_ARCHIVE_FILE_IO_DEFAULT;
+    options.bufferSize = 0;
+    return options;
+}
+
+int WriteArchive(const std::string &dir, const std::string &outfile, int32_t level, const std::string &io)
+{
+    OH_Archive_FileIoOptions ioOptions = IoOptions(io);
+    OH_Archive_Writer_Ctx ctx = OH_Archive_Writer_OpenFileWithOptions(outfile.c_str(), OH_ARCHIVE_OPEN_MODE_CREATE,
+        OH_ARCHIVE_FMT_ZIP, &ioOptions);
+    if (ctx == nullptr) {
+        return OH_ARCHIVE_OPEN_ERROR;
+    }
+    const char *infile[] = { dir.c_str() };
+    int ret = OH_Archive_Writer_SetCompressMethod(ctx, OH_ARCHIVE_COMPRESS_DEFLATE, level);
+    if (ret == OH_ARCHIVE_OK) {
+        ret = OH_Archive_Writer_Add(ctx, infile, 1);
+    }
+    int closeRet = OH_Archive_Writer_Close(ctx);
+    return ret != OH_ARCHIVE_OK ? ret : closeRet;
+}
+
+int ExtractArchive(const std::string &archive, const std::string &outDir, const std::string &io)
+{
+    RemoveTree(outDir);
+    if (mkdir(outDir.c_str(), S_IRWXU) != 0) {
+        return OH_ARCHIVE_OPEN_ERROR;
+    }
+    OH_Archive_FileIoOptions ioOptions = IoOptions(io);
+    OH_Archive_Reader_Ctx ctx = OH_Archive_Reader_OpenFileWithOptions(archive.c_str(), &ioOptions);
+    if (ctx == nullptr) {
+        return OH_ARCHIVE_OPEN_ERROR;
+    }
+    int ret = OH_Archive_Reader_ExtractAllFile(ctx, outDir.c_str());
+    int closeRet = OH_Archive_Reader_Close(ctx);
+    return ret != OH_ARCHIVE_OK ? ret : closeRet;
+}
+
+class Bench {
+public:
+    Bench(const BenchOptions &options, const std::string &path) : options_(options), path_(path) {}
+
+    void RunCorpus(const Corpus &corpus, const std::string &dir)
+    {
+        uint64_t bytesIn = static_cast<uint64_t>(corpus.fileCount) * corpus.fileSize;
+        for (const auto &io : options_.ioModes) {
+            std::string archive = options_.rootPath + "/" + corpus.name + "_" + io + ".zip";
+            if (HasCase(options_, "writer_add")) {
+                for (int32_t level : options_.levels) {
+                    CaseResult result = NewResult("writer_add");
+                    result.corpus = corpus.name;
+                    result.io = io;
+                    result.level = level;
+                    Finish(result, bytesIn, [&]() { return WriteArchive(dir, archive, level, io); });
+                    result.bytesOut = FileSize(archive);
+                    results_.emplace_back(result);
+                }
+            }
+            if (!HasCase(options_, "reader_extract")) {
+                continue;
+            }
+            CaseResult result = NewResult("reader_extract");
+            result.corpus = corpus.name;
+            result.io = io;
+            result.error = WriteArchive(dir, archive, DEFAULT_LEVEL, io);
+            if (result.error == OH_ARCHIVE_OK) {
+                std::string outDir = options_.rootPath + "/extract";
+                Finish(result, FileSize(archive), [&]() { return ExtractArchive(archive, outDir, io); });
+                result.bytesOut = bytesIn;
+                RemoveTree(outDir);
+            }
+            results_.emplace_back(result);
+        }
+    }
+
+    void RunStreams(const std::vector<uint8_t> &input)
+    {
+        for (uint32_t blockSize : options_.blockSizes) {
+            std::vector<uint8_t> compressed;
+            for (uint32_t threads : options_.threads) {
+                for (int32_t level : options_.levels) {
+                    std::vector<uint8_t> output;
+                    if (HasCase(options_, "stream_write")) {
+                        CaseResult result = NewResult("stream_write");
+                        result.blockSize = blockSize;
+                        result.threads = threads;
+                        result.level = level;
+                        Finish(result, input.size(), [&]() {
+                            return StreamWrite(input, blockSize, threads, level, output);
+                        });
+                        result.bytesOut = output.size();
+                        results_.emplace_back(result);
+                    }
+                    if (compressed.empty() && level == DEFAULT_LEVEL) {
+                        compressed.swap(output);
+                    }
+                }
+            }
+            if (HasCase(options_, "stream_read")) {
+                CaseResult result = NewResult("stream_read");
+                result.blockSize = blockSize;
+                if (compressed.empty()) {
+                    result.error = StreamWrite(input, blockSize, 1, DEFAULT_LEVEL, compressed);
+                }
+                uint64_t bytesOut = 0;
+                if (result.error == OH_ARCHIVE_OK) {
+                    Finish(result, compressed.size(), [&]() { return StreamRead(compressed, blockSize, bytesOut); });
+                }
+                result.bytesOut = bytesOut;
+                results_.emplace_back(result);
+            }
+        }
+    }
+
+    void RunBuffers(const std::vector<uint8_t> &input)
+    {
+        for (uint64_t payloadSize : options_.payloadSizes) {
+            uint64_t count = std::max<uint64_t>(input.size() / payloadSize, 1);
+            payloadSize = std::min<uint64_t>(payloadSize, input.size());
+            uint64_t bound = OH_Archive_BufferWriteCompressBound(OH_ARCHIVE_COMPRESS_DEFLATE, payloadSize);
+            std::vector<uint8_t> compressed(count * bound);
+            std::vector<uint64_t> compressedSizes(count);
+            for (int32_t level : options_.levels) {
+                if (HasCase(options_, "buffer_write")) {
+                    CaseResult result = NewResult("buffer_write");
+                    result.payloadSize = static_cast<int64_t>(payloadSize);
+                    result.level = level;
+                    Finish(result, count * payloadSize, [&]() {
+                        return BufferWrite(input, payloadSize, level, bound, compressed, compressedSizes);
+                    });
+                    result.bytesOut = Sum(compressedSizes);
+                    results_.emplace_back(result);
+                }
+                if (HasCase(options_, "codec_write")) {
+                    for (uint32_t threads : options_.threads) {
+                        CaseResult result = NewResult("codec_write");
+                        result.payloadSize = static_cast<int64_t>(payloadSize);
+                        result.level = level;
+                        result.threads = threads;
+                        std::vector<uint64_t> codecSizes(count);
+                        Finish(result, count * payloadSize, [&]() {
+                            return CodecWrite(input, payloadSize, level, threads, bound, compressed, codecSizes);
+                        });
+                        result.bytesOut = Sum(codecSizes);
+                        results_.emplace_back(result);
+                    }
+                }
+            }
+            if (HasCase(options_, "buffer_read")) {
+                CaseResult result = NewResult("buffer_read");
+                result.payloadSize = static_cast<int64_t>(payloadSize);
+                result.error = BufferWrite(input, payloadSize, DEFAULT_LEVEL, bound, compressed, compressedSizes);
+                if (result.error == OH_ARCHIVE_OK) {
+                    std::vector<uint8_t> plain(payloadSize);
+                    Finish(result, Sum(compressedSizes), [&]() {
+                        return BufferRead(compressed, compressedSizes, bound, plain);
+                    });
+                    result.bytesOut = count * payloadSize;
+                }
+                results_.emplace_back(result);
+            }
+        }
+    }
+
+    std::vector<CaseResult> &Results()
+    {
+        return results_;
+    }
+
+private:
+    CaseResult NewResult(const char *name) const
+    {
+        CaseResult result;
+        result.name = name;
+        result.path = path_;
+        return result;
+    }
+
+    void Finish(CaseResult &result, uint64_t bytesIn, const std::function<int()> &body) const
+    {
+        Sample sample;
+        result.error = Measure(options_.repeat, body, sample);
+        result.bytesIn = bytesIn;
+        result.wallSec = sample.wallSec;
+        result.cpuSec = sample.cpuSec;
+        result.peakRssKb = sample.peakRssKb;
+    }
+
+    static uint64_t Sum(const std::vector<uint64_t> &values)
+    {
+        uint64_t sum = 0;
+        for (uint64_t value : values) {
+            sum += value;
+        }
+        return sum;
+    }
+
+    static uint64_t AppendOutput(const void *data, uint64_t size, void *userData)
+    {
+        auto *output = static_cast<std::vector<uint8_t> *>(userData);
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        output->insert(output->end(), bytes, bytes + size);
+        return size;
+    }
+
+    static uint64_t CountOutput(const void *, uint64_t size, void *userData)
+    {
+        *static_cast<uint64_t *>(userData) += size;
+        return size;
+    }
+
+    static int StreamWrite(const std::vector<uint8_t> &input, uint32_t blockSize, uint32_t threads, int32_t level,
+        std::vector<uint8_t> &output)
+    {
+        output.clear();
+        OH_Archive_Stream_Config config {};
+        config.blockSize = blockSize;
+        config.threadNum = static_cast<int32_t>(threads);
+        config.checksum = OH_ARCHIVE_CRC32;
+        config.method = OH_ARCHIVE_COMPRESS_DEFLATE;
+        OH_Archive_StreamWrite_Ctx ctx = OH_Archive_StreamWrite_Create(config);
+        if (ctx == nullptr) {
+            return OH_ARCHIVE_PARAM_ERROR;
+        }
+        int ret = OH_Archive_StreamWrite_SetCompressLevel(ctx, level);
+        if (ret == OH_ARCHIVE_OK) {
+            ret = OH_Archive_StreamWrite_Start(ctx, AppendOutput, &output);
+        }
+        for (uint64_t pos = 0; ret == OH_ARCHIVE_OK && pos < input.size(); pos += STREAM_UPDATE_SIZE) {
+            uint64_t len = std::min<uint64_t>(STREAM_UPDATE_SIZE, input.size() - pos);
+            ret = OH_Archive_StreamWrite_Update(ctx, input.data() + pos, len);
+        }
+        OH_Archive_StreamInfo info {};
+        if (ret == OH_ARCHIVE_OK) {
+            ret = OH_Archive_StreamWrite_End(ctx, &info);
+        }
+        OH_Archive_StreamWrite_Destroy(ctx);
+        return ret;
+    }
+
+    static int StreamRead(const std::vector<uint8_t> &input, uint32_t blockSize, uint64_t &bytesOut)
+    {
+        bytesOut = 0;
+        OH_Archive_Stream_Config config {};
+        config.blockSize = blockSize;
+        config.threadNum = 1;
+        config.checksum = OH_ARCHIVE_CRC32;
+        config.method = OH_ARCHIVE_COMPRESS_DEFLATE;
+        OH_Archive_StreamRead_Ctx ctx = OH_Archive_StreamRead_Create(config);
+        if (ctx == nullptr) {
+            return OH_ARCHIVE_PARAM_ERROR;
+        }
+        int ret = OH_Archive_StreamRead_Start(ctx, CountOutput, &bytesOut);
+        for (uint64_t pos = 0; ret == OH_ARCHIVE_OK && pos < input.size(); pos += STREAM_UPDATE_SIZE) {
+            uint64_t len = std::min<uint64_t>(STREAM_UPDATE_SIZE, input.size() - pos);
+            ret = OH_Archive_StreamRead_Update(ctx, input.data() + pos, len);
+        }
+        OH_Archive_StreamInfo info {};
+        if (ret == OH_ARCHIVE_OK) {
+            ret = OH_Archive_StreamRead_End(ctx, &info);
+        }
+        OH_Archive_StreamRead_Destroy(ctx);
+        return ret;
+    }
+
+    static int BufferWrite(const std::vector<uint8_t> &input, uint64_t payloadSize, int32_t level, uint64_t bound,
+        std::vector<uint8_t> &compressed, std::vector<uint64_t> &sizes)
+    {
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            sizes[i] = bound;
+            int ret = OH_Archive_BufferWrite(compressed.data() + i * bound, &sizes[i], input.data() + i * payloadSize,
+                payloadSize, OH_ARCHIVE_COMPRESS_DEFLATE, level);
+            if (ret != OH_ARCHIVE_OK) {
+                return ret;
+            }
+        }
+        return OH_ARCHIVE_OK;
+    }
+
+    static int BufferRead(const std::vector<uint8_t> &compressed, const std::vector<uint64_t> &sizes, uint64_t bound,
+        std::vector<uint8_t> &plain)
+    {
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            uint64_t plainSize = plain.size();
+            int ret = OH_Archive_BufferRead(plain.data(), &plainSize, compressed.data() + i * bound, sizes[i],
+                OH_ARCHIVE_COMPRESS_DEFLATE);
+            if (ret != OH_ARCHIVE_OK) {
+                return ret;
+            }
+        }
+        return OH_ARCHIVE_OK;
+    }
+
+    static int CodecWrite(const std::vector<uint8_t> &input, uint64_t payloadSize, int32_t level, uint32_t threads,
+        uint64_t bound, std::vector<uint8_t> &compressed, std::vector<uint64_t> &sizes)
+    {
+        OH_Archive_Codec_Ctx ctx = OH_Archive_Codec_Create(OH_ARCHIVE_COMPRESS_DEFLATE, level);
+        if (ctx == nullptr) {
+            return OH_ARCHIVE_PARAM_ERROR;
+        }
+        std::vector<OH_Archive_Codec_Buffer> buffers(sizes.size());
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            buffers[i] = { input.data() + i * payloadSize, payloadSize, compressed.data() + i * bound, bound,
+                OH_ARCHIVE_OK };
+        }
+        int ret = OH_Archive_Codec_CompressBatch(ctx, buffers.data(), buffers.size(), threads);
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            sizes[i] = buffers[i].dstSize;
+        }
+        OH_Archive_Codec_Destroy(ctx);
+        return ret;
+    }
+
+    const BenchOptions &options_;
+    std::string path_;
+    std::vector<CaseResult> results_;
+};
+
+double MibPerSec(const CaseResult &result)
+{
+    return result.wallSec > 0 ? static_cast<double>(result.bytesIn) / MIB / result.wallSec : 0;
+}
+
+std::string Params(const CaseResult &result)
+{
+    std::string params;
+    auto add = [&params](const char *key, const std::string &value) {
+        params += (params.empty() ? "" : " ") + std::string(key) + "=" + value;
+    };
+    if (!result.corpus.empty()) {
+        add("corpus", result.corpus);
+    }
+    if (!result.io.empty()) {
+        add("io", result.io);
+    }
+    if (result.blockSize >= 0) {
+        add("block", std::to_string(result.blockSize));
+    }
+    if (result.payloadSize >= 0) {
+        add("payload", std::to_string(result.payloadSize));
+    }
+    if (result.threads >= 0) {
+        add("threads", std::to_string(result.threads));
+    }
+    if (result.level >= 0) {
+        add("level", std::to_string(result.level));
+    }
+    return params;
+}
+
+void PrintText(const BenchOptions &options, const std::vector<CaseResult> &results, bool pluginAvailable)
+{
+    printf("archive benchmark: plugin=%d data=%" PRIu64 " repeat=%u\n", pluginAvailable, options.dataSize,
+        options.repeat);
+    printf("%-15s %-8s %-44s %6s %9s %9s %9s %7s %11s\n", "case", "path", "params", "error", "MiB/s", "wall(s)",
+        "cpu(s)", "ratio", "peak_rss_kb");
+    for (const auto &result : results) {
+        double ratio = result.bytesIn > 0 ? static_cast<double>(result.bytesOut) / result.bytesIn : 0;
+        printf("%-15s %-8s %-44s %6d %9.2f %9.3f %9.3f %7.3f %11" PRId64 "\n", result.name.c_str(),
+            result.path.c_str(), Params(result).c_str(), result.error, MibPerSec(result), result.wallSec,
+            result.cpuSec, ratio, result.peakRssKb);
+    }
+}
+
+void PrintJson(const BenchOptions &options, const std::vector<CaseResult> &results, bool pluginAvailable)
+{
+    printf("{\"benchmark\":\"archive\",\"plugin\":%s,\"data\":%" PRIu64 ",\"repeat\":%u,\"runs\":[",
+        pluginAvailable ? "true" : "false", options.dataSize, options.repeat);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const CaseResult &result = results[i];
+        printf("%s{\"case\":\"%s\",\"path\":\"%s\",\"corpus\":\"%s\",\"io\":\"%s\",\"level\":%" PRId64
+            ",\"block_size\":%" PRId64 ",\"threads\":%" PRId64 ",\"payload_size\":%" PRId64 ",\"error\":%d"
+            ",\"bytes_in\":%" PRIu64 ",\"bytes_out\":%" PRIu64 ",\"wall_sec\":%.6f,\"cpu_sec\":%.6f"
+            ",\"mib_per_sec\":%.3f,\"peak_rss_kb\":%" PRId64 "}", i == 0 ? "" : ",", result.name.c_str(),
+            result.path.c_str(), result.corpus.c_str(), result.io.c_str(), result.level, result.blockSize,
+            result.threads, result.payloadSize, result.error, result.bytesIn, result.bytesOut, result.wallSec,
+            result.cpuSec, MibPerSec(result), result.peakRssKb);
+    }
+    printf("]}\n");
+}
+
+void RunAll(const BenchOptions &options, const std::vector<Corpus> &corpora, const std::vector<uint8_t> &input,
+    const std::string &path, std::vector<CaseResult> &results)
+{
+    Bench bench(options, path);
+    for (const auto &corpus : corpora) {
+        bench.RunCorpus(corpus, options.rootPath + "/" + corpus.name);
+    }
+    bench.RunStreams(input);
+    bench.RunBuffers(input);
+    results.insert(results.end(), bench.Results().begin(), bench.Results().end());
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (!ParseOption(argv[i], options)) {
+            fprintf(stderr, "invalid option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (mkdir(options.rootPath.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+        fprintf(stderr, "cannot create %s, errno: %d\n", options.rootPath.c_str(), errno);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Corpus> corpora;
+    if (HasCase(options, "writer_add") || HasCase(options, "reader_extract")) {
+        for (const auto &name : options.corpora) {
+            corpora.emplace_back(MakeCorpus(name, options.dataSize));
+            int ret = WriteCorpus(corpora.back(), options.rootPath + "/" + name);
+            if (ret != 0) {
+                fprintf(stderr, "cannot write corpus %s, errno: %d\n", name.c_str(), ret);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    std::vector<uint8_t> input(options.dataSize);
+    FillData(input, DataKind::MIXED, 0);
+
+    // the plugin is loaded on first use, releasing it sends every later call down the built-in path
+    bool pluginAvailable = GetHispeedArchivePluginHandle() != nullptr;
+    std::vector<CaseResult> results;
+    if (pluginAvailable && options.path != "builtin") {
+        RunAll(options, corpora, input, "plugin", results);
+    }
+    ReleaseHispeedArchivePluginHandle();
+    if (options.path != "plugin") {
+        RunAll(options, corpora, input, "builtin", results);
+    }
+
+    if (options.json) {
+        PrintJson(options, results, pluginAvailable);
+    } else {
+        PrintText(options, results, pluginAvailable);
+    }
+    if (!options.keep) {
+        RemoveTree(options.rootPath);
+    }
+    bool failed = results.empty() || std::any_of(results.begin(), results.end(),
+        [](const CaseResult &result) { return result.error != OH_ARCHIVE_OK; });
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
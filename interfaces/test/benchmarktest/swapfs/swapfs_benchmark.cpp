@@ -0,0 +1,566 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Load harness for SwapfsManager. Every (threads, size) combination runs against a fresh manager:
+ * each worker prefills its own keys and then issues a weighted SwapOut/SwapIn/RemoveData mix.
+ *
+ * Usage: swapfs_benchmark [--threads=1,4] [--sizes=4K,1M] [--ops=2000] [--mix=40:50:10]
+ *                         [--prefill=16] [--dio=0] [--space-check-ms=1000] [--limit=bytes]
+ *                         [--root=/data/local/tmp/swapfs_bench] [--format=text|json]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+
+#include "accesstoken_kit.h"
+#include "swapfs_manager.h"
+#include "swapfs_proxy_control.h"
+#include "swapfs_uring_read_engine.h"
+#include "tokenid_kit.h"
+
+namespace {
+using namespace OHOS::FileManagement::Swapfs;
+
+constexpr uint64_t KIB = 1024ULL;
+constexpr uint64_t MIB = 1024ULL * KIB;
+constexpr uint64_t GIB = 1024ULL * MIB;
+constexpr uint64_t NS_PER_US = 1000ULL;
+constexpr double NS_PER_SEC = 1e9;
+constexpr size_t OP_TYPE_COUNT = 3;
+constexpr const char *OP_NAMES[OP_TYPE_COUNT] = { "swap_out", "swap_in", "remove" };
+
+std::atomic<uint64_t> g_fsyncCount { 0 };
+
+enum OpType : size_t {
+    OP_SWAP_OUT = 0,
+    OP_SWAP_IN = 1,
+    OP_REMOVE = 2,
+};
+
+struct BenchOptions {
+    std::vector<uint32_t> threads = { 1, 4 };
+    std::vector<uint64_t> sizes = { 4 * KIB, 1 * MIB };
+    uint32_t opsPerThread = 2000;
+    uint32_t mix[OP_TYPE_COUNT] = { 40, 50, 10 };
+    uint32_t prefillPerThread = 16;
+    bool useDirectIo = false;
+    uint32_t spaceCheckIntervalMs = DEFAULT_SPACE_CHECK_INTERVAL_MS;
+    uint64_t spaceLimitBytes = 4 * GIB;
+    std::string rootPath = "/data/local/tmp/swapfs_bench";
+    bool json = false;
+};
+
+struct OpSamples {
+    std::vector<uint64_t> latencyNs;
+    uint64_t errors = 0;
+    uint64_t bytes = 0;
+};
+
+struct WorkerResult {
+    OpSamples ops[OP_TYPE_COUNT];
+};
+
+struct OpSummary {
+    uint64_t count = 0;
+    uint64_t errors = 0;
+    uint64_t bytes = 0;
+    double opsPerSec = 0;
+    double mibPerSec = 0;
+    double p50Us = 0;
+    double p99Us = 0;
+    double p999Us = 0;
+};
+
+struct RunResult {
+    uint32_t threads = 0;
+    uint64_t size = 0;
+    double wallSec = 0;
+    OpSummary ops[OP_TYPE_COUNT];
+    uint64_t fsyncs = 0;
+    int64_t deviceWriteBytes = -1;
+    uint64_t accumulatedWriteBytes = 0;
+    int initError = SWAPFS_E_OK;
+};
+
+// Forwards to the production provider but lets the harness pick the free-space refresh interval.
+class BenchControlProvider final : public SwapControlProvider {
+public:
+    explicit BenchControlProvider(uint32_t intervalMs) : intervalMs_(intervalMs) {}
+    int Init(uint64_t spaceLimitBytes, uint32_t) override
+    {
+        return inner_.Init(spaceLimitBytes, intervalMs_);
+    }
+    int ReserveSwapOut(uint64_t occupiedSize) override
+    {
+        return inner_.ReserveSwapOut(occupiedSize);
+    }
+    void CancelReservedSwapOut(uint64_t occupiedSize) override
+    {
+        inner_.CancelReservedSwapOut(occupiedSize);
+    }
+    void OnSwapOutCommitted(uint64_t dataSize, uint64_t occupiedSize) override
+    {
+        inner_.OnSwapOutCommitted(dataSize, occupiedSize);
+    }
+    void OnEntryRemoved(uint64_t dataSize, uint64_t occupiedSize) override
+    {
+        inner_.OnEntryRemoved(dataSize, occupiedSize);
+    }
+    void OnAllEntriesRemoved() override
+    {
+        inner_.OnAllEntriesRemoved();
+    }
+    void FillStats(OH_SwapfsStats &stats) override
+    {
+        inner_.FillStats(stats);
+    }
+
+private:
+    ProxySwapControlProvider inner_;
+    uint32_t intervalMs_;
+};
+
+bool ParseSize(const std::string &text, uint64_t &value)
+{
+    char *end = nullptr;
+    unsigned long long parsed = strtoull(text.c_str(), &end, 10);
+    if (end == text.c_str()) {
+        return false;
+    }
+    uint64_t scale = 1;
+    if (*end == 'K' || *end == 'k') {
+        scale = KIB;
+        ++end;
+    } else if (*end == 'M' || *end == 'm') {
+        scale = MIB;
+        ++end;
+    } else if (*end == 'G' || *end == 'g') {
+        scale = GIB;
+        ++end;
+    }
+    if (*end != '\0' || parsed == 0) {
+        return false;
+    }
+    value = static_cast<uint64_t>(parsed) * scale;
+    return true;
+}
+
+template <typename T>
+bool ParseList(const std::string &text, char separator, std::vector<T> &values)
+{
+    values.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, separator)) {
+        uint64_t value = 0;
+        if (!ParseSize(item, value)) {
+            return false;
+        }
+        values.emplace_back(static_cast<T>(value));
+    }
+    return !values.empty();
+}
+
+bool ParseMix(const std::string &text, uint32_t (&mix)[OP_TYPE_COUNT])
+{
+    unsigned int out = 0;
+    unsigned int in = 0;
+    unsigned int remove = 0;
+    if (sscanf(text.c_str(), "%u:%u:%u", &out, &in, &remove) != static_cast<int>(OP_TYPE_COUNT) ||
+        out + in + remove == 0) {
+        return false;
+    }
+    mix[OP_SWAP_OUT] = out;
+    mix[OP_SWAP_IN] = in;
+    mix[OP_REMOVE] = remove;
+    return true;
+}
+
+bool ParseOption(const std::string &arg, BenchOptions &options)
+{
+    size_t eq = arg.find('=');
+    if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+        return false;
+    }
+    std::string key = arg.substr(2, eq - 2);
+    std::string value = arg.substr(eq + 1);
+    uint64_t number = 0;
+    if (key == "threads") {
+        return ParseList(value, ',', options.threads);
+    } else if (key == "sizes") {
+        return ParseList(value, ',', options.sizes);
+    } else if (key == "mix") {
+        return ParseMix(value, options.mix);
+    } else if (key == "root") {
+        options.rootPath = value;
+        return !value.empty();
+    } else if (key == "format") {
+        options.json = value == "json";
+        return value == "json" || value == "text";
+    } else if (key == "dio") {
+        options.useDirectIo = value == "1";
+        return value == "0" || value == "1";
+    }
+    bool zeroAllowed = key == "prefill" || key == "space-check-ms";
+    if (!(zeroAllowed && value == "0") && !ParseSize(value, number)) {
+        return false;
+    }
+    if (key == "ops") {
+        options.opsPerThread = static_cast<uint32_t>(number);
+    } else if (key == "prefill") {
+        options.prefillPerThread = static_cast<uint32_t>(number);
+    } else if (key == "space-check-ms") {
+        options.spaceCheckIntervalMs = static_cast<uint32_t>(number);
+    } else if (key == "limit") {
+        options.spaceLimitBytes = number;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Reads write_bytes from /proc/self/io: bytes this process caused to reach the block layer.
+int64_t ReadDeviceWriteBytes()
+{
+    std::ifstream io("/proc/self/io");
+    std::string key;
+    int64_t value = 0;
+    while (io >> key >> value) {
+        if (key == "write_bytes:") {
+            return value;
+        }
+    }
+    return -1;
+}
+
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void *AllocBuffer(uint64_t size)
+{
+    void *buffer = nullptr;
+    uint64_t alignedSize = (size + DIO_ALIGNMENT - 1) / DIO_ALIGNMENT * DIO_ALIGNMENT;
+    if (posix_memalign(&buffer, DIO_ALIGNMENT, alignedSize) != 0) {
+        return nullptr;
+    }
+    memset(buffer, 0x5A, alignedSize);
+    return buffer;
+}
+
+class Worker {
+public:
+    Worker(SwapfsManager &manager, const BenchOptions &options, uint64_t size, uint32_t index)
+        : manager_(manager), options_(options), size_(size), random_(index + 1)
+    {}
+
+    int Prepare()
+    {
+        uint64_t alignedSize = (size_ + DIO_ALIGNMENT - 1) / DIO_ALIGNMENT * DIO_ALIGNMENT;
+        outBuffer_.reset(AllocBuffer(alignedSize));
+        inBuffer_.reset(AllocBuffer(alignedSize));
+        if (outBuffer_ == nullptr || inBuffer_ == nullptr) {
+            return SWAPFS_E_NOMEM;
+        }
+        // DIO requests must cover whole blocks, so round the payload up like a real DIO caller.
+        ioSize_ = options_.useDirectIo ? alignedSize : size_;
+        for (uint32_t i = 0; i < options_.prefillPerThread; ++i) {
+            uint64_t keyId = 0;
+            OH_SwapfsSwapOutRequest request { outBuffer_.get(), ioSize_ };
+            int ret = manager_.SwapOut(&request, &keyId);
+            if (ret != SWAPFS_E_OK) {
+                return ret;
+            }
+            keys_.emplace_back(keyId);
+        }
+        return SWAPFS_E_OK;
+    }
+
+    void Run(WorkerResult &result)
+    {
+        uint32_t total = options_.mix[OP_SWAP_OUT] + options_.mix[OP_SWAP_IN] + options_.mix[OP_REMOVE];
+        std::uniform_int_distribution<uint32_t> pick(0, total - 1);
+        for (auto &op : result.ops) {
+            op.latencyNs.reserve(options_.opsPerThread);
+        }
+        for (uint32_t i = 0; i < options_.opsPerThread; ++i) {
+            uint32_t roll = pick(random_);
+            OpType type = roll < options_.mix[OP_SWAP_OUT] ? OP_SWAP_OUT :
+                (roll < options_.mix[OP_SWAP_OUT] + options_.mix[OP_SWAP_IN] ? OP_SWAP_IN : OP_REMOVE);
+            if (keys_.empty()) {
+                type = OP_SWAP_OUT;
+            }
+            OpSamples &samples = result.ops[type];
+            uint64_t begin = NowNs();
+            int ret = Execute(type);
+            samples.latencyNs.emplace_back(NowNs() - begin);
+            if (ret != SWAPFS_E_OK) {
+                ++samples.errors;
+            } else if (type != OP_REMOVE) {
+                samples.bytes += ioSize_;
+            }
+        }
+    }
+
+private:
+    struct FreeDeleter {
+        void operator()(void *buffer) const
+        {
+            free(buffer);
+        }
+    };
+
+    int Execute(OpType type)
+    {
+        if (type == OP_SWAP_OUT) {
+            uint64_t keyId = 0;
+            OH_SwapfsSwapOutRequest request { outBuffer_.get(), ioSize_ };
+            int ret = manager_.SwapOut(&request, &keyId);
+            if (ret == SWAPFS_E_OK) {
+                keys_.emplace_back(keyId);
+            }
+            return ret;
+        }
+        std::uniform_int_distribution<size_t> pickKey(0, keys_.size() - 1);
+        size_t index = pickKey(random_);
+        if (type == OP_SWAP_IN) {
+            OH_SwapfsSwapInRequest request { keys_[index], inBuffer_.get(), ioSize_ };
+            return manager_.SwapIn(&request, nullptr);
+        }
+        int ret = manager_.RemoveData(keys_[index]);
+        keys_[index] = keys_.back();
+        keys_.pop_back();
+        return ret;
+    }
+
+    SwapfsManager &manager_;
+    const BenchOptions &options_;
+    uint64_t size_;
+    uint64_t ioSize_ = 0;
+    std::mt19937 random_;
+    std::unique_ptr<void, FreeDeleter> outBuffer_;
+    std::unique_ptr<void, FreeDeleter> inBuffer_;
+    std::vector<uint64_t> keys_;
+};
+
+double PercentileUs(const std::vector<uint64_t> &sorted, double percentile)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[rank]) / NS_PER_US;
+}
+
+OpSummary Summarize(std::vector<WorkerResult> &results, size_t type, double wallSec)
+{
+    OpSummary summary;
+    std::vector<uint64_t> merged;
+    for (auto &result : results) {
+        OpSamples &samples = result.ops[type];
+        merged.insert(merged.end(), samples.latencyNs.begin(), samples.latencyNs.end());
+        summary.errors += samples.errors;
+        summary.bytes += samples.bytes;
+    }
+    std::sort(merged.begin(), merged.end());
+    summary.count = merged.size();
+    if (wallSec > 0) {
+        summary.opsPerSec = static_cast<double>(summary.count) / wallSec;
+        summary.mibPerSec = static_cast<double>(summary.bytes) / MIB / wallSec;
+    }
+    summary.p50Us = PercentileUs(merged, 0.50);
+    summary.p99Us = PercentileUs(merged, 0.99);
+    summary.p999Us = PercentileUs(merged, 0.999);
+    return summary;
+}
+
+RunResult RunOnce(const BenchOptions &options, uint32_t threads, uint64_t size)
+{
+    RunResult run;
+    run.threads = threads;
+    run.size = size;
+    SwapfsManager manager(std::make_unique<BenchControlProvider>(options.spaceCheckIntervalMs));
+    OH_SwapfsConfig config {};
+    config.swapRootPath = options.rootPath.c_str();
+    config.spaceLimitBytes = options.spaceLimitBytes;
+    config.useDirectIo = options.useDirectIo;
+    run.initError = manager.Init(&config);
+    if (run.initError != SWAPFS_E_OK) {
+        return run;
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (uint32_t i = 0; i < threads; ++i) {
+        workers.emplace_back(std::make_unique<Worker>(manager, options, size, i));
+        run.initError = workers.back()->Prepare();
+        if (run.initError != SWAPFS_E_OK) {
+            (void)manager.Destroy();
+            return run;
+        }
+    }
+
+    std::vector<WorkerResult> results(threads);
+    std::vector<std::thread> pool;
+    uint64_t fsyncBefore = g_fsyncCount.load();
+    int64_t deviceBefore = ReadDeviceWriteBytes();
+    OH_SwapfsStats statsBefore {};
+    (void)manager.GetStats(&statsBefore);
+    uint64_t begin = NowNs();
+    for (uint32_t i = 0; i < threads; ++i) {
+        pool.emplace_back([&workers, &results, i] { workers[i]->Run(results[i]); });
+    }
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    run.wallSec = static_cast<double>(NowNs() - begin) / NS_PER_SEC;
+    run.fsyncs = g_fsyncCount.load() - fsyncBefore;
+    int64_t deviceAfter = ReadDeviceWriteBytes();
+    run.deviceWriteBytes = deviceBefore < 0 || deviceAfter < 0 ? -1 : deviceAfter - deviceBefore;
+    OH_SwapfsStats statsAfter {};
+    (void)manager.GetStats(&statsAfter);
+    run.accumulatedWriteBytes = statsAfter.accumulatedWriteBytes - statsBefore.accumulatedWriteBytes;
+    for (size_t type = 0; type < OP_TYPE_COUNT; ++type) {
+        run.ops[type] = Summarize(results, type, run.wallSec);
+    }
+    (void)manager.Destroy();
+    return run;
+}
+
+void PrintText(const BenchOptions &options, const std::vector<RunResult> &runs, bool uringAvailable)
+{
+    printf("swapfs benchmark: dio=%d uring=%d space_check_ms=%u ops/thread=%u mix=%u:%u:%u\n",
+        options.useDirectIo, uringAvailable, options.spaceCheckIntervalMs, options.opsPerThread,
+        options.mix[OP_SWAP_OUT], options.mix[OP_SWAP_IN], options.mix[OP_REMOVE]);
+    for (const auto &run : runs) {
+        printf("\nthreads=%u size=%" PRIu64 " wall=%.3fs fsyncs=%" PRIu64 " accumulated_write=%" PRIu64
+            " device_write=%" PRId64 "\n", run.threads, run.size, run.wallSec, run.fsyncs,
+            run.accumulatedWriteBytes, run.deviceWriteBytes);
+        if (run.initError != SWAPFS_E_OK) {
+            printf("  setup failed, ret: %d\n", run.initError);
+            continue;
+        }
+        printf("  %-9s %9s %7s %11s %9s %10s %10s %10s\n", "op", "count", "errors", "ops/s", "MiB/s",
+            "p50(us)", "p99(us)", "p999(us)");
+        for (size_t type = 0; type < OP_TYPE_COUNT; ++type) {
+            const OpSummary &op = run.ops[type];
+            printf("  %-9s %9" PRIu64 " %7" PRIu64 " %11.1f %9.2f %10.1f %10.1f %10.1f\n", OP_NAMES[type],
+                op.count, op.errors, op.opsPerSec, op.mibPerSec, op.p50Us, op.p99Us, op.p999Us);
+        }
+    }
+}
+
+void PrintJson(const BenchOptions &options, const std::vector<RunResult> &runs, bool uringAvailable)
+{
+    printf("{\"benchmark\":\"swapfs\",\"dio\":%s,\"uring\":%s,\"space_check_ms\":%u,"
+        "\"ops_per_thread\":%u,\"mix\":[%u,%u,%u],\"runs\":[",
+        options.useDirectIo ? "true" : "false", uringAvailable ? "true" : "false",
+        options.spaceCheckIntervalMs, options.opsPerThread, options.mix[OP_SWAP_OUT],
+        options.mix[OP_SWAP_IN], options.mix[OP_REMOVE]);
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const RunResult &run = runs[i];
+        printf("%s{\"threads\":%u,\"size\":%" PRIu64 ",\"error\":%d,\"wall_sec\":%.6f,\"fsyncs\":%" PRIu64
+            ",\"accumulated_write_bytes\":%" PRIu64 ",\"device_write_bytes\":%" PRId64 ",\"ops\":{",
+            i == 0 ? "" : ",", run.threads, run.size, run.initError, run.wallSec, run.fsyncs,
+            run.accumulatedWriteBytes, run.deviceWriteBytes);
+        for (size_t type = 0; type < OP_TYPE_COUNT; ++type) {
+            const OpSummary &op = run.ops[type];
+            printf("%s\"%s\":{\"count\":%" PRIu64 ",\"errors\":%" PRIu64 ",\"bytes\":%" PRIu64
+                ",\"ops_per_sec\":%.3f,\"mib_per_sec\":%.3f,\"p50_us\":%.3f,\"p99_us\":%.3f,\"p999_us\":%.3f}",
+                type == 0 ? "" : ",", OP_NAMES[type], op.count, op.errors, op.bytes, op.opsPerSec,
+                op.mibPerSec, op.p50Us, op.p99Us, op.p999Us);
+        }
+        printf("}}");
+    }
+    printf("]}\n");
+}
+} // namespace
+
+// Init and the io_uring path require a system-app caller; the harness runs as a shell binary, so it answers for the
+// token kits itself, on every thread.
+namespace OHOS::Security::AccessToken {
+bool TokenIdKit::IsSystemAppByFullTokenID(uint64_t tokenId)
+{
+    return true;
+}
+
+int AccessTokenKit::VerifyAccessToken(AccessTokenID tokenID, const std::string &permissionName)
+{
+    return PermissionState::PERMISSION_GRANTED;
+}
+} // namespace OHOS::Security::AccessToken
+
+// Counts every fsync issued by the process; SwapOut is the only caller in this harness.
+extern "C" int fsync(int fd)
+{
+    using FsyncFunction = int (*)(int);
+    static FsyncFunction realFsync = reinterpret_cast<FsyncFunction>(dlsym(RTLD_NEXT, "fsync"));
+    g_fsyncCount.fetch_add(1, std::memory_order_relaxed);
+    return realFsync != nullptr ? realFsync(fd) : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (!ParseOption(argv[i], options)) {
+            fprintf(stderr, "invalid option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (mkdir(options.rootPath.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+        fprintf(stderr, "cannot create %s, errno: %d\n", options.rootPath.c_str(), errno);
+        return EXIT_FAILURE;
+    }
+    bool uringAvailable = false;
+    if (options.useDirectIo) {
+        UringReadEngine probe;
+        uringAvailable = probe.IsAvailable();
+    }
+
+    std::vector<RunResult> runs;
+    bool failed = false;
+    for (uint32_t threads : options.threads) {
+        for (uint64_t size : options.sizes) {
+            runs.emplace_back(RunOnce(options, threads, size));
+            failed = failed || runs.back().initError != SWAPFS_E_OK;
+        }
+    }
+    if (options.json) {
+        PrintJson(options, runs, uringAvailable);
+    } else {
+        PrintText(options, runs, uringAvailable);
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -16,6 +16,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <pthread.h>
+#include <algorithm>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
 #include <gtest/gtest.h>
 #include <clocale>
 #include "oh_archive.h"
@@ -197,6 +202,457 @@ TEST(ArchiveReadTest, ZipDecompressZip64File)
     EXPECT_EQ(OH_ARCHIVE_OK, ret);
 }
 
+struct ProgressRecord {
+    int last;
+    int calls;
+    bool monotonic;
+};
+
+static OH_Archive_ProgressType ProgressHandlerRecord(int progress, void *userData)
+{
+    ProgressRecord *record = static_cast<ProgressRecord *>(userData);
+    if (progress < record->last) {
+        record->monotonic = false;
+    }
+    record->last = progress;
+    record->calls++;
+    return OH_ARCHIVE_PROGRESS_CONTINUE;
+}
+
+static std::string MakeEntryContent(size_t index)
+{
+    size_t size = (index * 7919) % (256 * 1024) + 1; // 每个文件大小不同，最大256K
+    std::string content(size, '\0');
+    for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<char>('a' + (i * 31 + index) % 26); // 26个字母
+    }
+    return content;
+}
+
+static bool IsFileContentSame(const std::string &path, const std::string &expect)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::string actual(expect.size() + 1, '\0');
+    size_t read = fread(&actual[0], 1, actual.size(), file);
+    (void)fclose(file);
+    return read == expect.size() && actual.compare(0, read, expect) == 0;
+}
+
+static void CreateManyEntriesZip(const std::string &srcDir, const char *zipFile, size_t entryNum)
+{
+    (void)mkdir(srcDir.c_str(), 0777);
+    (void)mkdir((srcDir + "/sub").c_str(), 0777);
+    for (size_t i = 0; i < entryNum; i++) {
+        std::string path = srcDir + (i % 2 == 0 ? "/file_" : "/sub/file_") + std::to_string(i);
+        FILE *file = fopen(path.c_str(), "wb");
+        ASSERT_NE(nullptr, file);
+        std::string content = MakeEntryContent(i);
+        (void)fwrite(content.data(), 1, content.size(), file);
+        (void)fclose(file);
+    }
+
+    const char *infiles[] = {srcDir.c_str()};
+    OH_Archive_Writer_Ctx writer = OH_Archive_Writer_OpenFile(zipFile, OH_ARCHIVE_OPEN_MODE_CREATE,
+        OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(nullptr, writer);
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Writer_SetCompressMethod(writer, OH_ARCHIVE_COMPRESS_DEFLATE, -1));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Writer_Add(writer, infiles, 1));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Writer_Close(writer));
+}
+
+TEST(ArchiveReadTest, ZipDecompressManyEntries)
+{
+    const std::string srcDir = "/data/test/archive_reader_many_entries";
+    const char *zipFile = "/data/test/archive_reader_many_entries.zip";
+    const std::string outDir = "/data/test/test_archive_reader_many_entries";
+    const size_t entryNum = 48; // 48个文件，一半在子目录
+    CreateManyEntriesZip(srcDir, zipFile, entryNum);
+
+    OH_Archive_Reader_Ctx arc = OH_Archive_Reader_OpenFile(zipFile);
+    ASSERT_NE(nullptr, arc);
+    ProgressRecord record = {0, 0, true};
+    (void)OH_Archive_Reader_SetExtractThreadNum(arc, 4); // 4个解压线程，插件读取时按插件方式解压
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_SetProgressHandlerWithData(arc, ProgressHandlerRecord, &record));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_ExtractAllFile(arc, outDir.c_str()));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_Close(arc));
+    EXPECT_TRUE(record.monotonic);
+    EXPECT_GE(record.calls, static_cast<int>(entryNum));
+    EXPECT_GT(record.last, 90); // 全部解压后进度应接近100%
+
+    for (size_t i = 0; i < entryNum; i++) {
+        std::string path = outDir + "/archive_reader_many_entries" + (i % 2 == 0 ? "/file_" : "/sub/file_") +
+            std::to_string(i);
+        EXPECT_TRUE(IsFileContentSame(path, MakeEntryContent(i))) << path;
+    }
+}
+
+TEST(ArchiveReadTest, ZipDecompressManyEntriesCancel)
+{
+    const std::string srcDir = "/data/test/archive_reader_many_entries_cancel";
+    const char *zipFile = "/data/test/archive_reader_many_entries_cancel.zip";
+    const char *outDir = "/data/test/test_archive_reader_many_entries_cancel";
+    CreateManyEntriesZip(srcDir, zipFile, 48); // 48个文件
+
+    OH_Archive_Reader_Ctx arc = OH_Archive_Reader_OpenFile(zipFile);
+    ASSERT_NE(nullptr, arc);
+    (void)OH_Archive_Reader_SetExtractThreadNum(arc, 4); // 4个解压线程，插件读取时按插件方式解压
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_SetProgressHandlerWithData(arc, ProgressHandlerWithCancel, nullptr));
+    EXPECT_EQ(OH_ARCHIVE_CANCEL_ERROR, OH_Archive_Reader_ExtractAllFile(arc, outDir));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_Close(arc));
+}
+
+TEST(ArchiveReadTest, ZipDecompressDuplicateNames)
+{
+    const std::string srcDir = "/data/test/archive_reader_duplicate_names";
+    const char *zipFile = "/data/test/archive_reader_duplicate_names.zip";
+    const std::string outDir = "/data/test/test_archive_reader_duplicate_names";
+    const size_t entryNum = 16; // 16个同名文件
+    (void)mkdir(srcDir.c_str(), 0777);
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < entryNum; i++) {
+        std::string dir = srcDir + "/dir_" + std::to_string(i);
+        (void)mkdir(dir.c_str(), 0777);
+        paths.push_back(dir + "/same.txt");
+        FILE *file = fopen(paths.back().c_str(), "wb");
+        ASSERT_NE(nullptr, file);
+        std::string content = MakeEntryContent(i);
+        (void)fwrite(content.data(), 1, content.size(), file);
+        (void)fclose(file);
+    }
+    std::vector<const char *> infiles;
+    for (const std::string &path : paths) {
+        infiles.push_back(path.c_str());
+    }
+    OH_Archive_Writer_Ctx writer = OH_Archive_Writer_OpenFile(zipFile, OH_ARCHIVE_OPEN_MODE_CREATE,
+        OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(nullptr, writer);
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Writer_Add(writer, infiles.data(), infiles.size()));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Writer_Close(writer));
+
+    OH_Archive_Reader_Ctx arc = OH_Archive_Reader_OpenFile(zipFile);
+    ASSERT_NE(nullptr, arc);
+    EXPECT_EQ(OH_ARCHIVE_PARAM_ERROR, OH_Archive_Reader_SetExtractThreadNum(arc, 17)); // 最多16个线程
+    OH_Archive_ErrCode ret = OH_Archive_Reader_SetExtractThreadNum(arc, 4); // 4个解压线程
+    if (ret == OH_ARCHIVE_UNSUPPORTED_ERROR) {
+        // 插件读取时不支持设置解压线程数
+        EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_Close(arc));
+        return;
+    }
+    EXPECT_EQ(OH_ARCHIVE_OK, ret);
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_ExtractAllFile(arc, outDir.c_str()));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_Close(arc));
+
+    // 与串行解压一致，先出现的条目保留原名，其余按归档顺序重命名
+    EXPECT_TRUE(IsFileContentSame(outDir + "/same.txt", MakeEntryContent(0)));
+    for (size_t i = 1; i < entryNum; i++) {
+        std::string path = outDir + "/same (" + std::to_string(i + 1) + ").txt";
+        EXPECT_TRUE(IsFileContentSame(path, MakeEntryContent(i))) << path;
+    }
+}
+
+static uint64_t StringOutputHandler(const void *data, uint64_t size, void *userData)
+{
+    std::string *output = static_cast<std::string *>(userData);
+    output->append(static_cast<const char *>(data), size);
+    return size;
+}
+
+TEST(ArchiveReadTest, ZipReaderEntryIndex)
+{
+    const std::string srcDir = "/data/test/archive_reader_entry_index";
+    const char *zipFile = "/data/test/archive_reader_entry_index.zip";
+    const size_t entryNum = 48; // 48个文件，一半在子目录
+    CreateManyEntriesZip(srcDir, zipFile, entryNum);
+
+    OH_Archive_Reader_Ctx arc = OH_Archive_Reader_OpenFile(zipFile);
+    ASSERT_NE(nullptr, arc);
+    uint64_t count = 0;
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_GetEntryCount(arc, &count));
+    EXPECT_GE(count, entryNum);
+
+    size_t fileNum = 0;
+    for (uint64_t index = 0; index < count; index++) {
+        OH_Archive_EntryInfo info;
+        ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_GetEntryInfo(arc, index, &info));
+        uint64_t found = count;
+        EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_FindEntry(arc, info.name, &found));
+        EXPECT_EQ(index, found) << info.name;
+        if (info.isDirectory) {
+            EXPECT_EQ(OH_ARCHIVE_PARAM_ERROR, OH_Archive_Reader_ExtractEntryToStream(arc, index,
+                StringOutputHandler, nullptr));
+            continue;
+        }
+        fileNum++;
+        EXPECT_EQ(OH_ARCHIVE_COMPRESS_DEFLATE, info.method);
+        EXPECT_GT(info.compressedSize, 0u);
+    }
+    EXPECT_EQ(entryNum, fileNum);
+
+    uint64_t index = 0;
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_FindEntry(arc, "archive_reader_entry_index/sub/file_7", &index));
+    OH_Archive_EntryInfo info;
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_GetEntryInfo(arc, index, &info));
+    std::string expect = MakeEntryContent(7); // 第7个文件
+    EXPECT_STREQ("archive_reader_entry_index/sub/file_7", info.name);
+    EXPECT_EQ(expect.size(), info.uncompressedSize);
+    EXPECT_EQ(crc32(0, reinterpret_cast<const Bytef *>(expect.data()), expect.size()), info.crc32);
+
+    EXPECT_EQ(OH_ARCHIVE_PATH_NOT_EXIST_ERROR, OH_Archive_Reader_FindEntry(arc, "archive_reader_entry_index/none",
+        &index));
+    EXPECT_EQ(OH_ARCHIVE_PARAM_ERROR, OH_Archive_Reader_GetEntryInfo(arc, count, &info));
+    EXPECT_EQ(OH_ARCHIVE_PARAM_ERROR, OH_Archive_Reader_FindEntry(arc, nullptr, &index));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_Close(arc));
+}
+
+TEST(ArchiveReadTest, ZipReaderExtractEntry)
+{
+    const std::string srcDir = "/data/test/archive_reader_extract_entry";
+    const char *zipFile = "/data/test/archive_reader_extract_entry.zip";
+    const std::string outDir = "/data/test/test_archive_reader_extract_entry";
+    CreateManyEntriesZip(srcDir, zipFile, 16); // 16个文件
+    (void)mkdir(outDir.c_str(), 0777);
+
+    OH_Archive_Reader_Ctx arc = OH_Archive_Reader_OpenFile(zipFile);
+    ASSERT_NE(nullptr, arc);
+    uint64_t index = 0;
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_FindEntry(arc, "archive_reader_extract_entry/file_12", &index));
+    std::string expect = MakeEntryContent(12); // 第12个文件
+
+    std::string filePath = outDir + "/file_12";
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_ExtractEntryToFile(arc, index, filePath.c_str()));
+    EXPECT_TRUE(IsFileContentSame(filePath, expect));
+    // 再次解压覆盖已有文件
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_ExtractEntryToFile(arc, index, filePath.c_str()));
+    EXPECT_TRUE(IsFileContentSame(filePath, expect));
+
+    std::string fdPath = outDir + "/file_12_fd";
+    FILE *file = fopen(fdPath.c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_ExtractEntryToFd(arc, index, fileno(file)));
+    (void)fclose(file);
+    EXPECT_TRUE(IsFileContentSame(fdPath, expect));
+
+    std::string buffer(expect.size() - 1, '\0');
+    uint64_t size = buffer.size();
+    EXPECT_EQ(OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR, OH_Archive_Reader_ExtractEntryToBuffer(arc, index,
+        reinterpret_cast<uint8_t *>(&buffer[0]), &size));
+    EXPECT_EQ(expect.size(), size);
+    buffer.resize(size);
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_ExtractEntryToBuffer(arc, index,
+        reinterpret_cast<uint8_t *>(&buffer[0]), &size));
+    EXPECT_EQ(expect.size(), size);
+    EXPECT_EQ(expect, buffer);
+
+    // 全量解压与单文件解压交替使用同一上下文
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_ExtractAllFile(arc, outDir.c_str()));
+    std::string output;
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_FindEntry(arc, "archive_reader_extract_entry/sub/file_3", &index));
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_ExtractEntryToStream(arc, index, StringOutputHandler, &output));
+    EXPECT_EQ(MakeEntryContent(3), output); // 第3个文件
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_Reader_Close(arc));
+}
+
+static std::string ReadWholeFile(const char *path)
+{
+    std::string content;
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return content;
+    }
+    char buf[4096]; // 4K缓冲区
+    size_t read = 0;
+    while ((read = fread(buf, 1, sizeof(buf), file)) > 0) {
+        content.append(buf, read);
+    }
+    (void)fclose(file);
+    return content;
+}
+
+static OH_Archive_ErrCode FeedZipStream(OH_Archive_ZipStreamRead_Ctx ctx, const std::string &zip, size_t chunkSize)
+{
+    for (size_t pos = 0; pos < zip.size(); pos += chunkSize) {
+        size_t size = std::min(chunkSize, zip.size() - pos);
+        OH_Archive_ErrCode ret = OH_Archive_ZipStreamRead_Update(ctx,
+            reinterpret_cast<const uint8_t *>(zip.data()) + pos, size);
+        if (ret != OH_ARCHIVE_OK) {
+            return ret;
+        }
+    }
+    return OH_ARCHIVE_OK;
+}
+
+TEST(ArchiveReadTest, ZipStreamReadToDir)
+{
+    const std::string srcDir = "/data/test/archive_zip_stream_dir";
+    const char *zipFile = "/data/test/archive_zip_stream_dir.zip";
+    const std::string outDir = "/data/test/test_archive_zip_stream_dir";
+    const size_t entryNum = 48; // 48个文件，一半在子目录
+    CreateManyEntriesZip(srcDir, zipFile, entryNum);
+    std::string zip = ReadWholeFile(zipFile);
+    ASSERT_FALSE(zip.empty());
+    (void)mkdir(outDir.c_str(), 0777);
+
+    OH_Archive_ZipStreamRead_Ctx ctx = OH_Archive_ZipStreamRead_Create();
+    ASSERT_NE(nullptr, ctx);
+    EXPECT_EQ(OH_ARCHIVE_PARAM_ERROR, OH_Archive_ZipStreamRead_Update(ctx,
+        reinterpret_cast<const uint8_t *>(zip.data()), zip.size()));
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_ZipStreamRead_StartToDir(ctx, outDir.c_str()));
+    EXPECT_EQ(OH_ARCHIVE_OK, FeedZipStream(ctx, zip, 1021)); // 1021字节分块，跨越头部边界
+    uint64_t entryCount = 0;
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_ZipStreamRead_End(ctx, &entryCount));
+    EXPECT_EQ(entryNum + 2, entryCount); // 两个目录
+    OH_Archive_ZipStreamRead_Destroy(ctx);
+
+    for (size_t i = 0; i < entryNum; i++) {
+        std::string path = outDir + "/archive_zip_stream_dir" + (i % 2 == 0 ? "/file_" : "/sub/file_") +
+            std::to_string(i);
+        EXPECT_TRUE(IsFileContentSame(path, MakeEntryContent(i))) << path;
+    }
+}
+
+static void AppendLe(std::string &out, uint64_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i++) {
+        out.push_back(static_cast<char>((value >> (i * 8)) & 0xff)); // 8位一字节
+    }
+}
+
+static void AppendLocalEntry(std::string &zip, const std::string &name, const std::string &content, bool compress,
+    bool descriptor64 = false)
+{
+    std::string data = content;
+    if (compress) {
+        z_stream strm = {};
+        ASSERT_EQ(Z_OK, deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY));
+        data.resize(deflateBound(&strm, content.size()));
+        strm.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(content.data()));
+        strm.avail_in = content.size();
+        strm.next_out = reinterpret_cast<Bytef *>(&data[0]);
+        strm.avail_out = data.size();
+        ASSERT_EQ(Z_STREAM_END, deflate(&strm, Z_FINISH));
+        data.resize(strm.total_out);
+        (void)deflateEnd(&strm);
+    }
+    uint32_t crc = crc32(0, reinterpret_cast<const Bytef *>(content.data()), content.size());
+    AppendLe(zip, 0x04034b50, 4); // 本地文件头签名
+    AppendLe(zip, 20, 2); // 20: version needed
+    AppendLe(zip, compress ? 0x0008 : 0, 2); // 压缩条目使用数据描述符
+    AppendLe(zip, compress ? OH_ARCHIVE_COMPRESS_DEFLATE : OH_ARCHIVE_NO_COMPRESSION, 2);
+    AppendLe(zip, 0, 4);
+    AppendLe(zip, compress ? 0 : crc, 4);
+    AppendLe(zip, compress ? 0 : data.size(), 4);
+    AppendLe(zip, compress ? 0 : content.size(), 4);
+    AppendLe(zip, name.size(), 2);
+    AppendLe(zip, 0, 2);
+    zip += name;
+    zip += data;
+    if (compress) {
+        AppendLe(zip, 0x08074b50, 4); // 数据描述符签名
+        AppendLe(zip, crc, 4);
+        AppendLe(zip, data.size(), descriptor64 ? 8 : 4); // 8字节或4字节大小
+        AppendLe(zip, content.size(), descriptor64 ? 8 : 4); // 8字节或4字节大小
+    }
+}
+
+struct ZipStreamRecord {
+    std::vector<std::string> names;
+    std::vector<std::string> contents;
+};
+
+static OH_Archive_ProgressType ZipStreamEntryHandler(const OH_Archive_EntryInfo *info, void *userData)
+{
+    ZipStreamRecord *record = static_cast<ZipStreamRecord *>(userData);
+    record->names.push_back(info->name);
+    record->contents.emplace_back();
+    return OH_ARCHIVE_PROGRESS_CONTINUE;
+}
+
+static uint64_t ZipStreamOutputHandler(const void *data, uint64_t size, void *userData)
+{
+    ZipStreamRecord *record = static_cast<ZipStreamRecord *>(userData);
+    record->contents.back().append(static_cast<const char *>(data), size);
+    return size;
+}
+
+TEST(ArchiveReadTest, ZipStreamReadToHandler)
+{
+    std::string text;
+    while (text.size() < 100 * 1024) { // 100K文本数据
+        text += "zip stream read with data descriptor ";
+    }
+    const std::string stored = "stored entry";
+    std::string zip;
+    AppendLocalEntry(zip, "stream/desc.txt", text, true);
+    AppendLocalEntry(zip, "stream/stored.txt", stored, false);
+    AppendLe(zip, 0x02014b50, 4); // 中央目录签名，之后的内容被忽略
+    zip.append(64, '\0'); // 64字节填充
+
+    OH_Archive_ZipStreamRead_Ctx ctx = OH_Archive_ZipStreamRead_Create();
+    ASSERT_NE(nullptr, ctx);
+    ZipStreamRecord record;
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_ZipStreamRead_Start(ctx, ZipStreamEntryHandler, ZipStreamOutputHandler,
+        &record));
+    EXPECT_EQ(OH_ARCHIVE_OK, FeedZipStream(ctx, zip, 7)); // 7字节分块
+    uint64_t entryCount = 0;
+    EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_ZipStreamRead_End(ctx, &entryCount));
+    EXPECT_EQ(2u, entryCount);
+    ASSERT_EQ(2u, record.names.size());
+    EXPECT_EQ("stream/desc.txt", record.names[0]);
+    EXPECT_EQ(text, record.contents[0]);
+    EXPECT_EQ("stream/stored.txt", record.names[1]);
+    EXPECT_EQ(stored, record.contents[1]);
+
+    // 截断的压缩包
+    record = ZipStreamRecord();
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_ZipStreamRead_Start(ctx, ZipStreamEntryHandler, ZipStreamOutputHandler,
+        &record));
+    EXPECT_EQ(OH_ARCHIVE_OK, FeedZipStream(ctx, zip.substr(0, zip.size() / 2), 4096)); // 4K分块
+    EXPECT_EQ(OH_ARCHIVE_DATA_ERROR, OH_Archive_ZipStreamRead_End(ctx, nullptr));
+
+    // 数据描述符中的CRC错误
+    std::string corrupt;
+    AppendLocalEntry(corrupt, "stream/desc.txt", text, true);
+    corrupt[corrupt.size() - 12] ^= 0x01; // CRC位于描述符末尾前12字节
+    record = ZipStreamRecord();
+    ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_ZipStreamRead_Start(ctx, ZipStreamEntryHandler, ZipStreamOutputHandler,
+        &record));
+    EXPECT_EQ(OH_ARCHIVE_CRC_ERROR, FeedZipStream(ctx, corrupt, 4096)); // 4K分块
+    EXPECT_EQ(OH_ARCHIVE_CRC_ERROR, OH_Archive_ZipStreamRead_Update(ctx,
+        reinterpret_cast<const uint8_t *>(zip.data()), zip.size()));
+    OH_Archive_ZipStreamRead_Destroy(ctx);
+}
+
+TEST(ArchiveReadTest, ZipStreamReadDescriptor64)
+{
+    const std::string first = "zip64 descriptor without zip64 extra field";
+    const std::string second = "32 bit descriptor";
+    std::string zip;
+    AppendLocalEntry(zip, "stream/first.txt", first, true, true);
+    AppendLocalEntry(zip, "stream/second.txt", second, true);
+    AppendLocalEntry(zip, "stream/empty.txt", "", true, true);
+    AppendLe(zip, 0x02014b50, 4); // 中央目录签名，之后的内容被忽略
+
+    OH_Archive_ZipStreamRead_Ctx ctx = OH_Archive_ZipStreamRead_Create();
+    ASSERT_NE(nullptr, ctx);
+    for (size_t chunkSize : {4096, 5, 1}) { // 4K、5字节及1字节分块
+        ZipStreamRecord record;
+        ASSERT_EQ(OH_ARCHIVE_OK, OH_Archive_ZipStreamRead_Start(ctx, ZipStreamEntryHandler, ZipStreamOutputHandler,
+            &record));
+        EXPECT_EQ(OH_ARCHIVE_OK, FeedZipStream(ctx, zip, chunkSize)) << chunkSize;
+        uint64_t entryCount = 0;
+        EXPECT_EQ(OH_ARCHIVE_OK, OH_Archive_ZipStreamRead_End(ctx, &entryCount)) << chunkSize;
+        EXPECT_EQ(3u, entryCount);
+        ASSERT_EQ(3u, record.contents.size());
+        EXPECT_EQ(first, record.contents[0]);
+        EXPECT_EQ(second, record.contents[1]);
+        EXPECT_EQ("", record.contents[2]);
+    }
+    OH_Archive_ZipStreamRead_Destroy(ctx);
+}
+
 #define ZLIB_OK 0
 #define ZLIB_ERROR 1
 
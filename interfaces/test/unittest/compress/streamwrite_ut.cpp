@@ -17,6 +17,8 @@
 #include <cstdio>
 #include <climits>
 #include <cstdint>
+#include <algorithm>
+#include <vector>
 #include "oh_archive.h"
 #include "oh_archive_errcode.h"
 #include "zlib.h"
@@ -462,6 +464,107 @@ TEST_F(OHCompressTest, CompressCheckSum)
     EXPECT_TRUE(isSame);
 }
 
+TEST_F(OHCompressTest, CompressMultiThreadCheckSum)
+{
+    config.checksum = OH_ARCHIVE_CRC32;
+    config.threadNum = 4; // 4 个压缩线程
+    ctx = OH_Archive_StreamWrite_Create(config);
+    ASSERT_NE(ctx, nullptr);
+
+    const char *compressedFile = "compressed_file_multi_thread";
+    const char *decompressedFile = "decompressed_file_multi_thread";
+
+    const char *inFile = "file_multi_thread";
+    CreateRandomFile(inFile, 1024 * 1024 + 777);  // 非 block 对齐的文件大小
+    char *source = nullptr;
+    uint64_t sourceLen = 0;
+    ASSERT_EQ(ReadFileData(inFile, &source, &sourceLen), 0);
+    uLong expectCrc = crc32(0L, reinterpret_cast<const Bytef *>(source), static_cast<uInt>(sourceLen));
+    free(source);
+
+    OH_Archive_StreamInfo info = {0};
+    OH_Archive_ErrCode compRet = CompressFileAndGetInfo(inFile, compressedFile, 6, &info); // 6 为默认压缩等级
+    ASSERT_EQ(compRet, OH_ARCHIVE_OK);
+    EXPECT_EQ(info.totalInSize, sourceLen);
+    EXPECT_EQ(info.checksum, expectCrc);
+    int ret = DecompressFileBase(compressedFile, decompressedFile);
+    EXPECT_EQ(ret, 0);
+    EXPECT_TRUE(IsSameFile(inFile, decompressedFile));
+}
+
+static uint64_t DiscardCallBack(const void *data, uint64_t size, void *userData)
+{
+    (void)data;
+    (void)userData;
+    return size;
+}
+
+TEST_F(OHCompressTest, CompressCheckSumUnalignedUpdate)
+{
+    config.checksum = OH_ARCHIVE_CRC32;
+    ctx = OH_Archive_StreamWrite_Create(config);
+    ASSERT_NE(ctx, nullptr);
+    ASSERT_EQ(OH_Archive_StreamWrite_Start(ctx, DiscardCallBack, nullptr), OH_ARCHIVE_OK);
+
+    const uint64_t dataLen = 256 * 1024 + 3; // 256K + 3 字节
+    std::vector<uint8_t> data(dataLen);
+    FillBufferWithRandomData(data.data(), dataLen);
+    uint64_t offset = 0;
+    uint64_t step = 1;
+    while (offset < dataLen) {
+        uint64_t size = std::min(step, dataLen - offset);
+        ASSERT_EQ(OH_Archive_StreamWrite_Update(ctx, data.data() + offset, size), OH_ARCHIVE_OK);
+        offset += size;
+        step = step * 3 + 1; // 长度与对齐各不相同
+        if (step > 70000) { // 70000 回绕
+            step = 1;
+        }
+    }
+    OH_Archive_StreamInfo info = {0};
+    ASSERT_EQ(OH_Archive_StreamWrite_End(ctx, &info), OH_ARCHIVE_OK);
+    EXPECT_EQ(info.totalInSize, dataLen);
+    EXPECT_EQ(info.checksum, crc32(0L, data.data(), static_cast<uInt>(dataLen)));
+}
+
+TEST_F(OHCompressTest, CompressMultiThreadRestart)
+{
+    config.threadNum = 2; // 2 个压缩线程
+    ctx = OH_Archive_StreamWrite_Create(config);
+    ASSERT_NE(ctx, nullptr);
+
+    const char *compressedFile = "compressed_file_restart";
+    const char *decompressedFile = "decompressed_file_restart";
+    const char *inFile = "file_restart";
+    CreateRandomFile(inFile, 512 * 1024);  // 512K大小文件
+
+    CompressFileQuit(inFile, compressedFile, 1, 300 * 1024); // 300K 时取消
+    OH_Archive_StreamInfo info = {0};
+    OH_Archive_ErrCode compRet = CompressFileAndGetInfo(inFile, compressedFile, 1, &info);
+    ASSERT_EQ(compRet, OH_ARCHIVE_OK);
+    EXPECT_EQ(info.totalInSize, 512u * 1024);
+    EXPECT_EQ(DecompressFileBase(compressedFile, decompressedFile), 0);
+    EXPECT_TRUE(IsSameFile(inFile, decompressedFile));
+}
+
+TEST_F(OHCompressTest, CompressMultiThreadEmpty)
+{
+    ctx = OH_Archive_StreamWrite_Create(config);
+    ASSERT_NE(ctx, nullptr);
+
+    const char *compressedFile = "compressed_file_empty";
+    FILE *fout = fopen(compressedFile, "wb");
+    ASSERT_NE(fout, nullptr);
+    ASSERT_EQ(OH_Archive_StreamWrite_Start(ctx, WriteCallBack, fout), OH_ARCHIVE_OK);
+    OH_Archive_StreamInfo info = {0};
+    EXPECT_EQ(OH_Archive_StreamWrite_End(ctx, &info), OH_ARCHIVE_OK);
+    (void)fclose(fout);
+    EXPECT_EQ(info.totalInSize, 0u);
+    EXPECT_GT(info.totalOutSize, 0u);
+
+    const char *decompressedFile = "decompressed_file_empty";
+    EXPECT_EQ(DecompressFileBase(compressedFile, decompressedFile), 0);
+}
+
 TEST_F(OHCompressTest, CompressCancel)
 {
     ctx = OH_Archive_StreamWrite_Create(config);
@@ -558,4 +661,140 @@ TEST_F(OHCompressTest, BufferCompressBoundInvalidParam)
 {
     uint64_t bound = OH_Archive_BufferWriteCompressBound((OH_Archive_CompressMethod) - 1, 10);
     EXPECT_EQ(bound, 0);
-}
\ No newline at end of file
+}
+
+static std::vector<uint8_t> MakeRecord(int index)
+{
+    char record[128];
+    int len = snprintf(record, sizeof(record), "{\"id\":%d,\"name\":\"user_%d\",\"state\":\"active\",\"tag\":\"%d\"}",
+        index, index * 7, index % 13); // 13个tag循环
+    return std::vector<uint8_t>(record, record + len);
+}
+
+TEST_F(OHCompressTest, CodecCompressRecords)
+{
+    OH_Archive_Codec_Ctx codec = OH_Archive_Codec_Create(OH_ARCHIVE_COMPRESS_DEFLATE, 6);
+    ASSERT_NE(codec, nullptr);
+
+    for (int i = 0; i < 200; i++) { // 200条小记录复用同一个上下文
+        std::vector<uint8_t> record = MakeRecord(i);
+        uint8_t compressed[256];
+        uint64_t compressedLen = sizeof(compressed);
+        ASSERT_EQ(OH_Archive_Codec_Compress(codec, compressed, &compressedLen, record.data(), record.size()),
+            OH_ARCHIVE_OK);
+
+        // 无字典时与OH_Archive_BufferRead兼容
+        uint8_t plain[256];
+        uint64_t plainLen = sizeof(plain);
+        ASSERT_EQ(OH_Archive_BufferRead(plain, &plainLen, compressed, compressedLen, OH_ARCHIVE_COMPRESS_DEFLATE),
+            OH_ARCHIVE_OK);
+        ASSERT_EQ(std::vector<uint8_t>(plain, plain + plainLen), record);
+
+        plainLen = sizeof(plain);
+        ASSERT_EQ(OH_Archive_Codec_Decompress(codec, plain, &plainLen, compressed, compressedLen), OH_ARCHIVE_OK);
+        ASSERT_EQ(std::vector<uint8_t>(plain, plain + plainLen), record);
+    }
+
+    std::vector<uint8_t> record = MakeRecord(0);
+    uint8_t small[4];
+    uint64_t smallLen = sizeof(small);
+    EXPECT_EQ(OH_Archive_Codec_Compress(codec, small, &smallLen, record.data(), record.size()),
+        OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR);
+    OH_Archive_Codec_Destroy(codec);
+}
+
+TEST_F(OHCompressTest, CodecDictionary)
+{
+    OH_Archive_Codec_Ctx codec = OH_Archive_Codec_Create(OH_ARCHIVE_COMPRESS_DEFLATE, -1);
+    ASSERT_NE(codec, nullptr);
+    std::vector<uint8_t> record = MakeRecord(42); // 42号记录
+    uint8_t plainCompressed[256];
+    uint64_t plainCompressedLen = sizeof(plainCompressed);
+    ASSERT_EQ(OH_Archive_Codec_Compress(codec, plainCompressed, &plainCompressedLen, record.data(), record.size()),
+        OH_ARCHIVE_OK);
+
+    std::vector<uint8_t> dict = MakeRecord(0);
+    ASSERT_EQ(OH_Archive_Codec_SetDictionary(codec, dict.data(), dict.size()), OH_ARCHIVE_OK);
+    uint8_t compressed[256];
+    uint64_t compressedLen = sizeof(compressed);
+    ASSERT_EQ(OH_Archive_Codec_Compress(codec, compressed, &compressedLen, record.data(), record.size()),
+        OH_ARCHIVE_OK);
+    EXPECT_LT(compressedLen, plainCompressedLen);
+
+    uint8_t plain[256];
+    uint64_t plainLen = sizeof(plain);
+    ASSERT_EQ(OH_Archive_Codec_Decompress(codec, plain, &plainLen, compressed, compressedLen), OH_ARCHIVE_OK);
+    EXPECT_EQ(std::vector<uint8_t>(plain, plain + plainLen), record);
+
+    // Reset后字典失效, 带字典的数据无法正确解压
+    ASSERT_EQ(OH_Archive_Codec_Reset(codec), OH_ARCHIVE_OK);
+    plainLen = sizeof(plain);
+    OH_Archive_ErrCode ret = OH_Archive_Codec_Decompress(codec, plain, &plainLen, compressed, compressedLen);
+    EXPECT_TRUE(ret != OH_ARCHIVE_OK || std::vector<uint8_t>(plain, plain + plainLen) != record);
+    OH_Archive_Codec_Destroy(codec);
+}
+
+TEST_F(OHCompressTest, CodecBatch)
+{
+    const size_t count = 1000; // 1000条记录
+    std::vector<std::vector<uint8_t>> records;
+    for (size_t i = 0; i < count; i++) {
+        records.push_back(MakeRecord(static_cast<int>(i)));
+    }
+    std::vector<uint8_t> dict = MakeRecord(-1);
+    std::vector<std::vector<uint8_t>> compressed(count, std::vector<uint8_t>(256)); // 256字节输出
+    std::vector<std::vector<uint8_t>> plain(count, std::vector<uint8_t>(256)); // 256字节输出
+    std::vector<OH_Archive_Codec_Buffer> buffers(count);
+
+    OH_Archive_Codec_Ctx codec = OH_Archive_Codec_Create(OH_ARCHIVE_COMPRESS_DEFLATE, 6);
+    ASSERT_NE(codec, nullptr);
+    ASSERT_EQ(OH_Archive_Codec_SetDictionary(codec, dict.data(), dict.size()), OH_ARCHIVE_OK);
+    for (size_t i = 0; i < count; i++) {
+        buffers[i] = {records[i].data(), records[i].size(), compressed[i].data(), compressed[i].size(), OH_ARCHIVE_OK};
+    }
+    ASSERT_EQ(OH_Archive_Codec_CompressBatch(codec, buffers.data(), count, 4), OH_ARCHIVE_OK); // 4线程
+
+    for (size_t i = 0; i < count; i++) {
+        // 多线程结果与单线程一致
+        uint8_t serial[256];
+        uint64_t serialLen = sizeof(serial);
+        ASSERT_EQ(OH_Archive_Codec_Compress(codec, serial, &serialLen, records[i].data(), records[i].size()),
+            OH_ARCHIVE_OK);
+        ASSERT_EQ(serialLen, buffers[i].dstSize);
+        ASSERT_EQ(memcmp(serial, compressed[i].data(), serialLen), 0);
+        buffers[i] = {compressed[i].data(), serialLen, plain[i].data(), plain[i].size(), OH_ARCHIVE_OK};
+    }
+    ASSERT_EQ(OH_Archive_Codec_DecompressBatch(codec, buffers.data(), count, 4), OH_ARCHIVE_OK); // 4线程
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(std::vector<uint8_t>(plain[i].begin(), plain[i].begin() + buffers[i].dstSize), records[i]);
+    }
+
+    // 单条失败时返回首个失败结果, 其余条目照常处理
+    buffers[1].dstSize = 1;
+    EXPECT_EQ(OH_Archive_Codec_DecompressBatch(codec, buffers.data(), count, 0), OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR);
+    EXPECT_EQ(buffers[0].result, OH_ARCHIVE_OK);
+    EXPECT_EQ(buffers[1].result, OH_ARCHIVE_INSUFFICIENT_OUTBUF_ERROR);
+    OH_Archive_Codec_Destroy(codec);
+}
+
+TEST_F(OHCompressTest, CodecInvalidParam)
+{
+    EXPECT_EQ(OH_Archive_Codec_Create(OH_ARCHIVE_COMPRESS_DEFLATE, 10), nullptr); // 等级超出范围
+    EXPECT_EQ(OH_Archive_Codec_Create((OH_Archive_CompressMethod) - 1, 0), nullptr);
+
+    OH_Archive_Codec_Ctx codec = OH_Archive_Codec_Create(OH_ARCHIVE_COMPRESS_DEFLATE, 0);
+    ASSERT_NE(codec, nullptr);
+    uint8_t data[16] = {0};
+    uint64_t len = sizeof(data);
+    OH_Archive_Codec_Buffer buffer = {data, sizeof(data), data, sizeof(data), OH_ARCHIVE_OK};
+    EXPECT_EQ(OH_Archive_Codec_Compress(nullptr, data, &len, data, sizeof(data)), OH_ARCHIVE_PARAM_ERROR);
+    EXPECT_EQ(OH_Archive_Codec_Compress(codec, data, &len, data, 0), OH_ARCHIVE_PARAM_ERROR);
+    EXPECT_EQ(OH_Archive_Codec_Decompress(codec, nullptr, &len, data, sizeof(data)), OH_ARCHIVE_PARAM_ERROR);
+    EXPECT_EQ(OH_Archive_Codec_SetDictionary(codec, nullptr, 1), OH_ARCHIVE_PARAM_ERROR);
+    EXPECT_EQ(OH_Archive_Codec_SetDictionary(codec, nullptr, 0), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Codec_CompressBatch(codec, &buffer, 1, 17), OH_ARCHIVE_PARAM_ERROR); // 超过16线程
+    EXPECT_EQ(OH_Archive_Codec_DecompressBatch(codec, nullptr, 1, 1), OH_ARCHIVE_PARAM_ERROR);
+    EXPECT_EQ(OH_Archive_Codec_Reset(nullptr), OH_ARCHIVE_PARAM_ERROR);
+    OH_Archive_Codec_Destroy(codec);
+    OH_Archive_Codec_Destroy(nullptr);
+}
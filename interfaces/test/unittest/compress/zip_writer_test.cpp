@@ -15,6 +15,10 @@
 
 #include <gtest/gtest.h>
 #include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
 #include "oh_archive.h"
 #include "oh_archive_errcode.h"
 #include "unistd.h"
@@ -74,4 +78,289 @@ TEST(ARCHIVE_ZIP_WRITER_TEST, test_archive_writer_zip_compress_kongdir)
         ret = OH_Archive_Writer_Close(ctx);
         EXPECT_EQ(ret, OH_ARCHIVE_OK);
     }
-}
\ No newline at end of file
+}
+
+static void WriteTestFile(const std::string &path, const std::string &content)
+{
+    FILE *fileHandle = fopen(path.c_str(), "wb");
+    ASSERT_NE(fileHandle, nullptr);
+    fwrite(content.data(), sizeof(char), content.size(), fileHandle);
+    fclose(fileHandle);
+}
+
+static void CheckEntry(OH_Archive_Reader_Ctx reader, const char *name, uint16_t method, const std::string &content)
+{
+    uint64_t index = 0;
+    ASSERT_EQ(OH_Archive_Reader_FindEntry(reader, name, &index), OH_ARCHIVE_OK) << name;
+    OH_Archive_EntryInfo info;
+    ASSERT_EQ(OH_Archive_Reader_GetEntryInfo(reader, index, &info), OH_ARCHIVE_OK);
+    EXPECT_EQ(info.method, method) << name;
+    std::string data(content.size(), '\0');
+    uint64_t size = data.size();
+    EXPECT_EQ(OH_Archive_Reader_ExtractEntryToBuffer(reader, index, reinterpret_cast<uint8_t *>(&data[0]), &size),
+        OH_ARCHIVE_OK);
+    EXPECT_EQ(data, content) << name;
+}
+
+TEST(ARCHIVE_ZIP_WRITER_TEST, test_archive_writer_zip_auto_store)
+{
+    const std::string dir = "./autostore";
+    const char* infile[] = {dir.c_str()};
+    const char* outfile = "autostore.zip";
+    (void)mkdir(dir.c_str(), 0777);
+
+    std::string randomData(256 * 1024, '\0'); // 256K随机数据，无法压缩
+    srand(1);
+    for (auto &c : randomData) {
+        c = static_cast<char>(rand() & 0xff);
+    }
+    std::string textData;
+    while (textData.size() < 256 * 1024) { // 256K文本数据
+        textData += "archive auto store sample text ";
+    }
+    WriteTestFile(dir + "/random.bin", randomData);
+    WriteTestFile(dir + "/text.txt", textData);
+    WriteTestFile(dir + "/photo.JPG", textData);
+
+    OH_Archive_Writer_Ctx ctx = OH_Archive_Writer_OpenFile(outfile, OH_ARCHIVE_OPEN_MODE_CREATE, OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(ctx, nullptr);
+    const char *storeExtensions[] = {"jpg", "mp4"};
+    EXPECT_EQ(OH_Archive_Writer_SetAutoStore(ctx, 101, storeExtensions, 2), OH_ARCHIVE_PARAM_ERROR); // 101超出范围
+    EXPECT_EQ(OH_Archive_Writer_SetAutoStore(ctx, 5, nullptr, 2), OH_ARCHIVE_PARAM_ERROR); // 5%
+    OH_Archive_ErrCode ret = OH_Archive_Writer_SetAutoStore(ctx, 5, storeExtensions, 2); // 5%
+    if (ret == OH_ARCHIVE_UNSUPPORTED_ERROR) {
+        // 插件写入时不支持自动存储
+        EXPECT_EQ(OH_Archive_Writer_Close(ctx), OH_ARCHIVE_OK);
+        return;
+    }
+    EXPECT_EQ(ret, OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_SetCompressMethod(ctx, OH_ARCHIVE_COMPRESS_DEFLATE, -1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Add(ctx, infile, 1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Close(ctx), OH_ARCHIVE_OK);
+
+    OH_Archive_Reader_Ctx reader = OH_Archive_Reader_OpenFile(outfile);
+    ASSERT_NE(reader, nullptr);
+    CheckEntry(reader, "autostore/random.bin", OH_ARCHIVE_NO_COMPRESSION, randomData);
+    CheckEntry(reader, "autostore/text.txt", OH_ARCHIVE_COMPRESS_DEFLATE, textData);
+    CheckEntry(reader, "autostore/photo.JPG", OH_ARCHIVE_NO_COMPRESSION, textData);
+    EXPECT_EQ(OH_Archive_Reader_Close(reader), OH_ARCHIVE_OK);
+}
+
+static OH_Archive_ProgressType CancelProgressHandler(int progress, void *userData)
+{
+    return progress >= 50 ? OH_ARCHIVE_PROGRESS_CANCEL : OH_ARCHIVE_PROGRESS_CONTINUE; // 50%后取消
+}
+
+TEST(ARCHIVE_ZIP_WRITER_TEST, test_archive_writer_zip_many_files)
+{
+    const std::string dir = "./manyfiles";
+    const char* infile[] = {dir.c_str()};
+    const char* outfile = "manyfiles.zip";
+    (void)mkdir(dir.c_str(), 0777);
+    (void)mkdir((dir + "/empty").c_str(), 0777);
+
+    const int fileNum = 64; // 64个文件，超过工作线程的任务队列长度
+    std::vector<std::string> contents;
+    for (int i = 0; i < fileNum; i++) {
+        std::string content;
+        while (content.size() < static_cast<size_t>(i) * 1024) { // 每个文件i K
+            content += "many files entry " + std::to_string(i) + " ";
+        }
+        WriteTestFile(dir + "/file" + std::to_string(i) + ".txt", content);
+        contents.push_back(content);
+    }
+    std::string bigData(5 * 1024 * 1024, 'b'); // 5M文件由写线程直接压缩
+    WriteTestFile(dir + "/big.bin", bigData);
+
+    OH_Archive_Writer_Ctx ctx = OH_Archive_Writer_OpenFile(outfile, OH_ARCHIVE_OPEN_MODE_CREATE, OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(OH_Archive_Writer_SetCompressMethod(ctx, OH_ARCHIVE_COMPRESS_DEFLATE, -1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Add(ctx, infile, 1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Close(ctx), OH_ARCHIVE_OK);
+
+    OH_Archive_Reader_Ctx reader = OH_Archive_Reader_OpenFile(outfile);
+    ASSERT_NE(reader, nullptr);
+    uint64_t count = 0;
+    EXPECT_EQ(OH_Archive_Reader_GetEntryCount(reader, &count), OH_ARCHIVE_OK);
+    EXPECT_EQ(count, static_cast<uint64_t>(fileNum + 3)); // 根目录、空目录和大文件
+    uint64_t lastOffset = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        OH_Archive_EntryInfo info;
+        ASSERT_EQ(OH_Archive_Reader_GetEntryInfo(reader, i, &info), OH_ARCHIVE_OK);
+        if (i > 0) {
+            EXPECT_GT(info.offset, lastOffset);
+        }
+        lastOffset = info.offset;
+    }
+    for (int i = 0; i < fileNum; i++) {
+        CheckEntry(reader, ("manyfiles/file" + std::to_string(i) + ".txt").c_str(), OH_ARCHIVE_COMPRESS_DEFLATE,
+            contents[i]);
+    }
+    CheckEntry(reader, "manyfiles/big.bin", OH_ARCHIVE_COMPRESS_DEFLATE, bigData);
+    uint64_t index = 0;
+    EXPECT_EQ(OH_Archive_Reader_FindEntry(reader, "manyfiles/empty/", &index), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Reader_Close(reader), OH_ARCHIVE_OK);
+
+    ctx = OH_Archive_Writer_OpenFile("manyfiles_cancel.zip", OH_ARCHIVE_OPEN_MODE_CREATE, OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(OH_Archive_Writer_SetProgressHandlerWithData(ctx, CancelProgressHandler, nullptr), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Add(ctx, infile, 1), OH_ARCHIVE_CANCEL_ERROR);
+    (void)OH_Archive_Writer_Close(ctx);
+}
+
+TEST(ARCHIVE_ZIP_WRITER_TEST, test_archive_writer_zip_mapped_file_io)
+{
+    const std::string dir = "./mappedio";
+    const char* infile[] = {dir.c_str()};
+    const char* outfile = "mappedio.zip";
+    (void)mkdir(dir.c_str(), 0777);
+    (void)mkdir("./mappedio_out", 0777);
+
+    std::string bigData;
+    while (bigData.size() < 3 * 1024 * 1024) { // 3M文本数据，跨越多个缓冲区
+        bigData += "mapped file io " + std::to_string(bigData.size()) + " ";
+    }
+    std::string smallData = "small";
+    WriteTestFile(dir + "/big.txt", bigData);
+    WriteTestFile(dir + "/small.txt", smallData);
+    WriteTestFile(dir + "/empty.txt", "");
+
+    OH_Archive_FileIoOptions badOptions = {OH_ARCHIVE_FILE_IO_MAPPED, 128 * 1024 * 1024}; // 128M超出上限
+    EXPECT_EQ(OH_Archive_Writer_OpenFileWithOptions(outfile, OH_ARCHIVE_OPEN_MODE_CREATE, OH_ARCHIVE_FMT_ZIP,
+        &badOptions), nullptr);
+    OH_Archive_FileIoOptions options = {OH_ARCHIVE_FILE_IO_MAPPED, 4096}; // 4K缓冲区
+    OH_Archive_Writer_Ctx ctx = OH_Archive_Writer_OpenFileWithOptions(outfile, OH_ARCHIVE_OPEN_MODE_CREATE,
+        OH_ARCHIVE_FMT_ZIP, &options);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(OH_Archive_Writer_SetCompressMethod(ctx, OH_ARCHIVE_COMPRESS_DEFLATE, -1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Add(ctx, infile, 1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Close(ctx), OH_ARCHIVE_OK);
+
+    EXPECT_EQ(OH_Archive_Reader_OpenFileWithOptions(outfile, &badOptions), nullptr);
+    OH_Archive_Reader_Ctx reader = OH_Archive_Reader_OpenFileWithOptions(outfile, &options);
+    ASSERT_NE(reader, nullptr);
+    CheckEntry(reader, "mappedio/big.txt", OH_ARCHIVE_COMPRESS_DEFLATE, bigData);
+    CheckEntry(reader, "mappedio/small.txt", OH_ARCHIVE_COMPRESS_DEFLATE, smallData);
+    EXPECT_EQ(OH_Archive_Reader_ExtractAllFile(reader, "./mappedio_out"), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Reader_Close(reader), OH_ARCHIVE_OK);
+
+    struct stat statBuf;
+    ASSERT_EQ(stat("./mappedio_out/mappedio/big.txt", &statBuf), 0);
+    EXPECT_EQ(static_cast<uint64_t>(statBuf.st_size), bigData.size());
+}
+
+TEST(ARCHIVE_ZIP_WRITER_TEST, test_archive_writer_zip_mapped_file_truncated)
+{
+    const std::string dir = "./mappedtrunc";
+    const char* infile[] = {dir.c_str()};
+    const char* outfile = "mappedtrunc.zip";
+    (void)mkdir(dir.c_str(), 0777);
+    std::string bigData;
+    while (bigData.size() < 1024 * 1024) { // 1M文本数据
+        bigData += "mapped file truncated " + std::to_string(bigData.size()) + " ";
+    }
+    WriteTestFile(dir + "/big.txt", bigData);
+
+    OH_Archive_Writer_Ctx ctx = OH_Archive_Writer_OpenFile(outfile, OH_ARCHIVE_OPEN_MODE_CREATE, OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(OH_Archive_Writer_SetCompressMethod(ctx, OH_ARCHIVE_NO_COMPRESSION, -1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Add(ctx, infile, 1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Close(ctx), OH_ARCHIVE_OK);
+
+    FILE *fileHandle = fopen(outfile, "rb");
+    ASSERT_NE(fileHandle, nullptr);
+    std::string zipData;
+    char buf[4096];
+    size_t readSize = 0;
+    while ((readSize = fread(buf, sizeof(char), sizeof(buf), fileHandle)) > 0) {
+        zipData.append(buf, readSize);
+    }
+    fclose(fileHandle);
+    size_t centralDirOffset = zipData.find(std::string("PK\x01\x02", 4));
+    ASSERT_NE(centralDirOffset, std::string::npos);
+
+    OH_Archive_FileIoOptions options = {OH_ARCHIVE_FILE_IO_MAPPED, 0};
+    OH_Archive_Reader_Ctx reader = OH_Archive_Reader_OpenFileWithOptions(outfile, &options);
+    ASSERT_NE(reader, nullptr);
+    uint64_t index = 0;
+    ASSERT_EQ(OH_Archive_Reader_FindEntry(reader, "mappedtrunc/big.txt", &index), OH_ARCHIVE_OK);
+    // 映射后截去中央目录，条目数据仍在截断处之前，读取不受影响
+    ASSERT_EQ(truncate(outfile, static_cast<off_t>(centralDirOffset)), 0);
+    std::string data(bigData.size(), '\0');
+    uint64_t size = data.size();
+    EXPECT_EQ(OH_Archive_Reader_ExtractEntryToBuffer(reader, index, reinterpret_cast<uint8_t *>(&data[0]), &size),
+        OH_ARCHIVE_OK);
+    EXPECT_EQ(data, bigData);
+    EXPECT_EQ(OH_Archive_Reader_Close(reader), OH_ARCHIVE_OK);
+}
+
+TEST(ARCHIVE_ZIP_WRITER_TEST, test_archive_writer_zip_append)
+{
+    const char* outfile = "append.zip";
+    (void)mkdir("./append_a", 0777);
+    (void)mkdir("./append_b", 0777);
+    std::string dataA;
+    while (dataA.size() < 64 * 1024) { // 64K文本数据
+        dataA += "append first ";
+    }
+    std::string dataB = "append second";
+    std::string dataC = "append third";
+    WriteTestFile("./append_a/a.txt", dataA);
+    WriteTestFile("./append_b/b.txt", dataB);
+    WriteTestFile("./append_c.txt", dataC);
+    (void)remove(outfile);
+
+    // 文件不存在时追加模式新建压缩包
+    const char* infileA[] = {"./append_a"};
+    OH_Archive_Writer_Ctx ctx = OH_Archive_Writer_OpenFile(outfile, OH_ARCHIVE_OPEN_MODE_APPEND, OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(OH_Archive_Writer_Add(ctx, infileA, 1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Close(ctx), OH_ARCHIVE_OK);
+
+    OH_Archive_Reader_Ctx reader = OH_Archive_Reader_OpenFile(outfile);
+    ASSERT_NE(reader, nullptr);
+    uint64_t index = 0;
+    OH_Archive_EntryInfo infoA;
+    ASSERT_EQ(OH_Archive_Reader_FindEntry(reader, "append_a/a.txt", &index), OH_ARCHIVE_OK);
+    ASSERT_EQ(OH_Archive_Reader_GetEntryInfo(reader, index, &infoA), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Reader_Close(reader), OH_ARCHIVE_OK);
+
+    const char* infileB[] = {"./append_b"};
+    ctx = OH_Archive_Writer_OpenFile(outfile, OH_ARCHIVE_OPEN_MODE_APPEND, OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(OH_Archive_Writer_Add(ctx, infileB, 1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Close(ctx), OH_ARCHIVE_OK);
+
+    const char* infileC[] = {"./append_c.txt"};
+    OH_Archive_FileIoOptions options = {OH_ARCHIVE_FILE_IO_MAPPED, 4096}; // 4K缓冲区
+    ctx = OH_Archive_Writer_OpenFileWithOptions(outfile, OH_ARCHIVE_OPEN_MODE_APPEND, OH_ARCHIVE_FMT_ZIP, &options);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(OH_Archive_Writer_Add(ctx, infileC, 1), OH_ARCHIVE_OK);
+    EXPECT_EQ(OH_Archive_Writer_Close(ctx), OH_ARCHIVE_OK);
+
+    reader = OH_Archive_Reader_OpenFile(outfile);
+    ASSERT_NE(reader, nullptr);
+    uint64_t count = 0;
+    EXPECT_EQ(OH_Archive_Reader_GetEntryCount(reader, &count), OH_ARCHIVE_OK);
+    EXPECT_EQ(count, 5u); // 两个目录和三个文件
+    // 已有条目原地保留
+    OH_Archive_EntryInfo info;
+    ASSERT_EQ(OH_Archive_Reader_FindEntry(reader, "append_a/a.txt", &index), OH_ARCHIVE_OK);
+    ASSERT_EQ(OH_Archive_Reader_GetEntryInfo(reader, index, &info), OH_ARCHIVE_OK);
+    EXPECT_EQ(info.offset, infoA.offset);
+    CheckEntry(reader, "append_a/a.txt", OH_ARCHIVE_COMPRESS_DEFLATE, dataA);
+    CheckEntry(reader, "append_b/b.txt", OH_ARCHIVE_COMPRESS_DEFLATE, dataB);
+    CheckEntry(reader, "append_c.txt", OH_ARCHIVE_COMPRESS_DEFLATE, dataC);
+    EXPECT_EQ(OH_Archive_Reader_Close(reader), OH_ARCHIVE_OK);
+
+    // 非zip文件追加失败且保持原样
+    const std::string notZip = "not a zip archive";
+    WriteTestFile("./append_bad.zip", notZip);
+    ctx = OH_Archive_Writer_OpenFile("./append_bad.zip", OH_ARCHIVE_OPEN_MODE_APPEND, OH_ARCHIVE_FMT_ZIP);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_NE(OH_Archive_Writer_Add(ctx, infileC, 1), OH_ARCHIVE_OK);
+    (void)OH_Archive_Writer_Close(ctx);
+    struct stat statBuf;
+    ASSERT_EQ(stat("./append_bad.zip", &statBuf), 0);
+    EXPECT_EQ(static_cast<uint64_t>(statBuf.st_size), notZip.size());
+}
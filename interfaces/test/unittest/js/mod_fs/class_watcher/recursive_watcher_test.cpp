@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "recursive_watcher.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <sys/inotify.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+
+#include "filemgmt_libfs.h"
+#include "ut_file_utils.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+namespace Test {
+using namespace std;
+
+class RecursiveWatcherTest : public testing::Test {
+public:
+    static void SetUpTestSuite();
+    static void TearDownTestSuite();
+    void SetUp();
+    void TearDown();
+
+protected:
+    RecursiveWatchHandler Recorder();
+    bool WaitForEvent(const string &fileName, uint32_t event);
+
+    const string testDir = FileUtils::testRootDir + "/RecursiveWatcherTest";
+    mutex eventsMutex_;
+    condition_variable eventsCond_;
+    vector<WatchEvent> events_;
+};
+
+void RecursiveWatcherTest::SetUpTestSuite()
+{
+    GTEST_LOG_(INFO) << "SetUpTestSuite";
+    prctl(PR_SET_NAME, "RecursiveWatcherTest");
+}
+
+void RecursiveWatcherTest::TearDownTestSuite()
+{
+    GTEST_LOG_(INFO) << "TearDownTestSuite";
+}
+
+void RecursiveWatcherTest::SetUp()
+{
+    GTEST_LOG_(INFO) << "SetUp";
+    ASSERT_TRUE(FileUtils::CreateDirectories(testDir + "/a/b", true));
+    ASSERT_TRUE(FileUtils::CreateDirectories(testDir + "/c"));
+    events_.clear();
+}
+
+void RecursiveWatcherTest::TearDown()
+{
+    ASSERT_TRUE(FileUtils::RemoveAll(testDir));
+    GTEST_LOG_(INFO) << "TearDown";
+}
+
+RecursiveWatchHandler RecursiveWatcherTest::Recorder()
+{
+    return [this](vector<WatchEvent> &&events) {
+        lock_guard<mutex> lock(eventsMutex_);
+        events_.insert(events_.end(), events.begin(), events.end());
+        eventsCond_.notify_all();
+    };
+}
+
+bool RecursiveWatcherTest::WaitForEvent(const string &fileName, uint32_t event)
+{
+    unique_lock<mutex> lock(eventsMutex_);
+    return eventsCond_.wait_for(lock, chrono::seconds(2), [this, &fileName, event]() {
+        for (const auto &item : events_) {
+            if (item.fileName == fileName && (item.event & event) != 0) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+/**
+ * @tc.name: RecursiveWatcherTest_Start_001
+ * @tc.desc: Test function of RecursiveWatcher::Start interface for SUCCESS, every directory of the tree is watched and
+ * events carry paths relative to the root.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(RecursiveWatcherTest, RecursiveWatcherTest_Start_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-begin RecursiveWatcherTest_Start_001";
+
+    auto watcher = make_shared<RecursiveWatcher>(testDir + "/", IN_CREATE | IN_DELETE);
+    ASSERT_EQ(watcher->Start(Recorder()), ERRNO_NOERR);
+    EXPECT_EQ(watcher->GetWatchCount(), 4);
+
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/a/b/file.txt", 1));
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/root.txt", 1));
+    ASSERT_EQ(remove((testDir + "/a/b/file.txt").c_str()), 0);
+
+    EXPECT_TRUE(WaitForEvent("a/b/file.txt", IN_CREATE));
+    EXPECT_TRUE(WaitForEvent("root.txt", IN_CREATE));
+    EXPECT_TRUE(WaitForEvent("a/b/file.txt", IN_DELETE));
+    watcher->Stop();
+
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-end RecursiveWatcherTest_Start_001";
+}
+
+/**
+ * @tc.name: RecursiveWatcherTest_Start_002
+ * @tc.desc: Test function of RecursiveWatcher::Start interface for SUCCESS, a new directory is watched together with
+ * what was created in it before its watch was added.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(RecursiveWatcherTest, RecursiveWatcherTest_Start_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-begin RecursiveWatcherTest_Start_002";
+
+    auto watcher = make_shared<RecursiveWatcher>(testDir, IN_CREATE);
+    ASSERT_EQ(watcher->Start(Recorder()), ERRNO_NOERR);
+
+    ASSERT_TRUE(FileUtils::CreateDirectories(testDir + "/c/new/deep"));
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/c/new/deep/early.txt", 1));
+    EXPECT_TRUE(WaitForEvent("c/new", IN_CREATE));
+    EXPECT_TRUE(WaitForEvent("c/new/deep/early.txt", IN_CREATE));
+
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/c/new/deep/late.txt", 1));
+    EXPECT_TRUE(WaitForEvent("c/new/deep/late.txt", IN_CREATE));
+    EXPECT_EQ(watcher->GetWatchCount(), 6);
+    watcher->Stop();
+
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-end RecursiveWatcherTest_Start_002";
+}
+
+/**
+ * @tc.name: RecursiveWatcherTest_Start_003
+ * @tc.desc: Test function of RecursiveWatcher::Start interface for SUCCESS, directories renamed inside the tree keep
+ * their watches under the new name and the ones moved out or removed are forgotten.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(RecursiveWatcherTest, RecursiveWatcherTest_Start_003, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-begin RecursiveWatcherTest_Start_003";
+
+    ASSERT_TRUE(FileUtils::CreateDirectories(FileUtils::testRootDir + "/RecursiveWatcherTestOutside"));
+    auto watcher = make_shared<RecursiveWatcher>(testDir, IN_CREATE | IN_MOVED_TO);
+    ASSERT_EQ(watcher->Start(Recorder()), ERRNO_NOERR);
+
+    ASSERT_EQ(rename((testDir + "/a").c_str(), (testDir + "/c/renamed").c_str()), 0);
+    EXPECT_TRUE(WaitForEvent("c/renamed", IN_MOVED_TO));
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/c/renamed/b/file.txt", 1));
+    EXPECT_TRUE(WaitForEvent("c/renamed/b/file.txt", IN_CREATE));
+
+    ASSERT_EQ(rename((testDir + "/c/renamed").c_str(),
+        (FileUtils::testRootDir + "/RecursiveWatcherTestOutside/renamed").c_str()), 0);
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/c/marker.txt", 1));
+    EXPECT_TRUE(WaitForEvent("c/marker.txt", IN_CREATE));
+    EXPECT_EQ(watcher->GetWatchCount(), 2);
+    watcher->Stop();
+    EXPECT_TRUE(FileUtils::RemoveAll(FileUtils::testRootDir + "/RecursiveWatcherTestOutside"));
+
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-end RecursiveWatcherTest_Start_003";
+}
+
+/**
+ * @tc.name: RecursiveWatcherTest_Start_004
+ * @tc.desc: Test function of RecursiveWatcher::Start interface for SUCCESS, a tree over the cap is reported as an
+ * overflow of the root.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(RecursiveWatcherTest, RecursiveWatcherTest_Start_004, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-begin RecursiveWatcherTest_Start_004";
+
+    auto watcher = make_shared<RecursiveWatcher>(testDir, IN_CREATE, 2);
+    ASSERT_EQ(watcher->Start(Recorder()), ERRNO_NOERR);
+    EXPECT_EQ(watcher->GetWatchCount(), 2);
+    EXPECT_TRUE(WaitForEvent("", IN_Q_OVERFLOW));
+    watcher->Stop();
+
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-end RecursiveWatcherTest_Start_004";
+}
+
+/**
+ * @tc.name: RecursiveWatcherTest_Start_005
+ * @tc.desc: Test function of RecursiveWatcher::Start interface for FAILURE when the root is missing or not a
+ * directory.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(RecursiveWatcherTest, RecursiveWatcherTest_Start_005, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-begin RecursiveWatcherTest_Start_005";
+
+    auto missing = make_shared<RecursiveWatcher>(testDir + "/nonExistent", IN_CREATE);
+    EXPECT_EQ(missing->Start(Recorder()), ENOENT);
+
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/file.txt", 1));
+    auto file = make_shared<RecursiveWatcher>(testDir + "/file.txt", IN_CREATE);
+    EXPECT_EQ(file->Start(Recorder()), ENOTDIR);
+
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-end RecursiveWatcherTest_Start_005";
+}
+
+/**
+ * @tc.name: RecursiveWatcherTest_Stop_001
+ * @tc.desc: Test function of RecursiveWatcher::Stop interface for SUCCESS when called from the handler.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(RecursiveWatcherTest, RecursiveWatcherTest_Stop_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-begin RecursiveWatcherTest_Stop_001";
+
+    auto watcher = make_shared<RecursiveWatcher>(testDir, IN_CREATE);
+    weak_ptr<RecursiveWatcher> weakWatcher = watcher;
+    auto record = Recorder();
+    ASSERT_EQ(watcher->Start([weakWatcher, record](vector<WatchEvent> &&events) {
+        if (auto self = weakWatcher.lock()) {
+            self->Stop();
+        }
+        record(move(events));
+    }), ERRNO_NOERR);
+
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/file.txt", 1));
+    EXPECT_TRUE(WaitForEvent("file.txt", IN_CREATE));
+    watcher->Stop();
+    watcher.reset();
+
+    GTEST_LOG_(INFO) << "RecursiveWatcherTest-end RecursiveWatcherTest_Stop_001";
+}
+
+} // namespace Test
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
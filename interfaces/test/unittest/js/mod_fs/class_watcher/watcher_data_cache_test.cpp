@@ -15,6 +15,7 @@
 
 #include "watcher_data_cache.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -224,6 +225,100 @@ HWTEST_F(WatcherDataCacheTest, WatcherDataCacheTest_FindWatchedEvents_003, testi
     GTEST_LOG_(INFO) << "WatcherDataCacheTest-end WatcherDataCacheTest_FindWatchedEvents_003";
 }
 
+/**
+ * @tc.name: WatcherDataCacheTest_FindWatcherInfos_001
+ * @tc.desc: Test function of WatcherDataCache::FindWatcherInfos for SUCCESS, only watchers of the event are returned.
+ * @tc.size: SMALL
+ * @tc.type: FUNC
+ * @tc.level Level 0
+ */
+HWTEST_F(WatcherDataCacheTest, WatcherDataCacheTest_FindWatcherInfos_001, testing::ext::TestSize.Level0)
+{
+    GTEST_LOG_(INFO) << "WatcherDataCacheTest-begin WatcherDataCacheTest_FindWatcherInfos_001";
+    // Prepare test condition
+    WatcherDataCache cache;
+    std::string fileName = "fakePath/WatcherDataCacheTest_FindWatcherInfos_001";
+    auto accessInfo = std::make_shared<WatcherInfo>(nullptr);
+    accessInfo->fileName = fileName;
+    accessInfo->events = IN_ACCESS;
+    accessInfo->wd = EXPECTED_WD;
+    auto deleteInfo = std::make_shared<WatcherInfo>(nullptr);
+    deleteInfo->fileName = fileName;
+    deleteInfo->events = IN_DELETE;
+    deleteInfo->wd = EXPECTED_WD;
+    cache.watcherInfoCache_[fileName] = { accessInfo, deleteInfo };
+    cache.UpdateWatchedEvents(fileName, EXPECTED_WD, IN_ACCESS | IN_DELETE);
+    // Do testing
+    auto [matched, matchedFileName, infos] = cache.FindWatcherInfos(EXPECTED_WD, IN_ACCESS);
+    // Verify results
+    EXPECT_TRUE(matched);
+    EXPECT_EQ(matchedFileName, fileName);
+    ASSERT_EQ(infos.size(), 1);
+    EXPECT_EQ(infos[0], accessInfo);
+    GTEST_LOG_(INFO) << "WatcherDataCacheTest-end WatcherDataCacheTest_FindWatcherInfos_001";
+}
+
+/**
+ * @tc.name: WatcherDataCacheTest_FindWatcherInfos_002
+ * @tc.desc: Test function of WatcherDataCache::FindWatcherInfos for FAILURE when the wd of the file changed.
+ * @tc.size: SMALL
+ * @tc.type: FUNC
+ * @tc.level Level 0
+ */
+HWTEST_F(WatcherDataCacheTest, WatcherDataCacheTest_FindWatcherInfos_002, testing::ext::TestSize.Level0)
+{
+    GTEST_LOG_(INFO) << "WatcherDataCacheTest-begin WatcherDataCacheTest_FindWatcherInfos_002";
+    // Prepare test condition
+    WatcherDataCache cache;
+    std::string fileName = "fakePath/WatcherDataCacheTest_FindWatcherInfos_002";
+    auto info = std::make_shared<WatcherInfo>(nullptr);
+    info->fileName = fileName;
+    info->events = IN_ACCESS;
+    info->wd = EXPECTED_WD;
+    cache.watcherInfoCache_[fileName] = { info };
+    cache.UpdateWatchedEvents(fileName, UNEXPECTED_WD, IN_ACCESS);
+    cache.UpdateWatchedEvents(fileName, EXPECTED_WD, IN_ACCESS);
+    // Do testing
+    auto [staleMatched, staleFileName, staleInfos] = cache.FindWatcherInfos(UNEXPECTED_WD, IN_ACCESS);
+    auto [matched, matchedFileName, infos] = cache.FindWatcherInfos(EXPECTED_WD, IN_ACCESS);
+    // Verify results
+    EXPECT_FALSE(staleMatched);
+    EXPECT_TRUE(staleInfos.empty());
+    EXPECT_TRUE(matched);
+    EXPECT_EQ(infos.size(), 1);
+    EXPECT_EQ(cache.wdIndex_.size(), 1);
+    GTEST_LOG_(INFO) << "WatcherDataCacheTest-end WatcherDataCacheTest_FindWatcherInfos_002";
+}
+
+/**
+ * @tc.name: WatcherDataCacheTest_FindWatcherInfos_003
+ * @tc.desc: Test function of WatcherDataCache::FindWatcherInfos for FAILURE when the watched events were removed.
+ * @tc.size: SMALL
+ * @tc.type: FUNC
+ * @tc.level Level 0
+ */
+HWTEST_F(WatcherDataCacheTest, WatcherDataCacheTest_FindWatcherInfos_003, testing::ext::TestSize.Level0)
+{
+    GTEST_LOG_(INFO) << "WatcherDataCacheTest-begin WatcherDataCacheTest_FindWatcherInfos_003";
+    // Prepare test condition
+    WatcherDataCache cache;
+    std::string fileName = "fakePath/WatcherDataCacheTest_FindWatcherInfos_003";
+    auto info = std::make_shared<WatcherInfo>(nullptr);
+    info->fileName = fileName;
+    info->events = IN_ACCESS;
+    info->wd = EXPECTED_WD;
+    cache.watcherInfoCache_[fileName] = { info };
+    cache.UpdateWatchedEvents(fileName, EXPECTED_WD, IN_ACCESS);
+    // Do testing
+    cache.RemoveWatchedEvents(fileName);
+    auto [matched, matchedFileName, infos] = cache.FindWatcherInfos(EXPECTED_WD, IN_ACCESS);
+    // Verify results
+    EXPECT_FALSE(matched);
+    EXPECT_TRUE(infos.empty());
+    EXPECT_TRUE(cache.wdIndex_.empty());
+    GTEST_LOG_(INFO) << "WatcherDataCacheTest-end WatcherDataCacheTest_FindWatcherInfos_003";
+}
+
 } // namespace Test
 } // namespace ModuleFileIO
 } // namespace FileManagement
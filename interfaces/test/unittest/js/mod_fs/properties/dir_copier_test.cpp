@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dir_copier.h"
+
+#include <gtest/gtest.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+
+#include "filemgmt_libfs.h"
+#include "ut_file_utils.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+namespace Test {
+using namespace std;
+
+class DirCopierTest : public testing::Test {
+public:
+    static void SetUpTestSuite();
+    static void TearDownTestSuite();
+    void SetUp();
+    void TearDown();
+
+protected:
+    const string testDir = FileUtils::testRootDir + "/DirCopierTest";
+    const string srcDir = testDir + "/src";
+    const string destDir = testDir + "/dest";
+    static constexpr size_t workerNum = 4;
+    static constexpr int dirNum = 8;
+    static constexpr int fileNum = 30;
+};
+
+void DirCopierTest::SetUpTestSuite()
+{
+    GTEST_LOG_(INFO) << "SetUpTestSuite";
+    prctl(PR_SET_NAME, "DirCopierTest");
+}
+
+void DirCopierTest::TearDownTestSuite()
+{
+    GTEST_LOG_(INFO) << "TearDownTestSuite";
+}
+
+void DirCopierTest::SetUp()
+{
+    GTEST_LOG_(INFO) << "SetUp";
+    string dir = srcDir;
+    for (int i = 0; i < dirNum; i++) {
+        dir += "/dir" + to_string(i);
+        ASSERT_TRUE(FileUtils::CreateDirectories(dir, true));
+        for (int j = 0; j < fileNum; j++) {
+            ASSERT_TRUE(FileUtils::CreateFile(dir + "/file" + to_string(j), "content" + to_string(j)));
+        }
+    }
+    ASSERT_TRUE(FileUtils::CreateFile(srcDir + "/top.txt", "top"));
+}
+
+void DirCopierTest::TearDown()
+{
+    ASSERT_TRUE(FileUtils::RemoveAll(testDir));
+    GTEST_LOG_(INFO) << "TearDown";
+}
+
+static string ReadContent(const string &path)
+{
+    auto [succ, content] = FileUtils::ReadTextFileContent(path);
+    return succ ? content : "";
+}
+
+/**
+ * @tc.name: DirCopierTest_Copy_001
+ * @tc.desc: Test function of DirCopier::Copy interface for SUCCESS with several workers, every file is copied with
+ * its content and permissions into a new destination.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirCopierTest, DirCopierTest_Copy_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirCopierTest-begin DirCopierTest_Copy_001";
+
+    ASSERT_EQ(chmod((srcDir + "/top.txt").c_str(), 0640), 0);
+    vector<DirCopyConflict> conflicts;
+    DirCopyOptions options;
+    options.workerNum = workerNum;
+    EXPECT_EQ(DirCopier(options).Copy(srcDir, destDir, conflicts), ERRNO_NOERR);
+    EXPECT_TRUE(conflicts.empty());
+
+    string dir = destDir;
+    for (int i = 0; i < dirNum; i++) {
+        dir += "/dir" + to_string(i);
+        EXPECT_EQ(ReadContent(dir + "/file" + to_string(fileNum - 1)), "content" + to_string(fileNum - 1));
+    }
+    struct stat info;
+    ASSERT_EQ(stat((destDir + "/top.txt").c_str(), &info), 0);
+    EXPECT_EQ(info.st_mode & 0777, 0640);
+    EXPECT_EQ(ReadContent(destDir + "/top.txt"), "top");
+
+    GTEST_LOG_(INFO) << "DirCopierTest-end DirCopierTest_Copy_001";
+}
+
+/**
+ * @tc.name: DirCopierTest_Copy_002
+ * @tc.desc: Test function of DirCopier::Copy interface when existing files are kept, they are reported in the order
+ * of the serial copy, depth first with alphasort, and left as they are while the other files are copied.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirCopierTest, DirCopierTest_Copy_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirCopierTest-begin DirCopierTest_Copy_002";
+
+    ASSERT_TRUE(FileUtils::CreateDirectories(destDir + "/dir0/dir1", true));
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/dir0/dir1/file3", "old"));
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/dir0/file5", "old"));
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/top.txt", "old"));
+    ASSERT_TRUE(FileUtils::CreateFile(srcDir + "/dir0.txt", "new"));
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/dir0.txt", "old"));
+
+    vector<DirCopyConflict> conflicts;
+    DirCopyOptions options;
+    options.workerNum = workerNum;
+    EXPECT_EQ(DirCopier(options).Copy(srcDir, destDir, conflicts), ERRNO_NOERR);
+    ASSERT_EQ(conflicts.size(), 4U);
+    EXPECT_EQ(conflicts[0].srcFile, srcDir + "/dir0/dir1/file3");
+    EXPECT_EQ(conflicts[0].destFile, destDir + "/dir0/dir1/file3");
+    EXPECT_EQ(conflicts[1].srcFile, srcDir + "/dir0/file5");
+    EXPECT_EQ(conflicts[2].srcFile, srcDir + "/dir0.txt");
+    EXPECT_EQ(conflicts[3].srcFile, srcDir + "/top.txt");
+    EXPECT_EQ(ReadContent(destDir + "/dir0/dir1/file3"), "old");
+    EXPECT_EQ(ReadContent(destDir + "/top.txt"), "old");
+    EXPECT_EQ(ReadContent(destDir + "/dir0/dir1/file4"), "content4");
+
+    GTEST_LOG_(INFO) << "DirCopierTest-end DirCopierTest_Copy_002";
+}
+
+/**
+ * @tc.name: DirCopierTest_Copy_003
+ * @tc.desc: Test function of DirCopier::Copy interface for SUCCESS when existing files are replaced.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirCopierTest, DirCopierTest_Copy_003, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirCopierTest-begin DirCopierTest_Copy_003";
+
+    ASSERT_TRUE(FileUtils::CreateDirectories(destDir + "/dir0", true));
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/dir0/file5", "old content"));
+
+    vector<DirCopyConflict> conflicts;
+    DirCopyOptions options;
+    options.workerNum = workerNum;
+    options.replace = true;
+    EXPECT_EQ(DirCopier(options).Copy(srcDir, destDir, conflicts), ERRNO_NOERR);
+    EXPECT_TRUE(conflicts.empty());
+    EXPECT_EQ(ReadContent(destDir + "/dir0/file5"), "content5");
+
+    GTEST_LOG_(INFO) << "DirCopierTest-end DirCopierTest_Copy_003";
+}
+
+/**
+ * @tc.name: DirCopierTest_Copy_004
+ * @tc.desc: Test function of DirCopier::Copy interface for FAILURE when the source is missing or a directory of the
+ * destination is a file.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirCopierTest, DirCopierTest_Copy_004, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirCopierTest-begin DirCopierTest_Copy_004";
+
+    vector<DirCopyConflict> conflicts;
+    DirCopyOptions options;
+    options.workerNum = workerNum;
+    EXPECT_EQ(DirCopier(options).Copy(testDir + "/missing", destDir, conflicts), ENOENT);
+
+    ASSERT_TRUE(FileUtils::CreateDirectories(destDir, true));
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/dir0", "file"));
+    options.replace = true;
+    EXPECT_EQ(DirCopier(options).Copy(srcDir, destDir, conflicts), ENOTDIR);
+
+    GTEST_LOG_(INFO) << "DirCopierTest-end DirCopierTest_Copy_004";
+}
+
+} // namespace Test
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
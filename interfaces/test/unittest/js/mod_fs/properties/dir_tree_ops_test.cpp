@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dir_tree_ops.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "filemgmt_libfs.h"
+#include "ut_file_utils.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+namespace Test {
+using namespace std;
+
+class DirTreeOpsTest : public testing::Test {
+public:
+    static void SetUpTestSuite();
+    static void TearDownTestSuite();
+    void SetUp();
+    void TearDown();
+
+protected:
+    const string testDir = FileUtils::testRootDir + "/DirTreeOpsTest";
+    const string srcDir = testDir + "/src";
+    const string destDir = testDir + "/dest";
+    static constexpr int32_t fileSize = 64;
+};
+
+void DirTreeOpsTest::SetUpTestSuite()
+{
+    GTEST_LOG_(INFO) << "SetUpTestSuite";
+    prctl(PR_SET_NAME, "DirTreeOpsTest");
+}
+
+void DirTreeOpsTest::TearDownTestSuite()
+{
+    GTEST_LOG_(INFO) << "TearDownTestSuite";
+}
+
+void DirTreeOpsTest::SetUp()
+{
+    GTEST_LOG_(INFO) << "SetUp";
+    ASSERT_TRUE(FileUtils::CreateDirectories(srcDir + "/dir/sub", true));
+    ASSERT_TRUE(FileUtils::CreateDirectories(destDir, true));
+    ASSERT_TRUE(FileUtils::CreateFile(srcDir + "/file.txt", fileSize));
+    ASSERT_TRUE(FileUtils::CreateFile(srcDir + "/dir/sub/deep.txt", fileSize));
+}
+
+void DirTreeOpsTest::TearDown()
+{
+    ASSERT_TRUE(FileUtils::RemoveAll(testDir));
+    GTEST_LOG_(INFO) << "TearDown";
+}
+
+static bool IsDir(const string &path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_MakeDirs_001
+ * @tc.desc: Test function of DirTreeOps::MakeDirs interface for SUCCESS when several parents are missing or the
+ * directory exists.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_MakeDirs_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_MakeDirs_001";
+
+    string path = testDir + "/a//b/./c/d/";
+    EXPECT_EQ(DirTreeOps::MakeDirs(path, MAKE_DIRS_DEFAULT_MODE), ERRNO_NOERR);
+    EXPECT_TRUE(IsDir(testDir + "/a/b/c/d"));
+    EXPECT_EQ(DirTreeOps::MakeDirs(path, MAKE_DIRS_DEFAULT_MODE), ERRNO_NOERR);
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_MakeDirs_001";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_MakeDirs_002
+ * @tc.desc: Test function of DirTreeOps::MakeDirs interface for FAILURE when a component is a file.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_MakeDirs_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_MakeDirs_002";
+
+    string file = srcDir + "/file.txt";
+    EXPECT_EQ(DirTreeOps::MakeDirs(file, MAKE_DIRS_DEFAULT_MODE), EEXIST);
+    EXPECT_EQ(DirTreeOps::MakeDirs(file + "/a/b", MAKE_DIRS_DEFAULT_MODE), ENOTDIR);
+    EXPECT_EQ(DirTreeOps::MakeDirs(testDir + "/x/y", MAKE_DIRS_DEFAULT_MODE), ERRNO_NOERR);
+    ASSERT_TRUE(FileUtils::CreateFile(testDir + "/x/y/z"));
+    EXPECT_EQ(DirTreeOps::MakeDirs(testDir + "/x/y/z/w", MAKE_DIRS_DEFAULT_MODE), ENOTDIR);
+    EXPECT_EQ(DirTreeOps::MakeDirs("", MAKE_DIRS_DEFAULT_MODE), ENOENT);
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_MakeDirs_002";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_MoveDir_001
+ * @tc.desc: Test function of DirTreeOps::MoveDir interface for SUCCESS when the target does not exist.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_MoveDir_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_MoveDir_001";
+
+    deque<ErrFiles> errFiles;
+    EXPECT_EQ(DirTreeOps::MoveDir(srcDir, destDir, DIRMODE_DIRECTORY_THROW_ERR, errFiles), ERRNO_NOERR);
+    EXPECT_TRUE(errFiles.empty());
+    EXPECT_FALSE(FileUtils::Exists(srcDir));
+    EXPECT_TRUE(FileUtils::Exists(destDir + "/src/file.txt"));
+    EXPECT_TRUE(FileUtils::Exists(destDir + "/src/dir/sub/deep.txt"));
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_MoveDir_001";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_MoveDir_002
+ * @tc.desc: Test function of DirTreeOps::MoveDir interface for FAILURE when the target is not empty and the mode
+ * throws on directories, and for SUCCESS when the mode replaces them.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_MoveDir_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_MoveDir_002";
+
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/src/old.txt", fileSize));
+    deque<ErrFiles> errFiles;
+    EXPECT_EQ(DirTreeOps::MoveDir(srcDir, destDir, DIRMODE_DIRECTORY_THROW_ERR, errFiles), ENOTEMPTY);
+    EXPECT_TRUE(FileUtils::Exists(srcDir + "/file.txt"));
+
+    EXPECT_EQ(DirTreeOps::MoveDir(srcDir, destDir, DIRMODE_DIRECTORY_REPLACE, errFiles), ERRNO_NOERR);
+    EXPECT_TRUE(errFiles.empty());
+    EXPECT_FALSE(FileUtils::Exists(srcDir));
+    EXPECT_FALSE(FileUtils::Exists(destDir + "/src/old.txt"));
+    EXPECT_TRUE(FileUtils::Exists(destDir + "/src/dir/sub/deep.txt"));
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_MoveDir_002";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_MoveDir_003
+ * @tc.desc: Test function of DirTreeOps::MoveDir interface for FAILURE when files conflict and the mode throws on
+ * files, the conflicts are reported and left in place while the rest is merged.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_MoveDir_003, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_MoveDir_003";
+
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/src/dir/sub/deep.txt", 1));
+    ASSERT_TRUE(FileUtils::CreateDirectories(destDir + "/src/file.txt", true));
+    deque<ErrFiles> errFiles;
+    EXPECT_EQ(DirTreeOps::MoveDir(srcDir, destDir, DIRMODE_FILE_THROW_ERR, errFiles), EEXIST);
+    ASSERT_EQ(errFiles.size(), 2);
+    // A file that would replace a directory is reported first
+    EXPECT_EQ(errFiles[0].srcFiles, srcDir + "/file.txt");
+    EXPECT_EQ(errFiles[0].destFiles, destDir + "/src/file.txt");
+    EXPECT_EQ(errFiles[1].srcFiles, srcDir + "/dir/sub/deep.txt");
+    EXPECT_EQ(errFiles[1].destFiles, destDir + "/src/dir/sub/deep.txt");
+    EXPECT_TRUE(FileUtils::Exists(srcDir + "/dir/sub/deep.txt"));
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_MoveDir_003";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_MoveDir_004
+ * @tc.desc: Test function of DirTreeOps::MoveDir interface for SUCCESS when files conflict and the mode replaces
+ * them.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_MoveDir_004, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_MoveDir_004";
+
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/src/dir/sub/deep.txt", 1));
+    ASSERT_TRUE(FileUtils::CreateFile(destDir + "/src/other.txt", 1));
+    deque<ErrFiles> errFiles;
+    EXPECT_EQ(DirTreeOps::MoveDir(srcDir, destDir, DIRMODE_FILE_REPLACE, errFiles), ERRNO_NOERR);
+    EXPECT_TRUE(errFiles.empty());
+    EXPECT_FALSE(FileUtils::Exists(srcDir));
+    struct stat info;
+    ASSERT_EQ(stat((destDir + "/src/dir/sub/deep.txt").c_str(), &info), 0);
+    EXPECT_EQ(info.st_size, fileSize);
+    EXPECT_TRUE(FileUtils::Exists(destDir + "/src/other.txt"));
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_MoveDir_004";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_MoveDir_005
+ * @tc.desc: Test function of DirTreeOps::MoveDir interface for FAILURE when src has no parent or does not exist.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_MoveDir_005, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_MoveDir_005";
+
+    deque<ErrFiles> errFiles;
+    EXPECT_EQ(DirTreeOps::MoveDir("src", destDir, DIRMODE_FILE_REPLACE, errFiles), EINVAL);
+    EXPECT_EQ(DirTreeOps::MoveDir(testDir + "/nonExistent", destDir, DIRMODE_FILE_REPLACE, errFiles), ENOENT);
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_MoveDir_005";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_MoveDir_006
+ * @tc.desc: Test function of DirTreeOps::MoveDir interface for SUCCESS with several workers, whether the target is
+ * missing or an empty directory.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_MoveDir_006, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_MoveDir_006";
+
+    constexpr size_t workerNum = 4;
+    deque<ErrFiles> errFiles;
+    EXPECT_EQ(DirTreeOps::MoveDir(srcDir, destDir, DIRMODE_FILE_THROW_ERR, errFiles, workerNum), ERRNO_NOERR);
+    EXPECT_FALSE(FileUtils::Exists(srcDir));
+    EXPECT_TRUE(FileUtils::Exists(destDir + "/src/dir/sub/deep.txt"));
+
+    ASSERT_TRUE(FileUtils::CreateDirectories(testDir + "/other/src", true));
+    EXPECT_EQ(DirTreeOps::MoveDir(destDir + "/src", testDir + "/other", DIRMODE_FILE_THROW_ERR, errFiles, workerNum),
+        ERRNO_NOERR);
+    EXPECT_TRUE(errFiles.empty());
+    EXPECT_FALSE(FileUtils::Exists(destDir + "/src"));
+    EXPECT_TRUE(FileUtils::Exists(testDir + "/other/src/dir/sub/deep.txt"));
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_MoveDir_006";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_CopyFileData_001
+ * @tc.desc: Test function of DirTreeOps::CopyFileData interface for SUCCESS with a file larger than one chunk and
+ * an empty file.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_CopyFileData_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_CopyFileData_001";
+
+    constexpr int32_t bigSize = 3 * 1024 * 1024 + 7;
+    string src = srcDir + "/big.bin";
+    string dest = destDir + "/big.bin";
+    ASSERT_TRUE(FileUtils::CreateFile(src, bigSize));
+    int srcFd = open(src.c_str(), O_RDONLY);
+    ASSERT_GE(srcFd, 0);
+    int destFd = open(dest.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    ASSERT_GE(destFd, 0);
+    EXPECT_EQ(DirTreeOps::CopyFileData(srcFd, destFd, bigSize), ERRNO_NOERR);
+    EXPECT_EQ(DirTreeOps::CopyFileData(srcFd, destFd, 0), ERRNO_NOERR);
+    close(srcFd);
+    close(destFd);
+    EXPECT_EQ(FileUtils::GetFileSize(dest), bigSize);
+    auto [succSrc, srcContent] = FileUtils::ReadTextFileContent(src);
+    auto [succDest, destContent] = FileUtils::ReadTextFileContent(dest);
+    EXPECT_TRUE(succSrc && succDest);
+    EXPECT_TRUE(srcContent == destContent);
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_CopyFileData_001";
+}
+
+/**
+ * @tc.name: DirTreeOpsTest_CopyFileData_002
+ * @tc.desc: Test function of DirTreeOps::CopyFileData interface for SUCCESS with a sysfs file, whose size is larger
+ * than its content and which copy_file_range may report as empty.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(DirTreeOpsTest, DirTreeOpsTest_CopyFileData_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-begin DirTreeOpsTest_CopyFileData_002";
+
+    string src = "/sys/devices/system/cpu/online";
+    string dest = destDir + "/online";
+    auto [succSrc, srcContent] = FileUtils::ReadTextFileContent(src);
+    ASSERT_TRUE(succSrc);
+    ASSERT_FALSE(srcContent.empty());
+    int srcFd = open(src.c_str(), O_RDONLY);
+    ASSERT_GE(srcFd, 0);
+    struct stat info;
+    ASSERT_EQ(fstat(srcFd, &info), 0);
+    int destFd = open(dest.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    ASSERT_GE(destFd, 0);
+    EXPECT_EQ(DirTreeOps::CopyFileData(srcFd, destFd, info.st_size), ERRNO_NOERR);
+    close(srcFd);
+    close(destFd);
+    auto [succDest, destContent] = FileUtils::ReadTextFileContent(dest);
+    EXPECT_TRUE(succDest);
+    EXPECT_EQ(destContent, srcContent);
+
+    GTEST_LOG_(INFO) << "DirTreeOpsTest-end DirTreeOpsTest_CopyFileData_002";
+}
+
+} // namespace Test
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
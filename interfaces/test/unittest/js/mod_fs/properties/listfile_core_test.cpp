@@ -539,6 +539,74 @@ HWTEST_F(ListFileCoreTest, ListFileCoreTest_DoListFile_017, testing::ext::TestSi
     GTEST_LOG_(INFO) << "ListFileCoreTest-end ListFileCoreTest_DoListFile_017";
 }
 
+/**
+ * @tc.name: ListFileCoreTest_DoListFile_018
+ * @tc.desc: Test function of ListFileCore::DoListFile interface for SUCCESS when combining name and size filters in
+ * recursion.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(ListFileCoreTest, ListFileCoreTest_DoListFile_018, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ListFileCoreTest-begin ListFileCoreTest_DoListFile_018";
+
+    FsListFileOptions opt;
+    FsFilter filter;
+    filter.suffix = std::vector<std::string> { ".jpg", ".data" };
+    filter.displayName = std::vector<std::string> { "photo_*", "data_2.data" };
+    filter.fileSizeOver = 600;
+    opt.filter = filter;
+    opt.recursion = true;
+
+    auto result = ListFileCore::DoListFile(dataDir, opt);
+
+    ASSERT_TRUE(result.IsSuccess());
+    auto files = result.GetData().value();
+    ASSERT_EQ(files.size(), 3);
+    // Sort manually by dictionary
+    std::sort(files.begin(), files.end());
+    EXPECT_EQ(files[0], "/level1/level2/photo_3.jpg");
+    EXPECT_EQ(files[1], "/level1/photo_2.jpg");
+    EXPECT_EQ(files[2], "/photo_1.jpg");
+
+    GTEST_LOG_(INFO) << "ListFileCoreTest-end ListFileCoreTest_DoListFile_018";
+}
+
+/**
+ * @tc.name: ListFileCoreTest_DoListFile_019
+ * @tc.desc: Test function of ListFileCore::DoListFile interface for SUCCESS when delivering batches in recursion with
+ * listNum.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(ListFileCoreTest, ListFileCoreTest_DoListFile_019, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ListFileCoreTest-begin ListFileCoreTest_DoListFile_019";
+
+    FsListFileOptions opt;
+    opt.recursion = true;
+    opt.listNum = 5;
+
+    std::vector<std::string> files;
+    size_t batchNum = 0;
+    auto sink = [&files, &batchNum](std::vector<std::string> &&batch) {
+        batchNum++;
+        files.insert(files.end(), batch.begin(), batch.end());
+    };
+    auto result = ListFileCore::DoListFile(dataDir, opt, sink);
+
+    ASSERT_TRUE(result.IsSuccess());
+    EXPECT_GE(batchNum, 1);
+    ASSERT_EQ(files.size(), 5);
+    for (const auto &file : files) {
+        EXPECT_EQ(file[0], '/');
+    }
+
+    GTEST_LOG_(INFO) << "ListFileCoreTest-end ListFileCoreTest_DoListFile_019";
+}
+
 } // namespace Test
 } // namespace ModuleFileIO
 } // namespace FileManagement
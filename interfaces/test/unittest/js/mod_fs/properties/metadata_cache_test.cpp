@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "metadata_cache.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "ut_file_utils.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+namespace Test {
+using namespace std;
+
+class MetadataCacheTest : public testing::Test {
+public:
+    static void SetUpTestSuite();
+    static void TearDownTestSuite();
+    void SetUp();
+    void TearDown();
+
+protected:
+    // Stats the path like fs.stat and counts how often the file system was asked
+    int32_t Stat(const string &path, uv_stat_t &buf)
+    {
+        return MetadataCache::GetInstance().GetStat(path, buf, [this, &path](uv_stat_t &statBuf) {
+            loads++;
+            struct stat info;
+            if (stat(path.c_str(), &info) != 0) {
+                return -errno;
+            }
+            statBuf.st_mode = info.st_mode;
+            statBuf.st_nlink = info.st_nlink;
+            statBuf.st_size = static_cast<uint64_t>(info.st_size);
+            return 0;
+        });
+    }
+
+    // Waits for the watcher thread to drop an entry
+    bool WaitInvalidated()
+    {
+        constexpr int32_t retryTimes = 200;
+        for (int32_t i = 0; i < retryTimes; i++) {
+            if (MetadataCache::GetInstance().GetStats().invalidations != 0) {
+                return true;
+            }
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    const string testDir = FileUtils::testRootDir + "/MetadataCacheTest";
+    const string filePath = testDir + "/file.txt";
+    const string otherPath = testDir + "/other.txt";
+    const string subDir = testDir + "/subDir";
+    const string subFilePath = subDir + "/file.txt";
+    const string missingPath = testDir + "/nonExistent";
+    int32_t loads = 0;
+};
+
+void MetadataCacheTest::SetUpTestSuite()
+{
+    GTEST_LOG_(INFO) << "SetUpTestSuite";
+    prctl(PR_SET_NAME, "MetadataCacheTest");
+}
+
+void MetadataCacheTest::TearDownTestSuite()
+{
+    GTEST_LOG_(INFO) << "TearDownTestSuite";
+}
+
+void MetadataCacheTest::SetUp()
+{
+    GTEST_LOG_(INFO) << "SetUp";
+    ASSERT_TRUE(FileUtils::CreateDirectories(subDir, true));
+    ASSERT_TRUE(FileUtils::CreateFile(filePath, 1));
+    ASSERT_TRUE(FileUtils::CreateFile(otherPath, 1));
+    ASSERT_TRUE(FileUtils::CreateFile(subFilePath, 1));
+    loads = 0;
+}
+
+void MetadataCacheTest::TearDown()
+{
+    MetadataCache::GetInstance().Disable();
+    ASSERT_TRUE(FileUtils::RemoveAll(testDir));
+    GTEST_LOG_(INFO) << "TearDown";
+}
+
+/**
+ * @tc.name: MetadataCacheTest_GetStat_001
+ * @tc.desc: Test function of MetadataCache::GetStat interface for SUCCESS, repeated queries are answered from the
+ * cache and missing paths are cached too.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(MetadataCacheTest, MetadataCacheTest_GetStat_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "MetadataCacheTest-begin MetadataCacheTest_GetStat_001";
+
+    auto &cache = MetadataCache::GetInstance();
+    ASSERT_EQ(cache.Enable(MetadataCacheOptions()), ERRNO_NOERR);
+    uv_stat_t buf {};
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(buf.st_size, 1);
+    buf = {};
+    EXPECT_EQ(Stat(filePath + "/", buf), 0);
+    EXPECT_EQ(buf.st_size, 1);
+    EXPECT_EQ(Stat(missingPath, buf), -ENOENT);
+    EXPECT_EQ(Stat(missingPath, buf), -ENOENT);
+    EXPECT_EQ(loads, 2);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.size, 2);
+    EXPECT_EQ(stats.watches, 1);
+
+    GTEST_LOG_(INFO) << "MetadataCacheTest-end MetadataCacheTest_GetStat_001";
+}
+
+/**
+ * @tc.name: MetadataCacheTest_GetStat_002
+ * @tc.desc: Test function of MetadataCache::GetStat interface for SUCCESS, the least recently used entry is evicted
+ * at capacity and relative paths are never cached.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(MetadataCacheTest, MetadataCacheTest_GetStat_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "MetadataCacheTest-begin MetadataCacheTest_GetStat_002";
+
+    auto &cache = MetadataCache::GetInstance();
+    MetadataCacheOptions options;
+    options.capacity = 2;
+    ASSERT_EQ(cache.Enable(options), ERRNO_NOERR);
+    uv_stat_t buf {};
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(Stat(otherPath, buf), 0);
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(Stat(subFilePath, buf), 0);
+    EXPECT_EQ(loads, 3);
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(Stat(otherPath, buf), 0);
+    EXPECT_EQ(loads, 4);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.evictions, 2);
+    EXPECT_EQ(stats.size, 2);
+
+    Stat("MetadataCacheTest.txt", buf);
+    Stat("MetadataCacheTest.txt", buf);
+    EXPECT_EQ(loads, 6);
+
+    GTEST_LOG_(INFO) << "MetadataCacheTest-end MetadataCacheTest_GetStat_002";
+}
+
+/**
+ * @tc.name: MetadataCacheTest_GetStat_003
+ * @tc.desc: Test function of MetadataCache::GetStat interface for SUCCESS, entries expire with the ttl.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(MetadataCacheTest, MetadataCacheTest_GetStat_003, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "MetadataCacheTest-begin MetadataCacheTest_GetStat_003";
+
+    auto &cache = MetadataCache::GetInstance();
+    MetadataCacheOptions options;
+    options.ttlMs = 50;
+    ASSERT_EQ(cache.Enable(options), ERRNO_NOERR);
+    uv_stat_t buf {};
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(loads, 1);
+    this_thread::sleep_for(chrono::milliseconds(100));
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(loads, 2);
+
+    GTEST_LOG_(INFO) << "MetadataCacheTest-end MetadataCacheTest_GetStat_003";
+}
+
+/**
+ * @tc.name: MetadataCacheTest_GetStat_004
+ * @tc.desc: Test function of MetadataCache::GetStat interface for SUCCESS, a change of the file drops its entry
+ * through the directory watch.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(MetadataCacheTest, MetadataCacheTest_GetStat_004, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "MetadataCacheTest-begin MetadataCacheTest_GetStat_004";
+
+    auto &cache = MetadataCache::GetInstance();
+    MetadataCacheOptions options;
+    options.ttlMs = 0;
+    ASSERT_EQ(cache.Enable(options), ERRNO_NOERR);
+    ASSERT_EQ(chmod(filePath.c_str(), 0644), 0);
+    uv_stat_t buf {};
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(buf.st_mode & 0777, 0644);
+
+    ASSERT_EQ(chmod(filePath.c_str(), 0600), 0);
+    ASSERT_TRUE(WaitInvalidated());
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(buf.st_mode & 0777, 0600);
+    EXPECT_EQ(loads, 2);
+
+    GTEST_LOG_(INFO) << "MetadataCacheTest-end MetadataCacheTest_GetStat_004";
+}
+
+/**
+ * @tc.name: MetadataCacheTest_GetStat_005
+ * @tc.desc: Test function of MetadataCache::GetStat interface for SUCCESS, a cached directory is watched itself and
+ * a change of its content drops its entry.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(MetadataCacheTest, MetadataCacheTest_GetStat_005, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "MetadataCacheTest-begin MetadataCacheTest_GetStat_005";
+
+    auto &cache = MetadataCache::GetInstance();
+    MetadataCacheOptions options;
+    options.ttlMs = 0;
+    ASSERT_EQ(cache.Enable(options), ERRNO_NOERR);
+    uv_stat_t buf {};
+    // The first miss of a directory loads it again once it is watched
+    EXPECT_EQ(Stat(subDir, buf), 0);
+    uint64_t nlink = buf.st_nlink;
+    EXPECT_EQ(Stat(subDir, buf), 0);
+    EXPECT_EQ(loads, 2);
+    EXPECT_EQ(cache.GetStats().watches, 2);
+
+    ASSERT_TRUE(FileUtils::CreateDirectories(subDir + "/newDir"));
+    ASSERT_TRUE(WaitInvalidated());
+    EXPECT_EQ(Stat(subDir, buf), 0);
+    EXPECT_EQ(buf.st_nlink, nlink + 1);
+    EXPECT_EQ(loads, 4);
+
+    GTEST_LOG_(INFO) << "MetadataCacheTest-end MetadataCacheTest_GetStat_005";
+}
+
+/**
+ * @tc.name: MetadataCacheTest_GetAccess_001
+ * @tc.desc: Test function of MetadataCache::GetAccess and GetLocation interfaces for SUCCESS, every mode and the
+ * location are cached apart in the same entry.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(MetadataCacheTest, MetadataCacheTest_GetAccess_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "MetadataCacheTest-begin MetadataCacheTest_GetAccess_001";
+
+    auto &cache = MetadataCache::GetInstance();
+    ASSERT_EQ(cache.Enable(MetadataCacheOptions()), ERRNO_NOERR);
+    auto access = [this](int32_t mode) {
+        return MetadataCache::GetInstance().GetAccess(filePath, mode, [this, mode]() {
+            loads++;
+            return ::access(filePath.c_str(), mode) == 0 ? 0 : -errno;
+        });
+    };
+    EXPECT_EQ(access(F_OK), 0);
+    EXPECT_EQ(access(F_OK), 0);
+    EXPECT_EQ(access(R_OK), 0);
+    EXPECT_EQ(access(R_OK), 0);
+    EXPECT_EQ(loads, 2);
+
+    auto location = [this]() {
+        return MetadataCache::GetInstance().GetLocation(filePath, [this]() {
+            loads++;
+            return 1;
+        });
+    };
+    EXPECT_EQ(location(), 1);
+    EXPECT_EQ(location(), 1);
+    EXPECT_EQ(loads, 3);
+    EXPECT_EQ(cache.GetStats().size, 1);
+
+    GTEST_LOG_(INFO) << "MetadataCacheTest-end MetadataCacheTest_GetAccess_001";
+}
+
+/**
+ * @tc.name: MetadataCacheTest_Invalidate_001
+ * @tc.desc: Test function of MetadataCache::Invalidate and Disable interfaces for SUCCESS.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(MetadataCacheTest, MetadataCacheTest_Invalidate_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "MetadataCacheTest-begin MetadataCacheTest_Invalidate_001";
+
+    auto &cache = MetadataCache::GetInstance();
+    ASSERT_EQ(cache.Enable(MetadataCacheOptions()), ERRNO_NOERR);
+    uv_stat_t buf {};
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(Stat(subFilePath, buf), 0);
+    EXPECT_EQ(Stat(subDir, buf), 0);
+    EXPECT_EQ(cache.GetStats().watches, 2);
+
+    cache.Invalidate(subDir + "/");
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.invalidations, 2);
+    EXPECT_EQ(stats.size, 1);
+    EXPECT_EQ(stats.watches, 1);
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(loads, 3);
+
+    cache.Disable();
+    EXPECT_FALSE(cache.IsEnabled());
+    stats = cache.GetStats();
+    EXPECT_EQ(stats.size, 0);
+    EXPECT_EQ(stats.watches, 0);
+    EXPECT_EQ(stats.hits, 0);
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(Stat(filePath, buf), 0);
+    EXPECT_EQ(loads, 5);
+
+    MetadataCacheOptions options;
+    options.capacity = 0;
+    EXPECT_EQ(cache.Enable(options), EINVAL);
+
+    GTEST_LOG_(INFO) << "MetadataCacheTest-end MetadataCacheTest_Invalidate_001";
+}
+
+} // namespace Test
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "read_dir_with_stats_core.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+
+#include "ut_file_utils.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+namespace Test {
+using namespace std;
+
+class ReadDirWithStatsCoreTest : public testing::Test {
+public:
+    static void SetUpTestSuite();
+    static void TearDownTestSuite();
+    void SetUp();
+    void TearDown();
+
+protected:
+    const string testDir = FileUtils::testRootDir + "/ReadDirWithStatsCoreTest";
+    const string dataDir = testDir + "/data";
+    static constexpr int32_t fileSize = 256;
+};
+
+void ReadDirWithStatsCoreTest::SetUpTestSuite()
+{
+    GTEST_LOG_(INFO) << "SetUpTestSuite";
+    prctl(PR_SET_NAME, "ReadDirWithStatsCoreTest");
+}
+
+void ReadDirWithStatsCoreTest::TearDownTestSuite()
+{
+    GTEST_LOG_(INFO) << "TearDownTestSuite";
+}
+
+void ReadDirWithStatsCoreTest::SetUp()
+{
+    GTEST_LOG_(INFO) << "SetUp";
+    ASSERT_TRUE(FileUtils::CreateDirectories(testDir, true));
+    ASSERT_TRUE(FileUtils::CreateDirectories(dataDir + "/subDir"));
+    ASSERT_TRUE(FileUtils::CreateFile(dataDir + "/file_1.txt", fileSize));
+    ASSERT_TRUE(FileUtils::CreateFile(dataDir + "/file_2.txt", fileSize));
+}
+
+void ReadDirWithStatsCoreTest::TearDown()
+{
+    ASSERT_TRUE(FileUtils::RemoveAll(testDir));
+    GTEST_LOG_(INFO) << "TearDown";
+}
+
+static size_t IndexOf(const FsDirStats &stats, const string &name)
+{
+    return find(stats.names.begin(), stats.names.end(), name) - stats.names.begin();
+}
+
+/**
+ * @tc.name: ReadDirWithStatsCoreTest_DoReadDirWithStats_001
+ * @tc.desc: Test function of ReadDirWithStatsCore::DoReadDirWithStats interface for SUCCESS with all fields.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(ReadDirWithStatsCoreTest, ReadDirWithStatsCoreTest_DoReadDirWithStats_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-begin ReadDirWithStatsCoreTest_DoReadDirWithStats_001";
+
+    auto result = ReadDirWithStatsCore::DoReadDirWithStats(dataDir);
+
+    ASSERT_TRUE(result.IsSuccess());
+    const auto &stats = result.GetData().value();
+    ASSERT_EQ(stats.names.size(), 3);
+    ASSERT_EQ(stats.types.size(), 3);
+    ASSERT_EQ(stats.sizes.size(), 3);
+    ASSERT_EQ(stats.modes.size(), 3);
+    ASSERT_EQ(stats.mtimes.size(), 3);
+    ASSERT_EQ(stats.inos.size(), 3);
+
+    size_t file = IndexOf(stats, "file_1.txt");
+    size_t dir = IndexOf(stats, "subDir");
+    ASSERT_LT(file, stats.names.size());
+    ASSERT_LT(dir, stats.names.size());
+    EXPECT_EQ(stats.types[file], DIR_ENTRY_TYPE_FILE);
+    EXPECT_EQ(stats.sizes[file], fileSize);
+    EXPECT_TRUE(S_ISREG(stats.modes[file]));
+    EXPECT_GT(stats.mtimes[file], 0);
+    EXPECT_EQ(stats.types[dir], DIR_ENTRY_TYPE_DIRECTORY);
+    EXPECT_TRUE(S_ISDIR(stats.modes[dir]));
+
+    struct stat info;
+    ASSERT_EQ(stat((dataDir + "/file_1.txt").c_str(), &info), 0);
+    EXPECT_EQ(stats.inos[file], info.st_ino);
+
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-end ReadDirWithStatsCoreTest_DoReadDirWithStats_001";
+}
+
+/**
+ * @tc.name: ReadDirWithStatsCoreTest_DoReadDirWithStats_002
+ * @tc.desc: Test function of ReadDirWithStatsCore::DoReadDirWithStats interface for SUCCESS when only some fields are
+ * requested.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(ReadDirWithStatsCoreTest, ReadDirWithStatsCoreTest_DoReadDirWithStats_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-begin ReadDirWithStatsCoreTest_DoReadDirWithStats_002";
+
+    auto result = ReadDirWithStatsCore::DoReadDirWithStats(dataDir, DIR_STATS_FIELD_SIZE);
+
+    ASSERT_TRUE(result.IsSuccess());
+    const auto &stats = result.GetData().value();
+    ASSERT_EQ(stats.names.size(), 3);
+    ASSERT_EQ(stats.sizes.size(), 3);
+    EXPECT_TRUE(stats.types.empty());
+    EXPECT_TRUE(stats.modes.empty());
+    EXPECT_TRUE(stats.mtimes.empty());
+    EXPECT_TRUE(stats.inos.empty());
+    EXPECT_EQ(stats.sizes[IndexOf(stats, "file_2.txt")], fileSize);
+
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-end ReadDirWithStatsCoreTest_DoReadDirWithStats_002";
+}
+
+/**
+ * @tc.name: ReadDirWithStatsCoreTest_DoReadDirWithStats_003
+ * @tc.desc: Test function of ReadDirWithStatsCore::DoReadDirWithStats interface for SUCCESS when only the type is
+ * requested.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(ReadDirWithStatsCoreTest, ReadDirWithStatsCoreTest_DoReadDirWithStats_003, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-begin ReadDirWithStatsCoreTest_DoReadDirWithStats_003";
+
+    auto result = ReadDirWithStatsCore::DoReadDirWithStats(dataDir, DIR_STATS_FIELD_TYPE);
+
+    ASSERT_TRUE(result.IsSuccess());
+    const auto &stats = result.GetData().value();
+    ASSERT_EQ(stats.types.size(), 3);
+    EXPECT_TRUE(stats.sizes.empty());
+    EXPECT_EQ(stats.types[IndexOf(stats, "file_1.txt")], DIR_ENTRY_TYPE_FILE);
+    EXPECT_EQ(stats.types[IndexOf(stats, "subDir")], DIR_ENTRY_TYPE_DIRECTORY);
+
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-end ReadDirWithStatsCoreTest_DoReadDirWithStats_003";
+}
+
+/**
+ * @tc.name: ReadDirWithStatsCoreTest_DoReadDirWithStats_004
+ * @tc.desc: Test function of ReadDirWithStatsCore::DoReadDirWithStats interface for FAILURE when fields is invalid.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(ReadDirWithStatsCoreTest, ReadDirWithStatsCoreTest_DoReadDirWithStats_004, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-begin ReadDirWithStatsCoreTest_DoReadDirWithStats_004";
+
+    auto result = ReadDirWithStatsCore::DoReadDirWithStats(dataDir, 0);
+    EXPECT_FALSE(result.IsSuccess());
+    EXPECT_EQ(result.GetError().GetErrNo(), 13900020);
+
+    result = ReadDirWithStatsCore::DoReadDirWithStats(dataDir, DIR_STATS_FIELD_ALL + 1);
+    EXPECT_FALSE(result.IsSuccess());
+    EXPECT_EQ(result.GetError().GetErrNo(), 13900020);
+
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-end ReadDirWithStatsCoreTest_DoReadDirWithStats_004";
+}
+
+/**
+ * @tc.name: ReadDirWithStatsCoreTest_DoReadDirWithStats_005
+ * @tc.desc: Test function of ReadDirWithStatsCore::DoReadDirWithStats interface for FAILURE when the dir does not
+ * exist or is a file.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(ReadDirWithStatsCoreTest, ReadDirWithStatsCoreTest_DoReadDirWithStats_005, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-begin ReadDirWithStatsCoreTest_DoReadDirWithStats_005";
+
+    auto result = ReadDirWithStatsCore::DoReadDirWithStats(testDir + "/nonExistent");
+    EXPECT_FALSE(result.IsSuccess());
+    EXPECT_EQ(result.GetError().GetErrNo(), 13900002);
+
+    result = ReadDirWithStatsCore::DoReadDirWithStats(dataDir + "/file_1.txt");
+    EXPECT_FALSE(result.IsSuccess());
+    EXPECT_EQ(result.GetError().GetErrNo(), 13900018);
+
+    GTEST_LOG_(INFO) << "ReadDirWithStatsCoreTest-end ReadDirWithStatsCoreTest_DoReadDirWithStats_005";
+}
+
+} // namespace Test
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
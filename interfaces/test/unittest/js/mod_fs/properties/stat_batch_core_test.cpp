@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stat_batch_core.h"
+
+#include <gtest/gtest.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+
+#include "ut_file_utils.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+namespace Test {
+using namespace std;
+
+class StatBatchCoreTest : public testing::Test {
+public:
+    static void SetUpTestSuite();
+    static void TearDownTestSuite();
+    void SetUp();
+    void TearDown();
+
+protected:
+    const string testDir = FileUtils::testRootDir + "/StatBatchCoreTest";
+    const string filePath = testDir + "/file.txt";
+    const string dirPath = testDir + "/subDir";
+    const string missingPath = testDir + "/nonExistent";
+    static constexpr int32_t fileSize = 256;
+};
+
+void StatBatchCoreTest::SetUpTestSuite()
+{
+    GTEST_LOG_(INFO) << "SetUpTestSuite";
+    prctl(PR_SET_NAME, "StatBatchCoreTest");
+}
+
+void StatBatchCoreTest::TearDownTestSuite()
+{
+    GTEST_LOG_(INFO) << "TearDownTestSuite";
+}
+
+void StatBatchCoreTest::SetUp()
+{
+    GTEST_LOG_(INFO) << "SetUp";
+    ASSERT_TRUE(FileUtils::CreateDirectories(dirPath, true));
+    ASSERT_TRUE(FileUtils::CreateFile(filePath, fileSize));
+}
+
+void StatBatchCoreTest::TearDown()
+{
+    ASSERT_TRUE(FileUtils::RemoveAll(testDir));
+    GTEST_LOG_(INFO) << "TearDown";
+}
+
+/**
+ * @tc.name: StatBatchCoreTest_DoStatBatch_001
+ * @tc.desc: Test function of StatBatchCore::DoStatBatch interface for SUCCESS with all fields.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(StatBatchCoreTest, StatBatchCoreTest_DoStatBatch_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-begin StatBatchCoreTest_DoStatBatch_001";
+
+    auto result = StatBatchCore::DoStatBatch({ filePath, dirPath });
+
+    ASSERT_TRUE(result.IsSuccess());
+    const auto &stats = result.GetData().value();
+    ASSERT_EQ(stats.errs.size(), 2);
+    ASSERT_EQ(stats.modes.size(), 2);
+    ASSERT_EQ(stats.sizes.size(), 2);
+    ASSERT_EQ(stats.inos.size(), 2);
+    ASSERT_EQ(stats.uids.size(), 2);
+    ASSERT_EQ(stats.gids.size(), 2);
+    ASSERT_EQ(stats.atimes.size(), 2);
+    ASSERT_EQ(stats.mtimes.size(), 2);
+    ASSERT_EQ(stats.ctimes.size(), 2);
+    ASSERT_EQ(stats.locations.size(), 2);
+
+    struct stat info;
+    ASSERT_EQ(stat(filePath.c_str(), &info), 0);
+    EXPECT_EQ(stats.errs[0], ERRNO_NOERR);
+    EXPECT_EQ(stats.modes[0], info.st_mode);
+    EXPECT_EQ(stats.sizes[0], fileSize);
+    EXPECT_EQ(stats.inos[0], info.st_ino);
+    EXPECT_EQ(stats.uids[0], info.st_uid);
+    EXPECT_EQ(stats.gids[0], info.st_gid);
+    EXPECT_EQ(stats.mtimes[0], info.st_mtime);
+    EXPECT_EQ(stats.ctimes[0], info.st_ctime);
+    EXPECT_EQ(stats.errs[1], ERRNO_NOERR);
+    EXPECT_TRUE(S_ISDIR(stats.modes[1]));
+
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-end StatBatchCoreTest_DoStatBatch_001";
+}
+
+/**
+ * @tc.name: StatBatchCoreTest_DoStatBatch_002
+ * @tc.desc: Test function of StatBatchCore::DoStatBatch interface for SUCCESS when only some fields are requested and
+ * one path is missing.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(StatBatchCoreTest, StatBatchCoreTest_DoStatBatch_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-begin StatBatchCoreTest_DoStatBatch_002";
+
+    StatBatchOptions options;
+    options.fields = STAT_BATCH_FIELD_SIZE;
+    auto result = StatBatchCore::DoStatBatch({ missingPath, filePath }, options);
+
+    ASSERT_TRUE(result.IsSuccess());
+    const auto &stats = result.GetData().value();
+    ASSERT_EQ(stats.errs.size(), 2);
+    ASSERT_EQ(stats.sizes.size(), 2);
+    EXPECT_TRUE(stats.modes.empty());
+    EXPECT_TRUE(stats.inos.empty());
+    EXPECT_TRUE(stats.mtimes.empty());
+    EXPECT_TRUE(stats.locations.empty());
+    EXPECT_EQ(stats.errs[0], ENOENT);
+    EXPECT_EQ(stats.sizes[0], 0);
+    EXPECT_EQ(stats.errs[1], ERRNO_NOERR);
+    EXPECT_EQ(stats.sizes[1], fileSize);
+
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-end StatBatchCoreTest_DoStatBatch_002";
+}
+
+/**
+ * @tc.name: StatBatchCoreTest_DoStatBatch_003
+ * @tc.desc: Test function of StatBatchCore::DoStatBatch interface for SUCCESS when only the location is requested
+ * without syncing.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(StatBatchCoreTest, StatBatchCoreTest_DoStatBatch_003, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-begin StatBatchCoreTest_DoStatBatch_003";
+
+    StatBatchOptions options;
+    options.fields = STAT_BATCH_FIELD_LOCATION;
+    options.dontSync = true;
+    auto result = StatBatchCore::DoStatBatch({ filePath, missingPath }, options);
+
+    ASSERT_TRUE(result.IsSuccess());
+    const auto &stats = result.GetData().value();
+    ASSERT_EQ(stats.locations.size(), 2);
+    EXPECT_TRUE(stats.modes.empty());
+    EXPECT_TRUE(stats.sizes.empty());
+    EXPECT_EQ(stats.errs[0], ERRNO_NOERR);
+    EXPECT_EQ(stats.locations[0], 1);
+    EXPECT_EQ(stats.errs[1], ENOENT);
+    EXPECT_EQ(stats.locations[1], 0);
+
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-end StatBatchCoreTest_DoStatBatch_003";
+}
+
+/**
+ * @tc.name: StatBatchCoreTest_DoStatBatch_004
+ * @tc.desc: Test function of StatBatchCore::DoStatBatch interface for SUCCESS when the paths are split across
+ * threads.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(StatBatchCoreTest, StatBatchCoreTest_DoStatBatch_004, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-begin StatBatchCoreTest_DoStatBatch_004";
+
+    const size_t count = 2048;
+    vector<string> paths;
+    for (size_t i = 0; i < count; i++) {
+        paths.push_back((i % 2 == 0) ? filePath : missingPath);
+    }
+    StatBatchOptions options;
+    options.fields = STAT_BATCH_FIELD_SIZE | STAT_BATCH_FIELD_MODE;
+    auto result = StatBatchCore::DoStatBatch(paths, options);
+
+    ASSERT_TRUE(result.IsSuccess());
+    const auto &stats = result.GetData().value();
+    ASSERT_EQ(stats.sizes.size(), count);
+    for (size_t i = 0; i < count; i++) {
+        if (i % 2 == 0) {
+            ASSERT_EQ(stats.errs[i], ERRNO_NOERR);
+            ASSERT_EQ(stats.sizes[i], fileSize);
+            ASSERT_TRUE(S_ISREG(stats.modes[i]));
+        } else {
+            ASSERT_EQ(stats.errs[i], ENOENT);
+        }
+    }
+
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-end StatBatchCoreTest_DoStatBatch_004";
+}
+
+/**
+ * @tc.name: StatBatchCoreTest_DoStatBatch_005
+ * @tc.desc: Test function of StatBatchCore::DoStatBatch interface for FAILURE when fields or a path is invalid.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(StatBatchCoreTest, StatBatchCoreTest_DoStatBatch_005, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-begin StatBatchCoreTest_DoStatBatch_005";
+
+    StatBatchOptions options;
+    options.fields = 0;
+    auto result = StatBatchCore::DoStatBatch({ filePath }, options);
+    EXPECT_FALSE(result.IsSuccess());
+    EXPECT_EQ(result.GetError().GetErrNo(), 13900020);
+
+    options.fields = STAT_BATCH_FIELD_ALL + 1;
+    result = StatBatchCore::DoStatBatch({ filePath }, options);
+    EXPECT_FALSE(result.IsSuccess());
+    EXPECT_EQ(result.GetError().GetErrNo(), 13900020);
+
+    result = StatBatchCore::DoStatBatch({ filePath, "" });
+    EXPECT_FALSE(result.IsSuccess());
+    EXPECT_EQ(result.GetError().GetErrNo(), 13900020);
+
+    GTEST_LOG_(INFO) << "StatBatchCoreTest-end StatBatchCoreTest_DoStatBatch_005";
+}
+
+} // namespace Test
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
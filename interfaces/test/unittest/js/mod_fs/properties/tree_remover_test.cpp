@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tree_remover.h"
+
+#include <chrono>
+#include <dirent.h>
+#include <gtest/gtest.h>
+#include <sys/prctl.h>
+#include <thread>
+#include <unistd.h>
+
+#include "filemgmt_libfs.h"
+#include "ut_file_utils.h"
+
+namespace OHOS {
+namespace FileManagement {
+namespace ModuleFileIO {
+namespace Test {
+using namespace std;
+
+class TreeRemoverTest : public testing::Test {
+public:
+    static void SetUpTestSuite();
+    static void TearDownTestSuite();
+    void SetUp();
+    void TearDown();
+
+protected:
+    // Creates dirNum directories of fileNum files each, every directory holding the next one, returns the entry count
+    uint64_t CreateTree(const string &root, int dirNum, int fileNum);
+
+    const string testDir = FileUtils::testRootDir + "/TreeRemoverTest";
+    const string treeDir = testDir + "/tree";
+    const string keepDir = testDir + "/keep";
+    static constexpr size_t workerNum = 4;
+};
+
+void TreeRemoverTest::SetUpTestSuite()
+{
+    GTEST_LOG_(INFO) << "SetUpTestSuite";
+    prctl(PR_SET_NAME, "TreeRemoverTest");
+}
+
+void TreeRemoverTest::TearDownTestSuite()
+{
+    GTEST_LOG_(INFO) << "TearDownTestSuite";
+}
+
+void TreeRemoverTest::SetUp()
+{
+    GTEST_LOG_(INFO) << "SetUp";
+    ASSERT_TRUE(FileUtils::CreateDirectories(keepDir, true));
+    ASSERT_TRUE(FileUtils::CreateFile(keepDir + "/keep.txt"));
+}
+
+void TreeRemoverTest::TearDown()
+{
+    ASSERT_TRUE(FileUtils::RemoveAll(testDir));
+    GTEST_LOG_(INFO) << "TearDown";
+}
+
+uint64_t TreeRemoverTest::CreateTree(const string &root, int dirNum, int fileNum)
+{
+    uint64_t count = 0;
+    string dir = root;
+    for (int i = 0; i < dirNum; i++) {
+        EXPECT_TRUE(FileUtils::CreateDirectories(dir + "/side" + to_string(i), true));
+        count++;
+        for (int j = 0; j < fileNum; j++) {
+            EXPECT_TRUE(FileUtils::CreateFile(dir + "/side" + to_string(i) + "/file" + to_string(j)));
+            count++;
+        }
+        dir += "/next";
+        EXPECT_TRUE(FileUtils::CreateDirectories(dir, true));
+        count++;
+    }
+    // The root itself
+    return count + 1;
+}
+
+static size_t CountEntries(const string &path)
+{
+    size_t count = 0;
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return 0;
+    }
+    while (readdir(dir) != nullptr) {
+        count++;
+    }
+    closedir(dir);
+    return count;
+}
+
+/**
+ * @tc.name: TreeRemoverTest_Remove_001
+ * @tc.desc: Test function of TreeRemover::Remove interface for SUCCESS with several workers, a deep tree and a
+ * symbolic link that must not be followed, the last progress reports every entry.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(TreeRemoverTest, TreeRemoverTest_Remove_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "TreeRemoverTest-begin TreeRemoverTest_Remove_001";
+
+    uint64_t total = CreateTree(treeDir, 40, 150);
+    ASSERT_EQ(symlink(keepDir.c_str(), (treeDir + "/next/link").c_str()), 0);
+    total++;
+
+    uint64_t last = 0;
+    bool ordered = true;
+    TreeRemoveOptions options;
+    options.workerNum = workerNum;
+    options.progress = [&last, &ordered](uint64_t removed) {
+        ordered = ordered && removed > last;
+        last = removed;
+    };
+    EXPECT_EQ(TreeRemover(options).Remove(treeDir), ERRNO_NOERR);
+    EXPECT_FALSE(FileUtils::Exists(treeDir));
+    EXPECT_TRUE(FileUtils::Exists(keepDir + "/keep.txt"));
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(last, total);
+
+    GTEST_LOG_(INFO) << "TreeRemoverTest-end TreeRemoverTest_Remove_001";
+}
+
+/**
+ * @tc.name: TreeRemoverTest_Remove_002
+ * @tc.desc: Test function of TreeRemover::Remove interface for a file, an empty directory and missing paths.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(TreeRemoverTest, TreeRemoverTest_Remove_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "TreeRemoverTest-begin TreeRemoverTest_Remove_002";
+
+    TreeRemoveOptions options;
+    options.workerNum = workerNum;
+    EXPECT_EQ(TreeRemover(options).Remove(keepDir + "/keep.txt"), ERRNO_NOERR);
+    EXPECT_FALSE(FileUtils::Exists(keepDir + "/keep.txt"));
+    EXPECT_EQ(TreeRemover(options).Remove(keepDir + "/"), ERRNO_NOERR);
+    EXPECT_FALSE(FileUtils::Exists(keepDir));
+    EXPECT_EQ(TreeRemover(options).Remove(keepDir), ENOENT);
+    EXPECT_EQ(TreeRemover(options).Remove(""), ENOENT);
+
+    GTEST_LOG_(INFO) << "TreeRemoverTest-end TreeRemoverTest_Remove_002";
+}
+
+/**
+ * @tc.name: TreeRemoverTest_Remove_003
+ * @tc.desc: Test function of TreeRemover::Remove interface for FAILURE when canceled, the top directory stays.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(TreeRemoverTest, TreeRemoverTest_Remove_003, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "TreeRemoverTest-begin TreeRemoverTest_Remove_003";
+
+    CreateTree(treeDir, 10, 20);
+    atomic<int> polls { 0 };
+    TreeRemoveOptions options;
+    options.workerNum = workerNum;
+    options.isCanceled = [&polls]() { return polls.fetch_add(1) >= 50; };
+    EXPECT_EQ(TreeRemover(options).Remove(treeDir), ECANCELED);
+    EXPECT_TRUE(FileUtils::Exists(treeDir));
+
+    options.isCanceled = nullptr;
+    EXPECT_EQ(TreeRemover(options).Remove(treeDir), ERRNO_NOERR);
+    EXPECT_FALSE(FileUtils::Exists(treeDir));
+
+    GTEST_LOG_(INFO) << "TreeRemoverTest-end TreeRemoverTest_Remove_003";
+}
+
+/**
+ * @tc.name: TreeRemoverTest_RemoveInBackground_001
+ * @tc.desc: Test function of TreeRemover::RemoveInBackground interface for SUCCESS, the path is gone on return and
+ * the hidden trash directory is removed afterwards.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(TreeRemoverTest, TreeRemoverTest_RemoveInBackground_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "TreeRemoverTest-begin TreeRemoverTest_RemoveInBackground_001";
+
+    CreateTree(treeDir, 10, 50);
+    size_t before = CountEntries(testDir);
+    EXPECT_EQ(TreeRemover::RemoveInBackground(treeDir, workerNum), ERRNO_NOERR);
+    EXPECT_FALSE(FileUtils::Exists(treeDir));
+
+    constexpr int maxWaits = 500;
+    for (int i = 0; i < maxWaits && CountEntries(testDir) != before - 1; i++) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    EXPECT_EQ(CountEntries(testDir), before - 1);
+    EXPECT_TRUE(FileUtils::Exists(keepDir + "/keep.txt"));
+    EXPECT_EQ(TreeRemover::RemoveInBackground(treeDir, workerNum), ENOENT);
+
+    GTEST_LOG_(INFO) << "TreeRemoverTest-end TreeRemoverTest_RemoveInBackground_001";
+}
+
+} // namespace Test
+} // namespace ModuleFileIO
+} // namespace FileManagement
+} // namespace OHOS
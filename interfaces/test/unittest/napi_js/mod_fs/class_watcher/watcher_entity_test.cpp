@@ -15,6 +15,7 @@
 
 #include "watcher_entity.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <thread>
@@ -74,8 +75,10 @@ void WatcherEntityTest::TearDown(void)
     watcher.closed_ = false;
     watcher.notifyFd_ = -1;
     watcher.eventFd_ = -1;
-    watcher.watcherInfoSet_.clear();
+    watcher.watcherInfoMap_.clear();
     watcher.wdFileNameMap_.clear();
+    watcher.wdIndex_.clear();
+    watcher.pendingArgs_.clear();
     GTEST_LOG_(INFO) << "TearDown";
 }
 
@@ -84,6 +87,39 @@ inline const int32_t UNINITIALIZED_NOTIFYFD = -1;
 inline const int32_t INITIALIZED_EVENTFD = 1;
 inline const int32_t UNINITIALIZED_EVENTFD = -1;
 inline const int32_t TOTAL_THREADS = 20;
+inline const int32_t EXPECTED_WD = 100;
+inline const int32_t BATCH_WINDOW_MS = 50;
+
+static std::vector<std::pair<std::vector<WatchEvent>, bool>> g_deliveredEvents;
+
+static void RecordWatcherCallback(napi_env env, LibN::NRef &callback, std::vector<WatchEvent> &&events, bool batched)
+{
+    g_deliveredEvents.emplace_back(std::move(events), batched);
+}
+
+static std::shared_ptr<WatcherInfoArg> CreateWatchedArg(const std::string &fileName, uint32_t events)
+{
+    auto arg = std::make_shared<WatcherInfoArg>(LibN::NVal());
+    arg->fileName = fileName;
+    arg->events = events;
+    arg->wd = EXPECTED_WD;
+    auto &watcher = FileWatcher::GetInstance();
+    watcher.AddWatcherInfo(fileName, arg);
+    watcher.UpdateWatchedWd(fileName, EXPECTED_WD, events);
+    return arg;
+}
+
+static std::vector<char> CreateInotifyEvent(int32_t wd, uint32_t mask, const std::string &name)
+{
+    size_t nameLen = name.empty() ? 0 : name.size() + 1;
+    std::vector<char> buf(sizeof(struct inotify_event) + nameLen, 0);
+    auto *event = reinterpret_cast<struct inotify_event *>(buf.data());
+    event->wd = wd;
+    event->mask = mask;
+    event->len = nameLen;
+    std::copy(name.begin(), name.end(), buf.begin() + sizeof(struct inotify_event));
+    return buf;
+}
 
 /**
  * @tc.name: WatcherEntityTest_CloseNotifyFd_001
@@ -455,7 +491,7 @@ HWTEST_F(WatcherEntityTest, WatcherEntityTest_CloseNotifyFdLocked_005, testing::
     watcher.InitNotify();
     watcher.run_ = true;
     watcher.reading_ = false;
-    watcher.watcherInfoSet_.clear();
+    watcher.watcherInfoMap_.clear();
     EXPECT_GT(watcher.notifyFd_, -1);
     EXPECT_GT(watcher.eventFd_, -1);
     std::vector<std::thread> threads;
@@ -514,7 +550,7 @@ HWTEST_F(WatcherEntityTest, WatcherEntityTest_CloseNotifyFdLocked_006, testing::
             }
             started = true;
             watcher.reading_ = false;
-            watcher.watcherInfoSet_.clear();
+            watcher.watcherInfoMap_.clear();
             int result = watcher.CloseNotifyFdLocked();
             EXPECT_EQ(result, 0);
         });
@@ -544,4 +580,116 @@ HWTEST_F(WatcherEntityTest, WatcherEntityTest_CloseNotifyFdLocked_006, testing::
     GTEST_LOG_(INFO) << "WatcherEntityTest-end WatcherEntityTest_CloseNotifyFdLocked_006";
 }
 
+/**
+ * @tc.name: WatcherEntityTest_NotifyEvent_001
+ * @tc.desc: Test function of WatcherEntityTest::NotifyEvent interface for SUCCESS, the events of one read reach a
+ * watcher in one delivery.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(WatcherEntityTest, WatcherEntityTest_NotifyEvent_001, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "WatcherEntityTest-begin WatcherEntityTest_NotifyEvent_001";
+
+    auto &watcher = FileWatcher::GetInstance();
+    g_deliveredEvents.clear();
+    auto arg = CreateWatchedArg("fakePath/WatcherEntityTest_NotifyEvent_001", IN_CREATE | IN_MODIFY);
+    auto created = CreateInotifyEvent(EXPECTED_WD, IN_CREATE, "a.txt");
+    auto modified = CreateInotifyEvent(EXPECTED_WD, IN_MODIFY, "a.txt");
+    auto otherWd = CreateInotifyEvent(EXPECTED_WD + 1, IN_CREATE, "b.txt");
+
+    watcher.NotifyEvent(reinterpret_cast<struct inotify_event *>(created.data()), RecordWatcherCallback);
+    watcher.NotifyEvent(reinterpret_cast<struct inotify_event *>(modified.data()), RecordWatcherCallback);
+    watcher.NotifyEvent(reinterpret_cast<struct inotify_event *>(otherWd.data()), RecordWatcherCallback);
+    EXPECT_TRUE(g_deliveredEvents.empty());
+    EXPECT_EQ(watcher.NextFlushTimeout(), 0);
+    watcher.FlushPendingEvents(RecordWatcherCallback);
+
+    ASSERT_EQ(g_deliveredEvents.size(), 1);
+    EXPECT_FALSE(g_deliveredEvents[0].second);
+    ASSERT_EQ(g_deliveredEvents[0].first.size(), 2);
+    EXPECT_EQ(g_deliveredEvents[0].first[0].fileName, "fakePath/WatcherEntityTest_NotifyEvent_001/a.txt");
+    EXPECT_EQ(g_deliveredEvents[0].first[0].event, IN_CREATE);
+    EXPECT_EQ(g_deliveredEvents[0].first[1].event, IN_MODIFY);
+    EXPECT_TRUE(watcher.pendingArgs_.empty());
+    EXPECT_TRUE(arg->pending.empty());
+
+    GTEST_LOG_(INFO) << "WatcherEntityTest-end WatcherEntityTest_NotifyEvent_001";
+}
+
+/**
+ * @tc.name: WatcherEntityTest_NotifyEvent_002
+ * @tc.desc: Test function of WatcherEntityTest::NotifyEvent interface for SUCCESS, a batched watcher gets identical
+ * events once and only when its window ends.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(WatcherEntityTest, WatcherEntityTest_NotifyEvent_002, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "WatcherEntityTest-begin WatcherEntityTest_NotifyEvent_002";
+
+    auto &watcher = FileWatcher::GetInstance();
+    g_deliveredEvents.clear();
+    auto arg = CreateWatchedArg("fakePath/WatcherEntityTest_NotifyEvent_002", IN_MODIFY | IN_DELETE);
+    arg->batchWindow = BATCH_WINDOW_MS;
+    auto modified = CreateInotifyEvent(EXPECTED_WD, IN_MODIFY, "a.txt");
+    auto deleted = CreateInotifyEvent(EXPECTED_WD, IN_DELETE, "a.txt");
+
+    for (int i = 0; i < TOTAL_THREADS; ++i) {
+        watcher.NotifyEvent(reinterpret_cast<struct inotify_event *>(modified.data()), RecordWatcherCallback);
+    }
+    watcher.NotifyEvent(reinterpret_cast<struct inotify_event *>(deleted.data()), RecordWatcherCallback);
+    watcher.FlushPendingEvents(RecordWatcherCallback);
+    EXPECT_TRUE(g_deliveredEvents.empty());
+    int timeout = watcher.NextFlushTimeout();
+    EXPECT_GT(timeout, 0);
+    EXPECT_LE(timeout, BATCH_WINDOW_MS + 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+    watcher.FlushPendingEvents(RecordWatcherCallback);
+
+    ASSERT_EQ(g_deliveredEvents.size(), 1);
+    EXPECT_TRUE(g_deliveredEvents[0].second);
+    ASSERT_EQ(g_deliveredEvents[0].first.size(), 2);
+    EXPECT_EQ(g_deliveredEvents[0].first[0].event, IN_MODIFY);
+    EXPECT_EQ(g_deliveredEvents[0].first[1].event, IN_DELETE);
+    EXPECT_EQ(watcher.NextFlushTimeout(), -1);
+
+    GTEST_LOG_(INFO) << "WatcherEntityTest-end WatcherEntityTest_NotifyEvent_002";
+}
+
+/**
+ * @tc.name: WatcherEntityTest_NotifyEvent_003
+ * @tc.desc: Test function of WatcherEntityTest::NotifyEvent interface for SUCCESS, the events pending for a removed
+ * watcher are dropped.
+ * @tc.size: MEDIUM
+ * @tc.type: FUNC
+ * @tc.level Level 1
+ */
+HWTEST_F(WatcherEntityTest, WatcherEntityTest_NotifyEvent_003, testing::ext::TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "WatcherEntityTest-begin WatcherEntityTest_NotifyEvent_003";
+
+    auto &watcher = FileWatcher::GetInstance();
+    g_deliveredEvents.clear();
+    auto arg = CreateWatchedArg("fakePath/WatcherEntityTest_NotifyEvent_003", IN_CREATE);
+    arg->batchWindow = BATCH_WINDOW_MS;
+    auto created = CreateInotifyEvent(EXPECTED_WD, IN_CREATE, "");
+
+    watcher.NotifyEvent(reinterpret_cast<struct inotify_event *>(created.data()), RecordWatcherCallback);
+    EXPECT_EQ(watcher.pendingArgs_.size(), 1);
+    EXPECT_EQ(watcher.RemoveWatcherInfo(arg), 0);
+    watcher.RemoveWatchedWd(arg->fileName);
+
+    EXPECT_TRUE(watcher.pendingArgs_.empty());
+    EXPECT_TRUE(watcher.watcherInfoMap_.empty());
+    EXPECT_TRUE(watcher.wdIndex_.empty());
+    watcher.FlushPendingEvents(RecordWatcherCallback);
+    EXPECT_TRUE(g_deliveredEvents.empty());
+
+    GTEST_LOG_(INFO) << "WatcherEntityTest-end WatcherEntityTest_NotifyEvent_003";
+}
+
 } // namespace OHOS::FileManagement::ModuleFileIO::Test
\ No newline at end of file
@@ -65,8 +65,10 @@ void WatcherMockTest::SetUp()
     watcher.closed_ = false;
     watcher.notifyFd_ = -1;
     watcher.eventFd_ = -1;
-    watcher.watcherInfoSet_.clear();
+    watcher.watcherInfoMap_.clear();
     watcher.wdFileNameMap_.clear();
+    watcher.wdIndex_.clear();
+    watcher.pendingArgs_.clear();
 }
 
 void WatcherMockTest::TearDown()
@@ -79,8 +81,10 @@ void WatcherMockTest::TearDown()
     watcher.closed_ = false;
     watcher.notifyFd_ = -1;
     watcher.eventFd_ = -1;
-    watcher.watcherInfoSet_.clear();
+    watcher.watcherInfoMap_.clear();
     watcher.wdFileNameMap_.clear();
+    watcher.wdIndex_.clear();
+    watcher.pendingArgs_.clear();
 }
 
 /**
@@ -97,7 +101,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_001, testing::ext::TestS
     napi_callback_info info = reinterpret_cast<napi_callback_info>(0x1000);
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(false));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(false));
     EXPECT_CALL(*libnMock, ThrowErr(testing::_));
 
     auto res = Watcher::CreateWatcher(env, info);
@@ -131,7 +135,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_002, testing::ext::TestS
     std::tuple<bool, std::unique_ptr<char[]>, size_t> srcRes = { false, move(srcPtr), 1 };
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ThrowErr(testing::_));
 
@@ -166,7 +170,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_003, testing::ext::TestS
     std::tuple<bool, std::unique_ptr<char[]>, size_t> srcRes = { true, move(srcPtr), 1 };
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(false, 0)));
     EXPECT_CALL(*libnMock, ThrowErr(testing::_));
@@ -202,7 +206,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_004, testing::ext::TestS
     std::tuple<bool, std::unique_ptr<char[]>, size_t> srcRes = { true, move(srcPtr), 1 };
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, 0)));
     EXPECT_CALL(*libnMock, ThrowErr(testing::_));
@@ -238,7 +242,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_005, testing::ext::TestS
     std::tuple<bool, std::unique_ptr<char[]>, size_t> srcRes = { true, move(srcPtr), 1 };
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, -1)));
     EXPECT_CALL(*libnMock, ThrowErr(testing::_));
@@ -274,7 +278,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_006, testing::ext::TestS
     std::tuple<bool, std::unique_ptr<char[]>, size_t> srcRes = { true, move(srcPtr), 1 };
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, IN_CREATE)));
     EXPECT_CALL(*libnMock, TypeIs(testing::_)).WillOnce(testing::Return(false));
@@ -311,7 +315,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_007, testing::ext::TestS
     std::tuple<bool, std::unique_ptr<char[]>, size_t> srcRes = { true, move(srcPtr), 1 };
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, IN_CREATE)));
     EXPECT_CALL(*libnMock, TypeIs(testing::_)).WillOnce(testing::Return(true));
@@ -350,7 +354,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_008, testing::ext::TestS
     std::tuple<bool, std::unique_ptr<char[]>, size_t> srcRes = { true, move(srcPtr), 1 };
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, IN_CREATE)));
     EXPECT_CALL(*libnMock, TypeIs(testing::_)).WillOnce(testing::Return(true));
@@ -392,7 +396,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_009, testing::ext::TestS
     WatcherEntity entity;
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, IN_CREATE)));
     EXPECT_CALL(*libnMock, TypeIs(testing::_)).WillOnce(testing::Return(true));
@@ -432,7 +436,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_010, testing::ext::TestS
 
     auto libnMock = LibnMock::GetMock();
     auto inotifyMock = InotifyMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, IN_CREATE)));
     EXPECT_CALL(*libnMock, TypeIs(testing::_)).WillOnce(testing::Return(true));
@@ -471,7 +475,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_011, testing::ext::TestS
     std::tuple<bool, std::unique_ptr<char[]>, size_t> srcRes = { true, move(srcPtr), 1 };
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     // Use invalid event that will fail CheckEventValid (event not in IN_ALL_EVENTS)
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, ~IN_ALL_EVENTS)));
@@ -512,7 +516,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_012, testing::ext::TestS
 
     auto libnMock = LibnMock::GetMock();
     auto inotifyMock = InotifyMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, IN_ALL_EVENTS)));
     EXPECT_CALL(*libnMock, TypeIs(testing::_)).WillOnce(testing::Return(true));
@@ -555,7 +559,7 @@ HWTEST_F(WatcherMockTest, WatcherMockTest_CreateWatcher_013, testing::ext::TestS
     WatcherEntity entity;
 
     auto libnMock = LibnMock::GetMock();
-    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>())).WillOnce(testing::Return(true));
+    EXPECT_CALL(*libnMock, InitArgs(testing::A<size_t>(), testing::A<size_t>())).WillOnce(testing::Return(true));
     EXPECT_CALL(*libnMock, ToUTF8StringPath()).WillOnce(testing::Return(move(srcRes)));
     EXPECT_CALL(*libnMock, ToInt32()).WillOnce(testing::Return(std::make_tuple(true, IN_CLOSE)));
     EXPECT_CALL(*libnMock, TypeIs(testing::_)).WillOnce(testing::Return(true));
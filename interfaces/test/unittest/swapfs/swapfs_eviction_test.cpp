@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "swapfs_eviction.h"
+
+namespace OHOS::FileManagement::Swapfs {
+namespace {
+SwapKeyEntry MakeEntry(uint64_t keyId, uint64_t dataSize, int64_t lastAccessTime, uint64_t accessCount)
+{
+    SwapKeyEntry entry;
+    entry.keyId = keyId;
+    entry.dataSize = dataSize;
+    entry.lastAccessTime = lastAccessTime;
+    entry.accessCount = accessCount;
+    return entry;
+}
+
+std::vector<uint64_t> SortedKeys(OH_SwapfsEvictionPolicy policy)
+{
+    std::vector<SwapKeyEntry> candidates = {
+        MakeEntry(1, 100, 30, 5),
+        MakeEntry(2, 400, 10, 9),
+        MakeEntry(3, 200, 20, 1),
+        MakeEntry(4, 400, 40, 1),
+    };
+    SortEvictionCandidates(policy, candidates);
+    std::vector<uint64_t> keys;
+    for (const auto &candidate : candidates) {
+        keys.emplace_back(candidate.keyId);
+    }
+    return keys;
+}
+
+TEST(SwapfsEvictionTest, SortByPolicy)
+{
+    EXPECT_EQ(SortedKeys(OH_SWAPFS_EVICTION_LRU), (std::vector<uint64_t> { 2, 3, 1, 4 }));
+    EXPECT_EQ(SortedKeys(OH_SWAPFS_EVICTION_LFU), (std::vector<uint64_t> { 3, 4, 1, 2 }));
+    EXPECT_EQ(SortedKeys(OH_SWAPFS_EVICTION_SIZE), (std::vector<uint64_t> { 2, 4, 3, 1 }));
+    EXPECT_TRUE(SortedKeys(OH_SWAPFS_EVICTION_NONE).empty());
+}
+
+TEST(SwapfsEvictionTest, ValidatePolicy)
+{
+    EXPECT_TRUE(IsValidEvictionPolicy(OH_SWAPFS_EVICTION_NONE));
+    EXPECT_TRUE(IsValidEvictionPolicy(OH_SWAPFS_EVICTION_SIZE));
+    EXPECT_FALSE(IsValidEvictionPolicy(static_cast<OH_SwapfsEvictionPolicy>(-1)));
+    EXPECT_FALSE(IsValidEvictionPolicy(static_cast<OH_SwapfsEvictionPolicy>(OH_SWAPFS_EVICTION_SIZE + 1)));
+}
+} // namespace
+} // namespace OHOS::FileManagement::Swapfs
@@ -45,6 +45,7 @@
 namespace {
 using OHOS::FileManagement::Swapfs::Test::SwapfsSyscallMock;
 using OHOS::FileManagement::Swapfs::IsDioAligned;
+using OHOS::FileManagement::Swapfs::MmapReadEngine;
 using OHOS::FileManagement::Swapfs::SyncReadEngine;
 using OHOS::FileManagement::Swapfs::SyncWriteEngine;
 using OHOS::FileManagement::Swapfs::UringReadEngine;
@@ -351,6 +352,27 @@ HWTEST_F(SwapfsIoEngineTest, Swapfs_SyncReadHandlesFileBoundaryCases_0000,
     EXPECT_NE(reader.Read(badPath, output, sizeof(output), 0, false), SWAPFS_E_OK);
 }
 
+HWTEST_F(SwapfsIoEngineTest, Swapfs_MmapReadMapsFileAndRejectsShortFiles_0000,
+    testing::ext::TestSize.Level1)
+{
+    const std::string payload = "mmap engine payload";
+    WritePayload(payload);
+
+    MmapReadEngine mapper;
+    const void *data = nullptr;
+    ASSERT_EQ(mapper.Map(TEST_FILE_PATH, payload.size(), data), SWAPFS_E_OK);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::string(static_cast<const char *>(data), payload.size()), payload);
+    MmapReadEngine::Unmap(data, payload.size());
+
+    EXPECT_EQ(mapper.Map(TEST_FILE_PATH, payload.size() + 1, data), SWAPFS_E_IO_ERROR);
+    EXPECT_EQ(data, nullptr);
+    EXPECT_EQ(mapper.Map(TEST_FILE_PATH, 0, data), SWAPFS_E_INVAL);
+    const char *badPath = "/data/swapfs_test/nonexistent_file.swap";
+    (void)unlink(badPath);
+    EXPECT_NE(mapper.Map(badPath, payload.size(), data), SWAPFS_E_OK);
+}
+
 HWTEST_F(SwapfsIoEngineTest, Swapfs_SyncWriteOpenFailure_0000, testing::ext::TestSize.Level1)
 {
     constexpr const char *missingDir = "/data/swapfs_test/swapfs_io_missing_ut";
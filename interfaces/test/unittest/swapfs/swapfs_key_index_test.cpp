@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "swapfs_errcode.h"
+#include "swapfs_key_index.h"
+
+namespace OHOS::FileManagement::Swapfs {
+namespace {
+SwapKeyEntry MakeEntry(uint64_t keyId, uint64_t dataSize)
+{
+    SwapKeyEntry entry;
+    entry.keyId = keyId;
+    entry.dataSize = dataSize;
+    entry.createTime = 1;
+    return entry;
+}
+
+TEST(SwapfsKeyIndexTest, InsertQueryAndTotalsAcrossShards)
+{
+    SwapKeyIndex index;
+    EXPECT_TRUE(index.Empty());
+    constexpr uint64_t keyCount = 40;
+    for (uint64_t keyId = 1; keyId <= keyCount; ++keyId) {
+        index.Insert(MakeEntry(keyId, keyId * 2));
+    }
+
+    uint64_t totalKeys = 0;
+    uint64_t totalDataSize = 0;
+    index.GetTotals(totalKeys, totalDataSize);
+    EXPECT_EQ(totalKeys, keyCount);
+    EXPECT_EQ(totalDataSize, keyCount * (keyCount + 1));
+
+    SwapKeyEntry entry;
+    ASSERT_EQ(index.Query(7, entry), SWAPFS_E_OK);
+    EXPECT_EQ(entry.keyId, 7u);
+    EXPECT_EQ(entry.dataSize, 14u);
+    EXPECT_EQ(entry.status, OH_SWAPFS_KEY_STATUS_ACTIVE);
+    EXPECT_EQ(index.Query(keyCount + 1, entry), SWAPFS_E_KEY_NOT_FOUND);
+
+    index.Clear();
+    EXPECT_TRUE(index.Empty());
+}
+
+TEST(SwapfsKeyIndexTest, RemoveIsDeferredUntilLastReaderReleases)
+{
+    SwapKeyIndex index;
+    index.Insert(MakeEntry(1, 8));
+    SwapKeyEntry entry;
+    ASSERT_EQ(index.AcquireRead(1, 0, entry), SWAPFS_E_OK);
+    ASSERT_EQ(index.AcquireRead(1, 0, entry), SWAPFS_E_OK);
+    EXPECT_EQ(entry.readCount, 2u);
+
+    bool removeNow = true;
+    ASSERT_EQ(index.MarkRemoving(1, entry, removeNow), SWAPFS_E_OK);
+    EXPECT_FALSE(removeNow);
+    EXPECT_EQ(index.AcquireRead(1, 0, entry), SWAPFS_E_KEY_STATE_INVALID);
+    EXPECT_EQ(index.MarkRemoving(1, entry, removeNow), SWAPFS_E_KEY_STATE_INVALID);
+
+    ASSERT_EQ(index.ReleaseRead(1, entry, removeNow), SWAPFS_E_OK);
+    EXPECT_FALSE(removeNow);
+    ASSERT_EQ(index.ReleaseRead(1, entry, removeNow), SWAPFS_E_OK);
+    EXPECT_TRUE(removeNow);
+
+    EXPECT_TRUE(index.FinishRemove(1, true));
+    EXPECT_FALSE(index.FinishRemove(1, true));
+    EXPECT_EQ(index.ReleaseRead(1, entry, removeNow), SWAPFS_E_KEY_NOT_FOUND);
+    EXPECT_TRUE(index.Empty());
+}
+
+TEST(SwapfsKeyIndexTest, FailedRemoveRevertsToActive)
+{
+    SwapKeyIndex index;
+    index.Insert(MakeEntry(3, 16));
+    SwapKeyEntry entry;
+    bool removeNow = false;
+    ASSERT_EQ(index.MarkRemoving(3, entry, removeNow), SWAPFS_E_OK);
+    EXPECT_TRUE(removeNow);
+    EXPECT_TRUE(index.FinishRemove(3, false));
+    ASSERT_EQ(index.Query(3, entry), SWAPFS_E_OK);
+    EXPECT_EQ(entry.status, OH_SWAPFS_KEY_STATUS_ACTIVE);
+
+    std::vector<SwapKeyEntry> entries;
+    index.Insert(MakeEntry(4, 32));
+    index.MarkAllRemoving(entries);
+    EXPECT_EQ(entries.size(), 2u);
+    EXPECT_EQ(index.AcquireRead(3, 0, entry), SWAPFS_E_KEY_STATE_INVALID);
+    EXPECT_EQ(index.AcquireRead(4, 0, entry), SWAPFS_E_KEY_STATE_INVALID);
+}
+
+TEST(SwapfsKeyIndexTest, ConcurrentReadersKeepReadCountBalanced)
+{
+    SwapKeyIndex index;
+    constexpr uint64_t keyCount = 8;
+    for (uint64_t keyId = 1; keyId <= keyCount; ++keyId) {
+        index.Insert(MakeEntry(keyId, 1));
+    }
+    constexpr int threadCount = 8;
+    constexpr int loops = 2000;
+    std::atomic<int> failures { 0 };
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < threadCount; ++thread) {
+        threads.emplace_back([&index, &failures, thread] {
+            for (int loop = 0; loop < loops; ++loop) {
+                uint64_t keyId = static_cast<uint64_t>((thread + loop) % keyCount) + 1;
+                SwapKeyEntry entry;
+                bool removeNow = false;
+                if (index.AcquireRead(keyId, 0, entry) != SWAPFS_E_OK ||
+                    index.ReleaseRead(keyId, entry, removeNow) != SWAPFS_E_OK || removeNow) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+    for (uint64_t keyId = 1; keyId <= keyCount; ++keyId) {
+        SwapKeyEntry entry;
+        ASSERT_EQ(index.Query(keyId, entry), SWAPFS_E_OK);
+        EXPECT_EQ(entry.readCount, 0u);
+    }
+}
+} // namespace
+} // namespace OHOS::FileManagement::Swapfs
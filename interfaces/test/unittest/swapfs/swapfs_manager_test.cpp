@@ -27,6 +27,7 @@
 #include <dirent.h>
 #include <fcntl.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -45,6 +46,7 @@ using OHOS::FileManagement::Swapfs::MIN_AVAILABLE_DEVICE_SPACE_BYTES;
 using OHOS::FileManagement::Swapfs::ProxySwapControlProvider;
 using OHOS::FileManagement::Swapfs::SwapControlProvider;
 using OHOS::FileManagement::Swapfs::SwapKeyEntry;
+using OHOS::FileManagement::Swapfs::SwapKeySlot;
 using OHOS::FileManagement::Swapfs::SwapfsSessionCleaner;
 using OHOS::FileManagement::Swapfs::SwapfsConfigInner;
 using OHOS::FileManagement::Swapfs::SwapfsManager;
@@ -92,6 +94,11 @@ OH_SwapfsConfig MakeConfig()
     return config;
 }
 
+SwapKeySlot &KeySlot(SwapfsManager &manager, uint64_t keyId)
+{
+    return manager.keyIndex_.ShardOf(keyId).slots[keyId];
+}
+
 SwapfsManager MakeManager()
 {
     auto provider = std::make_unique<ProxySwapControlProvider>();
@@ -361,11 +368,10 @@ HWTEST_F(SwapfsManagerTest, Swapfs_DioReadFallsBackToSyncWhenUringUnavailable_00
         OHOS::FileManagement::ModuleEnvironment::Test::AccessTokenKitMock::GetMock();
     ON_CALL(*accessTokenMock, VerifyAccessToken(_, _)).WillByDefault(Return(-1));
     auto manager = MakeManager();
-    SwapKeyEntry entry;
-    entry.path = std::string(TEST_SWAP_ROOT) + "/missing.swap";
+    std::string path = std::string(TEST_SWAP_ROOT) + "/missing.swap";
     alignas(SWAPFS_DIO_ALIGNMENT) char buffer[SWAPFS_DIO_ALIGNMENT] {};
 
-    EXPECT_EQ(manager.ExecuteSwapInRead(entry, buffer, sizeof(buffer), true),
+    EXPECT_EQ(manager.ExecuteSwapInRead(path, buffer, sizeof(buffer), true),
         SWAPFS_E_KEY_NOT_FOUND);
 
     ON_CALL(*accessTokenMock, VerifyAccessToken(_, _)).WillByDefault(Return(0));
@@ -539,6 +545,249 @@ HWTEST_F(SwapfsManagerTest, Swapfs_GetStatsAfterSwapOut_0000, testing::ext::Test
     EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
 }
 
+struct EvictionRecord {
+    std::vector<uint64_t> keyIds;
+    uint64_t bytes = 0;
+    SwapfsManager *manager = nullptr;
+    int reentrantRet = SWAPFS_E_INVAL;
+};
+
+void RecordEviction(uint64_t keyId, uint64_t dataSize, void *userData)
+{
+    auto *record = static_cast<EvictionRecord *>(userData);
+    record->keyIds.emplace_back(keyId);
+    record->bytes += dataSize;
+}
+
+HWTEST_F(SwapfsManagerTest, Swapfs_SwapOutEvictsLeastRecentlyUsedWhenQuotaReached_0000,
+    testing::ext::TestSize.Level1)
+{
+    const std::string payload(1024, 'e');
+    EvictionRecord record;
+    OH_SwapfsConfig config = MakeConfig();
+    config.spaceLimitBytes = payload.size() * 3;
+    auto manager = MakeManager();
+    ASSERT_EQ(manager.Init(&config), SWAPFS_E_OK);
+    OH_SwapfsEvictionConfig eviction { OH_SWAPFS_EVICTION_LRU, RecordEviction, &record };
+    ASSERT_EQ(manager.SetEvictionConfig(&eviction), SWAPFS_E_OK);
+
+    OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
+    uint64_t keys[3] = {};
+    for (auto &key : keys) {
+        ASSERT_EQ(manager.SwapOut(&request, &key), SWAPFS_E_OK);
+    }
+    KeySlot(manager, keys[0]).lastAccessTime = KeySlot(manager, keys[2]).lastAccessTime + 1;
+    KeySlot(manager, keys[1]).lastAccessTime = KeySlot(manager, keys[2]).lastAccessTime - 1;
+
+    uint64_t newKey = 0;
+    ASSERT_EQ(manager.SwapOut(&request, &newKey), SWAPFS_E_OK);
+    ASSERT_EQ(record.keyIds.size(), 1u);
+    EXPECT_EQ(record.keyIds[0], keys[1]);
+    EXPECT_EQ(record.bytes, payload.size());
+    EXPECT_TRUE(FindSwapFile(TEST_SWAP_ROOT, keys[1]).empty());
+    OH_SwapfsDataInfo info {};
+    EXPECT_EQ(manager.QueryData(keys[1], &info), SWAPFS_E_KEY_NOT_FOUND);
+
+    OH_SwapfsStats stats {};
+    ASSERT_EQ(manager.GetStats(&stats), SWAPFS_E_OK);
+    EXPECT_EQ(stats.totalKeys, 3u);
+    OH_SwapfsEvictionStats evictionStats {};
+    ASSERT_EQ(manager.GetEvictionStats(&evictionStats), SWAPFS_E_OK);
+    EXPECT_EQ(evictionStats.evictedKeys, 1u);
+    EXPECT_EQ(evictionStats.evictedBytes, payload.size());
+    EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
+}
+
+void SwapOutFromEvictionCallback(uint64_t keyId, uint64_t dataSize, void *userData)
+{
+    auto *record = static_cast<EvictionRecord *>(userData);
+    RecordEviction(keyId, dataSize, userData);
+    if (record->keyIds.size() > 1) {
+        return;
+    }
+    const std::string payload(dataSize, 'c');
+    OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
+    uint64_t newKey = 0;
+    record->reentrantRet = record->manager->SwapOut(&request, &newKey);
+}
+
+HWTEST_F(SwapfsManagerTest, Swapfs_EvictionCallbackMayCallBackIntoManager_0000,
+    testing::ext::TestSize.Level1)
+{
+    const std::string payload(1024, 'b');
+    OH_SwapfsConfig config = MakeConfig();
+    config.spaceLimitBytes = payload.size() * 2;
+    auto manager = MakeManager();
+    ASSERT_EQ(manager.Init(&config), SWAPFS_E_OK);
+    EvictionRecord record;
+    record.manager = &manager;
+    OH_SwapfsEvictionConfig eviction { OH_SWAPFS_EVICTION_LRU, SwapOutFromEvictionCallback, &record };
+    ASSERT_EQ(manager.SetEvictionConfig(&eviction), SWAPFS_E_OK);
+
+    OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
+    uint64_t keys[3] = {};
+    for (auto &key : keys) {
+        ASSERT_EQ(manager.SwapOut(&request, &key), SWAPFS_E_OK);
+    }
+    // The callback's own SwapOut evicts again, which needs the eviction lock to be free.
+    EXPECT_EQ(record.reentrantRet, SWAPFS_E_OK);
+    ASSERT_EQ(record.keyIds.size(), 2u);
+    EXPECT_EQ(record.keyIds[0], keys[0]);
+    EXPECT_EQ(record.keyIds[1], keys[1]);
+    OH_SwapfsEvictionStats evictionStats {};
+    ASSERT_EQ(manager.GetEvictionStats(&evictionStats), SWAPFS_E_OK);
+    EXPECT_EQ(evictionStats.evictedKeys, 2u);
+    EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
+}
+
+HWTEST_F(SwapfsManagerTest, Swapfs_SwapOutEvictionSkipsKeysBeingRead_0000,
+    testing::ext::TestSize.Level1)
+{
+    const std::string payload(1024, 'r');
+    OH_SwapfsConfig config = MakeConfig();
+    config.spaceLimitBytes = payload.size();
+    auto manager = MakeManager();
+    ASSERT_EQ(manager.Init(&config), SWAPFS_E_OK);
+    OH_SwapfsEvictionConfig eviction { OH_SWAPFS_EVICTION_SIZE, nullptr, nullptr };
+    ASSERT_EQ(manager.SetEvictionConfig(&eviction), SWAPFS_E_OK);
+
+    OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
+    uint64_t keyId = 0;
+    ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
+    KeySlot(manager, keyId).readCount = 1;
+    uint64_t newKey = 0;
+    EXPECT_EQ(manager.SwapOut(&request, &newKey), SWAPFS_E_QUOTA_EXCEEDED);
+
+    KeySlot(manager, keyId).readCount = 0;
+    const std::string oversized(payload.size() + 1, 'o');
+    OH_SwapfsSwapOutRequest oversizedRequest { oversized.data(), oversized.size() };
+    EXPECT_EQ(manager.SwapOut(&oversizedRequest, &newKey), SWAPFS_E_QUOTA_EXCEEDED);
+    OH_SwapfsDataInfo info {};
+    EXPECT_EQ(manager.QueryData(keyId, &info), SWAPFS_E_OK);
+
+    ASSERT_EQ(manager.SwapOut(&request, &newKey), SWAPFS_E_OK);
+    EXPECT_EQ(manager.QueryData(keyId, &info), SWAPFS_E_KEY_NOT_FOUND);
+    EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
+}
+
+HWTEST_F(SwapfsManagerTest, Swapfs_SetEvictionConfigRejectsInvalidPolicy_0000, testing::ext::TestSize.Level1)
+{
+    OH_SwapfsEvictionConfig eviction { OH_SWAPFS_EVICTION_LRU, nullptr, nullptr };
+    auto manager = MakeManager();
+    EXPECT_EQ(manager.SetEvictionConfig(&eviction), SWAPFS_E_INVAL);
+    OH_SwapfsConfig config = MakeConfig();
+    ASSERT_EQ(manager.Init(&config), SWAPFS_E_OK);
+    eviction.policy = static_cast<OH_SwapfsEvictionPolicy>(OH_SWAPFS_EVICTION_SIZE + 1);
+    EXPECT_EQ(manager.SetEvictionConfig(&eviction), SWAPFS_E_INVAL);
+    EXPECT_EQ(manager.SetEvictionConfig(nullptr), SWAPFS_E_INVAL);
+    EXPECT_EQ(manager.evictionPolicy_.load(), OH_SWAPFS_EVICTION_NONE);
+    EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
+}
+
+HWTEST_F(SwapfsManagerTest, Swapfs_QueryDataReportsAccessTracking_0000, testing::ext::TestSize.Level1)
+{
+    OH_SwapfsConfig config = MakeConfig();
+    auto manager = MakeManager();
+    ASSERT_EQ(manager.Init(&config), SWAPFS_E_OK);
+    const std::string payload = "access tracking";
+    OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
+    uint64_t keyId = 0;
+    ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
+
+    std::vector<char> buffer(payload.size());
+    OH_SwapfsSwapInRequest inReq { keyId, buffer.data(), buffer.size() };
+    ASSERT_EQ(manager.SwapIn(&inReq, nullptr), SWAPFS_E_OK);
+    ASSERT_EQ(manager.SwapIn(&inReq, nullptr), SWAPFS_E_OK);
+    OH_SwapfsDataInfo info {};
+    ASSERT_EQ(manager.QueryData(keyId, &info), SWAPFS_E_OK);
+    OH_SwapfsAccessInfo access {};
+    ASSERT_EQ(manager.QueryAccessInfo(keyId, &access), SWAPFS_E_OK);
+    EXPECT_EQ(access.keyId, keyId);
+    EXPECT_EQ(access.accessCount, 2u);
+    EXPECT_GE(access.lastAccessTime, info.createTime);
+    EXPECT_EQ(manager.QueryAccessInfo(keyId + 1, &access), SWAPFS_E_KEY_NOT_FOUND);
+    EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
+}
+
+HWTEST_F(SwapfsManagerTest, Swapfs_MapInReturnsReadOnlyViewOfKeyData_0000, testing::ext::TestSize.Level1)
+{
+    OH_SwapfsConfig config = MakeConfig();
+    auto manager = MakeManager();
+    ASSERT_EQ(manager.Init(&config), SWAPFS_E_OK);
+    const std::string payload = "mapped swap payload";
+    OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
+    uint64_t keyId = 0;
+    ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
+
+    OH_SwapfsMapView view {};
+    ASSERT_EQ(manager.MapIn(keyId, &view), SWAPFS_E_OK);
+    EXPECT_EQ(view.keyId, keyId);
+    ASSERT_EQ(view.dataSize, payload.size());
+    EXPECT_EQ(std::string(static_cast<const char *>(view.data), view.dataSize), payload);
+    EXPECT_EQ(KeySlot(manager, keyId).readCount.load(), 1u);
+    EXPECT_EQ(manager.activeOps_.load(), 1u);
+
+    EXPECT_EQ(manager.UnmapView(&view), SWAPFS_E_OK);
+    EXPECT_EQ(view.data, nullptr);
+    EXPECT_EQ(KeySlot(manager, keyId).readCount.load(), 0u);
+    EXPECT_EQ(manager.activeOps_.load(), 0u);
+    EXPECT_EQ(manager.UnmapView(&view), SWAPFS_E_INVAL);
+    EXPECT_EQ(manager.MapIn(keyId + 1, &view), SWAPFS_E_KEY_NOT_FOUND);
+    EXPECT_EQ(manager.activeOps_.load(), 0u);
+    EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
+}
+
+HWTEST_F(SwapfsManagerTest, Swapfs_MappedViewDefersRemoveUntilUnmap_0000, testing::ext::TestSize.Level1)
+{
+    OH_SwapfsConfig config = MakeConfig();
+    auto manager = MakeManager();
+    ASSERT_EQ(manager.Init(&config), SWAPFS_E_OK);
+    const std::string payload = "pinned by view";
+    OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
+    uint64_t keyId = 0;
+    ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
+    OH_SwapfsMapView view {};
+    ASSERT_EQ(manager.MapIn(keyId, &view), SWAPFS_E_OK);
+
+    EXPECT_EQ(manager.RemoveAllData(), SWAPFS_E_BUSY);
+    EXPECT_EQ(manager.Destroy(), SWAPFS_E_BUSY);
+    ASSERT_EQ(manager.RemoveData(keyId), SWAPFS_E_OK);
+    EXPECT_EQ(KeySlot(manager, keyId).status, OH_SWAPFS_KEY_STATUS_REMOVING);
+    EXPECT_FALSE(FindSwapFile(TEST_SWAP_ROOT, keyId).empty());
+    EXPECT_EQ(std::string(static_cast<const char *>(view.data), view.dataSize), payload);
+    OH_SwapfsMapView second {};
+    EXPECT_EQ(manager.MapIn(keyId, &second), SWAPFS_E_KEY_STATE_INVALID);
+
+    OH_SwapfsMapView forged = view;
+    forged.keyId = keyId + 1;
+    EXPECT_EQ(manager.UnmapView(&forged), SWAPFS_E_INVAL);
+    ASSERT_EQ(manager.UnmapView(&view), SWAPFS_E_OK);
+    EXPECT_TRUE(FindSwapFile(TEST_SWAP_ROOT, keyId).empty());
+    EXPECT_TRUE(manager.keyIndex_.Empty());
+    EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
+}
+
+HWTEST_F(SwapfsManagerTest, Swapfs_DestructorUnmapsLiveViews_0000, testing::ext::TestSize.Level1)
+{
+    OH_SwapfsConfig config = MakeConfig();
+    const std::string payload = "mapped at destruction";
+    OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
+    uint64_t keyId = 0;
+    OH_SwapfsMapView view {};
+    {
+        auto manager = MakeManager();
+        ASSERT_EQ(manager.Init(&config), SWAPFS_E_OK);
+        ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
+        ASSERT_EQ(manager.MapIn(keyId, &view), SWAPFS_E_OK);
+        ASSERT_NE(view.data, nullptr);
+    }
+    // mincore fails with ENOMEM once the range is no longer mapped.
+    unsigned char resident = 0;
+    EXPECT_EQ(mincore(const_cast<void *>(view.data), 1, &resident), -1);
+    EXPECT_EQ(errno, ENOMEM);
+    EXPECT_TRUE(FindSwapFile(TEST_SWAP_ROOT, keyId).empty());
+}
+
 // ============================ RemoveData / RemoveAllData ============================
 
 HWTEST_F(SwapfsManagerTest, Swapfs_RemoveDataMakesKeyUnavailable_0000,
@@ -866,16 +1115,16 @@ HWTEST_F(SwapfsManagerTest, Swapfs_OperationsRejectInvalidKeyState_0000,
     uint64_t keyId = 0;
     ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
 
-    manager.entries_[keyId].status = OH_SWAPFS_KEY_STATUS_REMOVING;
+    KeySlot(manager, keyId).status = OH_SWAPFS_KEY_STATUS_REMOVING;
     OH_SwapfsDataInfo info {};
     EXPECT_EQ(manager.QueryData(keyId, &info), SWAPFS_E_KEY_STATE_INVALID);
     std::vector<char> buf(payload.size(), 0);
     OH_SwapfsSwapInRequest inReq { keyId, buf.data(), buf.size() };
     EXPECT_EQ(manager.SwapIn(&inReq, nullptr), SWAPFS_E_KEY_STATE_INVALID);
     EXPECT_EQ(manager.RemoveData(keyId), SWAPFS_E_KEY_STATE_INVALID);
-    EXPECT_EQ(manager.activeOps_, 0u);
+    EXPECT_EQ(manager.activeOps_.load(), 0u);
 
-    manager.entries_[keyId].status = OH_SWAPFS_KEY_STATUS_ACTIVE;
+    KeySlot(manager, keyId).status = OH_SWAPFS_KEY_STATUS_ACTIVE;
     EXPECT_EQ(manager.Destroy(), SWAPFS_E_OK);
 }
 
@@ -891,14 +1140,14 @@ HWTEST_F(SwapfsManagerTest, Swapfs_FinishSwapInHandlesConcurrentEntryRemoval_000
     uint64_t keyId = 0;
     ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
 
-    manager.entries_[keyId].status = OH_SWAPFS_KEY_STATUS_REMOVING;
-    manager.entries_[keyId].readCount = 1;
+    KeySlot(manager, keyId).status = OH_SWAPFS_KEY_STATUS_REMOVING;
+    KeySlot(manager, keyId).readCount = 1;
     auto mock = SwapfsSyscallMock::GetMock();
     auto *managerPtr = &manager;
     SwapfsSyscallMock::EnableMock();
     EXPECT_CALL(*mock, Unlink(_))
         .WillOnce(Invoke([managerPtr, keyId](const char *) {
-            managerPtr->entries_.erase(keyId);
+            managerPtr->keyIndex_.FinishRemove(keyId, true);
             return 0;
         }));
     manager.FinishSwapIn(keyId);
@@ -922,8 +1171,8 @@ HWTEST_F(SwapfsManagerTest, Swapfs_FinishSwapInDeferredDeleteUnlinkFailReverts_0
     uint64_t keyId = 0;
     ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
 
-    manager.entries_[keyId].status = OH_SWAPFS_KEY_STATUS_REMOVING;
-    manager.entries_[keyId].readCount = 1;
+    KeySlot(manager, keyId).status = OH_SWAPFS_KEY_STATUS_REMOVING;
+    KeySlot(manager, keyId).readCount = 1;
 
     auto mock = SwapfsSyscallMock::GetMock();
     SwapfsSyscallMock::EnableMock();
@@ -1017,7 +1266,7 @@ HWTEST_F(SwapfsManagerTest, Swapfs_WaitForActiveOperationsHandlesTimeout_0000,
     EXPECT_TRUE(manager.AllEntriesCleanLocked());
     manager.activeOps_ = 1;
 
-    EXPECT_EQ(manager.activeOps_, 1u);
+    EXPECT_EQ(manager.activeOps_.load(), 1u);
     EXPECT_FALSE(manager.AllEntriesCleanLocked());
     EXPECT_FALSE(manager.WaitForActiveOps(0));
 
@@ -1035,11 +1284,11 @@ HWTEST_F(SwapfsManagerTest, Swapfs_RemoveDataDefersDeletionWhileEntryIsBeingRead
     OH_SwapfsSwapOutRequest request { payload.data(), payload.size() };
     uint64_t keyId = 0;
     ASSERT_EQ(manager.SwapOut(&request, &keyId), SWAPFS_E_OK);
-    manager.entries_[keyId].readCount = 1;
+    KeySlot(manager, keyId).readCount = 1;
 
     EXPECT_EQ(manager.RemoveData(keyId), SWAPFS_E_OK);
-    EXPECT_EQ(manager.entries_[keyId].status, 1);
-    EXPECT_EQ(manager.activeOps_, 0u);
+    EXPECT_EQ(KeySlot(manager, keyId).status, 1);
+    EXPECT_EQ(manager.activeOps_.load(), 0u);
 
     manager.FinishSwapIn(keyId);
     OH_SwapfsDataInfo info {};
@@ -1360,7 +1609,7 @@ HWTEST_F(SwapfsManagerTest, Swapfs_EmptyHelperPathsRemainIdempotent_0000,
     entry.dataSize = 4;
     manager.FinishSwapIn(entry.keyId);
     manager.FinalizeRemoveEntry(entry, true);
-    EXPECT_TRUE(manager.entries_.empty());
+    EXPECT_TRUE(manager.keyIndex_.Empty());
 }
 
 } // namespace
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <thread>
 #include <utility>
@@ -185,7 +186,7 @@ bool WaitForDestroyStarted(OH_SwapfsManager *manager)
 {
     for (uint32_t attempt = 0; attempt < DESTROY_WAIT_SPINS; ++attempt) {
         {
-            std::lock_guard<std::mutex> lock(manager->impl.mutex_);
+            std::lock_guard<std::shared_mutex> lock(manager->impl.mutex_);
             if (manager->impl.shuttingDown_) {
                 return true;
             }
@@ -229,8 +230,13 @@ HWTEST_F(SwapfsTest, Swapfs_AllFunctionsRejectNullManager_0000, testing::ext::Te
     EXPECT_EQ(OH_Swapfs_DestroyManager(nullptr), SWAPFS_E_INVAL);
     EXPECT_EQ(OH_Swapfs_SwapOut(nullptr, nullptr, nullptr), SWAPFS_E_INVAL);
     EXPECT_EQ(OH_Swapfs_SwapIn(nullptr, nullptr, nullptr), SWAPFS_E_INVAL);
+    EXPECT_EQ(OH_Swapfs_MapIn(nullptr, 1, nullptr), SWAPFS_E_INVAL);
+    EXPECT_EQ(OH_Swapfs_UnmapView(nullptr, nullptr), SWAPFS_E_INVAL);
     EXPECT_EQ(OH_Swapfs_QueryData(nullptr, 1, nullptr), SWAPFS_E_INVAL);
     EXPECT_EQ(OH_Swapfs_GetStats(nullptr, nullptr), SWAPFS_E_INVAL);
+    EXPECT_EQ(OH_Swapfs_SetEvictionConfig(nullptr, nullptr), SWAPFS_E_INVAL);
+    EXPECT_EQ(OH_Swapfs_QueryAccessInfo(nullptr, 1, nullptr), SWAPFS_E_INVAL);
+    EXPECT_EQ(OH_Swapfs_GetEvictionStats(nullptr, nullptr), SWAPFS_E_INVAL);
     EXPECT_EQ(OH_Swapfs_RemoveData(nullptr, 1), SWAPFS_E_INVAL);
     EXPECT_EQ(OH_Swapfs_RemoveAllData(nullptr), SWAPFS_E_INVAL);
 }
@@ -241,8 +247,17 @@ HWTEST_F(SwapfsTest, Swapfs_NativeFunctionsRejectNullManager_0000, testing::ext:
     EXPECT_EQ(SwapfsNativeDestroyManager(nullptr), SWAPFS_E_INVAL);
     EXPECT_EQ(SwapfsNativeSwapOut(nullptr, nullptr, nullptr), SWAPFS_E_INVAL);
     EXPECT_EQ(SwapfsNativeSwapIn(nullptr, nullptr, nullptr), SWAPFS_E_INVAL);
+    OH_SwapfsMapView view {};
+    EXPECT_EQ(SwapfsNativeMapIn(nullptr, 1, &view), SWAPFS_E_INVAL);
+    EXPECT_EQ(SwapfsNativeUnmapView(nullptr, &view), SWAPFS_E_INVAL);
     EXPECT_EQ(SwapfsNativeQueryData(nullptr, 1, nullptr), SWAPFS_E_INVAL);
     EXPECT_EQ(SwapfsNativeGetStats(nullptr, nullptr), SWAPFS_E_INVAL);
+    OH_SwapfsEvictionConfig eviction {};
+    OH_SwapfsAccessInfo access {};
+    OH_SwapfsEvictionStats evictionStats {};
+    EXPECT_EQ(SwapfsNativeSetEvictionConfig(nullptr, &eviction), SWAPFS_E_INVAL);
+    EXPECT_EQ(SwapfsNativeQueryAccessInfo(nullptr, 1, &access), SWAPFS_E_INVAL);
+    EXPECT_EQ(SwapfsNativeGetEvictionStats(nullptr, &evictionStats), SWAPFS_E_INVAL);
     EXPECT_EQ(SwapfsNativeRemoveData(nullptr, 1), SWAPFS_E_INVAL);
     EXPECT_EQ(SwapfsNativeRemoveAllData(nullptr), SWAPFS_E_INVAL);
 }
@@ -316,7 +331,7 @@ HWTEST_F(SwapfsTest, Swapfs_DestroyManagerRejectsConcurrentApiCalls_0000,
     EXPECT_EQ(statsRet, SWAPFS_E_OK);
 
     {
-        std::lock_guard<std::mutex> lock(manager->impl.mutex_);
+        std::lock_guard<std::shared_mutex> lock(manager->impl.mutex_);
         manager->impl.activeOps_ = 1;
     }
     int destroyRet = SWAPFS_E_OK;
@@ -418,6 +433,19 @@ HWTEST_F(SwapfsTest, Swapfs_CapiFullLifecycle_0000, testing::ext::TestSize.Level
     OH_SwapfsSwapInRequest inRequest { firstKey, output.data(), output.size() };
     ASSERT_EQ(OH_Swapfs_SwapIn(manager, &inRequest, nullptr), SWAPFS_E_OK);
     EXPECT_EQ(std::string(output.begin(), output.end()), firstPayload);
+    OH_SwapfsMapView view {};
+    EXPECT_EQ(OH_Swapfs_MapIn(manager, 0, &view), SWAPFS_E_INVAL);
+    ASSERT_EQ(OH_Swapfs_MapIn(manager, secondKey, &view), SWAPFS_E_OK);
+    EXPECT_EQ(std::string(static_cast<const char *>(view.data), view.dataSize), secondPayload);
+    EXPECT_EQ(OH_Swapfs_UnmapView(manager, &view), SWAPFS_E_OK);
+    OH_SwapfsAccessInfo access {};
+    ASSERT_EQ(OH_Swapfs_QueryAccessInfo(manager, secondKey, &access), SWAPFS_E_OK);
+    EXPECT_EQ(access.accessCount, 1u);
+    OH_SwapfsEvictionConfig eviction { OH_SWAPFS_EVICTION_LRU, nullptr, nullptr };
+    EXPECT_EQ(OH_Swapfs_SetEvictionConfig(manager, &eviction), SWAPFS_E_OK);
+    OH_SwapfsEvictionStats evictionStats {};
+    ASSERT_EQ(OH_Swapfs_GetEvictionStats(manager, &evictionStats), SWAPFS_E_OK);
+    EXPECT_EQ(evictionStats.evictedKeys, 0u);
 
     EXPECT_EQ(OH_Swapfs_RemoveData(manager, firstKey), SWAPFS_E_OK);
     EXPECT_EQ(OH_Swapfs_QueryData(manager, firstKey, &info), SWAPFS_E_KEY_NOT_FOUND);